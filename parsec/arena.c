@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2023 The University of Tennessee and The University
+ * Copyright (c) 2010-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -11,6 +11,8 @@
 #include "parsec/data_internal.h"
 #include "parsec/utils/debug.h"
 #include "parsec/papi_sde.h"
+#include "parsec/execution_stream.h"
+#include "parsec/parsec_hwloc.h"
 #include <limits.h>
 
 #if defined(PARSEC_PROF_TRACE_ACTIVE_ARENA_SET)
@@ -54,6 +56,36 @@ extern int arena_memory_used_key, arena_memory_unused_key;
 
 size_t parsec_arena_max_allocated_memory = SIZE_MAX;  /* unlimited */
 size_t parsec_arena_max_cached_memory    = 256*1024*1024; /* limited to 256MB */
+int    parsec_arena_magazine_size        = 8;
+
+/**
+ * Single elements released by an execution stream are first kept in a small
+ * magazine private to this stream, accessed without atomic operations. Full
+ * magazines spill half their content into the depot of their NUMA node, and
+ * empty magazines refill from it. The depots and the arena shared lifo (which
+ * holds the elements allocated outside of any execution stream) are bounded by
+ * max_released, minus what the magazines can hold, so the arena never caches
+ * more than max_released elements overall. Elements remember the NUMA node of
+ * the stream that allocated (and first touched) them, and always return to the
+ * depot of this node.
+ */
+#define PARSEC_ARENA_MAGAZINE_MAX 31  /* a magazine then spans exactly 4 cache lines */
+
+typedef struct parsec_arena_magazine_s {
+    int32_t             count;   /**< number of elements in the magazine */
+    int32_t             numa;    /**< NUMA node of the owner execution stream */
+    parsec_list_item_t *items[PARSEC_ARENA_MAGAZINE_MAX];
+} parsec_arena_magazine_t;
+
+typedef struct parsec_arena_cache_s {
+    parsec_context_t        *context;       /**< context owning the execution streams of the magazines */
+    int32_t                  nb_magazines;  /**< one per execution stream of the context */
+    int32_t                  magazine_size; /**< number of elements in a full magazine */
+    int32_t                  max_released;  /**< maximum number of elements in the depots and the shared lifo */
+    int32_t                  nb_numa;       /**< number of depots */
+    parsec_lifo_t           *depots;
+    parsec_arena_magazine_t *magazines;
+} parsec_arena_cache_t;
 
 
 int parsec_arena_construct_ex(parsec_arena_t* arena,
@@ -64,6 +96,7 @@ int parsec_arena_construct_ex(parsec_arena_t* arena,
 {
     arena->elem_size = 0;  /* make sure the arena is marked as uninitialized to allow
                               the destructor to skip the lifo destruction. */
+    arena->cache     = NULL;
     /* alignment must be more than zero and power of two */
     if( (alignment <= 1) || (alignment & (alignment - 1)) )
         return PARSEC_ERR_BAD_PARAM;
@@ -96,18 +129,210 @@ int parsec_arena_construct(parsec_arena_t* arena,
                                     parsec_arena_max_cached_memory);
 }
 
+static parsec_arena_cache_t*
+parsec_arena_cache_create(parsec_arena_t *arena, parsec_context_t *context)
+{
+    parsec_arena_cache_t *cache;
+    parsec_execution_stream_t *es;
+    int p, t, idx, numa, nb_es = 0;
+
+    for( p = 0; p < context->nb_vp; p++ )
+        nb_es += context->virtual_processes[p]->nb_cores;
+
+    cache = (parsec_arena_cache_t*)malloc(sizeof(parsec_arena_cache_t));
+    if( 0 != posix_memalign((void**)&cache->magazines, 64, nb_es * sizeof(parsec_arena_magazine_t)) ) {
+        free(cache);
+        return NULL;
+    }
+    cache->context      = context;
+    cache->nb_magazines = nb_es;
+    cache->nb_numa      = 1;
+    for( idx = 0, p = 0; p < context->nb_vp; p++ ) {
+        for( t = 0; t < context->virtual_processes[p]->nb_cores; t++, idx++ ) {
+            es = context->virtual_processes[p]->execution_streams[t];
+            numa = (NULL != es && es->core_id >= 0) ? parsec_hwloc_numa_id(es->core_id) : 0;
+            if( numa < 0 ) numa = 0;
+            cache->magazines[idx].count = 0;
+            cache->magazines[idx].numa  = numa;
+            if( numa >= cache->nb_numa ) cache->nb_numa = numa + 1;
+        }
+    }
+    cache->magazine_size = parsec_arena_magazine_size < PARSEC_ARENA_MAGAZINE_MAX ?
+        parsec_arena_magazine_size : PARSEC_ARENA_MAGAZINE_MAX;
+    cache->max_released = arena->max_released;
+    if( INT32_MAX != arena->max_released ) {
+        /* Leave at least half of the cache to the depots */
+        if( cache->magazine_size > arena->max_released / (2 * nb_es) )
+            cache->magazine_size = arena->max_released / (2 * nb_es);
+        cache->max_released = arena->max_released - nb_es * cache->magazine_size;
+    }
+    cache->depots = (parsec_lifo_t*)malloc(cache->nb_numa * sizeof(parsec_lifo_t));
+    for( numa = 0; numa < cache->nb_numa; numa++ )
+        PARSEC_OBJ_CONSTRUCT(&cache->depots[numa], parsec_lifo_t);
+
+    if( !parsec_atomic_cas_ptr(&arena->cache, NULL, cache) ) {
+        /* Another stream was faster */
+        for( numa = 0; numa < cache->nb_numa; numa++ )
+            PARSEC_OBJ_DESTRUCT(&cache->depots[numa]);
+        free(cache->depots);
+        free(cache->magazines);
+        free(cache);
+        cache = arena->cache;
+    }
+    return cache;
+}
+
+/**
+ * Return the magazine of the calling execution stream, or NULL if the
+ * caller is not an execution stream or the magazines are disabled.
+ */
+static inline parsec_arena_magazine_t*
+parsec_arena_magazine(parsec_arena_t *arena, parsec_execution_stream_t *es)
+{
+    parsec_arena_cache_t *cache;
+    parsec_vp_t *vp;
+    int p, idx;
+
+    if( NULL == es ) return NULL;
+    vp = es->virtual_process;
+    /* The communication engine pretends to be the first stream of the first vp */
+    if( es != vp->execution_streams[es->th_id] ) return NULL;
+    if( NULL == (cache = arena->cache) ) {
+        if( 0 >= parsec_arena_magazine_size ) return NULL;
+        if( NULL == (cache = parsec_arena_cache_create(arena, vp->parsec_context)) ) return NULL;
+    }
+    if( 0 == cache->magazine_size || cache->context != vp->parsec_context ) return NULL;
+    for( idx = es->th_id, p = 0; p < vp->vp_id; p++ )
+        idx += vp->parsec_context->virtual_processes[p]->nb_cores;
+    return &cache->magazines[idx];
+}
+
+/**
+ * Account for nb elements joining the depots or the shared lifo, and
+ * return how many of them fit within the arena limit.
+ */
+static inline int32_t
+parsec_arena_reserve_released(parsec_arena_t *arena, int32_t nb)
+{
+    int32_t limit, current;
+
+    if( INT32_MAX == arena->max_released ) return nb;
+    limit = (NULL != arena->cache) ? arena->cache->max_released : arena->max_released;
+    current = parsec_atomic_fetch_add_int32(&arena->released, nb) + nb;
+    if( current > limit ) {
+        current = (current - limit) > nb ? nb : (current - limit);
+        (void)parsec_atomic_fetch_sub_int32(&arena->released, current);
+        return nb - current;
+    }
+    return nb;
+}
+
+static inline parsec_lifo_t*
+parsec_arena_depot(parsec_arena_t *arena, parsec_arena_chunk_t *chunk)
+{
+    if( NULL == arena->cache || chunk->numa < 0 || chunk->numa >= arena->cache->nb_numa )
+        return &arena->area_lifo;
+    return &arena->cache->depots[chunk->numa];
+}
+
+static void
+parsec_arena_free_chunk(parsec_arena_t* arena,
+                        parsec_arena_chunk_t *chunk)
+{
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Arena:\tdeallocate a tile of size %zu x %zu from arena %p, aligned by %zu, base ptr %p, data ptr %p, sizeof prefix %zu(%zd)",
+            arena->elem_size, chunk->count, arena, arena->alignment, chunk, chunk->data, sizeof(parsec_arena_chunk_t),
+            PARSEC_ARENA_MIN_ALIGNMENT(arena->alignment));
+    TRACE_FREE(arena_memory_free_key, -arena->elem_size*chunk->count, chunk);
+    if(arena->max_used != 0 && arena->max_used != INT32_MAX)
+        (void)parsec_atomic_fetch_sub_int32(&arena->used, chunk->count);
+    arena->data_free(chunk);
+}
+
+/**
+ * Move the oldest half of a full magazine into the depots.
+ */
+static void
+parsec_arena_magazine_flush(parsec_arena_t *arena, parsec_arena_magazine_t *mag)
+{
+    int32_t i, nb = (mag->count + 1) / 2, kept;
+
+    kept = parsec_arena_reserve_released(arena, nb);
+    for( i = 0; i < nb; i++ ) {
+        if( i < kept )
+            parsec_lifo_push(parsec_arena_depot(arena, (parsec_arena_chunk_t*)mag->items[i]), mag->items[i]);
+        else
+            parsec_arena_free_chunk(arena, (parsec_arena_chunk_t*)mag->items[i]);
+    }
+    for( i = nb; i < mag->count; i++ )
+        mag->items[i - nb] = mag->items[i];
+    mag->count -= nb;
+}
+
+/**
+ * Refill an empty magazine with up to half its size from the depot of its
+ * NUMA node; otherwise take a single element from the shared lifo, or
+ * from the depot of another NUMA node.
+ */
+static void
+parsec_arena_magazine_refill(parsec_arena_t *arena, parsec_arena_magazine_t *mag)
+{
+    parsec_arena_cache_t *cache = arena->cache;
+    parsec_list_item_t *item;
+    int32_t i, nb = (cache->magazine_size + 1) / 2;
+
+    while( mag->count < nb && NULL != (item = parsec_lifo_pop(&cache->depots[mag->numa])) )
+        mag->items[mag->count++] = item;
+    if( 0 == mag->count ) {
+        if( NULL != (item = parsec_lifo_pop(&arena->area_lifo)) ) {
+            mag->items[mag->count++] = item;
+        } else {
+            for( i = 1; i < cache->nb_numa; i++ ) {
+                if( NULL != (item = parsec_lifo_pop(&cache->depots[(mag->numa + i) % cache->nb_numa])) ) {
+                    PARSEC_PAPI_SDE_COUNTER_ADD(PARSEC_PAPI_SDE_ARENA_CROSS_NUMA, 1);
+                    mag->items[mag->count++] = item;
+                    break;
+                }
+            }
+        }
+    }
+    if( 0 != mag->count && INT32_MAX != arena->max_released )
+        (void)parsec_atomic_fetch_sub_int32(&arena->released, mag->count);
+}
+
 static void parsec_arena_destructor(parsec_arena_t* arena)
 {
+    parsec_arena_cache_t *cache = arena->cache;
     parsec_list_item_t* item;
+    int32_t i, cached = arena->released;
 
-    assert( arena->used == arena->released
+    if( NULL != cache ) {
+        for( i = 0; i < cache->nb_magazines; i++ )
+            cached += cache->magazines[i].count;
+    }
+    assert( arena->used == cached
          || arena->max_released == 0
          || arena->max_released == INT32_MAX
          || arena->max_used == 0
          || arena->max_used == INT32_MAX );
+    (void)cached;
 
     /* If elem_size == 0, the arena has not been initialized */
     if ( 0 != arena->elem_size ) {
+        if( NULL != cache ) {
+            for( i = 0; i < cache->nb_magazines; i++ ) {
+                while( cache->magazines[i].count > 0 )
+                    parsec_lifo_push(&arena->area_lifo, cache->magazines[i].items[--cache->magazines[i].count]);
+            }
+            for( i = 0; i < cache->nb_numa; i++ ) {
+                while(NULL != (item = parsec_lifo_pop(&cache->depots[i])))
+                    parsec_lifo_push(&arena->area_lifo, item);
+                PARSEC_OBJ_DESTRUCT(&cache->depots[i]);
+            }
+            free(cache->depots);
+            free(cache->magazines);
+            free(cache);
+            arena->cache = NULL;
+        }
         while(NULL != (item = parsec_lifo_pop(&arena->area_lifo))) {
             PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Arena:\tfree element base ptr %p, data ptr %p (from arena %p)",
                                 item, ((parsec_arena_chunk_t*)item)->data, arena);
@@ -123,14 +348,24 @@ PARSEC_OBJ_CLASS_INSTANCE(parsec_arena_t, parsec_object_t, NULL, parsec_arena_de
 static inline parsec_list_item_t*
 parsec_arena_get_chunk( parsec_arena_t *arena, size_t size, parsec_data_allocate_t alloc )
 {
-    parsec_lifo_t *list = &arena->area_lifo;
-    parsec_list_item_t *item;
-    item = parsec_lifo_pop(list);
-    if( NULL != item ) {
-        if( arena->max_released != INT32_MAX )
+    parsec_arena_magazine_t *mag = parsec_arena_magazine(arena, parsec_my_execution_stream());
+    parsec_list_item_t *item = NULL;
+
+    if( NULL != mag ) {
+        if( 0 == mag->count )
+            parsec_arena_magazine_refill(arena, mag);
+        if( 0 != mag->count )
+            item = mag->items[--mag->count];
+    } else {
+        item = parsec_lifo_pop(&arena->area_lifo);
+        if( (NULL != item) && (arena->max_released != INT32_MAX) )
             (void)parsec_atomic_fetch_dec_int32(&arena->released);
     }
+    if( NULL != item ) {
+        PARSEC_PAPI_SDE_COUNTER_ADD(PARSEC_PAPI_SDE_ARENA_CACHE_HITS, 1);
+    }
     else {
+        PARSEC_PAPI_SDE_COUNTER_ADD(PARSEC_PAPI_SDE_ARENA_CACHE_MISSES, 1);
         if(arena->max_used != INT32_MAX) {
             int32_t current = parsec_atomic_fetch_inc_int32(&arena->used) + 1;
             if(current > arena->max_used) {
@@ -144,6 +379,8 @@ parsec_arena_get_chunk( parsec_arena_t *arena, size_t size, parsec_data_allocate
         TRACE_MALLOC(arena_memory_alloc_key, size, item);
         PARSEC_OBJ_CONSTRUCT(item, parsec_list_item_t);
         assert(NULL != item);
+        ((parsec_arena_chunk_t*)item)->numa = (NULL != mag) ? mag->numa : -1;
+        assert((NULL == mag) || (0 <= ((parsec_arena_chunk_t*)item)->numa));
     }
     PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Arena:\tpop a data of size %zu from arena %p, aligned by %zu, base ptr %p, data ptr %p, sizeof prefix %zu(%zd)",
                 arena->elem_size, arena, arena->alignment, item, ((parsec_arena_chunk_t*)item)->data, sizeof(parsec_arena_chunk_t),
@@ -155,25 +392,27 @@ static void
 parsec_arena_release_chunk(parsec_arena_t* arena,
                           parsec_arena_chunk_t *chunk)
 {
+    parsec_arena_magazine_t *mag;
+
     TRACE_FREE(arena_memory_unused_key, -arena->elem_size*chunk->count, chunk);
 
-    if( (chunk->count == 1) && (arena->released < arena->max_released) ) {
+    if( chunk->count == 1 ) {
         PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Arena:\tpush a data of size %zu from arena %p, aligned by %zu, base ptr %p, data ptr %p, sizeof prefix %zu(%zd)",
                 arena->elem_size, arena, arena->alignment, chunk, chunk->data, sizeof(parsec_arena_chunk_t),
                 PARSEC_ARENA_MIN_ALIGNMENT(arena->alignment));
-        if(arena->max_released != INT32_MAX) {
-            (void)parsec_atomic_fetch_inc_int32(&arena->released);
+        mag = parsec_arena_magazine(arena, parsec_my_execution_stream());
+        if( (NULL != mag) && (chunk->numa == mag->numa) ) {
+            if( mag->count == arena->cache->magazine_size )
+                parsec_arena_magazine_flush(arena, mag);
+            mag->items[mag->count++] = &chunk->item;
+            return;
+        }
+        if( 1 == parsec_arena_reserve_released(arena, 1) ) {
+            parsec_lifo_push(parsec_arena_depot(arena, chunk), &chunk->item);
+            return;
         }
-        parsec_lifo_push(&arena->area_lifo, &chunk->item);
-        return;
     }
-    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Arena:\tdeallocate a tile of size %zu x %zu from arena %p, aligned by %zu, base ptr %p, data ptr %p, sizeof prefix %zu(%zd)",
-            arena->elem_size, chunk->count, arena, arena->alignment, chunk, chunk->data, sizeof(parsec_arena_chunk_t),
-            PARSEC_ARENA_MIN_ALIGNMENT(arena->alignment));
-    TRACE_FREE(arena_memory_free_key, -arena->elem_size*chunk->count, chunk);
-    if(arena->max_used != 0 && arena->max_used != INT32_MAX)
-        (void)parsec_atomic_fetch_sub_int32(&arena->used, chunk->count);
-    arena->data_free(chunk);
+    parsec_arena_free_chunk(arena, chunk);
 }
 
 int  parsec_arena_allocate_device_private(parsec_data_copy_t *copy,
@@ -205,10 +444,14 @@ int  parsec_arena_allocate_device_private(parsec_data_copy_t *copy,
                             arena->alignment, size_t);
         chunk = (parsec_arena_chunk_t*)arena->data_malloc(size);
         PARSEC_OBJ_CONSTRUCT(&chunk->item, parsec_list_item_t);
+        chunk->numa = -1;
 
         TRACE_MALLOC(arena_memory_alloc_key, size, chunk);
     }
     if(NULL == chunk) return PARSEC_ERR_OUT_OF_RESOURCE;  /* no more */
+    /* new or recycled, the chunk must know the depot it returns to */
+    assert((-1 == chunk->numa) ||
+           ((0 <= chunk->numa) && (NULL != arena->cache) && (chunk->numa < arena->cache->nb_numa)));
 
 #if defined(PARSEC_DEBUG_PARANOID)
     PARSEC_LIST_ITEM_SINGLETON( &chunk->item );
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009-2022 The University of Tennessee and The University
+ * Copyright (c) 2009-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -35,6 +35,12 @@ extern size_t parsec_arena_max_allocated_memory;
  */
 extern size_t parsec_arena_max_cached_memory;
 
+/**
+ * Number of single elements each execution stream keeps in its private
+ * magazine, for each arena (0 disables the per execution stream caches).
+ */
+extern int parsec_arena_magazine_size;
+
 #define PARSEC_ALIGN(x,a,t) (((x)+((t)(a)-1)) & ~(((t)(a)-1)))
 #define PARSEC_ALIGN_PTR(x,a,t) ((t)PARSEC_ALIGN((uintptr_t)x, a, uintptr_t))
 #define PARSEC_ALIGN_PAD_AMOUNT(x,s) ((~((uintptr_t)(x))+1) & ((uintptr_t)(s)-1))
@@ -57,6 +63,8 @@ struct parsec_arena_s {
     volatile int32_t      released;      /**< elements currently released but still cached in the freelist */
     int32_t               max_released;  /**< when more that max elements are released, they are really freed
                                           *   instead of joining the lifo */
+    struct parsec_arena_cache_s *cache;  /**< per execution stream magazines and per NUMA node depots
+                                          *   of single elements, created on first use */
     /** some host hardware requires special allocation functions (Cuda, pinning,
      *  Open CL, ...). Defaults are to use C malloc/free
      */
@@ -72,6 +80,8 @@ struct parsec_arena_chunk_s {
      *  It is SINGLETON when ( (not in a free list) and (in debug mode) ) */
     parsec_list_item_t item;
     uint32_t           count;    /**< Number of basic elements pointed by param in this chunck */
+    int32_t            numa;     /**< NUMA node of the execution stream that allocated (and first
+                                  *   touched) this chunk, -1 if unknown */
     parsec_arena_t    *origin;   /**< Arena in which this chunck should be released */
     void              *data;     /**< Actual data pointed by this chunck */
 };
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#ifndef PARSEC_EVENTCOUNT_H_HAS_BEEN_INCLUDED
+#define PARSEC_EVENTCOUNT_H_HAS_BEEN_INCLUDED
+
+#include "parsec/parsec_config.h"
+#include "parsec/sys/atomic.h"
+
+#if !defined(PARSEC_HAVE_FUTEX)
+#include <pthread.h>
+#endif  /* !defined(PARSEC_HAVE_FUTEX) */
+
+/**
+ * @defgroup parsec_internal_classes_eventcount Event Counts
+ * @ingroup parsec_internal_classes
+ * @{
+ *
+ *  @brief Park threads until an event is signaled, without losing wake ups
+ *
+ *  @details A thread that runs out of work announces that it is about to
+ *    wait with parsec_eventcount_prepare_wait(), checks one last time
+ *    whether some work has arrived, and then either cancels the wait or
+ *    commits to it with parsec_eventcount_wait(). A producer makes the
+ *    work visible first, then calls parsec_eventcount_notify(). Any notify
+ *    that happens after prepare_wait prevents the wait from blocking, so
+ *    no wake up can be lost between the last check and the wait.
+ *
+ *    On Linux the threads are parked on a futex on the epoch of the event
+ *    count, everywhere else a mutex and a condition are used.
+ */
+
+BEGIN_C_DECLS
+
+/**
+ * @brief An event count
+ */
+typedef struct parsec_eventcount_s {
+    volatile int32_t epoch;      /**< Incremented by each notify that finds some waiters */
+    volatile int32_t nb_waiters; /**< Number of threads between prepare_wait and the end of their wait */
+#if !defined(PARSEC_HAVE_FUTEX)
+    pthread_mutex_t  mutex;
+    pthread_cond_t   cond;
+#endif  /* !defined(PARSEC_HAVE_FUTEX) */
+} parsec_eventcount_t;
+
+/**
+ * @brief Initialize an event count
+ *
+ * @param[out] ec the event count to initialize
+ */
+void parsec_eventcount_init(parsec_eventcount_t *ec);
+
+/**
+ * @brief Release the resources of an event count
+ *
+ * @details No thread should be waiting on the event count.
+ * @param[inout] ec the event count to destroy
+ */
+void parsec_eventcount_fini(parsec_eventcount_t *ec);
+
+/**
+ * @brief Announce that the calling thread is about to wait
+ *
+ * @details The caller must then check the condition it is waiting for,
+ *   and call either parsec_eventcount_cancel_wait() or
+ *   parsec_eventcount_wait() with the returned key.
+ * @param[inout] ec the event count
+ * @return the key to pass to parsec_eventcount_wait()
+ */
+static inline int32_t parsec_eventcount_prepare_wait(parsec_eventcount_t *ec)
+{
+    (void)parsec_atomic_fetch_inc_int32(&ec->nb_waiters);
+    parsec_mfence();  /* the condition must be checked after the waiter is visible */
+    return ec->epoch;
+}
+
+/**
+ * @brief Give up waiting after parsec_eventcount_prepare_wait()
+ *
+ * @param[inout] ec the event count
+ */
+static inline void parsec_eventcount_cancel_wait(parsec_eventcount_t *ec)
+{
+    (void)parsec_atomic_fetch_dec_int32(&ec->nb_waiters);
+}
+
+/**
+ * @brief Block until the event count is notified
+ *
+ * @details Returns immediately if a notify happened since the
+ *   parsec_eventcount_prepare_wait() that produced the key. Spurious wake
+ *   ups are possible, the caller is expected to check its condition again.
+ * @param[inout] ec the event count
+ * @param[in] key the value returned by parsec_eventcount_prepare_wait()
+ * @param[in] timeout_ns the maximal time to wait, in nanoseconds, or a
+ *            negative value to wait without limit
+ * @return 1 if the event count was notified, 0 otherwise
+ */
+int parsec_eventcount_wait(parsec_eventcount_t *ec, int32_t key, int64_t timeout_ns);
+
+/**
+ * @brief Wake up some of the threads waiting on the event count
+ *
+ * @details The work the waiters are looking for must be visible before
+ *   this call. All the threads that are preparing to wait abort their
+ *   wait, and up to nb of the blocked threads are woken up.
+ * @param[inout] ec the event count
+ * @param[in] nb the maximal number of blocked threads to wake up, or a
+ *            negative value to wake up all of them
+ * @return the number of threads that were waiting, 0 if no notification
+ *         was needed.
+ */
+int parsec_eventcount_notify(parsec_eventcount_t *ec, int nb);
+
+END_C_DECLS
+
+/**
+ * @}
+ */
+
+#endif  /* PARSEC_EVENTCOUNT_H_HAS_BEEN_INCLUDED */
@@ -276,6 +276,32 @@ parsec_list_item_ring_push_sorted( parsec_list_item_t* ring,
     return ring;
 }
 
+/**
+ * @brief
+ *   Insert an item at the head of an items ring
+ *
+ * @details
+ *   The item becomes the first element of the ring, ahead of all the items
+ *   already in the ring. Sorting the resulting ring with a stable sort gives
+ *   the ring that successive calls to parsec_list_item_ring_push_sorted
+ *   would have built, at a fraction of the cost for long rings.
+ * @param[inout] ring the ring of items (can be NULL)
+ * @param[inout] item the item to add
+ * @return the newly formed ring of items, starting at item
+ * @remark This function is not thread safe
+ */
+static inline parsec_list_item_t*
+parsec_list_item_ring_push_head( parsec_list_item_t* ring,
+                                 parsec_list_item_t* item )
+{
+    parsec_list_item_singleton(item);
+    if( NULL == ring ) {
+        return item;
+    }
+    parsec_list_item_ring_push(ring, item);
+    return item;
+}
+
 /* This is debug helpers for list items accounting */
 /**
  * Don't include the implementation in the doxygen documentation
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/class/eventcount.h"
+
+#include <assert.h>
+#include <time.h>
+#if defined(PARSEC_HAVE_FUTEX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <sys/time.h>
+#endif  /* defined(PARSEC_HAVE_FUTEX) */
+
+void parsec_eventcount_init(parsec_eventcount_t *ec)
+{
+    ec->epoch      = 0;
+    ec->nb_waiters = 0;
+#if !defined(PARSEC_HAVE_FUTEX)
+    pthread_mutex_init(&ec->mutex, NULL);
+    pthread_cond_init(&ec->cond, NULL);
+#endif  /* !defined(PARSEC_HAVE_FUTEX) */
+}
+
+void parsec_eventcount_fini(parsec_eventcount_t *ec)
+{
+    assert(0 == ec->nb_waiters);
+#if !defined(PARSEC_HAVE_FUTEX)
+    pthread_mutex_destroy(&ec->mutex);
+    pthread_cond_destroy(&ec->cond);
+#endif  /* !defined(PARSEC_HAVE_FUTEX) */
+    (void)ec;
+}
+
+int parsec_eventcount_wait(parsec_eventcount_t *ec, int32_t key, int64_t timeout_ns)
+{
+    int notified;
+#if defined(PARSEC_HAVE_FUTEX)
+    struct timespec ts, *pts = NULL;
+
+    if( timeout_ns >= 0 ) {
+        ts.tv_sec  = timeout_ns / 1000000000;
+        ts.tv_nsec = timeout_ns % 1000000000;
+        pts = &ts;
+    }
+    /* The kernel checks that the epoch still matches the key before
+     * blocking, a notify between prepare_wait and here is not lost. */
+    (void)syscall(SYS_futex, (int32_t*)&ec->epoch, FUTEX_WAIT_PRIVATE, key, pts, NULL, 0);
+    notified = (key != ec->epoch);
+#else
+    pthread_mutex_lock(&ec->mutex);
+    if( timeout_ns >= 0 ) {
+        struct timeval now;
+        struct timespec deadline;
+        gettimeofday(&now, NULL);
+        deadline.tv_sec  = now.tv_sec + timeout_ns / 1000000000;
+        deadline.tv_nsec = now.tv_usec * 1000 + timeout_ns % 1000000000;
+        if( deadline.tv_nsec >= 1000000000 ) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        while( key == ec->epoch ) {
+            if( 0 != pthread_cond_timedwait(&ec->cond, &ec->mutex, &deadline) )
+                break;
+        }
+    } else {
+        while( key == ec->epoch )
+            pthread_cond_wait(&ec->cond, &ec->mutex);
+    }
+    notified = (key != ec->epoch);
+    pthread_mutex_unlock(&ec->mutex);
+#endif  /* defined(PARSEC_HAVE_FUTEX) */
+    (void)parsec_atomic_fetch_dec_int32(&ec->nb_waiters);
+    return notified;
+}
+
+int parsec_eventcount_notify(parsec_eventcount_t *ec, int nb)
+{
+    int nb_waiters;
+
+    /* the work published by the caller must be visible before we look
+     * for waiters, this pairs with the fence in prepare_wait */
+    parsec_mfence();
+    nb_waiters = ec->nb_waiters;
+    if( 0 >= nb_waiters )
+        return 0;
+    if( (nb < 0) || (nb > nb_waiters) )
+        nb = nb_waiters;
+#if defined(PARSEC_HAVE_FUTEX)
+    (void)parsec_atomic_fetch_inc_int32(&ec->epoch);
+    (void)syscall(SYS_futex, (int32_t*)&ec->epoch, FUTEX_WAKE_PRIVATE, nb, NULL, NULL, 0);
+#else
+    pthread_mutex_lock(&ec->mutex);
+    ec->epoch++;
+    if( nb == nb_waiters ) {
+        pthread_cond_broadcast(&ec->cond);
+    } else {
+        for( ; nb > 0; nb-- )
+            pthread_cond_signal(&ec->cond);
+    }
+    pthread_mutex_unlock(&ec->mutex);
+#endif  /* defined(PARSEC_HAVE_FUTEX) */
+    return nb_waiters;
+}
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parsec/parsec_config.h"
+#include "parsec/class/parsec_oa_hash_table.h"
+
+/* The keys are stored shifted by one, so that a zeroed slot is empty */
+#define OA_SLOT_EMPTY      ((int64_t)0)
+#define OA_SLOT_TOMBSTONE  ((int64_t)-1)  /**< the key was removed */
+#define OA_SLOT_KEPT       ((int64_t)-2)  /**< a removed slot that cannot be reclaimed yet, only while growing */
+#define OA_STORED_KEY(k)   ((int64_t)((uint64_t)(k) + 1))
+
+#define OA_MIN_NB_BITS     6
+#define OA_MAX_NB_BITS     27
+/* A key is always stored within that many slots of its hash */
+#define OA_MAX_PROBES      32
+
+struct parsec_oa_hash_table_slot_s {
+    volatile int64_t key;    /**< The key of this slot (shifted by one), or one of the OA_SLOT_ markers */
+    int32_t          value;  /**< The value associated with the key */
+};
+
+struct parsec_oa_hash_table_generation_s {
+    parsec_oa_hash_table_generation_t *next;    /**< The previous generation */
+    uint64_t                           mask;    /**< This generation has mask+1 slots */
+    int                                nb_bits;
+    volatile int32_t                   nb_keys; /**< Number of keys stored and not removed yet */
+    volatile int32_t                   nb_removed; /**< Number of removed slots not reclaimed yet */
+    parsec_oa_hash_table_slot_t       *slots;
+};
+
+static void parsec_oa_hash_table_construct(parsec_oa_hash_table_t *ht)
+{
+    ht->current = NULL;
+    ht->nb_generations = 0;
+    parsec_atomic_rwlock_init(&ht->rw_lock);
+}
+
+PARSEC_OBJ_CLASS_INSTANCE(parsec_oa_hash_table_t, parsec_object_t,
+                          parsec_oa_hash_table_construct, parsec_oa_hash_table_fini);
+
+/* 64 bits finalizer of MurmurHash3, the keys built from the task parameters
+ * are far from uniformly distributed */
+static inline uint64_t parsec_oa_hash(parsec_key_t key)
+{
+    uint64_t k = (uint64_t)key;
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+static parsec_oa_hash_table_generation_t *parsec_oa_generation_new(int nb_bits)
+{
+    parsec_oa_hash_table_generation_t *gen;
+
+    gen = (parsec_oa_hash_table_generation_t*)malloc(sizeof(parsec_oa_hash_table_generation_t));
+    gen->next    = NULL;
+    gen->nb_bits = nb_bits;
+    gen->nb_keys = 0;
+    gen->nb_removed = 0;
+    gen->mask    = (1ULL << nb_bits) - 1;
+    gen->slots   = (parsec_oa_hash_table_slot_t*)calloc(gen->mask + 1, sizeof(parsec_oa_hash_table_slot_t));
+    return gen;
+}
+
+static void parsec_oa_generation_free(parsec_oa_hash_table_generation_t *gen)
+{
+    free(gen->slots);
+    free(gen);
+}
+
+void parsec_oa_hash_table_init(parsec_oa_hash_table_t *ht, size_t nb_elts)
+{
+    int nb_bits = OA_MIN_NB_BITS;
+
+    /* keep the load of the first generation under 3/4 */
+    while( (nb_bits < OA_MAX_NB_BITS) && ((3ULL << nb_bits) / 4 < (unsigned long long)nb_elts) )
+        nb_bits++;
+    parsec_atomic_rwlock_init(&ht->rw_lock);
+    ht->current = parsec_oa_generation_new(nb_bits);
+    ht->nb_generations = 1;
+}
+
+void parsec_oa_hash_table_fini(parsec_oa_hash_table_t *ht)
+{
+    parsec_oa_hash_table_generation_t *gen, *next;
+
+    for( gen = ht->current; NULL != gen; gen = next ) {
+        next = gen->next;
+        parsec_oa_generation_free(gen);
+    }
+    ht->current = NULL;
+    ht->nb_generations = 0;
+}
+
+/**
+ * Look for a key in a generation. As keys are only inserted in the
+ * current generation, and always within OA_MAX_PROBES slots of their
+ * hash, the probe stops at the first empty slot or after OA_MAX_PROBES
+ * slots.
+ */
+static parsec_oa_hash_table_slot_t *parsec_oa_generation_lookup(parsec_oa_hash_table_generation_t *gen,
+                                                                int64_t skey, uint64_t hash)
+{
+    parsec_oa_hash_table_slot_t *slot;
+    uint64_t i;
+    int64_t k;
+
+    for( i = 0; (i < OA_MAX_PROBES) && (i <= gen->mask); i++ ) {
+        slot = &gen->slots[(hash + i) & gen->mask];
+        k = slot->key;
+        if( skey == k ) return slot;
+        if( OA_SLOT_EMPTY == k ) return NULL;
+    }
+    return NULL;
+}
+
+/**
+ * Find or insert a key in the current generation. Returns NULL if the
+ * OA_MAX_PROBES slots from the hash of the key are all taken.
+ *
+ * Removed slots are not claimed here: two threads inserting the same key
+ * both stop on the first empty slot of the probe, and agree on it because
+ * an empty slot can only be claimed once while the table is read locked.
+ */
+static int32_t *parsec_oa_generation_insert(parsec_oa_hash_table_generation_t *gen,
+                                            int64_t skey, uint64_t hash)
+{
+    parsec_oa_hash_table_slot_t *slot;
+    uint64_t i;
+    int64_t k;
+
+    for( i = 0; (i < OA_MAX_PROBES) && (i <= gen->mask); i++ ) {
+        slot = &gen->slots[(hash + i) & gen->mask];
+        k = slot->key;
+        if( OA_SLOT_EMPTY == k ) {
+            if( parsec_atomic_cas_int64(&slot->key, OA_SLOT_EMPTY, skey) ) {
+                parsec_atomic_fetch_inc_int32(&gen->nb_keys);
+                return &slot->value;
+            }
+            k = slot->key;
+        }
+        if( skey == k ) return &slot->value;
+    }
+    return NULL;
+}
+
+/**
+ * Release the generations older than the current one that have no keys
+ * left. The table must be write locked.
+ */
+static void parsec_oa_hash_table_prune(parsec_oa_hash_table_t *ht)
+{
+    parsec_oa_hash_table_generation_t *prev = ht->current, *gen;
+
+    while( NULL != (gen = prev->next) ) {
+        if( 0 == gen->nb_keys ) {
+            prev->next = gen->next;
+            parsec_oa_generation_free(gen);
+            ht->nb_generations--;
+            continue;
+        }
+        prev = gen;
+    }
+}
+
+/**
+ * Turn the removed slots of the current generation that are not on the
+ * probe of any remaining key (from the hash of the key to its slot) into
+ * empty slots, and return the number of empty slots. The table must be
+ * write locked.
+ */
+static uint64_t parsec_oa_generation_reclaim(parsec_oa_hash_table_generation_t *gen)
+{
+    uint64_t i, j, nb_empty = 0;
+    int32_t nb_removed = 0;
+    int64_t k;
+
+    if( 0 == gen->nb_keys ) {
+        memset(gen->slots, 0, (gen->mask + 1) * sizeof(parsec_oa_hash_table_slot_t));
+        gen->nb_removed = 0;
+        return gen->mask + 1;
+    }
+    /* Keep the removed slots that are on the probe of a key */
+    for( i = 0; i <= gen->mask; i++ ) {
+        k = gen->slots[i].key;
+        if( (OA_SLOT_EMPTY == k) || (OA_SLOT_TOMBSTONE == k) || (OA_SLOT_KEPT == k) ) continue;
+        for( j = parsec_oa_hash((parsec_key_t)((uint64_t)k - 1)) & gen->mask; j != i; j = (j + 1) & gen->mask ) {
+            if( OA_SLOT_TOMBSTONE == gen->slots[j].key )
+                gen->slots[j].key = OA_SLOT_KEPT;
+        }
+    }
+    /* and reclaim all the others */
+    for( i = 0; i <= gen->mask; i++ ) {
+        k = gen->slots[i].key;
+        if( OA_SLOT_KEPT == k ) {
+            gen->slots[i].key = OA_SLOT_TOMBSTONE;
+            nb_removed++;
+        } else if( OA_SLOT_TOMBSTONE == k ) {
+            gen->slots[i].key   = OA_SLOT_EMPTY;
+            gen->slots[i].value = 0;
+            nb_empty++;
+        } else if( OA_SLOT_EMPTY == k ) {
+            nb_empty++;
+        }
+    }
+    gen->nb_removed = nb_removed;
+    return nb_empty;
+}
+
+/**
+ * Make room for the key of the given hash, that could not be inserted in
+ * the current generation. The table must be write locked.
+ *
+ * The removed slots of the current generation are reclaimed first. If
+ * this leaves enough room, including for the key that triggered the call,
+ * the generation is kept. Otherwise a new generation is chained in front
+ * of it: four times larger if the keys are still mostly there, twice as
+ * large if the removed slots could not be reclaimed, as the keys are then
+ * stored too far from their hash.
+ */
+static void parsec_oa_hash_table_grow(parsec_oa_hash_table_t *ht, uint64_t hash)
+{
+    parsec_oa_hash_table_generation_t *cur = ht->current, *next;
+    uint64_t i, nb_empty;
+    int nb_bits = cur->nb_bits;
+
+    parsec_oa_hash_table_prune(ht);
+
+    nb_empty = parsec_oa_generation_reclaim(cur);
+    if( nb_empty > (cur->mask + 1) / 4 ) {
+        for( i = 0; (i < OA_MAX_PROBES) && (i <= cur->mask); i++ ) {
+            if( OA_SLOT_EMPTY == cur->slots[(hash + i) & cur->mask].key )
+                return;
+        }
+    }
+    nb_bits += ((uint64_t)cur->nb_keys > (cur->mask + 1) / 4) ? 2 : 1;
+    if( nb_bits > OA_MAX_NB_BITS ) nb_bits = OA_MAX_NB_BITS;
+    next = parsec_oa_generation_new(nb_bits);
+    next->next = cur;
+    ht->current = next;
+    ht->nb_generations++;
+}
+
+int32_t *parsec_oa_hash_table_find_or_insert(parsec_oa_hash_table_t *ht, parsec_key_t key)
+{
+    parsec_oa_hash_table_generation_t *cur, *gen;
+    parsec_oa_hash_table_slot_t *slot;
+    int64_t skey = OA_STORED_KEY(key);
+    uint64_t hash = parsec_oa_hash(key);
+    int32_t *value;
+
+    assert(key <= PARSEC_OA_HASH_TABLE_MAX_KEY);
+    for(;;) {
+        parsec_atomic_rwlock_rdlock(&ht->rw_lock);
+        cur = ht->current;
+        /* The key may have been inserted before the current generation was created */
+        for( gen = cur->next; NULL != gen; gen = gen->next ) {
+            if( NULL != (slot = parsec_oa_generation_lookup(gen, skey, hash)) ) {
+                parsec_atomic_rwlock_rdunlock(&ht->rw_lock);
+                return &slot->value;
+            }
+        }
+        value = parsec_oa_generation_insert(cur, skey, hash);
+        parsec_atomic_rwlock_rdunlock(&ht->rw_lock);
+        if( NULL != value ) return value;
+
+        parsec_atomic_rwlock_wrlock(&ht->rw_lock);
+        if( cur == ht->current ) {
+            /* Barring ABA problems, nobody made room in the meantime */
+            parsec_oa_hash_table_grow(ht, hash);
+        }
+        parsec_atomic_rwlock_wrunlock(&ht->rw_lock);
+    }
+}
+
+int32_t *parsec_oa_hash_table_find(parsec_oa_hash_table_t *ht, parsec_key_t key)
+{
+    parsec_oa_hash_table_generation_t *gen;
+    parsec_oa_hash_table_slot_t *slot = NULL;
+    int64_t skey = OA_STORED_KEY(key);
+    uint64_t hash = parsec_oa_hash(key);
+
+    parsec_atomic_rwlock_rdlock(&ht->rw_lock);
+    for( gen = ht->current; NULL != gen; gen = gen->next ) {
+        if( NULL != (slot = parsec_oa_generation_lookup(gen, skey, hash)) )
+            break;
+    }
+    parsec_atomic_rwlock_rdunlock(&ht->rw_lock);
+    return (NULL == slot) ? NULL : &slot->value;
+}
+
+int parsec_oa_hash_table_remove(parsec_oa_hash_table_t *ht, parsec_key_t key)
+{
+    parsec_oa_hash_table_generation_t *gen;
+    parsec_oa_hash_table_slot_t *slot = NULL;
+    int64_t skey = OA_STORED_KEY(key);
+    uint64_t hash = parsec_oa_hash(key);
+    int rc = 0, drained = 0, crowded = 0;
+
+    parsec_atomic_rwlock_rdlock(&ht->rw_lock);
+    for( gen = ht->current; NULL != gen; gen = gen->next ) {
+        if( NULL != (slot = parsec_oa_generation_lookup(gen, skey, hash)) )
+            break;
+    }
+    if( NULL != slot && parsec_atomic_cas_int64(&slot->key, skey, OA_SLOT_TOMBSTONE) ) {
+        rc = 1;
+        drained = (1 == parsec_atomic_fetch_dec_int32(&gen->nb_keys));
+        /* Removed slots lengthen the probes and are never claimed by the
+         * inserts: reclaim them when the current generation is drained, or
+         * before they take a quarter of it. Only the remove that crosses the
+         * threshold does it. */
+        crowded = (gen == ht->current) &&
+            (((int64_t)(gen->mask + 1) / 4 == parsec_atomic_fetch_inc_int32(&gen->nb_removed) + 1) || drained);
+        drained = drained && (gen != ht->current);
+    }
+    parsec_atomic_rwlock_rdunlock(&ht->rw_lock);
+
+    if( drained || crowded ) {
+        /* Nobody will look into a drained generation anymore once it is unlinked */
+        parsec_atomic_rwlock_wrlock(&ht->rw_lock);
+        parsec_oa_hash_table_prune(ht);
+        if( crowded && (gen == ht->current) )
+            (void)parsec_oa_generation_reclaim(gen);
+        parsec_atomic_rwlock_wrunlock(&ht->rw_lock);
+    }
+    return rc;
+}
+
+void parsec_oa_hash_table_stat(parsec_oa_hash_table_t *ht)
+{
+    parsec_oa_hash_table_generation_t *gen;
+    uint64_t i, live, removed;
+    int64_t k;
+    int j;
+
+    for( gen = ht->current, j = 0; NULL != gen; gen = gen->next, j++ ) {
+        live = removed = 0;
+        for( i = 0; i <= gen->mask; i++ ) {
+            k = gen->slots[i].key;
+            if( OA_SLOT_TOMBSTONE == k ) removed++;
+            else if( OA_SLOT_EMPTY != k ) live++;
+        }
+        printf("table %p generation %d: %"PRIu64" slots, %"PRIu64" keys, %"PRIu64" removed\n",
+               (void*)ht, j, gen->mask + 1, live, removed);
+    }
+}
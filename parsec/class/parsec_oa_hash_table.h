@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#ifndef _parsec_oa_hash_table_h
+#define _parsec_oa_hash_table_h
+
+#include "parsec/parsec_config.h"
+#include "parsec/sys/atomic.h"
+#include "parsec/class/parsec_object.h"
+#include "parsec/class/parsec_hash_table.h"
+#include "parsec/class/parsec_rwlock.h"
+
+/**
+ * @defgroup parsec_internal_classes_oahashtable Open Addressing Hash Tables
+ * @ingroup parsec_internal_classes
+ * @{
+ *
+ *  @brief Open addressing hash tables of 32 bits counters
+ *
+ *  @details
+ *    Each slot of the table holds a 64 bits key and a 32 bits value
+ *    inline, so finding the value associated with a key does not require
+ *    any allocation: slots are claimed with a compare and swap on the key
+ *    while the table is read locked, and the collisions are resolved with
+ *    linear probing.
+ *
+ *    The address of a value remains valid until the key is removed, which
+ *    allows the callers to update the value with atomic operations (this
+ *    is how the dependencies of the tasks are tracked). To preserve this
+ *    property, slots are never moved: when the probe of a key is full, the
+ *    table is write locked, and the removed slots that are not on the
+ *    probe of any remaining key are reclaimed. If that does not leave
+ *    enough room, a new table (called a generation) is chained in front of
+ *    it and receives the new keys, while the keys of the older generations
+ *    stay where they are. An older generation is released as soon as all
+ *    its keys have been removed, and the removed slots of the current
+ *    generation are reclaimed when it is drained or when they take a
+ *    quarter of it.
+ *
+ *    The table is not lock-free: like the buckets of parsec_hash_table,
+ *    every operation takes the lock of the table, but only in read mode,
+ *    and it is only write locked to reclaim slots or chain a generation.
+ *    What it saves over parsec_hash_table is the allocation of an item per
+ *    key and the exclusive lock of its bucket.
+ *
+ *    Keys are compared by value, and the three largest values of a 64 bits
+ *    key are reserved.
+ */
+
+BEGIN_C_DECLS
+
+/**
+ * @brief The largest key that can be stored in an open addressing hash table
+ */
+#define PARSEC_OA_HASH_TABLE_MAX_KEY ((parsec_key_t)(UINT64_MAX - 3))
+
+typedef struct parsec_oa_hash_table_slot_s       parsec_oa_hash_table_slot_t;
+typedef struct parsec_oa_hash_table_generation_s parsec_oa_hash_table_generation_t;
+
+/**
+ * @brief An open addressing hash table
+ */
+typedef struct parsec_oa_hash_table_s {
+    parsec_object_t                             super;       /**< A Hash Table is a PaRSEC object */
+    parsec_oa_hash_table_generation_t *volatile current;     /**< New keys go in this generation, the older
+                                                              *   generations are chained behind it */
+    parsec_atomic_rwlock_t                      rw_lock;     /**< 'readers' find, insert and remove keys, the
+                                                              *   'writer' reclaims slots and generations */
+    int32_t                                     nb_generations; /**< Number of generations in the chain */
+} parsec_oa_hash_table_t;
+PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_oa_hash_table_t);
+
+/**
+ * @brief Initialize an open addressing hash table
+ *
+ * @details
+ *  @arg[inout] ht       the hash table to initialize
+ *  @arg[in]    nb_elts  hint on the number of keys the table will receive,
+ *                       0 if unknown. The first generation is sized to hold
+ *                       that many keys without growing.
+ */
+void parsec_oa_hash_table_init(parsec_oa_hash_table_t *ht, size_t nb_elts);
+
+/**
+ * @brief Destroy an open addressing hash table
+ *
+ * @details
+ *  Releases all the generations of the table. The table may still contain
+ *  keys.
+ *  @arg[inout] ht the hash table to release
+ */
+void parsec_oa_hash_table_fini(parsec_oa_hash_table_t *ht);
+
+/**
+ * @brief Find the value associated with a key, inserting the key if needed
+ *
+ * @details
+ *  This function is thread-safe: when the current generation is too
+ *  crowded, the thread that cannot insert the key write locks the table to
+ *  reclaim the removed slots or to create the next generation. When
+ *  several threads insert the same key concurrently, all of them get the
+ *  same value. A newly inserted key has a value of 0.
+ *  @arg[inout] ht the hash table
+ *  @arg[in]    key the key to find or insert
+ *  @return the address of the value associated with the key, valid until
+ *          the key is removed.
+ */
+int32_t *parsec_oa_hash_table_find_or_insert(parsec_oa_hash_table_t *ht, parsec_key_t key);
+
+/**
+ * @brief Find the value associated with a key
+ *
+ * @details
+ *  This function is thread-safe, and only read locks the table.
+ *  @arg[in] ht the hash table
+ *  @arg[in] key the key to find
+ *  @return NULL if the key is not in the table, the address of the value
+ *          associated with the key otherwise.
+ */
+int32_t *parsec_oa_hash_table_find(parsec_oa_hash_table_t *ht, parsec_key_t key);
+
+/**
+ * @brief Remove a key from the hash table
+ *
+ * @details
+ *  This function is thread-safe. The address of the value becomes invalid,
+ *  and the slot of the key may be reused by another key. If this removes
+ *  the last key of an older generation, the generation is released; if
+ *  it removes the last key of the current generation, or enough keys,
+ *  the table is write locked to reclaim the removed slots.
+ *  @arg[inout] ht the hash table
+ *  @arg[in]    key the key to remove
+ *  @return 1 if the key was removed, 0 if it was not in the table.
+ */
+int parsec_oa_hash_table_remove(parsec_oa_hash_table_t *ht, parsec_key_t key);
+
+/**
+ * @brief Print statistics on the generations of the hash table
+ *
+ * @details
+ *  @arg[in] ht the hash table
+ */
+void parsec_oa_hash_table_stat(parsec_oa_hash_table_t *ht);
+
+END_C_DECLS
+
+/** @} */
+
+#endif  /* _parsec_oa_hash_table_h */
@@ -208,6 +208,49 @@ parsec_tiled_matrix_submatrix( parsec_tiled_matrix_t *tdesc,
     return newdesc;
 }
 
+/**
+ * Count the local tiles along the dimension dim of a collection whose ownership
+ * is periodic along that dimension: the owner of coordinate x only depends on
+ * x modulo period. The coordinates first + k*step then repeat their owner every
+ * period/gcd(step, period) steps, so rank_of is evaluated at most once per
+ * position in that cycle instead of once per coordinate.
+ */
+int64_t
+parsec_matrix_nb_local_periodic(parsec_data_collection_t *dc, int dim,
+                                int nb_coords, int *coords,
+                                int64_t first, int64_t last, int64_t step,
+                                int64_t period)
+{
+    int64_t nb, k, cycle, a, b, t, nb_in_cycle = 0, nb_in_remainder = 0;
+
+    assert( (dim >= 0) && (dim < nb_coords) && (nb_coords <= 2) );
+    if( (0 == step) || (period <= 0) ) return -1;
+    if( step > 0 ) {
+        if( first > last ) return 0;
+        nb = (last - first) / step + 1;
+    } else {
+        if( first < last ) return 0;
+        nb = (first - last) / (-step) + 1;
+        first += (nb - 1) * step;  /* walk the same coordinates upward */
+        step = -step;
+    }
+
+    for( a = step % period, b = period; 0 != b; t = a % b, a = b, b = t );
+    cycle = period / a;
+
+    for( k = 0; k < nb && k < cycle; k++ ) {
+        coords[dim] = (int)(first + k * step);
+        if( dc->myrank != (1 == nb_coords ? dc->rank_of(dc, coords[0])
+                                          : dc->rank_of(dc, coords[0], coords[1])) )
+            continue;
+        nb_in_cycle++;
+        if( k < (nb % cycle) ) nb_in_remainder++;
+    }
+    if( nb <= cycle )
+        return nb_in_cycle;
+    return (nb / cycle) * nb_in_cycle + nb_in_remainder;
+}
+
 /* return a unique key (unique only for the specified parsec_dc) associated to a data */
 static parsec_data_key_t tiled_matrix_data_key(struct parsec_data_collection_s *desc, ...)
 {
@@ -248,7 +291,8 @@ static int  tiled_matrix_key_to_string(struct parsec_data_collection_s *desc, pa
 
 /*
  * Writes the data into the file filename
- * Sequential function per node
+ * Sequential function per node, see parsec_tiled_matrix_io() for the parallel
+ * version writing a single file shared by all the nodes.
  */
 int parsec_tiled_matrix_data_write(parsec_tiled_matrix_t *tdesc, char *filename)
 {
@@ -296,7 +340,8 @@ int parsec_tiled_matrix_data_write(parsec_tiled_matrix_t *tdesc, char *filename)
 
 /*
  * Read the data from the file filename
- * Sequential function per node
+ * Sequential function per node, see parsec_tiled_matrix_io() for the parallel
+ * version reading a single file shared by all the nodes.
  */
 int parsec_tiled_matrix_data_read(parsec_tiled_matrix_t *tdesc, char *filename)
 {
@@ -309,7 +354,7 @@ int parsec_tiled_matrix_data_read(parsec_tiled_matrix_t *tdesc, char *filename)
     uint32_t myrank = tdesc->super.myrank;
     int eltsize =  parsec_datadist_getsizeoftype( tdesc->mtype );
 
-    tmpf = fopen(filename, "w");
+    tmpf = fopen(filename, "r");
     if(NULL == tmpf) {
         parsec_warning("The file %s cannot be open", filename);
         return -1;
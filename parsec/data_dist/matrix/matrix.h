@@ -188,6 +188,38 @@ parsec_apply( parsec_context_t *parsec,
              parsec_tiled_matrix_t *A,
              parsec_tiled_matrix_unary_op_t operation,
              void *op_args );
+/**
+ * Flags of the tiled matrix I/O. The file holds the tiles of the matrix in the
+ * global tile order (column major over the tiles), each tile as a dense block
+ * of mb*nb elements, whatever the distribution of the matrix. With
+ * PARSEC_MATRIX_IO_DIRECT, the file is accessed with O_DIRECT when the file
+ * system supports it, and each tile is stored in a slot padded to
+ * PARSEC_MATRIX_IO_ALIGNMENT bytes.
+ */
+#define PARSEC_MATRIX_IO_READ      0x0
+#define PARSEC_MATRIX_IO_WRITE     0x1
+#define PARSEC_MATRIX_IO_DIRECT    0x2
+#define PARSEC_MATRIX_IO_ALIGNMENT 4096
+
+extern parsec_taskpool_t*
+parsec_tiled_matrix_io_New( parsec_tiled_matrix_t *A,
+                            const char *filename,
+                            int flags );
+
+extern int parsec_tiled_matrix_io_Destruct( parsec_taskpool_t *tp );
+
+extern int
+parsec_tiled_matrix_io( parsec_context_t *parsec,
+                        parsec_tiled_matrix_t *A,
+                        const char *filename,
+                        int flags );
+
+extern int
+parsec_tiled_matrix_io_collective( parsec_context_t *parsec,
+                                   parsec_tiled_matrix_t *A,
+                                   const char *filename,
+                                   int flags );
+
 /**
  * @brief Non-blocking function of redistribute for PTG
  *
@@ -220,6 +252,10 @@ void parsec_redistribute_Destruct(parsec_taskpool_t *taskpool);
  * @details
  * Source and target could be ANY distribuiton with ANY displacement
  * in both source and target.
+ * The pieces of tiles exchanged between each pair of processes are
+ * aggregated in a single transfer, see the MCA parameter
+ * redistribute_planner. The call is collective over the communicator of
+ * the context.
  *
  * @param [in] source: source distribution, already distributed and allocated
  * @param [out] target: target distribution, redistributed and allocated
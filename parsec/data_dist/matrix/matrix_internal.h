@@ -16,12 +16,34 @@ BEGIN_C_DECLS
 void parsec_matrix_block_cyclic_key2coords(parsec_data_collection_t *desc,
                                            parsec_data_key_t key, int *m, int *n);
 
+/* Count the local tiles of a distribution periodic along dim, used by the
+ * nb_local_of implementations of the cyclic collections */
+int64_t parsec_matrix_nb_local_periodic(parsec_data_collection_t *dc, int dim,
+                                        int nb_coords, int *coords,
+                                        int64_t first, int64_t last, int64_t step,
+                                        int64_t period);
+
 
 size_t parsec_matrix_sym_block_cyclic_coord2pos(
     parsec_matrix_sym_block_cyclic_t *dc,
     int m,
     int n);
 
+/* State of a file accessed by the tasks of a parsec_tiled_matrix_io_New()
+ * taskpool */
+typedef struct parsec_tiled_matrix_io_file_s {
+    int     fd;
+    int     flags;      /**< PARSEC_MATRIX_IO_* flags of the taskpool */
+    int     direct;     /**< the file is open with O_DIRECT */
+    int32_t errors;     /**< number of local tiles that could not be transferred */
+    size_t  tile_size;  /**< bytes of a tile */
+    size_t  slot_size;  /**< bytes between two consecutive tiles in the file */
+} parsec_tiled_matrix_io_file_t;
+
+/* Transfer the tile (m, n) of A between the memory and its slot in the file */
+int parsec_tiled_matrix_io_tile(parsec_tiled_matrix_io_file_t *file,
+                                const parsec_tiled_matrix_t *A,
+                                void *tile, int m, int n);
 
 END_C_DECLS
 
@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+#include "parsec/parsec_config.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/execution_stream.h"
+#include "parsec/data_dist/matrix/matrix.h"
+#include "parsec/data_dist/matrix/matrix_internal.h"
+#include "matrix_io.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif
+
+#if !defined(IOV_MAX)
+#define IOV_MAX 1024
+#endif
+
+/*
+ * Layout of the file: the tiles are stored in the global tile order of the
+ * matrix (column major over the tiles), each tile as a dense block of mb*nb
+ * elements. With PARSEC_MATRIX_IO_DIRECT, each tile is stored in a slot padded
+ * to PARSEC_MATRIX_IO_ALIGNMENT bytes, so the offset and the length of every
+ * transfer satisfy the constraints of O_DIRECT.
+ */
+static void
+tiled_matrix_io_sizes( const parsec_tiled_matrix_t *A, int flags,
+                       size_t *tile_size, size_t *slot_size )
+{
+    *tile_size = A->bsiz * (size_t)parsec_datadist_getsizeoftype(A->mtype);
+    *slot_size = *tile_size;
+    if( flags & PARSEC_MATRIX_IO_DIRECT ) {
+        *slot_size = (*tile_size + PARSEC_MATRIX_IO_ALIGNMENT - 1) & ~((size_t)PARSEC_MATRIX_IO_ALIGNMENT - 1);
+    }
+}
+
+static inline off_t
+tiled_matrix_io_offset( const parsec_tiled_matrix_io_file_t *file,
+                        const parsec_tiled_matrix_t *A, int m, int n )
+{
+    return (off_t)((size_t)n * A->mt + m) * (off_t)file->slot_size;
+}
+
+/*
+ * Transfer the whole iovec at offset, resuming after the partial transfers
+ * and the interruptions. The iovec is modified.
+ */
+static int
+tiled_matrix_io_transfer( int fd, int write, struct iovec *iov, int iovcnt, off_t offset )
+{
+    ssize_t rc;
+
+    while( iovcnt > 0 ) {
+        if( write )
+            rc = pwritev(fd, iov, iovcnt > IOV_MAX ? IOV_MAX : iovcnt, offset);
+        else
+            rc = preadv(fd, iov, iovcnt > IOV_MAX ? IOV_MAX : iovcnt, offset);
+        if( rc < 0 ) {
+            if( EINTR == errno ) continue;
+            return PARSEC_ERROR;
+        }
+        if( 0 == rc ) {  /* end of file before the end of the tile */
+            errno = 0;
+            return PARSEC_ERR_TRUNCATE;
+        }
+        offset += rc;
+        while( iovcnt > 0 && (size_t)rc >= iov->iov_len ) {
+            rc -= iov->iov_len;
+            iov++; iovcnt--;
+        }
+        if( iovcnt > 0 ) {
+            iov->iov_base = (char*)iov->iov_base + rc;
+            iov->iov_len -= rc;
+        }
+    }
+    return PARSEC_SUCCESS;
+}
+
+int
+parsec_tiled_matrix_io_tile( parsec_tiled_matrix_io_file_t *file,
+                             const parsec_tiled_matrix_t *A,
+                             void *tile, int m, int n )
+{
+    int eltsize = parsec_datadist_getsizeoftype(A->mtype);
+    int write = file->flags & PARSEC_MATRIX_IO_WRITE;
+    size_t col = (size_t)A->mb * eltsize, ld = (size_t)BLKLDD(A, m) * eltsize;
+    off_t offset = tiled_matrix_io_offset(file, A, m, n);
+    struct iovec single, *iov = &single;
+    char *staging = NULL;
+    int k, iovcnt = 1, rc;
+
+    if( file->direct ) {
+        /* O_DIRECT transfers a whole slot from a buffer aligned on the
+         * alignment of the file, the tile is staged unless it already is */
+        if( PARSEC_MATRIX_TILE == A->storage &&
+            0 == ((uintptr_t)tile & (PARSEC_MATRIX_IO_ALIGNMENT - 1)) &&
+            file->tile_size == file->slot_size ) {
+            single.iov_base = tile;
+        } else {
+            if( 0 != posix_memalign((void**)&staging, PARSEC_MATRIX_IO_ALIGNMENT, file->slot_size) ) {
+                staging = NULL;
+                rc = PARSEC_ERR_OUT_OF_RESOURCE;
+                goto complete;
+            }
+            if( write ) {
+                if( PARSEC_MATRIX_TILE == A->storage ) {
+                    memcpy(staging, tile, file->tile_size);
+                } else {
+                    for( k = 0; k < A->nb; k++ )
+                        memcpy(staging + k * col, (char*)tile + k * ld, col);
+                }
+                memset(staging + file->tile_size, 0, file->slot_size - file->tile_size);
+            }
+            single.iov_base = staging;
+        }
+        single.iov_len = file->slot_size;
+    } else if( PARSEC_MATRIX_TILE == A->storage ) {
+        single.iov_base = tile;
+        single.iov_len = file->tile_size;
+    } else {
+        /* One vector per column of the tile, gathered in a single call */
+        iov = (struct iovec*)malloc(A->nb * sizeof(struct iovec));
+        if( NULL == iov ) {
+            iov = &single;
+            rc = PARSEC_ERR_OUT_OF_RESOURCE;
+            goto complete;
+        }
+        for( k = 0; k < A->nb; k++ ) {
+            iov[k].iov_base = (char*)tile + k * ld;
+            iov[k].iov_len = col;
+        }
+        iovcnt = A->nb;
+    }
+
+    rc = tiled_matrix_io_transfer(file->fd, write, iov, iovcnt, offset);
+
+    if( PARSEC_SUCCESS == rc && !write && NULL != staging ) {
+        if( PARSEC_MATRIX_TILE == A->storage ) {
+            memcpy(tile, staging, file->tile_size);
+        } else {
+            for( k = 0; k < A->nb; k++ )
+                memcpy((char*)tile + k * ld, staging + k * col, col);
+        }
+    }
+
+  complete:
+    if( PARSEC_SUCCESS != rc ) {
+        parsec_warning("The %s of the tile (%d, %d) at offset %lld failed: %s",
+                       write ? "write" : "read", m, n, (long long)offset,
+                       PARSEC_ERR_TRUNCATE == rc ? "truncated file" :
+                       (PARSEC_ERR_OUT_OF_RESOURCE == rc ? "out of memory" : strerror(errno)));
+        parsec_atomic_fetch_inc_int32(&file->errors);
+    }
+    free(staging);
+    if( &single != iov ) free(iov);
+    return rc;
+}
+
+/*
+ * Open the file on this process. All the processes open the same file and
+ * access their own tiles only, so the writers do not truncate the file but set
+ * its size to the size of the matrix, which does not discard the tiles
+ * already written by the other processes.
+ */
+static int
+tiled_matrix_io_open( parsec_tiled_matrix_io_file_t *file,
+                      const parsec_tiled_matrix_t *A,
+                      const char *filename, int flags )
+{
+    int oflags = (flags & PARSEC_MATRIX_IO_WRITE) ? (O_WRONLY | O_CREAT) : O_RDONLY;
+
+    file->flags = flags;
+    file->errors = 0;
+    file->direct = 0;
+    tiled_matrix_io_sizes(A, flags, &file->tile_size, &file->slot_size);
+
+    file->fd = -1;
+#if defined(O_DIRECT)
+    if( flags & PARSEC_MATRIX_IO_DIRECT ) {
+        file->fd = open(filename, oflags | O_DIRECT, 0644);
+        if( file->fd >= 0 ) {
+            file->direct = 1;
+        } else if( EINVAL == errno ) {
+            /* The file system does not support O_DIRECT, the layout of the
+             * file remains the padded one */
+            parsec_debug_verbose(4, parsec_debug_output,
+                                 "The file %s cannot be open with O_DIRECT, fall back to buffered I/O", filename);
+        } else {
+            goto failed;
+        }
+    }
+#endif  /* defined(O_DIRECT) */
+    if( file->fd < 0 ) {
+        file->fd = open(filename, oflags, 0644);
+        if( file->fd < 0 )
+            goto failed;
+    }
+    if( (flags & PARSEC_MATRIX_IO_WRITE) &&
+        0 != ftruncate(file->fd, (off_t)((size_t)A->mt * A->nt) * (off_t)file->slot_size) ) {
+        close(file->fd);
+        file->fd = -1;
+        goto failed;
+    }
+    return PARSEC_SUCCESS;
+
+  failed:
+    parsec_warning("The file %s cannot be open: %s", filename, strerror(errno));
+    return PARSEC_ERR_NOT_FOUND;
+}
+
+/**
+ *******************************************************************************
+ * parsec_tiled_matrix_io_New - Generates a taskpool that writes the local tiles
+ * of A into filename, or reads them from it, one task per tile.
+ *
+ * WARNING: The transfers are not done by this call.
+ *
+ *******************************************************************************
+ *
+ * @param[in,out] A
+ *          Descriptor of the distributed matrix to write or read.
+ *
+ * @param[in] filename
+ *          Name of the file, shared by all the processes.
+ *
+ * @param[in] flags
+ *          PARSEC_MATRIX_IO_WRITE to write the matrix, PARSEC_MATRIX_IO_READ
+ *          to read it, combined with PARSEC_MATRIX_IO_DIRECT to bypass the
+ *          page cache.
+ *
+ *******************************************************************************
+ *
+ * @return
+ *          \retval NULL if the file cannot be open.
+ *          \retval The parsec taskpool describing the operation that can be
+ *          enqueued in the runtime with parsec_context_add_taskpool(). It, then,
+ *          needs to be destroyed with parsec_tiled_matrix_io_Destruct();
+ *
+ ******************************************************************************/
+parsec_taskpool_t *
+parsec_tiled_matrix_io_New( parsec_tiled_matrix_t *A,
+                            const char *filename,
+                            int flags )
+{
+    parsec_matrix_io_taskpool_t *tp;
+    parsec_tiled_matrix_io_file_t *file;
+    parsec_datatype_t dt;
+
+    if( PARSEC_SUCCESS != parsec_translate_matrix_type(A->mtype, &dt) )
+        return NULL;
+
+    file = (parsec_tiled_matrix_io_file_t*)malloc(sizeof(parsec_tiled_matrix_io_file_t));
+    if( PARSEC_SUCCESS != tiled_matrix_io_open(file, A, filename, flags) ) {
+        free(file);
+        return NULL;
+    }
+
+    tp = parsec_matrix_io_new( A, file );
+
+    parsec_add2arena( &tp->arenas_datatypes[PARSEC_matrix_io_DEFAULT_ADT_IDX], dt,
+                      PARSEC_MATRIX_FULL, 1, A->mb, A->nb, A->mb, PARSEC_ARENA_ALIGNMENT_SSE, -1 );
+    return (parsec_taskpool_t*)tp;
+}
+
+/**
+ *******************************************************************************
+ *
+ * parsec_tiled_matrix_io_Destruct - Close the file and free the data structure
+ * associated to a taskpool created with parsec_tiled_matrix_io_New().
+ *
+ *******************************************************************************
+ *
+ * @param[in,out] taskpool
+ *          On entry, the taskpool to destroy.
+ *          On exit, the taskpool cannot be used anymore.
+ *
+ *******************************************************************************
+ *
+ * @return
+ *          \retval PARSEC_SUCCESS if all the local tiles were transferred.
+ *          \retval PARSEC_ERROR otherwise.
+ *
+ ******************************************************************************/
+int
+parsec_tiled_matrix_io_Destruct( parsec_taskpool_t *taskpool )
+{
+    parsec_matrix_io_taskpool_t *tp = (parsec_matrix_io_taskpool_t *)taskpool;
+    parsec_tiled_matrix_io_file_t *file = tp->_g_file;
+    int rc = (0 == file->errors) ? PARSEC_SUCCESS : PARSEC_ERROR;
+
+    /* The data written with O_DIRECT bypassed the page cache, the others
+     * must be flushed before reporting a checkpoint as complete */
+    if( (file->flags & PARSEC_MATRIX_IO_WRITE) && !file->direct && 0 != fsync(file->fd) ) {
+        parsec_warning("The file cannot be flushed: %s", strerror(errno));
+        rc = PARSEC_ERROR;
+    }
+    if( 0 != close(file->fd) )
+        rc = PARSEC_ERROR;
+    free(file);
+
+    parsec_del2arena( &tp->arenas_datatypes[PARSEC_matrix_io_DEFAULT_ADT_IDX] );
+    parsec_taskpool_free(taskpool);
+    return rc;
+}
+
+/**
+ *******************************************************************************
+ * parsec_tiled_matrix_io - Writes the local tiles of A into filename, or reads
+ * them from it, with the tasks of a parsec_tiled_matrix_io_New() taskpool.
+ *
+ *******************************************************************************
+ *
+ * @param[in,out] parsec
+ *          The parsec context of the application that will run the operation.
+ *
+ * @param[in,out] A
+ *          Descriptor of the distributed matrix to write or read.
+ *
+ * @param[in] filename
+ *          Name of the file, shared by all the processes.
+ *
+ * @param[in] flags
+ *          See parsec_tiled_matrix_io_New().
+ *
+ *******************************************************************************
+ *
+ * @return
+ *          \retval PARSEC_ERR_NOT_FOUND if the file cannot be open.
+ *          \retval PARSEC_ERROR if some local tiles were not transferred.
+ *          \retval PARSEC_SUCCESS on success.
+ *
+ ******************************************************************************/
+int
+parsec_tiled_matrix_io( parsec_context_t *parsec,
+                        parsec_tiled_matrix_t *A,
+                        const char *filename,
+                        int flags )
+{
+    parsec_taskpool_t *tp = parsec_tiled_matrix_io_New( A, filename, flags );
+
+    if( NULL == tp )
+        return PARSEC_ERR_NOT_FOUND;
+
+    parsec_context_add_taskpool( parsec, tp );
+    parsec_context_start( parsec );
+    parsec_context_wait( parsec );
+    return parsec_tiled_matrix_io_Destruct( tp );
+}
+
+#if defined(PARSEC_HAVE_MPI)
+/*
+ * Describe the local tiles of A in memory (absolute addresses) and in the file
+ * (offsets of their slots), in the increasing order of the offsets required by
+ * the file views.
+ */
+static int
+tiled_matrix_io_mpi_types( parsec_tiled_matrix_t *A, size_t tile_size, size_t slot_size,
+                           MPI_Datatype *memtype, MPI_Datatype *filetype )
+{
+    parsec_data_collection_t *dc = &A->super;
+    int eltsize = parsec_datadist_getsizeoftype(A->mtype);
+    MPI_Aint *addrs, *displs;
+    MPI_Datatype tiletype, slottype;
+    int m, n, count = 0;
+
+    addrs  = (MPI_Aint*)malloc(2 * (size_t)(A->nb_local_tiles + 1) * sizeof(MPI_Aint));
+    displs = addrs + A->nb_local_tiles + 1;
+    for( n = 0; n < A->nt; n++ ) {
+        for( m = 0; m < A->mt; m++ ) {
+            if( dc->rank_of(dc, m, n) != dc->myrank ) continue;
+            assert(count < A->nb_local_tiles);
+            MPI_Get_address(parsec_data_get_ptr(dc->data_of(dc, m, n), 0), &addrs[count]);
+            displs[count] = (MPI_Aint)((size_t)n * A->mt + m) * (MPI_Aint)slot_size;
+            count++;
+        }
+    }
+
+    if( PARSEC_MATRIX_TILE == A->storage ) {
+        MPI_Type_contiguous((int)tile_size, MPI_BYTE, &tiletype);
+    } else {
+        MPI_Type_create_hvector(A->nb, A->mb * eltsize, (MPI_Aint)A->llm * eltsize, MPI_BYTE, &tiletype);
+    }
+    MPI_Type_contiguous((int)tile_size, MPI_BYTE, &slottype);
+    MPI_Type_create_hindexed_block(count, 1, addrs, tiletype, memtype);
+    MPI_Type_create_hindexed_block(count, 1, displs, slottype, filetype);
+    MPI_Type_commit(memtype);
+    MPI_Type_commit(filetype);
+    MPI_Type_free(&tiletype);
+    MPI_Type_free(&slottype);
+    free(addrs);
+    return count;
+}
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+/**
+ *******************************************************************************
+ * parsec_tiled_matrix_io_collective - Writes A into filename, or reads it from
+ * it, with a single collective MPI-IO call over all the local tiles.
+ *
+ * The file has the same layout as with parsec_tiled_matrix_io(), the MPI-IO
+ * library aggregates the tiles of the processes (collective buffering) which
+ * suits the parallel file systems better than many independent transfers. The
+ * call is collective over the communicator of the context and blocks the
+ * caller: it must be issued while the context is not running. Without MPI,
+ * this is parsec_tiled_matrix_io().
+ *
+ *******************************************************************************
+ *
+ * @param[in,out] parsec
+ *          The parsec context of the application.
+ *
+ * @param[in,out] A
+ *          Descriptor of the distributed matrix to write or read.
+ *
+ * @param[in] filename
+ *          Name of the file, shared by all the processes.
+ *
+ * @param[in] flags
+ *          See parsec_tiled_matrix_io_New(). PARSEC_MATRIX_IO_DIRECT only
+ *          selects the padded layout, the MPI-IO library decides of the
+ *          access mode.
+ *
+ *******************************************************************************
+ *
+ * @return
+ *          \retval PARSEC_ERR_NOT_FOUND if the file cannot be open.
+ *          \retval PARSEC_ERROR if the transfer failed on any process.
+ *          \retval PARSEC_SUCCESS on success.
+ *
+ ******************************************************************************/
+int
+parsec_tiled_matrix_io_collective( parsec_context_t *parsec,
+                                   parsec_tiled_matrix_t *A,
+                                   const char *filename,
+                                   int flags )
+{
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Comm comm = (MPI_Comm)parsec->comm_ctx;
+    MPI_Datatype memtype, filetype;
+    MPI_File fh;
+    size_t tile_size, slot_size;
+    int write = flags & PARSEC_MATRIX_IO_WRITE;
+    int rc, count, failed, mpi_is_on;
+    char msg[MPI_MAX_ERROR_STRING];
+
+    MPI_Initialized(&mpi_is_on);
+    if( !mpi_is_on )
+        return parsec_tiled_matrix_io( parsec, A, filename, flags );
+
+    tiled_matrix_io_sizes(A, flags, &tile_size, &slot_size);
+    rc = MPI_File_open(comm, (char*)filename,
+                       write ? (MPI_MODE_WRONLY | MPI_MODE_CREATE) : MPI_MODE_RDONLY,
+                       MPI_INFO_NULL, &fh);
+    if( MPI_SUCCESS != rc ) {
+        MPI_Error_string(rc, msg, &count);
+        parsec_warning("The file %s cannot be open: %s", filename, msg);
+        return PARSEC_ERR_NOT_FOUND;
+    }
+    if( write )
+        rc = MPI_File_set_size(fh, (MPI_Offset)((size_t)A->mt * A->nt * slot_size));
+
+    count = tiled_matrix_io_mpi_types(A, tile_size, slot_size, &memtype, &filetype);
+    if( MPI_SUCCESS == rc )
+        rc = MPI_File_set_view(fh, 0, MPI_BYTE, count > 0 ? filetype : MPI_BYTE,
+                               "native", MPI_INFO_NULL);
+    if( MPI_SUCCESS == rc ) {
+        if( write )
+            rc = MPI_File_write_all(fh, MPI_BOTTOM, count > 0 ? 1 : 0, memtype, MPI_STATUS_IGNORE);
+        else
+            rc = MPI_File_read_all(fh, MPI_BOTTOM, count > 0 ? 1 : 0, memtype, MPI_STATUS_IGNORE);
+    }
+    if( MPI_SUCCESS != rc ) {
+        MPI_Error_string(rc, msg, &count);
+        parsec_warning("The collective %s of %s failed: %s", write ? "write" : "read", filename, msg);
+    }
+    MPI_Type_free(&memtype);
+    MPI_Type_free(&filetype);
+    if( MPI_SUCCESS != MPI_File_close(&fh) )
+        rc = MPI_ERR_OTHER;
+
+    failed = (MPI_SUCCESS != rc);
+    MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+    return failed ? PARSEC_ERROR : PARSEC_SUCCESS;
+#else
+    return parsec_tiled_matrix_io( parsec, A, filename, flags );
+#endif  /* defined(PARSEC_HAVE_MPI) */
+}
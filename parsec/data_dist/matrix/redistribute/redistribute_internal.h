@@ -104,6 +104,20 @@ void CORE_redistribute_dtd(DTYPE* T, DTYPE* Y, int mb_Y, int nb_Y, int m_Y, int
                            int i_start, int i_end, int j_start, int j_end, int mb_T_inner,
                            int size_row, int size_col, int R, int i_start_T, int j_start_T);
 
+/**
+ * @brief Redistribute Y to T with one aggregated exchange per pair of
+ * processes, used by parsec_redistribute
+ *
+ * @return PARSEC_ERR_NOT_SUPPORTED, without any communication, when the
+ * layouts do not allow it; the JDF is used instead.
+ */
+int parsec_redistribute_planned(parsec_context_t *parsec,
+                                parsec_tiled_matrix_t *dcY,
+                                parsec_tiled_matrix_t *dcT,
+                                int size_row, int size_col,
+                                int disi_Y, int disj_Y,
+                                int disi_T, int disj_T);
+
 /**
  * @brief Copy from Y to T
  *
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+#include "redistribute_internal.h"
+#include "parsec/execution_stream.h"
+#include "parsec/data_internal.h"
+#include "parsec/mca/device/device.h"
+#include "parsec/utils/debug.h"
+
+/*
+ * The redistributed submatrix is cut along each dimension at every tile
+ * boundary of the source and of the target, so each piece of the resulting
+ * grid lies in a single tile of the source and a single tile of the target.
+ * The pieces a process sends to a peer, and the ones it receives from it, are
+ * described by a single derived datatype addressing the tiles in place, and
+ * all the pieces are exchanged by one MPI_Alltoallw, instead of one message
+ * per piece with the JDF. The pieces local to both sides are copied directly.
+ */
+
+/* A segment of one dimension of the submatrix, within a single tile of the
+ * source (tile tY, offset oY) and of the target (tile tT, offset oT) */
+typedef struct redistribute_segment_s {
+    int tY, oY;
+    int tT, oT;
+    int len;
+} redistribute_segment_t;
+
+static redistribute_segment_t *
+redistribute_segments(int size, int bY, int disY, int bT, int disT, int *count)
+{
+    redistribute_segment_t *segments;
+    int pos, y, t, len, nb = 0;
+
+    segments = (redistribute_segment_t*)malloc(((size_t)size / bY + size / bT + 3) * sizeof(redistribute_segment_t));
+    for( pos = 0; pos < size; pos += len ) {
+        y = disY + pos;
+        t = disT + pos;
+        len = size - pos;
+        if( len > bY - y % bY ) len = bY - y % bY;
+        if( len > bT - t % bT ) len = bT - t % bT;
+        segments[nb].tY = y / bY; segments[nb].oY = y % bY;
+        segments[nb].tT = t / bT; segments[nb].oT = t % bT;
+        segments[nb].len = len;
+        nb++;
+    }
+    *count = nb;
+    return segments;
+}
+
+/* The pieces are read and written in the host copy of the tiles, which must
+ * hold the newest version of the data */
+static int
+redistribute_host_is_newest(parsec_tiled_matrix_t *dc, int m, int n)
+{
+    parsec_data_t *data = dc->super.data_of(&dc->super, m, n);
+    parsec_data_copy_t *host = data->device_copies[0], *copy;
+    uint32_t i;
+
+    if( NULL == host )
+        return 0;
+    for( i = 1; i < parsec_nb_devices; i++ ) {
+        copy = data->device_copies[i];
+        if( NULL != copy && PARSEC_DATA_COHERENCY_INVALID != copy->coherency_state &&
+            copy->version > host->version )
+            return 0;
+    }
+    return 1;
+}
+
+static inline char *
+redistribute_piece(parsec_tiled_matrix_t *dc, int m, int n, int i, int j, int eltsize, int *ld)
+{
+    char *tile = (char*)parsec_data_get_ptr(dc->super.data_of(&dc->super, m, n), 0);
+    *ld = (PARSEC_MATRIX_LAPACK == dc->storage) ? dc->llm : dc->mb;
+    return tile + ((size_t)j * (*ld) + i) * eltsize;
+}
+
+/**
+ * @brief Redistribute with a single aggregated exchange between the processes
+ *
+ * @details
+ * Collective over the communicator of the context, which the calling thread
+ * uses directly: every process must call it with the context not running.
+ * The pieces are moved between the host copies of the tiles, and the
+ * version of the host copies of dcT written is increased.
+ *
+ * @return PARSEC_ERR_NOT_SUPPORTED if the redistribution cannot be done this
+ * way: the context is running (without any communication), the element
+ * sizes or numbers of processes differ or MPI is not available (without any
+ * communication), or the newest version of a tile is not on the host of
+ * some process; PARSEC_SUCCESS otherwise.
+ */
+int
+parsec_redistribute_planned(parsec_context_t *parsec,
+                            parsec_tiled_matrix_t *dcY,
+                            parsec_tiled_matrix_t *dcT,
+                            int size_row, int size_col,
+                            int disi_Y, int disj_Y,
+                            int disi_T, int disj_T)
+{
+    redistribute_segment_t *rows, *cols;
+    int nb_rows, nb_cols, r, c, k, src, dst, ldY, ldT;
+    int myrank = dcY->super.myrank, nodes = dcY->super.nodes;
+    int eltsize = parsec_datadist_getsizeoftype(dcY->mtype);
+    char *pY, *pT;
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Comm comm = (MPI_Comm)parsec->comm_ctx;
+    MPI_Datatype *types, *sendtypes, *recvtypes;
+    MPI_Aint *addrs;
+    int *counts, *first, *displs, *blocklens, *sendcounts, *recvcounts;
+    int mpi_is_on, size, peer, nb_pieces = 0;
+#endif  /* defined(PARSEC_HAVE_MPI) */
+    int stale = 0;
+
+    /* The communication engine owns the communicator while the context runs */
+    if( PARSEC_CONTEXT_FLAG_CONTEXT_ACTIVE & parsec->flags )
+        return PARSEC_ERR_NOT_SUPPORTED;
+    if( eltsize != parsec_datadist_getsizeoftype(dcT->mtype) ||
+        nodes != (int)dcT->super.nodes || myrank != (int)dcT->super.myrank )
+        return PARSEC_ERR_NOT_SUPPORTED;
+#if defined(PARSEC_HAVE_MPI)
+    if( nodes > 1 ) {
+        MPI_Initialized(&mpi_is_on);
+        if( !mpi_is_on )
+            return PARSEC_ERR_NOT_SUPPORTED;
+        MPI_Comm_size(comm, &size);
+        if( size != nodes )
+            return PARSEC_ERR_NOT_SUPPORTED;
+    }
+#else
+    if( nodes > 1 )
+        return PARSEC_ERR_NOT_SUPPORTED;
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+    rows = redistribute_segments(size_row, dcY->mb, disi_Y, dcT->mb, disi_T, &nb_rows);
+    cols = redistribute_segments(size_col, dcY->nb, disj_Y, dcT->nb, disj_T, &nb_cols);
+
+    /* Fall back to the JDF, which moves the data between the devices, if
+     * any process has a tile whose newest version is not on the host */
+    for( c = 0; c < nb_cols && !stale; c++ ) {
+        for( r = 0; r < nb_rows && !stale; r++ ) {
+            if( (int)dcY->super.rank_of(&dcY->super, rows[r].tY, cols[c].tY) == myrank &&
+                !redistribute_host_is_newest(dcY, rows[r].tY, cols[c].tY) )
+                stale = 1;
+            if( (int)dcT->super.rank_of(&dcT->super, rows[r].tT, cols[c].tT) == myrank &&
+                !redistribute_host_is_newest(dcT, rows[r].tT, cols[c].tT) )
+                stale = 1;
+        }
+    }
+#if defined(PARSEC_HAVE_MPI)
+    if( nodes > 1 )
+        MPI_Allreduce(MPI_IN_PLACE, &stale, 1, MPI_INT, MPI_MAX, comm);
+#endif  /* defined(PARSEC_HAVE_MPI) */
+    if( stale ) {
+        free(rows);
+        free(cols);
+        return PARSEC_ERR_NOT_SUPPORTED;
+    }
+
+#if defined(PARSEC_HAVE_MPI)
+    /* Count the pieces exchanged with each peer, sends in the first half */
+    counts = (int*)calloc(4 * (size_t)nodes, sizeof(int));
+    first = counts + 2 * nodes;
+#endif  /* defined(PARSEC_HAVE_MPI) */
+    for( c = 0; c < nb_cols; c++ ) {
+        for( r = 0; r < nb_rows; r++ ) {
+            src = dcY->super.rank_of(&dcY->super, rows[r].tY, cols[c].tY);
+            dst = dcT->super.rank_of(&dcT->super, rows[r].tT, cols[c].tT);
+            if( src == myrank && dst == myrank ) {
+                pY = redistribute_piece(dcY, rows[r].tY, cols[c].tY, rows[r].oY, cols[c].oY, eltsize, &ldY);
+                pT = redistribute_piece(dcT, rows[r].tT, cols[c].tT, rows[r].oT, cols[c].oT, eltsize, &ldT);
+                for( k = 0; k < cols[c].len; k++ )
+                    memcpy(pT + (size_t)k * ldT * eltsize, pY + (size_t)k * ldY * eltsize, (size_t)rows[r].len * eltsize);
+            }
+#if defined(PARSEC_HAVE_MPI)
+            else if( src == myrank ) {
+                counts[dst]++; nb_pieces++;
+            } else if( dst == myrank ) {
+                counts[nodes + src]++; nb_pieces++;
+            }
+#endif  /* defined(PARSEC_HAVE_MPI) */
+        }
+    }
+
+#if defined(PARSEC_HAVE_MPI)
+    if( nodes > 1 ) {
+        /* Place the pieces of each peer, in the order of the submatrix on
+         * both sides, and describe each of them in place */
+        for( peer = 1; peer < 2 * nodes; peer++ )
+            first[peer] = first[peer-1] + counts[peer-1];
+        memset(counts, 0, 2 * (size_t)nodes * sizeof(int));
+        types = (MPI_Datatype*)malloc(((size_t)nb_pieces + 2 * nodes) * sizeof(MPI_Datatype));
+        addrs = (MPI_Aint*)malloc(((size_t)nb_pieces + 1) * sizeof(MPI_Aint));
+        blocklens = (int*)malloc(((size_t)nb_pieces + 4 * nodes + 1) * sizeof(int));
+        sendtypes = types + nb_pieces;
+        recvtypes = sendtypes + nodes;
+        sendcounts = blocklens + nb_pieces;
+        recvcounts = sendcounts + nodes;
+        displs = recvcounts + nodes;
+        for( c = 0; c < nb_cols; c++ ) {
+            for( r = 0; r < nb_rows; r++ ) {
+                src = dcY->super.rank_of(&dcY->super, rows[r].tY, cols[c].tY);
+                dst = dcT->super.rank_of(&dcT->super, rows[r].tT, cols[c].tT);
+                if( src == dst ) continue;
+                if( src == myrank ) {
+                    k = first[dst] + counts[dst]++;
+                    pY = redistribute_piece(dcY, rows[r].tY, cols[c].tY, rows[r].oY, cols[c].oY, eltsize, &ldY);
+                    MPI_Type_create_hvector(cols[c].len, rows[r].len * eltsize, (MPI_Aint)ldY * eltsize, MPI_BYTE, &types[k]);
+                    MPI_Get_address(pY, &addrs[k]);
+                } else if( dst == myrank ) {
+                    k = first[nodes + src] + counts[nodes + src]++;
+                    pT = redistribute_piece(dcT, rows[r].tT, cols[c].tT, rows[r].oT, cols[c].oT, eltsize, &ldT);
+                    MPI_Type_create_hvector(cols[c].len, rows[r].len * eltsize, (MPI_Aint)ldT * eltsize, MPI_BYTE, &types[k]);
+                    MPI_Get_address(pT, &addrs[k]);
+                }
+            }
+        }
+        for( k = 0; k < nb_pieces; k++ )
+            blocklens[k] = 1;
+        for( peer = 0; peer < 2 * nodes; peer++ ) {
+            displs[peer] = 0;
+            if( 0 == counts[peer] ) {
+                sendcounts[peer] = 0;
+                sendtypes[peer] = MPI_BYTE;
+                continue;
+            }
+            sendcounts[peer] = 1;
+            MPI_Type_create_struct(counts[peer], blocklens + first[peer], addrs + first[peer],
+                                   types + first[peer], &sendtypes[peer]);
+            MPI_Type_commit(&sendtypes[peer]);
+        }
+        for( k = 0; k < nb_pieces; k++ )
+            MPI_Type_free(&types[k]);
+
+        MPI_Alltoallw(MPI_BOTTOM, sendcounts, displs, sendtypes,
+                      MPI_BOTTOM, recvcounts, displs + nodes, recvtypes, comm);
+
+        for( peer = 0; peer < 2 * nodes; peer++ )
+            if( sendcounts[peer] > 0 )
+                MPI_Type_free(&sendtypes[peer]);
+        free(types);
+        free(addrs);
+        free(blocklens);
+    }
+    free(counts);
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+    /* The host copies of the tiles of dcT written hold a new version, once
+     * each: consecutive segments of a dimension are in increasing tiles */
+    for( c = 0; c < nb_cols; c++ ) {
+        if( c > 0 && cols[c].tT == cols[c-1].tT ) continue;
+        for( r = 0; r < nb_rows; r++ ) {
+            if( r > 0 && rows[r].tT == rows[r-1].tT ) continue;
+            if( (int)dcT->super.rank_of(&dcT->super, rows[r].tT, cols[c].tT) == myrank )
+                dcT->super.data_of(&dcT->super, rows[r].tT, cols[c].tT)->device_copies[0]->version++;
+        }
+    }
+
+    free(rows);
+    free(cols);
+    return PARSEC_SUCCESS;
+}
@@ -6,6 +6,7 @@
 #include "redistribute_internal.h"
 #include "redistribute.h"
 #include "redistribute_reshuffle.h"
+#include "parsec/utils/mca_param.h"
 
 static inline int parsec_imin(int a, int b)
 {
@@ -18,55 +19,72 @@ static inline int parsec_imax(int a, int b)
 };
 
 /**
- * @brief New function for redistribute
- *
- * @param [in] dcY: the data, already distributed and allocated
- * @param [out] dcT: the data, redistributed and allocated
- * @param [in] size_row: row size to be redistributed
- * @param [in] size_col: column size to be redistributed
- * @param [in] disi_Y: row displacement in dcY
- * @param [in] disj_Y: column displacement in dcY
- * @param [in] disi_T: row displacement in dcT
- * @param [in] disj_T: column displacement in dcT
- * @return the parsec object to schedule.
+ * @brief Check the submatrix fits in both dcY and dcT
  */
-parsec_taskpool_t*
-parsec_redistribute_New(parsec_tiled_matrix_t *dcY,
+static int
+redistribute_check_args(parsec_tiled_matrix_t *dcY,
                         parsec_tiled_matrix_t *dcT,
                         int size_row, int size_col,
                         int disi_Y, int disj_Y,
                         int disi_T, int disj_T)
 {
-    parsec_taskpool_t* redistribute_taskpool;
-    int num_cols;
-
     if( size_row < 1 || size_col < 1 ) {
         if( 0 == dcY->super.myrank )
             parsec_warning("ERROR: Submatrix size should be bigger than 1\n");
-        return NULL;
+        return PARSEC_ERR_BAD_PARAM;
     }
 
     if( disi_Y < 0 || disj_Y < 0 ||
         disi_T < 0 || disj_T < 0 ) {
         if( 0 == dcY->super.myrank )
             parsec_warning("ERROR: Submatrix displacement should not be negative\n");
-        return NULL;
+        return PARSEC_ERR_BAD_PARAM;
     }
 
     if( (disi_Y+size_row > dcY->lmt*dcY->mb) ||
         (disj_Y+size_col > dcY->lnt*dcY->nb) ){
         if( 0 == dcY->super.myrank )
             parsec_warning("ERROR: Submatrix exceed SOURCE size\n");
-        return NULL;
+        return PARSEC_ERR_BAD_PARAM;
     }
 
     if( (disi_T+size_row > dcT->lmt*dcT->mb)
         || (disj_T+size_col > dcT->lnt*dcT->nb) ){
         if( 0 == dcY->super.myrank )
             parsec_warning("ERROR: Submatrix exceed TARGET size\n");
-        return NULL;
+        return PARSEC_ERR_BAD_PARAM;
     }
 
+    return PARSEC_SUCCESS;
+}
+
+/**
+ * @brief New function for redistribute
+ *
+ * @param [in] dcY: the data, already distributed and allocated
+ * @param [out] dcT: the data, redistributed and allocated
+ * @param [in] size_row: row size to be redistributed
+ * @param [in] size_col: column size to be redistributed
+ * @param [in] disi_Y: row displacement in dcY
+ * @param [in] disj_Y: column displacement in dcY
+ * @param [in] disi_T: row displacement in dcT
+ * @param [in] disj_T: column displacement in dcT
+ * @return the parsec object to schedule.
+ */
+parsec_taskpool_t*
+parsec_redistribute_New(parsec_tiled_matrix_t *dcY,
+                        parsec_tiled_matrix_t *dcT,
+                        int size_row, int size_col,
+                        int disi_Y, int disj_Y,
+                        int disi_T, int disj_T)
+{
+    parsec_taskpool_t* redistribute_taskpool;
+    int num_cols;
+
+    if( PARSEC_SUCCESS != redistribute_check_args(dcY, dcT, size_row, size_col,
+                                                  disi_Y, disj_Y, disi_T, disj_T) )
+        return NULL;
+
     /* Check distribution, and determine batch size: num_col */
     if( (dcY->dtype & parsec_matrix_tabular_type) && (dcT->dtype & parsec_matrix_tabular_type) ) {
         num_cols = parsec_imin( ceil(size_col/dcY->nb), dcY->super.nodes );
@@ -173,6 +191,12 @@ PARSEC_OBJ_CLASS_INSTANCE(parsec_redistribute_reshuffle_taskpool_t, parsec_taskp
 /**
  * @brief Redistribute dcY to dcT in PTG
  *
+ * @details
+ * Unless the MCA parameter redistribute_planner is 0, the data is moved by
+ * parsec_redistribute_planned, and the JDF is only used when the layouts do
+ * not allow it, when the context is running, or when the newest version of
+ * a tile is not on the host.
+ *
  * @param [in] dcY: source distribution, already distributed and allocated
  * @param [out] dcT: target distribution, redistributed and allocated
  * @param [in] size_row: row size to be redistributed
@@ -190,6 +214,18 @@ int parsec_redistribute(parsec_context_t *parsec,
                         int disi_T, int disj_T)
 {
     parsec_taskpool_t *parsec_redistribute_ptg = NULL;
+    int planner = 1;
+
+    parsec_mca_param_reg_int_name("redistribute", "planner",
+                                  "Redistribute with one aggregated exchange between each pair of processes "
+                                  "when the layouts allow it, instead of one message per piece of tile.\n",
+                                  false, false, planner, &planner);
+    if( planner &&
+        PARSEC_SUCCESS == redistribute_check_args(dcY, dcT, size_row, size_col,
+                                                  disi_Y, disj_Y, disi_T, disj_T) &&
+        PARSEC_SUCCESS == parsec_redistribute_planned(parsec, dcY, dcT, size_row, size_col,
+                                                      disi_Y, disj_Y, disi_T, disj_T) )
+        return PARSEC_SUCCESS;
 
     parsec_redistribute_ptg = parsec_redistribute_New(
                               dcY, dcT, size_row, size_col, disi_Y,
@@ -19,6 +19,8 @@ static parsec_data_t* twoDBC_data_of(parsec_data_collection_t* dc, ...);
 static uint32_t twoDBC_rank_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static int32_t twoDBC_vpid_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
 static parsec_data_t* twoDBC_data_of_key(parsec_data_collection_t* dc, parsec_data_key_t key);
+static int64_t twoDBC_nb_local_of(parsec_data_collection_t* dc, int dim,
+                                  int64_t first, int64_t last, int64_t step, ...);
 
 static uint32_t twoDBC_kview_rank_of(parsec_data_collection_t* dc, ...);
 static int32_t twoDBC_kview_vpid_of(parsec_data_collection_t* dc, ...);
@@ -210,6 +212,7 @@ void parsec_matrix_block_cyclic_init(parsec_matrix_block_cyclic_t * dc,
         parsec_matrix_block_cyclic_kview(dc, dc, kp, kq);
 #endif /* PARSEC_KCYCLIC_WITH_VIEW */
     }
+    o->nb_local_of       = twoDBC_nb_local_of;
     o->register_memory   = twoDBC_memory_register;
     o->unregister_memory = twoDBC_memory_unregister;
 
@@ -235,6 +238,39 @@ void parsec_matrix_block_cyclic_init(parsec_matrix_block_cyclic_t * dc,
            dc->grid.rrank, dc->grid.crank);
 }
 
+/*
+ * Count the local tiles along one dimension without enumerating them: along
+ * the rows the owner repeats every krows*P tiles, along the columns every
+ * kcols*Q tiles. Views installed on top of the collection change rank_of,
+ * in which case the count is left to the caller.
+ */
+static int64_t twoDBC_nb_local_of(parsec_data_collection_t *desc, int dim,
+                                  int64_t first, int64_t last, int64_t step, ...)
+{
+    parsec_matrix_block_cyclic_t *dc = (parsec_matrix_block_cyclic_t *)desc;
+    int coords[2];
+    va_list ap;
+
+    if( (dim < 0) || (dim > 1) )
+        return -1;  /* the collection only has two coordinates */
+    if( (desc->rank_of != twoDBC_rank_of)
+#if !PARSEC_KCYCLIC_WITH_VIEW
+        && (desc->rank_of != twoDBC_kcyclic_rank_of)
+#endif  /* !PARSEC_KCYCLIC_WITH_VIEW */
+        ) {
+        return -1;
+    }
+
+    va_start(ap, step);
+    coords[0] = va_arg(ap, int);
+    coords[1] = va_arg(ap, int);
+    va_end(ap);
+
+    return parsec_matrix_nb_local_periodic(desc, dim, 2, coords, first, last, step,
+                                           (0 == dim) ? (int64_t)dc->grid.krows * dc->grid.rows
+                                                      : (int64_t)dc->grid.kcols * dc->grid.cols);
+}
+
 void parsec_matrix_block_cyclic_key2coords(parsec_data_collection_t *desc,
                                                    parsec_data_key_t key,
                                                    int *m, int *n)
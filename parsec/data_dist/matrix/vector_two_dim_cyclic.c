@@ -10,11 +10,14 @@
 #include "parsec/utils/debug.h"
 #include "parsec/data_dist/matrix/matrix.h"
 #include "parsec/data_dist/matrix/vector_two_dim_cyclic.h"
+#include "parsec/data_dist/matrix/matrix_internal.h"
 #include "parsec/vpmap.h"
 
 static uint32_t vector_twoDBC_rank_of(parsec_data_collection_t* dc, ...);
 static int32_t  vector_twoDBC_vpid_of(parsec_data_collection_t* dc, ...);
 static parsec_data_t* vector_twoDBC_data_of(parsec_data_collection_t* dc, ...);
+static int64_t vector_twoDBC_nb_local_of(parsec_data_collection_t* dc, int dim,
+                                         int64_t first, int64_t last, int64_t step, ...);
 
 #if defined(PARSEC_PROF_TRACE) || defined(PARSEC_HAVE_DEV_CUDA_SUPPORT) || defined(PARSEC_HAVE_DEV_HIP_SUPPORT)
 static parsec_data_key_t vector_twoDBC_data_key(struct parsec_data_collection_s *desc, ...);
@@ -125,6 +128,7 @@ void parsec_vector_two_dim_cyclic_init( parsec_vector_two_dim_cyclic_t * dc,
     o->rank_of = vector_twoDBC_rank_of;
     o->vpid_of = vector_twoDBC_vpid_of;
     o->data_of = vector_twoDBC_data_of;
+    o->nb_local_of = vector_twoDBC_nb_local_of;
 
 #if defined(PARSEC_PROF_TRACE) || defined(PARSEC_HAVE_DEV_CUDA_SUPPORT) || defined(PARSEC_HAVE_DEV_HIP_SUPPORT)
     o->data_key      = vector_twoDBC_data_key;
@@ -186,6 +190,25 @@ static uint32_t vector_twoDBC_rank_of(parsec_data_collection_t * desc, ...)
     return res;
 }
 
+/* The owner of a segment only depends on its position modulo P and Q */
+static int64_t vector_twoDBC_nb_local_of(parsec_data_collection_t *desc, int dim,
+                                         int64_t first, int64_t last, int64_t step, ...)
+{
+    parsec_vector_two_dim_cyclic_t * dc = (parsec_vector_two_dim_cyclic_t *)desc;
+    int coords[1];
+    va_list ap;
+
+    if( (desc->rank_of != vector_twoDBC_rank_of) || (0 != dim) )
+        return -1;
+
+    va_start(ap, step);
+    coords[0] = va_arg(ap, int);
+    va_end(ap);
+
+    return parsec_matrix_nb_local_periodic(desc, dim, 1, coords, first, last, step,
+                                           lcm(dc->grid.rows, dc->grid.cols));
+}
+
 static int32_t vector_twoDBC_vpid_of(parsec_data_collection_t *desc, ...)
 {
     int m, p, q, pq;
@@ -48,6 +48,13 @@ struct parsec_data_collection_s {
     int32_t  (*vpid_of)(parsec_data_collection_t *d, ...);
     int32_t  (*vpid_of_key)(parsec_data_collection_t *d, parsec_data_key_t key);
 
+    /* return the number of local data along the dimension dim, for the coordinates
+     * first, first+step, ... up to last (included), the other coordinates being
+     * provided in the variadic part. Returns -1 if the count cannot be computed
+     * without enumerating the coordinates. Optional, can be NULL. */
+    int64_t  (*nb_local_of)(parsec_data_collection_t *d, int dim,
+                            int64_t first, int64_t last, int64_t step, ...);
+
     /* Memory management function. They are used to register/unregister the data description
      * with the active devices.
      */
@@ -17,6 +17,7 @@
 #include "parsec/mempool.h"
 #include "parsec/profiling.h"
 #include "parsec/class/barrier.h"
+#include "parsec/class/eventcount.h"
 #include "parsec/class/parsec_hash_table.h"
 
 #ifdef PARSEC_PROF_PINS
@@ -53,12 +54,23 @@ struct parsec_execution_stream_s {
      */
     struct parsec_task_s* next_task;
 
+    /* Scratch space used to sort the rings of ready tasks by priority before
+     * delivering them to the scheduler. Twice ready_scratch_size tasks. */
+    struct parsec_task_s** ready_scratch;
+    size_t ready_scratch_size;
+
+    /* Tasks injected from outside of the virtual process and not yet
+     * compensated by selections of this stream, a load hint for the
+     * least loaded injection policy. */
+    volatile int32_t inject_pending;
+
 #if defined(PARSEC_SIM)
     int largest_simulation_date;
 #endif
 
 #if defined(PARSEC_PROF_PINS)
     struct parsec_pins_next_callback_s pins_events_cb[PARSEC_PINS_FLAG_COUNT];
+    int32_t select_distance;  /**< Distance returned by the last task selection, exposed to the PINS modules */
 #endif  /* defined(PARSEC_PROF_PINS) */
 
 #if defined(PARSEC_PROF_RUSAGE_EU)
@@ -82,6 +94,7 @@ struct parsec_vp_s {
     parsec_context_t *parsec_context; /**< backlink to the global context */
     int32_t vp_id;                  /**< virtual process identifier of this vp */
     int32_t nb_cores;               /**< number of cores for this vp */
+    volatile int32_t inject_next;   /**< next execution stream for the round robin injection policy */
 
     /* Mempools are allocated per VP, and used per execution_stream
      * The last eu of this VP will create the mempools for all eus of this VP
@@ -125,6 +138,8 @@ struct parsec_context_s {
     int32_t my_rank;     /**< rank of this physical process */
 
     parsec_barrier_t  barrier;
+    parsec_eventcount_t idle; /**< idle execution streams park on this event count until
+                               *   new tasks are scheduled or all taskpools complete */
 
     size_t remote_dep_fw_mask_sizeof; /* Size of the remote dep fw mask */
 
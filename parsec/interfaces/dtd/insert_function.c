@@ -57,6 +57,7 @@
 #include "parsec/utils/debug.h"
 #include "parsec/data_distribution.h"
 #include "parsec/utils/backoff.h"
+#include "parsec/sys/tls.h"
 
 /* This allows DTD to have a separate stream for debug verbose output */
 int parsec_dtd_debug_output;
@@ -69,6 +70,10 @@ int32_t __parsec_dtd_is_initialized = 0; /**< Indicates init of dtd environment
 
 int parsec_dtd_window_size             = 8000;   /**< Default window size */
 int parsec_dtd_threshold_size          = 4000;   /**< Default threshold size of tasks for master thread to wait on */
+int parsec_dtd_sliced_insertion        = 0;      /**< Do not instantiate the tasks that do not concern this rank */
+int parsec_dtd_adaptive_window         = 0;      /**< Adapt the window of the main thread to the runtime feedback */
+static int parsec_dtd_window_max       = 1<<17;  /**< Largest adaptive window */
+static size_t parsec_dtd_memory_limit  = 0;      /**< Memory of the pending tasks the adaptive window aims to stay under */
 static int parsec_dtd_task_hash_table_size = 1<<16; /**< Default task hash table size */
 static int parsec_dtd_tile_hash_table_size = 1<<16; /**< Default tile hash table size */
 
@@ -78,11 +83,65 @@ int insert_task_trace_keyout = -1;
 int hashtable_trace_keyin = -1;
 int hashtable_trace_keyout = -1;
 
+#if defined(PARSEC_PROF_TRACE)
+static int window_trace_keyin = -1;
+static int window_trace_keyout = -1;
+static const char *parsec_dtd_window_info_to_string = "window{int32_t};"
+                                                      "threshold{int32_t};"
+                                                      "pending{int32_t};"
+                                                      "idle{int32_t};"
+                                                      "found_permil{int32_t};"
+                                                      "decision{int32_t};"
+                                                      "task_bytes{int64_t}";
+#endif  /* defined(PARSEC_PROF_TRACE) */
+
+/* Decisions of the adaptive window, as saved in the dtd_window events */
+typedef enum {
+    PARSEC_DTD_WINDOW_KEEP   = 0,
+    PARSEC_DTD_WINDOW_GROW   = 1,
+    PARSEC_DTD_WINDOW_SHRINK = 2,
+    PARSEC_DTD_WINDOW_MEMORY = 3
+} parsec_dtd_window_decision_t;
+
+typedef struct parsec_dtd_window_info_s {
+    int32_t window;
+    int32_t threshold;
+    int32_t pending;
+    int32_t idle;
+    int32_t found_permil;
+    int32_t decision;
+    int64_t task_bytes;
+} parsec_dtd_window_info_t;
+
 extern parsec_sched_module_t *parsec_current_scheduler;
 
 /* Global mempool for all tiles */
 parsec_mempool_t *parsec_dtd_tile_mempool = NULL;
 
+/* Inserter attached to the current thread, if any */
+static PARSEC_TLS_DECLARE(parsec_dtd_tls_inserter);
+
+static inline parsec_dtd_inserter_t *
+parsec_dtd_my_inserter(parsec_dtd_taskpool_t *dtd_tp)
+{
+    parsec_dtd_inserter_t *inserter = (parsec_dtd_inserter_t *)PARSEC_TLS_GET_SPECIFIC(parsec_dtd_tls_inserter);
+    return (NULL != inserter && inserter->dtd_tp == dtd_tp) ? inserter : NULL;
+}
+
+/* The main thread numbers its tasks upward from 0, while inserter i takes
+ * -1-i, -1-i-PARSEC_DTD_MAX_INSERTERS, ... so that the ids do not depend
+ * on how the insertions of the different threads interleave. */
+static inline int
+parsec_dtd_next_task_id(parsec_dtd_taskpool_t *dtd_tp)
+{
+    parsec_dtd_inserter_t *inserter = parsec_dtd_my_inserter(dtd_tp);
+    if( NULL == inserter ) {
+        return dtd_tp->task_id++;
+    }
+    assert(inserter->task_id < INT32_MAX / PARSEC_DTD_MAX_INSERTERS);
+    return -1 - inserter->index - PARSEC_DTD_MAX_INSERTERS * inserter->task_id++;
+}
+
 static parsec_hook_return_t parsec_dtd_cpu_task_submit(parsec_execution_stream_t *es, parsec_task_t *this_task);
 
 static parsec_data_key_t parsec_dtd_tile_new_dc_data_key(parsec_data_collection_t *d, ...)
@@ -461,6 +520,10 @@ PARSEC_OBJ_CLASS_INSTANCE(parsec_dtd_taskpool_t, parsec_taskpool_t,
  *                                          thread will wait before going
  *                                          back and inserting task into the
  *                                          engine.
+ *  - dtd_adaptive_window (default=0 off):  Adapts the window and threshold
+ *                                          of the master thread at runtime,
+ *                                          up to dtd_window_max tasks and
+ *                                          under dtd_memory_limit bytes.
  * @ingroup DTD_INTERFACE
  */
 static void
@@ -496,6 +559,26 @@ parsec_dtd_lazy_init(void)
                                         "Registers the supplied size overriding the default size of threshold size",
                                         false, false, parsec_dtd_threshold_size, &parsec_dtd_threshold_size);
 
+    (void)parsec_mca_param_reg_int_name("dtd", "sliced_insertion",
+                                        "Only track the last remote writer of each tile for the tasks that neither run "
+                                        "on this rank nor produce or consume data on this rank, instead of creating them",
+                                        false, false, parsec_dtd_sliced_insertion, &parsec_dtd_sliced_insertion);
+
+    (void)parsec_mca_param_reg_int_name("dtd", "adaptive_window",
+                                        "Let the main thread adapt its window (and threshold) each time it fills it, "
+                                        "from the idle execution streams, the availability of ready tasks and the "
+                                        "memory held by the pending tasks",
+                                        false, false, parsec_dtd_adaptive_window, &parsec_dtd_adaptive_window);
+
+    (void)parsec_mca_param_reg_int_name("dtd", "window_max",
+                                        "Largest window the adaptive window can grow to",
+                                        false, false, parsec_dtd_window_max, &parsec_dtd_window_max);
+
+    (void)parsec_mca_param_reg_sizet_name("dtd", "memory_limit",
+                                          "Memory in bytes the tasks pending in the window of the main thread should "
+                                          "stay under when the window is adaptive (0 for no limit)",
+                                          false, false, parsec_dtd_memory_limit, &parsec_dtd_memory_limit);
+
     /* Registering mca param for threshold size */
     (void)parsec_mca_param_reg_int_name("dtd", "profile_verbose",
                                         "This param turns events that profiles task insertion and other dtd overheads",
@@ -525,6 +608,8 @@ parsec_dtd_lazy_init(void)
                               PARSEC_OBJ_CLASS(parsec_dtd_tile_t), sizeof(parsec_dtd_tile_t),
                               offsetof(parsec_dtd_tile_t, mempool_owner),
                               1/* no. of threads*/ );
+
+    PARSEC_TLS_KEY_CREATE(parsec_dtd_tls_inserter);
 }
 
 /* **************************************************************************** */
@@ -567,9 +652,10 @@ extern int __parsec_task_progress(parsec_execution_stream_t *es,
  *
  * @ingroup     DTD_INTERFACE_INTERNAL
  */
-void
-parsec_execute_and_come_back(parsec_taskpool_t *tp,
-                             int task_threshold_count)
+static void
+__parsec_execute_and_come_back(parsec_taskpool_t *tp,
+                               int task_threshold_count,
+                               uint32_t *nb_selects, uint32_t *nb_found)
 {
     uint64_t misses_in_a_row;
     parsec_execution_stream_t *es = parsec_my_execution_stream();
@@ -608,9 +694,11 @@ parsec_execute_and_come_back(parsec_taskpool_t *tp,
             es->next_task = NULL;
             distance = 1;
         }
+        (*nb_selects)++;
 
         if( task != NULL) {
             misses_in_a_row = 0;  /* reset the misses counter */
+            (*nb_found)++;
 
             rc = __parsec_task_progress(es, task, distance);
             (void)rc;
@@ -618,6 +706,14 @@ parsec_execute_and_come_back(parsec_taskpool_t *tp,
     }
 }
 
+void
+parsec_execute_and_come_back(parsec_taskpool_t *tp,
+                             int task_threshold_count)
+{
+    uint32_t nb_selects = 0, nb_found = 0;
+    __parsec_execute_and_come_back(tp, task_threshold_count, &nb_selects, &nb_found);
+}
+
 /* **************************************************************************** */
 /**
  * This function unpacks the parameters of a task
@@ -1260,25 +1356,33 @@ parsec_dtd_data_collection_fini(parsec_data_collection_t *dc)
 parsec_dtd_tile_t *
 parsec_dtd_tile_of(parsec_data_collection_t *dc, parsec_data_key_t key)
 {
+    parsec_hash_table_t *hash_table = (parsec_hash_table_t *)dc->tile_h_table;
     parsec_dtd_tile_t *tile = parsec_dtd_tile_find(dc, (uint64_t)key);
     if( NULL == tile ) {
-        /* Creating Tile object */
-        tile = (parsec_dtd_tile_t *)parsec_thread_mempool_allocate(parsec_dtd_tile_mempool->thread_mempools);
-        tile->dc = dc;
-        tile->arena_index = -1;
-        tile->key = (uint64_t)0x00000000 | key;
-        tile->rank = dc->rank_of_key(dc, tile->key);
-        tile->flushed = NOT_FLUSHED;
-        if( tile->rank == (int)dc->myrank ) {
-            tile->data_copy = (dc->data_of_key(dc, tile->key))->device_copies[0];
-            assert(NULL != tile->data_copy);
-            tile->data_copy->readers = 0;
-        } else {
-            tile->data_copy = NULL;
-        }
+        /* Several threads may be inserting tasks on this data */
+        parsec_hash_table_lock_bucket(hash_table, (parsec_key_t)key);
+        tile = (parsec_dtd_tile_t *)parsec_hash_table_nolock_find(hash_table, (parsec_key_t)key);
+        if( NULL == tile ) {
+            /* Creating Tile object */
+            tile = (parsec_dtd_tile_t *)parsec_thread_mempool_allocate(parsec_dtd_tile_mempool->thread_mempools);
+            tile->dc = dc;
+            tile->arena_index = -1;
+            tile->key = (uint64_t)0x00000000 | key;
+            tile->rank = dc->rank_of_key(dc, tile->key);
+            tile->flushed = NOT_FLUSHED;
+            if( tile->rank == (int)dc->myrank ) {
+                tile->data_copy = (dc->data_of_key(dc, tile->key))->device_copies[0];
+                assert(NULL != tile->data_copy);
+                tile->data_copy->readers = 0;
+            } else {
+                tile->data_copy = NULL;
+            }
 
-        SET_LAST_ACCESSOR(tile);
-        parsec_dtd_tile_insert(tile->key, tile, dc);
+            SET_LAST_ACCESSOR(tile);
+            tile->ht_item.key = (parsec_key_t)tile->key;
+            parsec_hash_table_nolock_insert(hash_table, &tile->ht_item);
+        }
+        parsec_hash_table_unlock_bucket(hash_table, (parsec_key_t)key);
     }
     assert(tile->flushed == NOT_FLUSHED);
 #if defined(PARSEC_DEBUG_PARANOID)
@@ -1408,9 +1512,16 @@ parsec_dtd_taskpool_new(void)
         __tp->super.task_classes_array[i] = NULL;
     }
 
+    parsec_atomic_lock_init(&__tp->task_class_lock);
     __tp->task_id = 0;
     __tp->task_window_size = 1;
+    __tp->task_window_cap = parsec_dtd_window_size;
     __tp->task_threshold_size = parsec_dtd_threshold_size;
+    __tp->task_bytes = 0;
+    __tp->wait_selects = 0;
+    __tp->wait_found = 0;
+    __tp->window_grows = 0;
+    __tp->window_shrinks = 0;
     __tp->local_task_inserted = 0;
     __tp->enqueue_flag = 0;
     __tp->new_tile_keys = 0;
@@ -1439,11 +1550,108 @@ parsec_dtd_taskpool_new(void)
     parsec_profiling_add_dictionary_keyword("dtd_data_flush", "fill:#111111", 0, "",
                                             (int *)&__tp->super.profiling_array[0],
                                             (int *)&__tp->super.profiling_array[1]);
+    if( parsec_dtd_adaptive_window ) {
+        parsec_profiling_add_dictionary_keyword("dtd_window", "fill:#7F7F00",
+                                                sizeof(parsec_dtd_window_info_t),
+                                                parsec_dtd_window_info_to_string,
+                                                &window_trace_keyin, &window_trace_keyout);
+    }
 #endif
 
     return (parsec_taskpool_t *)__tp;
 }
 
+/* **************************************************************************** */
+/**
+ * Attaches the calling thread to a DTD taskpool as an inserter
+ *
+ * The thread gets an execution stream of its own, modeled on the one of
+ * the communication thread: it belongs to the first virtual process, has
+ * no scheduler queues, and allocates from the mempools of the worker that
+ * receives the tasks it finds ready.
+ *
+ * @param[in]   tp
+ *                  DTD taskpool, added to a started context
+ * @param[in]   index
+ *                  Index of the inserter, selects the range of its task ids
+ * @return
+ *              The inserter, or NULL if the thread cannot insert into tp
+ *
+ * @ingroup     DTD_INTERFACE
+ */
+parsec_dtd_inserter_t *
+parsec_dtd_inserter_new(parsec_taskpool_t *tp, int index)
+{
+    parsec_dtd_inserter_t *inserter;
+    parsec_execution_stream_t *target_es;
+    parsec_vp_t *vp;
+
+    if( PARSEC_TASKPOOL_TYPE_DTD != tp->taskpool_type ) {
+        parsec_warning("Calling parsec_dtd_inserter_new on a taskpool that is not DTD\n");
+        return NULL;
+    }
+    if( index < 0 || index >= PARSEC_DTD_MAX_INSERTERS ) {
+        parsec_warning("DTD inserter index %d is out of [0, %d)\n", index, PARSEC_DTD_MAX_INSERTERS);
+        return NULL;
+    }
+    if( NULL == tp->context || !(PARSEC_CONTEXT_FLAG_CONTEXT_ACTIVE & tp->context->flags) ) {
+        parsec_warning("DTD inserters can only be attached to a taskpool of a started context\n");
+        return NULL;
+    }
+    if( NULL != parsec_my_execution_stream() ) {
+        parsec_warning("A PaRSEC thread cannot become a DTD inserter\n");
+        return NULL;
+    }
+
+    vp = tp->context->virtual_processes[0];
+    target_es = vp->execution_streams[index % vp->nb_cores];
+
+    inserter = (parsec_dtd_inserter_t *)calloc(1, sizeof(parsec_dtd_inserter_t));
+    inserter->es.th_id            = 0;  /* Pretend to be the master thread */
+    inserter->es.core_id          = target_es->core_id;
+    inserter->es.socket_id        = target_es->socket_id;
+    inserter->es.pthread_id       = pthread_self();
+    inserter->es.rand_seed        = (unsigned int)index;
+    inserter->es.scheduler_object = NULL;
+    inserter->es.next_task        = NULL;
+    inserter->es.virtual_process  = vp;
+    inserter->es.context_mempool  = target_es->context_mempool;
+    for( int pi = 0; pi <= MAX_PARAM_COUNT; pi++ )
+        inserter->es.datarepo_mempools[pi] = target_es->datarepo_mempools[pi];
+    inserter->es.dependencies_mempool = target_es->dependencies_mempool;
+
+    inserter->dtd_tp              = (parsec_dtd_taskpool_t *)tp;
+    inserter->target_es           = target_es;
+    inserter->index               = index;
+    inserter->task_id             = 0;
+    inserter->task_window_size    = 1;
+    inserter->local_task_inserted = 0;
+
+    parsec_set_my_execution_stream(&inserter->es);
+    PARSEC_TLS_SET_SPECIFIC(parsec_dtd_tls_inserter, inserter);
+    return inserter;
+}
+
+/* **************************************************************************** */
+/**
+ * Detaches the calling thread from the taskpool it was inserting into
+ *
+ * @param[in]   inserter
+ *                  The inserter returned by parsec_dtd_inserter_new() in
+ *                  this thread
+ *
+ * @ingroup     DTD_INTERFACE
+ */
+void
+parsec_dtd_inserter_free(parsec_dtd_inserter_t *inserter)
+{
+    assert(PARSEC_TLS_GET_SPECIFIC(parsec_dtd_tls_inserter) == inserter);
+    PARSEC_TLS_SET_SPECIFIC(parsec_dtd_tls_inserter, NULL);
+    parsec_set_my_execution_stream(NULL);
+    free(inserter->es.ready_scratch);
+    free(inserter);
+}
+
 /* **************************************************************************** */
 /**
  * This function only registers the taskpool with the different devices, and
@@ -1625,10 +1833,10 @@ dtd_release_dep_fct(parsec_execution_stream_t *es,
                                  current_task->super.task_class->nb_flows, current_task->flow_count);
 #endif
 
+            /* The ring is sorted by priority once, when scheduled */
             arg->ready_lists[dst_vpid] = (parsec_task_t *)
-                    parsec_list_item_ring_push_sorted((parsec_list_item_t *)arg->ready_lists[dst_vpid],
-                                                      &current_task->super.super,
-                                                      parsec_execution_context_priority_comparator);
+                    parsec_list_item_ring_push_head((parsec_list_item_t *)arg->ready_lists[dst_vpid],
+                                                    &current_task->super.super);
             return PARSEC_ITERATE_CONTINUE; /* Returns the status of the task being activated */
         } else {
             return PARSEC_ITERATE_STOP;
@@ -2444,27 +2652,11 @@ parsec_dtd_task_class_release(parsec_taskpool_t *tp, parsec_task_class_t *tc)
 }
 
 /* **************************************************************************** */
-/**
- * This function sets the flows in master-structure as we discover them
- *
- * @param[in,out]   __tp
- *                      DTD taskpool
- * @param[in]       this_task
- *                      Task to point to correct master-structure
- * @param[in]       tile_op_type
- *                      The operation type of the task on the flow
- *                      we are setting here
- * @param[in]       flow_index
- *                      The index of the flow we are setting
- *
- * @ingroup         DTD_INTERFACE_INTERNAL
- */
-void
-parsec_dtd_set_flow_in_function(parsec_dtd_taskpool_t *dtd_tp,
-                                parsec_dtd_task_t *this_task, int tile_op_type,
-                                int flow_index)
+/* Sets the flow of index flow_index of a task class */
+static void
+__parsec_dtd_set_flow_of_task_class(parsec_task_class_t *tc, int tile_op_type,
+                                    int flow_index)
 {
-    (void)dtd_tp;
     parsec_flow_t *flow = (parsec_flow_t *)calloc(1, sizeof(parsec_flow_t));
     flow->name = "Random";
     flow->sym_type = 0;
@@ -2488,12 +2680,38 @@ parsec_dtd_set_flow_in_function(parsec_dtd_taskpool_t *dtd_tp,
         flow->flow_flags = PARSEC_FLOW_ACCESS_RW;
     }
 
-    parsec_flow_t **in = (parsec_flow_t **)&(this_task->super.task_class->in[flow_index]);
+    parsec_flow_t **in = (parsec_flow_t **)&(tc->in[flow_index]);
     *in = flow;
-    parsec_flow_t **out = (parsec_flow_t **)&(this_task->super.task_class->out[flow_index]);
+    parsec_flow_t **out = (parsec_flow_t **)&(tc->out[flow_index]);
     *out = flow;
 }
 
+/* **************************************************************************** */
+/**
+ * This function sets the flows in master-structure as we discover them
+ *
+ * @param[in,out]   __tp
+ *                      DTD taskpool
+ * @param[in]       this_task
+ *                      Task to point to correct master-structure
+ * @param[in]       tile_op_type
+ *                      The operation type of the task on the flow
+ *                      we are setting here
+ * @param[in]       flow_index
+ *                      The index of the flow we are setting
+ *
+ * @ingroup         DTD_INTERFACE_INTERNAL
+ */
+void
+parsec_dtd_set_flow_in_function(parsec_dtd_taskpool_t *dtd_tp,
+                                parsec_dtd_task_t *this_task, int tile_op_type,
+                                int flow_index)
+{
+    (void)dtd_tp;
+    __parsec_dtd_set_flow_of_task_class((parsec_task_class_t *)this_task->super.task_class,
+                                        tile_op_type, flow_index);
+}
+
 /* **************************************************************************** */
 /**
  * This function sets the parent of a task
@@ -2589,7 +2807,9 @@ parsec_dtd_set_descendant(parsec_dtd_task_t *parent_task, uint8_t parent_flow_in
             }
         } else {
             if( !(flow->flags & TASK_INSERTED)) {
-                assert(dep->from == real_parent_task->rank);
+                /* the activation might have been forwarded by another receiver,
+                 * but it always carries the rank of the task */
+                assert((int)dep->msg.root == real_parent_task->rank);
                 flow->flags |= TASK_INSERTED;
                 parsec_dtd_untrack_remote_dep(tp, key);
 #if defined(PARSEC_PROF_TRACE)
@@ -2611,10 +2831,10 @@ parsec_dtd_set_descendant(parsec_dtd_task_t *parent_task, uint8_t parent_flow_in
  * Create and initialize a dtd task
  *
  */
-parsec_dtd_task_t *
-parsec_dtd_create_and_initialize_task(parsec_dtd_taskpool_t *dtd_tp,
-                                      parsec_task_class_t *tc,
-                                      int rank)
+static parsec_dtd_task_t *
+__parsec_dtd_create_and_initialize_task(parsec_dtd_taskpool_t *dtd_tp,
+                                        parsec_task_class_t *tc,
+                                        int rank, int key)
 {
     int i;
     parsec_dtd_task_t *this_task;
@@ -2636,7 +2856,7 @@ parsec_dtd_create_and_initialize_task(parsec_dtd_taskpool_t *dtd_tp,
     PARSEC_OBJ_CONSTRUCT(&this_task->super, parsec_task_t);
     this_task->orig_task = NULL;
     this_task->super.taskpool = (parsec_taskpool_t *)dtd_tp;
-    this_task->ht_item.key = (parsec_key_t)(uintptr_t)(dtd_tp->task_id++);
+    this_task->ht_item.key = (parsec_key_t)(uintptr_t)key;
     /* this is needed for grapher to work properly */
     this_task->super.locals[0].value = (int)(uintptr_t)this_task->ht_item.key;
     assert((uintptr_t)this_task->super.locals[0].value == (uintptr_t)this_task->ht_item.key);
@@ -2674,6 +2894,14 @@ parsec_dtd_create_and_initialize_task(parsec_dtd_taskpool_t *dtd_tp,
     return this_task;
 }
 
+parsec_dtd_task_t *
+parsec_dtd_create_and_initialize_task(parsec_dtd_taskpool_t *dtd_tp,
+                                      parsec_task_class_t *tc,
+                                      int rank)
+{
+    return __parsec_dtd_create_and_initialize_task(dtd_tp, tc, rank, parsec_dtd_next_task_id(dtd_tp));
+}
+
 /* **************************************************************************** */
 /**
  * Function to set parameters of a dtd task
@@ -2748,7 +2976,7 @@ fake_first_out_body(parsec_execution_stream_t *es, parsec_task_t *this_task)
 
 int
 parsec_dtd_schedule_task_if_ready(int satisfied_flow, parsec_dtd_task_t *this_task,
-                                  parsec_dtd_taskpool_t *dtd_tp, int *vpid)
+                                  parsec_dtd_taskpool_t *dtd_tp)
 {
     /* Building list of initial ready task */
     if( satisfied_flow == parsec_atomic_fetch_sub_int32(&this_task->flow_count, satisfied_flow)) {
@@ -2757,29 +2985,357 @@ parsec_dtd_schedule_task_if_ready(int satisfied_flow, parsec_dtd_task_t *this_ta
                              "%d\n-----\n", this_task->super.task_class->name, this_task->ht_item.key,
                              this_task->super.task_class->nb_flows, this_task->flow_count);
 
+        parsec_dtd_inserter_t *inserter = parsec_dtd_my_inserter(dtd_tp);
         PARSEC_LIST_ITEM_SINGLETON(this_task);
-        __parsec_schedule(parsec_my_execution_stream(), (parsec_task_t *)this_task, 0);
-        *vpid = (*vpid + 1) % dtd_tp->super.context->nb_vp;
+        /* An inserter has no scheduler queues, it hands its tasks to a worker */
+        __parsec_schedule(NULL == inserter ? parsec_my_execution_stream() : inserter->target_es,
+                          (parsec_task_t *)this_task, 0);
         return 1; /* Indicating local task was ready */
     }
     return 0;
 }
 
+void
+parsec_dtd_count_local_task(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task)
+{
+    parsec_dtd_inserter_t *inserter = parsec_dtd_my_inserter(dtd_tp);
+    if( NULL == inserter ) {
+        dtd_tp->local_task_inserted++;
+        dtd_tp->task_bytes += ((parsec_dtd_task_class_t *)this_task->super.task_class)->context_mempool.elt_size;
+    } else {
+        inserter->local_task_inserted++;
+    }
+}
+
+/* An inserter cannot execute tasks, it waits for the workers to bring the
+ * number of pending tasks down to the threshold */
+static void
+parsec_dtd_inserter_wait(parsec_dtd_inserter_t *inserter, int task_threshold)
+{
+    struct timespec rqtp = { .tv_sec = 0 };
+    uint64_t misses_in_a_row = 1;
+
+    while( inserter->dtd_tp->super.nb_tasks > task_threshold ) {
+        rqtp.tv_nsec = parsec_exponential_backoff(&inserter->es, misses_in_a_row++);
+        nanosleep(&rqtp, NULL);
+    }
+}
+
+/* **************************************************************************** */
+/**
+ * Adaptive window: each time the main thread fills its window, it chooses
+ * the size of the next ones from what the runtime reports.
+ *  - Execution streams parked while the window is full, or fewer pending
+ *    tasks than the threshold when the window fills up, mean that the
+ *    workers wait for tasks the window has not discovered yet: the window
+ *    doubles, up to dtd_window_max. The backlog tells this also when the
+ *    execution streams never park (runtime_idle_spin < 0).
+ *  - If the scheduler had a task ready each time the main thread looked
+ *    for one during its previous wait, the window holds more tasks than
+ *    needed to keep the workers busy: it shrinks by a quarter, not below
+ *    dtd_window_size.
+ *  - The window is capped so that its tasks fit in dtd_memory_limit bytes,
+ *    using the average size of the tasks inserted so far.
+ * The threshold keeps the ratio of dtd_threshold_size to dtd_window_size.
+ *
+ * @return the threshold the main thread waits for
+ *
+ * @ingroup     DTD_INTERFACE_INTERNAL
+ */
+static int
+parsec_dtd_adapt_window(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_window_info_t *info)
+{
+    int64_t window = dtd_tp->task_window_cap, threshold;
+    int64_t task_bytes = 0;
+
+    if( 0 < dtd_tp->local_task_inserted ) {
+        task_bytes = (int64_t)(dtd_tp->task_bytes / dtd_tp->local_task_inserted);
+    }
+    info->pending = dtd_tp->super.nb_tasks;
+    info->idle = dtd_tp->super.context->idle.nb_waiters;
+    info->found_permil = (0 == dtd_tp->wait_selects) ? -1 :
+                         (int32_t)((1000 * (uint64_t)dtd_tp->wait_found) / dtd_tp->wait_selects);
+    info->decision = PARSEC_DTD_WINDOW_KEEP;
+
+    if( 0 < info->idle || info->pending <= dtd_tp->task_threshold_size ) {
+        if( window < parsec_dtd_window_max ) {
+            window = (2 * window < parsec_dtd_window_max) ? 2 * window : parsec_dtd_window_max;
+            info->decision = PARSEC_DTD_WINDOW_GROW;
+        }
+    } else if( 0 < dtd_tp->wait_selects && dtd_tp->wait_found == dtd_tp->wait_selects ) {
+        if( window > parsec_dtd_window_size ) {
+            window -= window / 4;
+            if( window < parsec_dtd_window_size ) window = parsec_dtd_window_size;
+            info->decision = PARSEC_DTD_WINDOW_SHRINK;
+        }
+    }
+    if( 0 < parsec_dtd_memory_limit && 0 < task_bytes &&
+        (size_t)(window * task_bytes) > parsec_dtd_memory_limit ) {
+        window = (int64_t)(parsec_dtd_memory_limit / task_bytes);
+        if( window < 2 ) window = 2;
+        info->decision = PARSEC_DTD_WINDOW_MEMORY;
+    }
+    threshold = window * parsec_dtd_threshold_size / parsec_dtd_window_size;
+
+    dtd_tp->task_window_cap = (int32_t)window;
+    dtd_tp->task_window_size = (int)window;
+    dtd_tp->task_threshold_size = (int32_t)(threshold < window ? threshold : window - 1);
+    info->window = dtd_tp->task_window_cap;
+    info->threshold = dtd_tp->task_threshold_size;
+    info->task_bytes = task_bytes;
+    if( PARSEC_DTD_WINDOW_GROW == info->decision ) {
+        dtd_tp->window_grows++;
+    } else if( PARSEC_DTD_WINDOW_SHRINK == info->decision ) {
+        dtd_tp->window_shrinks++;
+    }
+
+    return dtd_tp->task_threshold_size;
+}
+
 int
 parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int task_threshold)
 {
-    if((dtd_tp->local_task_inserted % dtd_tp->task_window_size) == 0 ) {
-        if( dtd_tp->task_window_size < parsec_dtd_window_size ) {
-            dtd_tp->task_window_size *= 2;
+    parsec_dtd_inserter_t *inserter = parsec_dtd_my_inserter(dtd_tp);
+    uint32_t local_task_inserted = dtd_tp->local_task_inserted;
+    int *task_window_size = &dtd_tp->task_window_size;
+    /* Only the adaptive window of the main thread departs from dtd_window_size */
+    int task_window_cap = parsec_dtd_adaptive_window ? dtd_tp->task_window_cap : parsec_dtd_window_size;
+
+    if( NULL != inserter ) {
+        local_task_inserted = inserter->local_task_inserted;
+        task_window_size = &inserter->task_window_size;
+        task_window_cap = parsec_dtd_window_size;
+    }
+    if((local_task_inserted % *task_window_size) == 0 ) {
+        if( *task_window_size < task_window_cap ) {
+            *task_window_size *= 2;
         } else {
-            parsec_execute_and_come_back(&dtd_tp->super,
-                                         task_threshold);
+            if( NULL == inserter ) {
+                if( parsec_dtd_adaptive_window ) {
+                    parsec_dtd_window_info_t info;
+                    task_threshold = parsec_dtd_adapt_window(dtd_tp, &info);
+#if defined(PARSEC_PROF_TRACE)
+                    parsec_profiling_ts_trace_flags_info_fn(window_trace_keyin, 0, dtd_tp->super.taskpool_id,
+                                                            memcpy, &info, PARSEC_PROFILING_EVENT_HAS_INFO);
+#endif  /* defined(PARSEC_PROF_TRACE) */
+                    PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
+                                         "DTD window %d threshold %d (decision %d, %d pending, %d idle, %d/1000 found)\n",
+                                         info.window, info.threshold, info.decision, info.pending, info.idle,
+                                         info.found_permil);
+                }
+                dtd_tp->wait_selects = dtd_tp->wait_found = 0;
+                __parsec_execute_and_come_back(&dtd_tp->super, task_threshold,
+                                               &dtd_tp->wait_selects, &dtd_tp->wait_found);
+#if defined(PARSEC_PROF_TRACE)
+                if( parsec_dtd_adaptive_window )
+                    parsec_profiling_ts_trace_flags_info_fn(window_trace_keyout, 0, dtd_tp->super.taskpool_id,
+                                                            NULL, NULL, 0);
+#endif  /* defined(PARSEC_PROF_TRACE) */
+            } else {
+                parsec_dtd_inserter_wait(inserter, task_threshold);
+            }
             return 1; /* Indicating we blocked */
         }
     }
     return 0;
 }
 
+/* **************************************************************************** */
+/**
+ * Instantiate the last remote writer of a tile recorded by the sliced
+ * insertion, and make it the last user and last writer of the tile, in the
+ * same state as if it had been inserted normally. Must be called with the
+ * last_user lock of the tile held, before looking at the users of the tile.
+ *
+ * @param[in,out]   dtd_tp
+ *                      DTD taskpool
+ * @param[in,out]   tile
+ *                      The tile
+ *
+ * @ingroup         DTD_INTERFACE_INTERNAL
+ */
+void
+parsec_dtd_tile_instantiate_remote_writer(parsec_dtd_taskpool_t *dtd_tp,
+                                          parsec_dtd_tile_t *tile)
+{
+    parsec_dtd_tile_remote_writer_t *writer = &tile->last_remote_writer;
+    parsec_dtd_flow_info_t *flow;
+    parsec_dtd_task_t *task;
+    int i;
+
+    if( NULL == writer->tc ) {
+        return;
+    }
+
+    task = __parsec_dtd_create_and_initialize_task(dtd_tp, writer->tc, writer->rank, writer->key);
+    task->super.priority = writer->priority;
+    for( i = 0; i < writer->tc->nb_flows; i++ ) {
+        task->super.data[i].data_in = NULL;
+        task->super.data[i].data_out = NULL;
+        task->super.data[i].source_repo_entry = NULL;
+        task->super.data[i].source_repo = NULL;
+    }
+    flow = FLOW_OF(task, writer->flow_index);
+    flow->tile = tile;
+    flow->flags = 0;
+    flow->arena_index = (writer->op_type & PARSEC_GET_REGION_INFO);
+    flow->op_type = writer->op_type;
+
+    /* the reference the tile holds on its remote last writer */
+    parsec_dtd_remote_task_retain(task);
+
+    tile->last_writer.task = task;
+    tile->last_writer.flow_index = writer->flow_index;
+    tile->last_writer.op_type = writer->op_type;
+    tile->last_writer.alive = TASK_IS_ALIVE;
+
+    tile->last_user.task = task;
+    tile->last_user.flow_index = writer->flow_index;
+    tile->last_user.op_type = writer->op_type;
+    tile->last_user.alive = TASK_IS_ALIVE;
+
+    writer->tc = NULL;
+}
+
+/* **************************************************************************** */
+/**
+ * Sliced insertion: if a remote task does not access any local data, and
+ * none of the tiles it accesses has a local last user or last writer, no
+ * local task can depend on it, nor can it depend on a local task. Such a
+ * task is not created: its key is consumed, to stay consistent with the
+ * other ranks, and it is recorded as the last remote writer of the tiles it
+ * writes, releasing the previous remote writer like a normal insertion
+ * would. Readers of remote data written remotely are not chained in any
+ * case, they leave no trace.
+ *
+ * @return 1 if the task was handled here, 0 if it must be inserted normally
+ *
+ * @ingroup         DTD_INTERFACE_INTERNAL
+ */
+static int
+parsec_dtd_skip_remote_task(parsec_dtd_taskpool_t *dtd_tp, parsec_task_class_t *tc,
+                            int rank, int32_t priority, int nb_params,
+                            const parsec_dtd_param_t *params, parsec_dtd_tile_t **tiles)
+{
+    int my_rank = dtd_tp->super.context->my_rank;
+    parsec_dtd_task_t *last_writer;
+    parsec_dtd_tile_t *tile;
+    int i, op_type, key, flow_index, local_user;
+
+    if( rank == my_rank ) {
+        return 0;
+    }
+
+    /* With several inserters the users of a tile can change under us, read
+     * them under the tile lock as parsec_dtd_set_descendant does. Inserters
+     * of a distributed run do not share data, so no local task can become
+     * the last user of these tiles before they are updated below. */
+    for( i = 0; i < nb_params; i++ ) {
+        op_type = params[i].op & PARSEC_GET_OP_TYPE;
+        if( (PARSEC_INPUT != op_type && PARSEC_INOUT != op_type && PARSEC_OUTPUT != op_type) ||
+            NULL == tiles[i] || (params[i].op & PARSEC_DONT_TRACK) ) {
+            continue;
+        }
+        tile = tiles[i];
+        if( tile->rank == my_rank ) {
+            return 0;
+        }
+        parsec_dtd_last_user_lock(&(tile->last_user));
+        local_user = (NULL != tile->last_user.task && parsec_dtd_task_is_local(tile->last_user.task)) ||
+                     (NULL != tile->last_writer.task && parsec_dtd_task_is_local(tile->last_writer.task));
+        parsec_dtd_last_user_unlock(&(tile->last_user));
+        if( local_user ) {
+            return 0;
+        }
+    }
+
+    key = parsec_dtd_next_task_id(dtd_tp);
+
+    if( 0 == dtd_tp->flow_set_flag[tc->task_class_id] ) {
+        parsec_atomic_lock(&dtd_tp->task_class_lock);
+        if( 0 == dtd_tp->flow_set_flag[tc->task_class_id] ) {
+            for( i = 0, flow_index = 0; i < nb_params; i++ ) {
+                op_type = params[i].op & PARSEC_GET_OP_TYPE;
+                if( PARSEC_INPUT == op_type || PARSEC_INOUT == op_type || PARSEC_OUTPUT == op_type ) {
+                    __parsec_dtd_set_flow_of_task_class(tc, params[i].op, flow_index++);
+                }
+            }
+            parsec_mfence();
+            dtd_tp->flow_set_flag[tc->task_class_id] = 1;
+        }
+        parsec_atomic_unlock(&dtd_tp->task_class_lock);
+    }
+
+    for( i = 0, flow_index = -1; i < nb_params; i++ ) {
+        op_type = params[i].op & PARSEC_GET_OP_TYPE;
+        if( PARSEC_INPUT != op_type && PARSEC_INOUT != op_type && PARSEC_OUTPUT != op_type ) {
+            continue;
+        }
+        flow_index++;
+        tile = tiles[i];
+        if( NULL == tile || (params[i].op & PARSEC_DONT_TRACK) ) {
+            continue;
+        }
+
+        if( tile->arena_index == -1 ) {
+            tile->arena_index = (params[i].op & PARSEC_GET_REGION_INFO);
+        }
+
+        parsec_dtd_last_user_lock(&(tile->last_user));
+        if( NULL == tile->last_user.task && NULL == tile->last_remote_writer.tc &&
+            (rank != tile->rank || PARSEC_INPUT == op_type) ) {
+            parsec_dtd_last_user_unlock(&(tile->last_user));
+
+            /* parentless, the owner of the data provides it */
+            parsec_dtd_insert_task(&dtd_tp->super,
+                                   &fake_first_out_body, 0, PARSEC_DEV_CPU, "Fake_FIRST_OUT",
+                                   PASSED_BY_REF, tile,
+                                   PARSEC_INOUT | (params[i].op & PARSEC_GET_REGION_INFO) | PARSEC_AFFINITY,
+                                   PARSEC_DTD_ARG_END);
+
+            parsec_dtd_last_user_lock(&(tile->last_user));
+        }
+
+        if( PARSEC_INPUT == op_type ) {
+            parsec_dtd_last_user_unlock(&(tile->last_user));
+            continue;
+        }
+
+        last_writer = tile->last_writer.task;
+        assert(NULL == last_writer || !parsec_dtd_task_is_local(last_writer));
+        assert(NULL == tile->last_user.task || !parsec_dtd_task_is_local(tile->last_user.task));
+        tile->last_user.task = NULL;
+        tile->last_user.flow_index = -1;
+        tile->last_user.op_type = -1;
+        tile->last_user.alive = TASK_IS_NOT_ALIVE;
+        tile->last_writer.task = NULL;
+        tile->last_writer.flow_index = -1;
+        tile->last_writer.op_type = -1;
+        tile->last_writer.alive = TASK_IS_NOT_ALIVE;
+
+        tile->last_remote_writer.tc = tc;
+        tile->last_remote_writer.key = key;
+        tile->last_remote_writer.rank = rank;
+        tile->last_remote_writer.priority = priority;
+        tile->last_remote_writer.op_type = params[i].op;
+        tile->last_remote_writer.flow_index = flow_index;
+        parsec_dtd_last_user_unlock(&(tile->last_user));
+
+        if( NULL != last_writer ) {
+            /* releasing last writer every time writer is changed */
+            parsec_dtd_remote_task_release(last_writer);
+        }
+    }
+
+#if defined(PARSEC_PROF_TRACE)
+    if( parsec_dtd_profile_verbose )
+        parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyout, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+
+    parsec_dtd_block_if_threshold_reached(dtd_tp, parsec_dtd_threshold_size);
+    return 1;
+}
+
 /* **************************************************************************** */
 /**
  * Function to insert dtd task in PaRSEC
@@ -2799,7 +3355,6 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
     parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)this_task->super.taskpool;
 
     int flow_index, satisfied_flow = 0, tile_op_type = 0, put_in_chain = 1;
-    static int vpid = 0;
     parsec_dtd_tile_t *tile = NULL;
 
     /* Retaining every remote_task */
@@ -2807,6 +3362,21 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
         parsec_dtd_remote_task_retain(this_task);
     }
 
+    if( 0 == dtd_tp->flow_set_flag[tc->task_class_id] ) {
+        /* Other threads may be inserting the first tasks of this class */
+        parsec_atomic_lock(&dtd_tp->task_class_lock);
+        if( 0 == dtd_tp->flow_set_flag[tc->task_class_id] ) {
+            for( flow_index = 0; flow_index < tc->nb_flows; flow_index++ ) {
+                /* Setting flow in function structure */
+                parsec_dtd_set_flow_in_function(dtd_tp, this_task, (FLOW_OF(this_task, flow_index))->op_type,
+                                                flow_index);
+            }
+            parsec_mfence();
+            dtd_tp->flow_set_flag[tc->task_class_id] = 1;
+        }
+        parsec_atomic_unlock(&dtd_tp->task_class_lock);
+    }
+
     /* In the next segment we resolve the dependencies of each flow */
     for( flow_index = 0, tile = NULL, tile_op_type = 0; flow_index < tc->nb_flows; flow_index++ ) {
         parsec_dtd_tile_user_t last_user, last_writer;
@@ -2814,11 +3384,6 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
         tile_op_type = (FLOW_OF(this_task, flow_index))->op_type;
         put_in_chain = 1;
 
-        if( 0 == dtd_tp->flow_set_flag[tc->task_class_id] ) {
-            /* Setting flow in function structure */
-            parsec_dtd_set_flow_in_function(dtd_tp, this_task, tile_op_type, flow_index);
-        }
-
         if( NULL == tile ) {
             satisfied_flow++;
             continue;
@@ -2838,6 +3403,7 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
 
         /* Locking the last_user of the tile */
         parsec_dtd_last_user_lock(&(tile->last_user));
+        parsec_dtd_tile_instantiate_remote_writer(dtd_tp, tile);
 
         READ_FROM_TILE(last_user, tile->last_user);
         READ_FROM_TILE(last_writer, tile->last_writer);
@@ -2855,6 +3421,7 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
                                    PARSEC_DTD_ARG_END);
 
             parsec_dtd_last_user_lock(&(tile->last_user));
+            parsec_dtd_tile_instantiate_remote_writer(dtd_tp, tile);
 
             READ_FROM_TILE(last_user, tile->last_user);
             READ_FROM_TILE(last_writer, tile->last_writer);
@@ -3094,11 +3661,9 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
         }
     }
 
-    dtd_tp->flow_set_flag[tc->task_class_id] = 1;
-
     if( parsec_dtd_task_is_local(this_task) ) {/* Task is local */
         dtd_tp->super.tdm.module->taskpool_addto_nb_tasks(&dtd_tp->super, 1);
-        dtd_tp->local_task_inserted++;
+        parsec_dtd_count_local_task(dtd_tp, this_task);
         PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
                              "Task generated -> %s %d rank %d\n", this_task->super.task_class->name,
                              this_task->ht_item.key, this_task->rank);
@@ -3119,17 +3684,40 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
 #endif
 
     if( parsec_dtd_task_is_local(this_task)) {
-        parsec_dtd_schedule_task_if_ready(satisfied_flow, this_task,
-                                          dtd_tp, &vpid);
+        parsec_dtd_schedule_task_if_ready(satisfied_flow, this_task, dtd_tp);
     }
 
     parsec_dtd_block_if_threshold_reached(dtd_tp, parsec_dtd_threshold_size);
 }
 
+/* Final rank of a task, from the rank given by its affinity (-1 if none)
+ * and the number of data it writes */
+static inline int
+parsec_dtd_resolve_rank(parsec_dtd_taskpool_t *dtd_tp, int rank, int write_flow_count)
+{
+#if defined(DISTRIBUTED)
+    /* Safeguard: check that the rank has been set by affinity if it is needed */
+    if( dtd_tp->super.context->nb_nodes > 1 ) {
+        if((-1 == rank) && (write_flow_count > 1)) {
+            parsec_fatal("You inserted a task without indicating where the task should be executed (using\n"
+                         "PARSEC_AFFINITY flag). This will result in executing this task on all nodes and the outcome\n"
+                         "might be not be what you want. So we are exiting for now. Please see the usage of\n"
+                         "PARSEC_AFFINITY flag.\n");
+        } else if( rank == -1 && write_flow_count == 1 ) {
+            /* we have tasks with no real data as parameter so we are safe to execute it in each process */
+            rank = dtd_tp->super.context->my_rank;
+        }
+        return rank;
+    }
+#endif
+    (void)dtd_tp; (void)rank; (void)write_flow_count;
+    return 0;
+}
+
 static inline parsec_task_t *
 __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
                                   void *fpointer, int32_t priority, uint8_t device_type,
-                                  const char *name_of_kernel, parsec_task_class_t *tc, va_list args)
+                                  const char *name_of_kernel, parsec_task_class_t *tc, int sliced, va_list args)
 {
     parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
     int rank = -1;
@@ -3139,6 +3727,7 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
     parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t*)tc;
     int nb_params = 0;
     parsec_dtd_param_t params[PARSEC_DTD_MAX_PARAMS];
+    parsec_dtd_tile_t *tiles[PARSEC_DTD_MAX_PARAMS];
 
     if( dtd_tp == NULL) {
         parsec_fatal("You need to pass a correct parsec taskpool in order to insert task. "
@@ -3227,28 +3816,12 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
             params[nb_params].profile_info = dtd_tc->params[nb_params].profile_info;
         }
         params[nb_params].size = arg_size;
+        tiles[nb_params] = (parsec_dtd_tile_t *)tile;
         nb_params++;
     }
     va_end(arg_chk);
 
-#if defined(DISTRIBUTED)
-    /* Safeguard: check that the rank has been set by affinity if it is needed */
-    if( tp->context->nb_nodes > 1 ) {
-        if((-1 == rank) && (write_flow_count > 1)) {
-            parsec_fatal("You inserted a task without indicating where the task should be executed (using\n"
-                         "PARSEC_AFFINITY flag). This will result in executing this task on all nodes and the outcome\n"
-                         "might be not be what you want. So we are exiting for now. Please see the usage of\n"
-                         "PARSEC_AFFINITY flag.\n");
-        } else if( rank == -1 && write_flow_count == 1 ) {
-            /* we have tasks with no real data as parameter so we are safe to execute it in each process */
-            rank = tp->context->my_rank;
-        }
-    } else {
-        rank = 0;
-    }
-#else
-    rank = 0;
-#endif
+    rank = parsec_dtd_resolve_rank(dtd_tp, rank, write_flow_count);
 
     if(NULL != fpointer) {
         uint64_t fkey = (uint64_t)(uintptr_t)fpointer + flow_count_of_tc;
@@ -3257,29 +3830,39 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
         tc = (parsec_task_class_t *)parsec_dtd_find_task_class(dtd_tp, fkey);
 
         if( NULL == tc ) {
-            dtd_tc = parsec_dtd_create_task_classv(name_of_kernel, nb_params, params);
-            tc = &dtd_tc->super;
-
-            __parsec_chore_t **incarnations = (__parsec_chore_t **)&tc->incarnations;
-            (*incarnations)[0].type = device_type;
-            if( device_type == PARSEC_DEV_CUDA ) {
-                /* Special case for CUDA: we need an intermediate */
-                (*incarnations)[0].hook = parsec_dtd_gpu_task_submit;
-                dtd_tc->gpu_func_ptr = (parsec_advance_task_function_t)fpointer;
-            }
-            else {
-                /* Default case: the user-provided function is directly the hook to call */
-                (*incarnations)[0].hook = fpointer; // We can directly call the CPU hook
-                dtd_tc->cpu_func_ptr = fpointer;
-            }
-            (*incarnations)[1].type = PARSEC_DEV_NONE;
+            /* Another thread may be creating the same task class */
+            parsec_atomic_lock(&dtd_tp->task_class_lock);
+            tc = (parsec_task_class_t *)parsec_dtd_find_task_class(dtd_tp, fkey);
+            if( NULL == tc ) {
+                dtd_tc = parsec_dtd_create_task_classv(name_of_kernel, nb_params, params);
+                tc = &dtd_tc->super;
+
+                __parsec_chore_t **incarnations = (__parsec_chore_t **)&tc->incarnations;
+                (*incarnations)[0].type = device_type;
+                if( device_type == PARSEC_DEV_CUDA ) {
+                    /* Special case for CUDA: we need an intermediate */
+                    (*incarnations)[0].hook = parsec_dtd_gpu_task_submit;
+                    dtd_tc->gpu_func_ptr = (parsec_advance_task_function_t)fpointer;
+                }
+                else {
+                    /* Default case: the user-provided function is directly the hook to call */
+                    (*incarnations)[0].hook = fpointer; // We can directly call the CPU hook
+                    dtd_tc->cpu_func_ptr = fpointer;
+                }
+                (*incarnations)[1].type = PARSEC_DEV_NONE;
 
-            /* Bookkeeping of the task class */
-            parsec_dtd_register_task_class(&dtd_tp->super, fkey, tc);
-            parsec_dtd_insert_task_class(dtd_tp, dtd_tc);
+                /* Bookkeeping of the task class */
+                parsec_dtd_register_task_class(&dtd_tp->super, fkey, tc);
+                parsec_dtd_insert_task_class(dtd_tp, dtd_tc);
+            }
+            parsec_atomic_unlock(&dtd_tp->task_class_lock);
         }
     }
 
+    if( sliced && parsec_dtd_skip_remote_task(dtd_tp, tc, rank, priority, nb_params, params, tiles) ) {
+        return NULL;
+    }
+
     parsec_dtd_task_t *this_task = parsec_dtd_create_and_initialize_task(dtd_tp, tc, rank);
 
     this_task->super.priority = priority;
@@ -3401,12 +3984,14 @@ parsec_dtd_insert_task(parsec_taskpool_t *tp,
     va_start(args, name_of_kernel);
 
     parsec_task_t *this_task = __parsec_dtd_taskpool_create_task(tp, fpointer, priority, device_type,
-                                                                 name_of_kernel, NULL, args);
+                                                                 name_of_kernel, NULL,
+                                                                 parsec_dtd_sliced_insertion, args);
     va_end(args);
 
+    /* With sliced insertion, tasks that do not concern this rank are not created */
     if( NULL != this_task ) {
         parsec_insert_dtd_task(this_task);
-    } else {
+    } else if( !parsec_dtd_sliced_insertion ) {
         parsec_fatal("Unknow Error! Could not create task\n");
     }
 }
@@ -3421,16 +4006,238 @@ parsec_dtd_insert_task_with_task_class(parsec_taskpool_t *tp,
     va_start(args, device_type);
 
     parsec_task_t *this_task = __parsec_dtd_taskpool_create_task(tp, NULL, priority, device_type,
-                                                                 tc->name, tc, args);
+                                                                 tc->name, tc,
+                                                                 parsec_dtd_sliced_insertion, args);
     va_end(args);
 
     if( NULL != this_task ) {
         parsec_insert_dtd_task(this_task);
-    } else {
+    } else if( !parsec_dtd_sliced_insertion ) {
         parsec_fatal("Unknown Error! Could not create task\n");
     }
 }
 
+/* **************************************************************************** */
+/**
+ * Compiles the parameters of a task class into a signature, to insert its
+ * tasks from packed arguments: each flow gets the next slot in the array
+ * of tiles of a task, each value the next offset in its packed arguments.
+ *
+ * @ingroup         DTD_INTERFACE
+ */
+parsec_dtd_task_signature_t *
+parsec_dtd_task_signature_new(parsec_taskpool_t *tp,
+                              parsec_task_class_t *tc,
+                              int device_type)
+{
+    parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t *)tc;
+    parsec_dtd_task_signature_t *sig;
+    parsec_dtd_packed_run_t *run = NULL;
+    int i, op_type, size, value_offset = 0;
+
+    if( PARSEC_TASKPOOL_TYPE_DTD != tp->taskpool_type ) {
+        parsec_warning("Calling parsec_dtd_task_signature_new on a taskpool that is not DTD\n");
+        return NULL;
+    }
+
+    sig = (parsec_dtd_task_signature_t *)calloc(1, sizeof(parsec_dtd_task_signature_t));
+    sig->dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    sig->tc = tc;
+    sig->nb_params = dtd_tc->count_of_params;
+    sig->affinity = -1;
+
+    /* We take only the chores that are defined and that allowed by the user */
+    for( i = 0; NULL != tc->incarnations[i].hook; i++ ) {
+        if( tc->incarnations[i].type & device_type ) {
+            sig->chore_mask |= (1 << i);
+        }
+    }
+    if( 0 == sig->chore_mask ) {
+        parsec_warning("Task class '%s' has no chore for the devices 0x%x\n", tc->name, device_type);
+        free(sig);
+        return NULL;
+    }
+
+    for( i = 0; i < sig->nb_params; i++ ) {
+        op_type = dtd_tc->params[i].op & PARSEC_GET_OP_TYPE;
+        size = (int)dtd_tc->params[i].size;
+        if( PARSEC_INPUT == op_type || PARSEC_INOUT == op_type || PARSEC_OUTPUT == op_type ) {
+            if( PARSEC_INPUT != op_type && !(dtd_tc->params[i].op & PARSEC_DONT_TRACK) ) {
+                sig->tracked_writes |= (uint64_t)1 << sig->nb_tiles;
+            }
+            sig->params[i].source = sig->nb_tiles++;
+            sig->params[i].value_offset = -1;
+        } else if( PARSEC_VALUE == op_type ) {
+            sig->params[i].source = (int)sig->args_size;
+            sig->params[i].value_offset = value_offset;
+            /* Values following each other in both layouts are copied at once */
+            if( NULL != run &&
+                run->source + run->size == (int)sig->args_size &&
+                run->value_offset + run->size == value_offset ) {
+                run->size += size;
+            } else {
+                run = &sig->runs[sig->nb_runs++];
+                run->source = (int)sig->args_size;
+                run->value_offset = value_offset;
+                run->size = size;
+            }
+            sig->args_size += size;
+            value_offset += size;
+        } else if( PARSEC_SCRATCH == op_type ) {
+            sig->params[i].source = -1;
+            sig->params[i].value_offset = value_offset;
+            value_offset += size;
+        } else {
+            parsec_warning("Parameter %d of task class '%s' is neither a flow, a value nor a scratch,"
+                           " its tasks cannot be inserted packed\n", i, tc->name);
+            free(sig);
+            return NULL;
+        }
+
+        if( (dtd_tc->params[i].op & PARSEC_AFFINITY) && PARSEC_SCRATCH != op_type ) {
+            if( -1 == sig->affinity ) {
+                sig->affinity = i;
+            } else {
+                parsec_warning("/!\\ Task class '%s' is already placed, only the first use of AFFINITY flag is effective,"
+                               " others are ignored /!\\\n", tc->name);
+            }
+        }
+    }
+
+    return sig;
+}
+
+void
+parsec_dtd_task_signature_free(parsec_dtd_task_signature_t *sig)
+{
+    free(sig);
+}
+
+int
+parsec_dtd_task_signature_nb_tiles(const parsec_dtd_task_signature_t *sig)
+{
+    return sig->nb_tiles;
+}
+
+size_t
+parsec_dtd_task_signature_args_size(const parsec_dtd_task_signature_t *sig)
+{
+    return sig->args_size;
+}
+
+/* **************************************************************************** */
+/**
+ * Inserts a batch of tasks described by a signature. This is the same
+ * sequence as __parsec_dtd_taskpool_create_task() followed by
+ * parsec_insert_dtd_task(), with the parsing of the arguments done once for
+ * all in the signature: the tiles are read from their slots and the values
+ * are copied in the value block of the task with a few memcpy.
+ *
+ * @ingroup         DTD_INTERFACE
+ */
+void
+parsec_dtd_insert_packed_tasks(parsec_taskpool_t *tp,
+                               const parsec_dtd_task_signature_t *sig,
+                               int nb, int priority,
+                               parsec_dtd_tile_t * const *tiles,
+                               const void *args, size_t args_stride)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t *)sig->tc;
+    parsec_dtd_tile_t *param_tiles[PARSEC_DTD_MAX_PARAMS];
+    const parsec_dtd_packed_param_t *aff;
+    const char *task_args = (const char *)args;
+    parsec_dtd_task_param_t *current_param;
+    parsec_dtd_task_t *this_task;
+    char *values;
+    int t, i, rank, write_flow_count, flow_index;
+
+    if( tp->context == NULL) {
+        parsec_fatal("Sorry! You can not insert task without enqueuing the taskpool to parsec_context"
+                     " first. Please make sure you call parsec_context_add_taskpool(parsec_context, taskpool) before"
+                     " you try inserting task in PaRSEC\n");
+    }
+    assert(sig->dtd_tp == dtd_tp);
+
+    for( t = 0; t < nb; t++, tiles += sig->nb_tiles, task_args += args_stride ) {
+#if defined(PARSEC_PROF_TRACE)
+        if( parsec_dtd_profile_verbose )
+            parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyin, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+
+        write_flow_count = 1;
+        for( i = 0; i < sig->nb_tiles; i++ ) {
+            if( (sig->tracked_writes & ((uint64_t)1 << i)) && NULL != tiles[i] ) {
+                write_flow_count++;
+            }
+        }
+
+        rank = -1;
+        if( -1 != sig->affinity ) {
+            aff = &sig->params[sig->affinity];
+            if( -1 == aff->value_offset ) {
+                if( NULL != tiles[aff->source] ) {
+                    rank = tiles[aff->source]->rank;
+                }
+            } else {
+                memcpy(&rank, task_args + aff->source, sizeof(int));
+                if( rank < 0 || rank >= dtd_tp->super.context->nb_nodes ) {
+                    parsec_warning("/!\\ Rank information passed to task is invalid,"
+                                   " placing task in rank 0 /!\\\n");
+                }
+            }
+        }
+        rank = parsec_dtd_resolve_rank(dtd_tp, rank, write_flow_count);
+
+        if( parsec_dtd_sliced_insertion ) {
+            for( i = 0; i < sig->nb_params; i++ ) {
+                param_tiles[i] = (-1 == sig->params[i].value_offset) ? tiles[sig->params[i].source] : NULL;
+            }
+            if( parsec_dtd_skip_remote_task(dtd_tp, sig->tc, rank, priority,
+                                            sig->nb_params, dtd_tc->params, param_tiles) ) {
+                continue;
+            }
+        }
+
+        this_task = parsec_dtd_create_and_initialize_task(dtd_tp, sig->tc, rank);
+        this_task->super.priority = priority;
+        this_task->super.chore_mask = sig->chore_mask;
+
+        flow_index = 0;
+        if( parsec_dtd_task_is_local(this_task) ) {
+            /* retaining the local task as many write flows as
+             * it has and one to indicate when we have executed the task */
+            (void)parsec_atomic_fetch_add_int32(&((parsec_object_t *)this_task)->obj_reference_count,
+                                                write_flow_count);
+
+            current_param = GET_HEAD_OF_PARAM_LIST(this_task);
+            values = GET_VALUE_BLOCK(current_param, sig->nb_params);
+            for( i = 0; i < sig->nb_runs; i++ ) {
+                memcpy(values + sig->runs[i].value_offset, task_args + sig->runs[i].source, sig->runs[i].size);
+            }
+            for( i = 0; i < sig->nb_params; i++, current_param++ ) {
+                current_param->arg_size = (int)dtd_tc->params[i].size;
+                current_param->op_type = dtd_tc->params[i].op;
+                if( -1 == sig->params[i].value_offset ) {
+                    parsec_dtd_set_params_of_task(this_task, tiles[sig->params[i].source], dtd_tc->params[i].op,
+                                                  &flow_index, NULL, NULL, PASSED_BY_REF);
+                } else {
+                    current_param->pointer_to_tile = values + sig->params[i].value_offset;
+                }
+            }
+        } else {
+            for( i = 0; i < sig->nb_params; i++ ) {
+                if( -1 == sig->params[i].value_offset ) {
+                    parsec_dtd_set_params_of_task(this_task, tiles[sig->params[i].source], dtd_tc->params[i].op,
+                                                  &flow_index, NULL, NULL, PASSED_BY_REF);
+                }
+            }
+        }
+
+        parsec_insert_dtd_task(&this_task->super);
+    }
+}
+
 parsec_task_t *
 parsec_dtd_create_task(parsec_taskpool_t *tp,
                        parsec_dtd_funcptr_t *fpointer, int priority,
@@ -3440,8 +4247,9 @@ parsec_dtd_create_task(parsec_taskpool_t *tp,
     va_list args;
     va_start(args, name_of_kernel);
 
+    /* The caller expects a task to insert: never skip it */
     parsec_task_t *this_task = __parsec_dtd_taskpool_create_task(tp, fpointer, priority, device_type,
-                                                                 name_of_kernel, NULL, args);
+                                                                 name_of_kernel, NULL, 0, args);
     va_end(args);
 
     return this_task;
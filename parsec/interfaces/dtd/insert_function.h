@@ -138,6 +138,27 @@ int parsec_dtd_destroy_arena_datatype(parsec_context_t *ctx, int id);
 extern int parsec_dtd_window_size;
 extern int parsec_dtd_threshold_size;
 
+/**
+ * When set (mca param dtd_sliced_insertion), the tasks that neither execute
+ * on this rank nor access any data owned by, or produced or consumed on,
+ * this rank are not instantiated during insertion: each rank only keeps
+ * track of the last remote writer of each tile. This makes the cost of the
+ * insertion mostly proportional to the number of tasks that concern the
+ * rank instead of the total number of tasks.
+ */
+extern int parsec_dtd_sliced_insertion;
+
+/**
+ * When set (mca param dtd_adaptive_window), the main thread resizes its
+ * window each time it fills it instead of always using
+ * parsec_dtd_window_size: it grows while execution streams are idle,
+ * shrinks back while the workers always find ready tasks, and stays under
+ * the memory given by the mca param dtd_memory_limit. The threshold follows
+ * the window. With profiling enabled each decision is saved as a dtd_window
+ * event, lasting as long as the main thread waits on the window.
+ */
+extern int parsec_dtd_adaptive_window;
+
 
 typedef struct parsec_dtd_tile_s         parsec_dtd_tile_t;
 typedef struct parsec_dtd_task_s         parsec_dtd_task_t;
@@ -373,6 +394,50 @@ parsec_dtd_get_taskpool(parsec_task_t *this_task);
 int
 parsec_dtd_dequeue_taskpool(parsec_taskpool_t *tp);
 
+/**
+ * Handle of a thread inserting tasks in a DTD taskpool concurrently with
+ * other threads.
+ */
+typedef struct parsec_dtd_inserter_s     parsec_dtd_inserter_t;
+
+/**
+ * Hard limit on the number of inserters of a taskpool
+ */
+#define PARSEC_DTD_MAX_INSERTERS 64
+
+/**
+ * This function attaches the calling thread to a DTD taskpool as its
+ * inserter number index (0 <= index < PARSEC_DTD_MAX_INSERTERS), after
+ * which the thread can insert tasks into tp concurrently with the main
+ * thread, the other inserters and the tasks. The calling thread must not be
+ * a PaRSEC thread, the taskpool must have been added to a started context,
+ * and an index can only be used by one thread at a time.
+ *
+ * Each inserter has its own sliding window (see parsec_dtd_window_size);
+ * when it is full the inserter waits for the PaRSEC threads to bring the
+ * number of pending tasks below parsec_dtd_threshold_size, as it cannot
+ * execute tasks itself.
+ * Tasks inserted by different threads that use the same data are ordered
+ * as their insertions reach the data. In distributed runs, the tasks are
+ * numbered from a range reserved to the inserter index: every rank must
+ * insert the same tasks with the same index, the data used by different
+ * inserters must not overlap and the task classes must be created before
+ * the inserters start.
+ *
+ * All inserters must be freed before waiting on the taskpool.
+ *
+ * @return the inserter, or NULL if the thread cannot insert into tp.
+ */
+parsec_dtd_inserter_t *
+parsec_dtd_inserter_new(parsec_taskpool_t *tp, int index);
+
+/**
+ * This function detaches the calling thread from the taskpool it
+ * inserted into, the handle cannot be used anymore.
+ */
+void
+parsec_dtd_inserter_free(parsec_dtd_inserter_t *inserter);
+
 parsec_task_class_t*
 parsec_dtd_create_task_class( parsec_taskpool_t *__tp,
                               const char* name,
@@ -397,6 +462,62 @@ parsec_dtd_insert_task_with_task_class(parsec_taskpool_t *tp,
                                        int device_type,
                                        ...);
 
+/**
+ * Precompiled description of how the arguments of a task class are laid
+ * out, to insert its tasks without parsing a variadic argument list.
+ */
+typedef struct parsec_dtd_task_signature_s parsec_dtd_task_signature_t;
+
+/**
+ * This function compiles the parameters of tc into a signature used by
+ * parsec_dtd_insert_packed_tasks(). The tasks inserted with the signature
+ * run one of the chores of tc allowed by device_type: all the chores must
+ * have been added to tc before the signature is created, and the
+ * signature must be freed before tc is released.
+ *
+ * The arguments of a task are given in two parts:
+ *  - tiles: the tiles of the INPUT, INOUT and OUTPUT parameters, in the
+ *    order of the parameters (NULL for a flow without data);
+ *  - args: the PARSEC_VALUE parameters, packed back to back without padding
+ *    in the order of the parameters, sizes as declared in tc.
+ * SCRATCH parameters take no argument, the scratch space is allocated with
+ * the task. Task classes with PARSEC_REF parameters are not supported.
+ *
+ * @return the signature, or NULL if tc cannot be inserted packed.
+ */
+parsec_dtd_task_signature_t *
+parsec_dtd_task_signature_new(parsec_taskpool_t *tp,
+                              parsec_task_class_t *tc,
+                              int device_type);
+
+void
+parsec_dtd_task_signature_free(parsec_dtd_task_signature_t *sig);
+
+/**
+ * Returns the number of tiles, and the size of the packed values, taken by
+ * each task of the signature.
+ */
+int
+parsec_dtd_task_signature_nb_tiles(const parsec_dtd_task_signature_t *sig);
+
+size_t
+parsec_dtd_task_signature_args_size(const parsec_dtd_task_signature_t *sig);
+
+/**
+ * This function inserts nb tasks of the signature with the same priority,
+ * in order, as the same number of calls to
+ * parsec_dtd_insert_task_with_task_class() would. Task i takes its tiles from
+ * tiles[i * nb_tiles] and its packed values from args + i * args_stride,
+ * args_stride can be larger than the packed size to walk an array of
+ * structures.
+ */
+void
+parsec_dtd_insert_packed_tasks(parsec_taskpool_t *tp,
+                               const parsec_dtd_task_signature_t *sig,
+                               int nb, int priority,
+                               parsec_dtd_tile_t * const *tiles,
+                               const void *args, size_t args_stride);
+
 void
 parsec_dtd_register_task_class(parsec_taskpool_t *tp,
                                uint64_t key,
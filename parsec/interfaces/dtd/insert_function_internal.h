@@ -61,6 +61,8 @@ extern int parsec_dtd_dump_traversal_info; /**< For printing traversal info */
                                 TILE->last_writer.task        = NULL;                   \
                                 TILE->last_writer.alive       = TASK_IS_NOT_ALIVE;      \
                                 parsec_atomic_unlock(&TILE->last_writer.atomic_lock);   \
+                                                                                        \
+                                TILE->last_remote_writer.tc   = NULL;                   \
 
 #define READ_FROM_TILE(TO, FROM) TO.task       = FROM.task;                             \
                                  TO.flow_index = FROM.flow_index;                       \
@@ -196,6 +198,19 @@ typedef struct parsec_dtd_tile_user_s {
     uint8_t              flow_index;
 }parsec_dtd_tile_user_t;
 
+/* Last writer of a tile that was never instantiated on this rank, because
+ * the sliced insertion found it did not involve any local task or data.
+ * Holds what is needed to build the remote task if a local task ever
+ * depends on it. */
+typedef struct parsec_dtd_tile_remote_writer_s {
+    parsec_task_class_t *tc;         /* NULL if there is no such writer */
+    int32_t              key;
+    int32_t              rank;
+    int32_t              priority;
+    int32_t              op_type;
+    uint8_t              flow_index;
+}parsec_dtd_tile_remote_writer_t;
+
 struct parsec_dtd_tile_s {
     parsec_list_item_t        super;
     parsec_hash_table_item_t  ht_item;
@@ -208,6 +223,7 @@ struct parsec_dtd_tile_s {
     parsec_data_collection_t *dc;
     parsec_dtd_tile_user_t    last_user;
     parsec_dtd_tile_user_t    last_writer;
+    parsec_dtd_tile_remote_writer_t last_remote_writer;
 };
 /* For creating objects of class parsec_dtd_tile_t */
 PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_dtd_tile_t);
@@ -226,13 +242,21 @@ struct parsec_dtd_taskpool_s {
     int                          enqueue_flag;
     int                          task_id;
     int                          task_window_size;
+    int32_t                      task_window_cap;      /* window size at which the main thread blocks, with the adaptive window */
     int32_t                      task_threshold_size;
     int                          total_tasks_to_be_exec;
     uint32_t                     local_task_inserted;  /* don't waste an atomic operation
                                                           on this, it can be loosely connected
                                                           to the number of locally inserted
                                                           tasks. */
+    uint64_t                     task_bytes;           /* memory of the tasks counted in local_task_inserted */
+    uint32_t                     wait_selects;         /* tasks looked for and found by the main thread */
+    uint32_t                     wait_found;           /* during its last wait on the window */
+    uint32_t                     window_grows;         /* decisions of the adaptive window, */
+    uint32_t                     window_shrinks;       /* checked by the tests */
     uint8_t                      flow_set_flag[PARSEC_DTD_NB_TASK_CLASSES];
+    parsec_atomic_lock_t         task_class_lock;      /* protects the task classes created
+                                                          or completed during insertion */
     int64_t                      new_tile_keys;
     parsec_data_collection_t     new_tile_dc;
     parsec_mempool_t            *hash_table_bucket_mempool;
@@ -242,6 +266,54 @@ struct parsec_dtd_taskpool_s {
     struct hook_info             actual_hook[PARSEC_DTD_NB_TASK_CLASSES];
 };
 
+/*
+ * State of a thread inserting tasks concurrently in a taskpool. The thread
+ * runs with its own execution stream, borrowing the mempools of a worker
+ * of the first virtual process, and delivers the tasks that are ready at
+ * insertion to that worker.
+ */
+struct parsec_dtd_inserter_s {
+    parsec_execution_stream_t    es;
+    parsec_dtd_taskpool_t       *dtd_tp;
+    parsec_execution_stream_t   *target_es;
+    int                          index;
+    int                          task_id;              /* number of ids taken in the range of this inserter */
+    int                          task_window_size;
+    uint32_t                     local_task_inserted;
+};
+
+/*
+ * Where each parameter of a task class comes from when its tasks are
+ * inserted packed: the slot of its tile for a flow, the offset of its value
+ * in the packed arguments for a VALUE. The values land in the value block of
+ * the task at value_offset, and are copied in as few contiguous runs as the
+ * layout allows.
+ */
+typedef struct parsec_dtd_packed_param_s {
+    int                          source;
+    int                          value_offset;
+} parsec_dtd_packed_param_t;
+
+typedef struct parsec_dtd_packed_run_s {
+    int                          source;
+    int                          value_offset;
+    int                          size;
+} parsec_dtd_packed_run_t;
+
+struct parsec_dtd_task_signature_s {
+    parsec_dtd_taskpool_t       *dtd_tp;
+    parsec_task_class_t         *tc;
+    uint32_t                     chore_mask;
+    int                          nb_params;
+    int                          nb_tiles;
+    int                          nb_runs;
+    int                          affinity;             /* parameter giving the rank, -1 if none */
+    size_t                       args_size;
+    uint64_t                     tracked_writes;       /* tile slots counted as write flows */
+    parsec_dtd_packed_param_t    params[PARSEC_DTD_MAX_PARAMS];
+    parsec_dtd_packed_run_t      runs[PARSEC_DTD_MAX_PARAMS];
+};
+
 /*
  * Extension of parsec_task_class_t class
  */
@@ -272,6 +344,10 @@ parsec_dtd_create_and_initialize_task( parsec_dtd_taskpool_t *dtd_tp,
                                        parsec_task_class_t *tc,
                                        int rank );
 
+void
+parsec_dtd_tile_instantiate_remote_writer( parsec_dtd_taskpool_t *dtd_tp,
+                                           parsec_dtd_tile_t *tile );
+
 void
 parsec_dtd_set_params_of_task( parsec_dtd_task_t *this_task, parsec_dtd_tile_t *tile,
                                int tile_op_type, int *flow_index, void **current_val,
@@ -408,11 +484,14 @@ parsec_dtd_set_descendant(parsec_dtd_task_t *parent_task, uint8_t parent_flow_in
 
 int
 parsec_dtd_schedule_task_if_ready(int satisfied_flow, parsec_dtd_task_t *this_task,
-                                  parsec_dtd_taskpool_t *dtd_tp, int *vpid);
+                                  parsec_dtd_taskpool_t *dtd_tp);
 
 int
 parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int task_threshold);
 
+void
+parsec_dtd_count_local_task(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task);
+
 void
 parsec_dtd_fini();
 
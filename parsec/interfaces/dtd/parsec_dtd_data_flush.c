@@ -120,7 +120,6 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
 
     int flow_index = 0;
     int satisfied_flow = 0, tile_op_type = PARSEC_INOUT;
-    static int vpid = 0;
 
     if( NULL == tile ) {
         assert(0);
@@ -133,14 +132,21 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
 
     parsec_dtd_tile_user_t last_user, last_writer;
     if(0 == dtd_tp->flow_set_flag[tc->task_class_id]) {
-        /* Setting flow in function structure */
-        parsec_dtd_set_flow_in_function(dtd_tp, this_task, tile_op_type, flow_index);
-        set_deps_for_flush_task(tc);
+        parsec_atomic_lock(&dtd_tp->task_class_lock);
+        if(0 == dtd_tp->flow_set_flag[tc->task_class_id]) {
+            /* Setting flow in function structure */
+            parsec_dtd_set_flow_in_function(dtd_tp, this_task, tile_op_type, flow_index);
+            set_deps_for_flush_task(tc);
+            parsec_mfence();
+            dtd_tp->flow_set_flag[tc->task_class_id] = 1;
+        }
+        parsec_atomic_unlock(&dtd_tp->task_class_lock);
     }
 
     (FLOW_OF(this_task, flow_index))->arena_index = tile->arena_index;
 
     parsec_dtd_last_user_lock(&(tile->last_user));
+    parsec_dtd_tile_instantiate_remote_writer(dtd_tp, tile);
 
     READ_FROM_TILE(last_user, tile->last_user);
     READ_FROM_TILE(last_writer, tile->last_writer);
@@ -222,11 +228,9 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
         parsec_dtd_remote_task_release( last_writer.task );
     }
 
-    dtd_tp->flow_set_flag[tc->task_class_id] = 1;
-
     if( parsec_dtd_task_is_local(this_task) ) {/* Task is local */
         dtd_tp->super.tdm.module->taskpool_addto_nb_tasks(&dtd_tp->super, 1);
-        dtd_tp->local_task_inserted++;
+        parsec_dtd_count_local_task(dtd_tp, this_task);
         PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
                              "Task generated -> %s %d rank %d\n", this_task->super.task_class->name, this_task->ht_item.key, this_task->rank);
     }
@@ -242,8 +246,7 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
     satisfied_flow++;
 
     if( parsec_dtd_task_is_local(this_task) ) {
-        parsec_dtd_schedule_task_if_ready(satisfied_flow, this_task,
-                                          dtd_tp, &vpid);
+        parsec_dtd_schedule_task_if_ready(satisfied_flow, this_task, dtd_tp);
     }
 
     parsec_dtd_block_if_threshold_reached(dtd_tp, parsec_dtd_threshold_size);
@@ -307,6 +310,7 @@ parsec_dtd_insert_flush_task_pair(parsec_taskpool_t *tp, parsec_dtd_tile_t *tile
     parsec_dtd_tile_user_t last_writer;
 
     parsec_dtd_last_user_lock(&(tile->last_user));
+    parsec_dtd_tile_instantiate_remote_writer((parsec_dtd_taskpool_t *)tp, tile);
     READ_FROM_TILE(last_writer, tile->last_writer);
     parsec_dtd_last_user_unlock(&(tile->last_user));
 
@@ -10,6 +10,7 @@
 #include "parsec/mca/device/device.h"
 #include "parsec/utils/debug.h"
 #include "parsec/scheduling.h"
+#include "parsec/execution_stream.h"
 #if defined(PARSEC_HAVE_LIMITS_H)
 #include <limits.h>
 #endif  /* defined(HAVE_LIMITS_H) */
@@ -148,6 +149,53 @@ const parsec_task_class_t __parsec_generic_startup = {
 #endif
 };
 
+/**
+ * Split a startup task in slices, one per execution stream of the context
+ * (or parsec_task_startup_split if smaller). The task itself becomes the
+ * first slice, and a copy of it is scheduled directly on each of the other
+ * execution streams, so that every stream enumerates and schedules its own
+ * share of the startup tasks into its own queue. The slice index and the
+ * number of slices are stored in the locals slot and slot+1 of each slice.
+ */
+int parsec_startup_task_split(parsec_execution_stream_t *es,
+                              parsec_task_t *this_task,
+                              int slot)
+{
+    parsec_context_t *context = this_task->taskpool->context;
+    parsec_execution_stream_t *target;
+    parsec_task_t *slice_task;
+    int nb_es = 0, nb_slices, s, p, c;
+
+    assert((slot + 1) < MAX_LOCAL_COUNT);
+    for(p = 0; p < context->nb_vp; p++)
+        nb_es += context->virtual_processes[p]->nb_cores;
+    nb_slices = nb_es;
+    if( (parsec_task_startup_split > 0) && (parsec_task_startup_split < nb_es) )
+        nb_slices = parsec_task_startup_split;
+    this_task->locals[slot].value     = 0;
+    this_task->locals[slot + 1].value = nb_slices;
+
+    for(s = 1, p = 0; (p < context->nb_vp) && (s < nb_slices); p++) {
+        for(c = 0; (c < context->virtual_processes[p]->nb_cores) && (s < nb_slices); c++) {
+            target = context->virtual_processes[p]->execution_streams[c];
+            if( target == es ) continue;
+            slice_task = (parsec_task_t*)parsec_thread_mempool_allocate(es->context_mempool);
+            PARSEC_COPY_EXECUTION_CONTEXT(slice_task, this_task);
+            slice_task->status = PARSEC_TASK_STATUS_HOOK;
+            memset(slice_task->locals, 0, sizeof(parsec_assignment_t) * MAX_LOCAL_COUNT);
+            slice_task->locals[slot].value     = s;
+            slice_task->locals[slot + 1].value = nb_slices;
+            PARSEC_LIST_ITEM_SINGLETON(slice_task);
+            /* each slice is released as a runtime task */
+            parsec_taskpool_update_runtime_nbtask(this_task->taskpool, 1);
+            __parsec_schedule(target, slice_task, 0);
+            s++;
+        }
+    }
+    PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Split %s in %d slices", this_task->task_class->name, nb_slices);
+    return nb_slices;
+}
+
 #if defined(PARSEC_PROF_TRACE)
 void *parsec_task_profile_info(void *dst, const void *task_, size_t size)
 {
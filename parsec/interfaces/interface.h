@@ -60,6 +60,16 @@ parsec_release_task_to_mempool_and_count_as_runtime_tasks(parsec_execution_strea
                                                           parsec_task_t *this_task);
 
 
+/**
+ * Split the startup task of a task class in slices, each one scheduled on a
+ * different execution stream. Return the number of slices, the slice index
+ * and count are stored in the locals slot and slot+1 of each slice.
+ */
+PARSEC_DECLSPEC int
+parsec_startup_task_split(parsec_execution_stream_t *es,
+                          parsec_task_t *this_task,
+                          int slot);
+
 #if defined(PARSEC_PROF_TRACE)
 void *parsec_task_profile_info(void *dst, const void *task, size_t size);
 #endif
@@ -32,6 +32,8 @@ static char *FUNCTION_PROPERTY_KEYWORDS[] = {
     JDF_PROP_UD_ALLOC_DEPS_FN_NAME,
     JDF_PROP_UD_FREE_DEPS_FN_NAME,
     "time_estimate",
+    JDF_PROP_DEP_MANAGEMENT_NAME,
+    JDF_PROP_CRITICAL_PATH_PRIORITY_NAME,
     NULL
 };
 
@@ -89,6 +89,10 @@ int jdf_sanity_checks( jdf_warning_mask_t mask );
 #define DEP_MANAGEMENT_DYNAMIC_HASH_TABLE 1
 #define DEP_MANAGEMENT_INDEX_ARRAY_STRING        "index-array"
 #define DEP_MANAGEMENT_INDEX_ARRAY        2
+#define DEP_MANAGEMENT_OPEN_ADDRESSING_STRING    "open-addressing"
+#define DEP_MANAGEMENT_OPEN_ADDRESSING    3
+#define DEP_MANAGEMENT_FLAT_ARRAY_STRING         "flat-array"
+#define DEP_MANAGEMENT_FLAT_ARRAY         4
 
 #define TERMDET_DEFAULT                   0
 #define TERMDET_DYNAMIC                   1
@@ -108,6 +112,8 @@ typedef struct jdf_compiler_global_args {
     int   noline;  /**< Don't dump the jdf line number in the generate .c file */
     struct jdf_name_list *ignore_properties; /**< Properties to ignore */
     int   termdet; /**< What termination detection to use (one of TERMDET_*) */
+    int   critical_path_priority; /**< Derive the priority of the task classes without one from
+                                   *   the estimated length of their critical path */
 } jdf_compiler_global_args_t;
 extern jdf_compiler_global_args_t JDF_COMPILER_GLOBAL_ARGS;
 
@@ -181,6 +187,12 @@ typedef unsigned int jdf_flags_t;
 #define JDF_FUNCTION_FLAG_HAS_DATA_INPUT    ((jdf_flags_t)(1 << 4))
 #define JDF_FUNCTION_FLAG_HAS_DATA_OUTPUT   ((jdf_flags_t)(1 << 5))
 #define JDF_FUNCTION_FLAG_NO_PREDECESSORS   ((jdf_flags_t)(1 << 6))
+#define JDF_FUNCTION_FLAG_OA_DEPENDENCIES   ((jdf_flags_t)(1 << 7))  /**< dependencies tracked in a
+                                                                      *   parsec_oa_hash_table_t */
+#define JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES ((jdf_flags_t)(1 << 8))  /**< dependencies tracked in a flat
+                                                                      *   array indexed by the parameters */
+#define JDF_FUNCTION_FLAG_CRITICAL_PATH     ((jdf_flags_t)(1 << 9))  /**< the priority is the estimated
+                                                                      *   bottom level of the task */
 
 #define JDF_HAS_UD_NB_LOCAL_TASKS              ((jdf_flags_t)(1 << 0))
 #define JDF_PROP_UD_NB_LOCAL_TASKS_FN_NAME     "nb_local_tasks_fn"
@@ -200,6 +212,10 @@ typedef unsigned int jdf_flags_t;
 #define JDF_PROP_UD_ALLOC_DEPS_FN_NAME         "alloc_deps_fn"
 #define JDF_PROP_UD_FREE_DEPS_FN_NAME          "free_deps_fn"
 
+#define JDF_PROP_DEP_MANAGEMENT_NAME           "dep_management"
+
+#define JDF_PROP_CRITICAL_PATH_PRIORITY_NAME   "critical_path_priority"
+
 #define JDF_PROP_NO_AUTOMATIC_TASKPOOL_INSTANCE "no_taskpool_instance"
 
 #define JDF_PROP_TERMDET_NAME                  "termdet"
@@ -51,6 +51,10 @@ static void
 jdf_generate_code_find_deps(const jdf_t *jdf,
                             const jdf_function_entry_t *f,
                             const char *name);
+static void
+jdf_generate_code_flat_find_deps(const jdf_t *jdf,
+                                 const jdf_function_entry_t *f,
+                                 const char *name);
 static void jdf_generate_inline_c_functions(jdf_t* jdf);
 
 /* local constants */
@@ -1552,6 +1556,15 @@ static void jdf_minimal_code_before_prologue(const jdf_t *jdf)
     jdf_generate_predeclarations(jdf);
 }
 
+static int jdf_uses_critical_path( const jdf_t *jdf )
+{
+    const jdf_function_entry_t *f;
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        if( f->flags & JDF_FUNCTION_FLAG_CRITICAL_PATH ) return 1;
+    }
+    return 0;
+}
+
 static void jdf_generate_structure(jdf_t *jdf)
 {
     int nbfunctions, need_profile = 0;
@@ -1595,6 +1608,10 @@ static void jdf_generate_structure(jdf_t *jdf)
     if(nbfunctions != 0 ) {
         coutput("  data_repo_t* repositories[%d];\n", nbfunctions );
     }
+    if( jdf_uses_critical_path(jdf) ) {
+        coutput("  /* The bottom levels already evaluated, for the critical path priorities */\n"
+                "  int32_t* bottom_levels[%d];\n", nbfunctions );
+    }
 
     coutput("};\n\n");
 
@@ -2064,7 +2081,8 @@ static void jdf_generate_affinity( const jdf_t *jdf, const jdf_function_entry_t
             "  /* Silent Warnings: should look into predicate to know what variables are usefull */\n"
             "%s\n"
             "  ref->dc = (parsec_data_collection_t *)"TASKPOOL_GLOBAL_PREFIX"_g_%s;\n"
-            "  /* Compute data key */\n"
+            "  /* Compute data key, if the collection provides them */\n"
+            "  if( NULL == ref->dc->data_key ) return 0;\n"
             "  ref->key = ref->dc->data_key(ref->dc, %s);\n"
             "  return 1;\n"
             "}\n",
@@ -3040,13 +3058,21 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
     int nesting = 0, idx, nb_locals;
     expr_info_t info1 = EMPTY_EXPR_INFO;
     jdf_expr_t *ld;
-    int ctx_level = 0;
+    int ctx_level = 0, split;
 
     assert( f->flags & JDF_FUNCTION_FLAG_CAN_BE_STARTUP );
     if( f->user_defines & JDF_FUNCTION_HAS_UD_STARTUP_TASKS_FUN )
         return;
     (void)jdf;
 
+    /* The outermost loop can be split across the execution streams if it is a range,
+     * and if there are enough reserved locals to save the slice index and count
+     * (reserved[1] and reserved[2], reserved[0] tracks the submission process). */
+    JDF_COUNT_LIST_ENTRIES(f->locals, jdf_variable_list_t, next, nb_locals);
+    nb_locals += f->nb_max_local_def;
+    split = (NULL != f->locals) && (JDF_RANGE == f->locals->expr->op) &&
+            ((nb_locals + 3) <= MAX_LOCAL_COUNT);
+
     sa1 = string_arena_new(64);
     sa2 = string_arena_new(64);
     sa_properties = string_arena_new(64);
@@ -3067,8 +3093,15 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
     for(vl = f->locals; vl != NULL; vl = vl->next)
         coutput("  int %s = this_task->locals.%s.value;  /* retrieve value saved during the last iteration */\n", vl->name, vl->name);
 
-    coutput("  for(int _i = 0; _i < context->nb_vp; pready_ring[_i++] = NULL );\n"
-            "  if( 0 != this_task->locals.reserved[0].value ) {\n"
+    coutput("  for(int _i = 0; _i < context->nb_vp; pready_ring[_i++] = NULL );\n");
+    if( split ) {
+        coutput("  int slice = this_task->locals.reserved[1].value, nb_slices = this_task->locals.reserved[2].value;\n"
+                "  if( 0 == nb_slices ) {  /* first activation: share the outermost loop with the other execution streams */\n"
+                "    nb_slices = parsec_startup_task_split(es, (parsec_task_t*)this_task, %d);\n"
+                "  }\n",
+                nb_locals + 1);
+    }
+    coutput("  if( 0 != this_task->locals.reserved[0].value ) {\n"
             "    this_task->locals.reserved[0].value = 1; /* reset the submission process */\n"
             "    restore_context = 1;\n"
             "    goto restore_context_0;\n"
@@ -3085,7 +3118,18 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
 
     idx = 0;
     for(vl = f->locals; vl != NULL; vl = vl->next, idx++) {
-        if(vl->expr->op == JDF_RANGE) {
+        if( split && (vl == f->locals) ) {
+            /* each slice takes one iteration of the outermost loop every nb_slices */
+            char *inc = strdup(dump_expr((void**)vl->expr->jdf_ta3, &info1));
+            coutput("%s  for(this_task->locals.%s.value = %s = (%s) + slice * (%s);\n",
+                    indent(nesting), vl->name, vl->name, dump_expr((void**)vl->expr->jdf_ta1, &info1), inc);
+            coutput("%s      this_task->locals.%s.value <= %s;\n",
+                    indent(nesting), vl->name, dump_expr((void**)vl->expr->jdf_ta2, &info1));
+            coutput("%s      this_task->locals.%s.value += nb_slices * (%s), %s = this_task->locals.%s.value) {\n",
+                    indent(nesting), vl->name, inc, vl->name, vl->name);
+            free(inc);
+            nesting++;
+        } else if(vl->expr->op == JDF_RANGE) {
             coutput("%s  for(this_task->locals.%s.value = %s = %s;\n",
                     indent(nesting), vl->name, vl->name, dump_expr((void**)vl->expr->jdf_ta1, &info1));
             coutput("%s      this_task->locals.%s.value <= %s;\n",
@@ -3171,7 +3215,6 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
             indent(nesting), parsec_get_name(jdf, f, "task_t"),
             indent(nesting));
 
-    JDF_COUNT_LIST_ENTRIES(f->locals, jdf_variable_list_t, next, nb_locals);
     coutput("%s  /* Copy only the valid elements from this_task to new_task one */\n"
             "%s  new_task->taskpool   = this_task->taskpool;\n"
             "%s  new_task->task_class = __parsec_tp->super.super.task_classes_array[%s_%s.task_class_id];\n"
@@ -3219,10 +3262,9 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
             "#endif\n", indent(nesting), indent(nesting), indent(nesting), indent(nesting), indent(nesting));
 
     coutput("%s  parsec_dependencies_mark_task_as_startup((parsec_task_t*)new_task, es);\n"
-            "%s  pready_ring[vpid] = parsec_list_item_ring_push_sorted(pready_ring[vpid],\n"
-            "%s                                                        (parsec_list_item_t*)new_task,\n"
-            "%s                                                        parsec_execution_context_priority_comparator);\n"
-            "%s  nb_tasks++;\n", indent(nesting), indent(nesting), indent(nesting), indent(nesting), indent(nesting));
+            "%s  pready_ring[vpid] = parsec_list_item_ring_push_head(pready_ring[vpid],\n"
+            "%s                                                      (parsec_list_item_t*)new_task);\n"
+            "%s  nb_tasks++;\n", indent(nesting), indent(nesting), indent(nesting), indent(nesting));
     coutput("%s restore_context_%d:  /* we jump here just so that we have code after the label */\n", indent(nesting), ctx_level);
     coutput("%s  restore_context = 0;\n"
             "%s  (void)restore_context;\n"
@@ -3233,7 +3275,8 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
         coutput("%s      __parsec_tp->super.super.tdm.module->taskpool_addto_nb_tasks(&__parsec_tp->super.super, nb_tasks);\n",
                 indent(nesting));
     }
-    coutput("%s    __parsec_schedule_vp(es, (parsec_task_t**)pready_ring, 0);\n"
+    coutput("%s    parsec_taskpool_mark_first_ready(this_task->taskpool);\n"
+            "%s    __parsec_schedule_vp(es, (parsec_task_t**)pready_ring, 0);\n"
             "%s    total_nb_tasks += nb_tasks;\n"
             "%s    nb_tasks = 0;\n"
             "%s    if( total_nb_tasks > parsec_task_startup_chunk ) {  /* stop here and request to be rescheduled */\n"
@@ -3241,7 +3284,7 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
             "%s    }\n"
             "%s  }\n",
             indent(nesting), indent(nesting), indent(nesting), indent(nesting),
-            indent(nesting), indent(nesting), indent(nesting));
+            indent(nesting), indent(nesting), indent(nesting), indent(nesting));
 
     /* We close all variables, in reverse order to manage the local indices */
     while( NULL != inner_vl ) {
@@ -3270,7 +3313,8 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
     if(jdf_uses_dynamic_termdet(jdf)) {
         coutput("    __parsec_tp->super.super.tdm.module->taskpool_addto_nb_tasks(&__parsec_tp->super.super, nb_tasks);\n");
     }
-    coutput("    __parsec_schedule_vp(es, (parsec_task_t**)pready_ring, 0);\n"
+    coutput("    parsec_taskpool_mark_first_ready(this_task->taskpool);\n"
+            "    __parsec_schedule_vp(es, (parsec_task_t**)pready_ring, 0);\n"
             "    nb_tasks = 0;\n"
             "  }\n"
             "  return PARSEC_HOOK_RETURN_DONE;\n"
@@ -3429,6 +3473,65 @@ static  void jdf_generate_deps_key_functions(const jdf_t *jdf, const jdf_functio
             "\n", sname, sname);
 }
 
+/**
+ * Whether e references the variable name. Inline C code is opaque and
+ * assumed to reference everything.
+ */
+static int jdf_expr_uses_variable( const jdf_expr_t *e, const char *name )
+{
+    if( JDF_OP_IS_CST(e->op) || JDF_OP_IS_STRING(e->op) )
+        return 0;
+    if( JDF_OP_IS_VAR(e->op) )
+        return 0 == strcmp(e->jdf_var, name);
+    if( JDF_OP_IS_UNARY(e->op) )
+        return jdf_expr_uses_variable(e->jdf_ua, name);
+    if( JDF_OP_IS_BINARY(e->op) )
+        return jdf_expr_uses_variable(e->jdf_ba1, name) || jdf_expr_uses_variable(e->jdf_ba2, name);
+    if( JDF_OP_IS_TERNARY(e->op) )
+        return jdf_expr_uses_variable(e->jdf_tat, name) ||
+            jdf_expr_uses_variable(e->jdf_ta1, name) || jdf_expr_uses_variable(e->jdf_ta2, name);
+    return 1;
+}
+
+/**
+ * When the innermost range of f appears bare in exactly one position of the
+ * affinity, and neither the other positions nor the locals defined after it
+ * depend on it, the number of local tasks along that range can be asked to
+ * the data collection (nb_local_of) instead of evaluating rank_of on every
+ * point. Returns that position and the range, or -1 if the innermost loop
+ * must be enumerated.
+ */
+static int jdf_function_nb_local_dim( const jdf_function_entry_t *f,
+                                      const jdf_variable_list_t **range_vl )
+{
+    const jdf_variable_list_t *vl;
+    const jdf_expr_t *e;
+    int pos, dim = -1;
+
+    *range_vl = NULL;
+    for(vl = f->locals; NULL != vl; vl = vl->next) {
+        if( NULL != vl->expr->local_variables )
+            return -1;
+        if( JDF_RANGE == vl->expr->op )
+            *range_vl = vl;
+    }
+    if( NULL == *range_vl )
+        return -1;
+    for(pos = 0, e = f->predicate->parameters; NULL != e; e = e->next, pos++) {
+        if( JDF_OP_IS_VAR(e->op) && (0 == strcmp(e->jdf_var, (*range_vl)->name)) ) {
+            if( -1 != dim )
+                return -1;
+            dim = pos;
+            continue;
+        }
+        for(vl = *range_vl; NULL != vl; vl = vl->next) {
+            if( jdf_expr_uses_variable(e, vl->name) )
+                return -1;
+        }
+    }
+    return dim;
+}
+
 static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entry_t *f, const char *fname)
 {
     string_arena_t *sa1, *sa2, *sa_end;
@@ -3436,7 +3539,8 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
     jdf_expr_t *ld;
     const jdf_param_list_t *pl;
     expr_info_t info = EMPTY_EXPR_INFO;
-    int need_to_iterate, need_min_max, need_to_count_tasks;
+    int need_to_iterate, need_min_max, need_to_count_tasks, nb_local_dim = -1;
+    const jdf_variable_list_t *nb_local_vl = NULL;
     int nesting = 0, idx;
     jdf_l2p_t *l2p = build_l2p(f), *l2p_item;
     char *dep_key_fn_name = NULL;
@@ -3451,11 +3555,14 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
             (0 == (f->user_defines & JDF_HAS_DYNAMIC_TERMDET)) &&
             (0 == (f->user_defines & JDF_HAS_USER_TRIGGERED_TERMDET));
     need_to_iterate = need_min_max || need_to_count_tasks;
+    if( need_to_count_tasks && (JDF_COMPILER_GLOBAL_ARGS.dep_management != DEP_MANAGEMENT_INDEX_ARRAY) )
+        nb_local_dim = jdf_function_nb_local_dim(f, &nb_local_vl);
 
     if( 0 != (f->user_defines & JDF_FUNCTION_HAS_UD_HASH_STRUCT) ) {
         dep_key_fn_name = strdup( jdf_property_get_string(f->properties, JDF_PROP_UD_HASH_STRUCT_NAME, NULL) );
     } else {
-        if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE) {
+        if( (JDF_COMPILER_GLOBAL_ARGS.dep_management != DEP_MANAGEMENT_INDEX_ARRAY) &&
+            !(f->flags & (JDF_FUNCTION_FLAG_OA_DEPENDENCIES | JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES)) ) {
             if( asprintf(&dep_key_fn_name, "%s_%s_deps_key_functions", jdf_basename, fname) <= 0 ) {
                 fprintf(stderr, "Cannot allocate internal memory for the PTG compiler\n");
                 exit(-1);
@@ -3476,6 +3583,8 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
 
     if(need_to_count_tasks) {
         coutput("  int32_t nb_tasks = 0, saved_nb_tasks = 0;\n");
+        if( -1 != nb_local_dim )
+            coutput("  int64_t %snb_local;\n", JDF2C_NAMESPACE);
         /* prepare the epilog output to prevent compiler from complaining about initialized but unused data */
         string_arena_add_string(sa_end, "(void)saved_nb_tasks;\n");
     }
@@ -3558,6 +3667,27 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
                             indent(nesting), JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name, vl->name);
                 }
 
+                if( (-1 != nb_local_dim) && (nb_local_vl == vl) ) {
+                    /* Innermost range: ask the affinity collection for the number of local
+                     * tasks, and fall back on the enumeration if it cannot tell. */
+                    string_arena_init(sa2);
+                    coutput("%s    %s = %s%s_start;\n"
+                            "%s    if( (NULL != ((parsec_data_collection_t*)("TASKPOOL_GLOBAL_PREFIX"_g_%s))->nb_local_of) &&\n"
+                            "%s        (0 <= (%snb_local = ((parsec_data_collection_t*)("TASKPOOL_GLOBAL_PREFIX"_g_%s))->nb_local_of(\n"
+                            "%s                  (parsec_data_collection_t*)("TASKPOOL_GLOBAL_PREFIX"_g_%s), %d,\n"
+                            "%s                  %s%s_start, %s%s_end, %s%s_inc, %s))) ) {\n"
+                            "%s      nb_tasks += (int32_t)%snb_local;\n"
+                            "%s    } else\n",
+                            indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name,
+                            indent(nesting), f->predicate->func_or_mem,
+                            indent(nesting), JDF2C_NAMESPACE, f->predicate->func_or_mem,
+                            indent(nesting), f->predicate->func_or_mem, nb_local_dim,
+                            indent(nesting), JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name,
+                            UTIL_DUMP_LIST(sa2, f->predicate->parameters, next,
+                                           dump_expr, &info, "", "", ", ", ""),
+                            indent(nesting), JDF2C_NAMESPACE,
+                            indent(nesting));
+                }
                 /* Adapt the loop condition depending on the value of the increment. We can
                  * now handle both increasing and decreasing execution spaces. */
                 coutput("%s    for(%s =  %s%s_start;\n",
@@ -3795,8 +3925,26 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
         if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
             coutput("  __parsec_tp->super.super.dependencies_array[%d] = dep;\n",
                     f->task_class_id);
-        } else if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ||
-                   0 != (f->user_defines & JDF_FUNCTION_HAS_UD_HASH_STRUCT)) {
+        } else if( f->flags & JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES ) {
+            /* One dependency per point of the bounding box of the execution space,
+             * the parameters that are not ranges derive from the others */
+            coutput("  {\n"
+                    "    size_t nb_deps = 1;\n");
+            for(l2p_item = l2p; NULL != l2p_item; l2p_item = l2p_item->next) {
+                vl = l2p_item->vl;
+                if( NULL == (pl = l2p_item->pl) || JDF_RANGE != vl->expr->op ) continue;
+                coutput("    nb_deps *= (size_t)parsec_imax(__parsec_tp->%s_%s_range, 1);\n",
+                        f->fname, pl->name);
+            }
+            coutput("    PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, \"Allocating %%zu flat dependencies for %s\", nb_deps);\n"
+                    "    __parsec_tp->super.super.dependencies_array[%d] = calloc(nb_deps, sizeof(parsec_dependency_t));\n"
+                    "  }\n",
+                    f->fname, f->task_class_id);
+        } else if( f->flags & JDF_FUNCTION_FLAG_OA_DEPENDENCIES ) {
+            coutput("  __parsec_tp->super.super.dependencies_array[%d] = PARSEC_OBJ_NEW(parsec_oa_hash_table_t);\n"
+                    "  parsec_oa_hash_table_init(__parsec_tp->super.super.dependencies_array[%d], %s);\n",
+                    f->task_class_id, f->task_class_id, need_to_count_tasks ? "nb_tasks" : "0");
+        } else {
             coutput("  __parsec_tp->super.super.dependencies_array[%d] = PARSEC_OBJ_NEW(parsec_hash_table_t);\n"
                     "  parsec_hash_table_init(__parsec_tp->super.super.dependencies_array[%d], offsetof(parsec_hashable_dependency_t, ht_item), 10, %s, this_task->taskpool);\n",
                     f->task_class_id, f->task_class_id, dep_key_fn_name);
@@ -4001,7 +4149,13 @@ static void jdf_generate_release_task_fct(const jdf_t *jdf, jdf_function_entry_t
             prefix,
             jdf_basename,
             jdf_basename);
-    if( !(f->user_defines & JDF_FUNCTION_HAS_UD_DEPENDENCIES_FUNS) ) {
+    if( f->flags & JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES ) {
+        coutput("    (void)__parsec_tp;  /* the flat dependencies are released with the taskpool */\n");
+    } else if( f->flags & JDF_FUNCTION_FLAG_OA_DEPENDENCIES ) {
+        coutput("    parsec_key_t key = this_task->task_class->make_key((const parsec_taskpool_t*)__parsec_tp, (const parsec_assignment_t*)&this_task->locals);\n"
+                "    parsec_oa_hash_table_remove((parsec_oa_hash_table_t*)__parsec_tp->super.super.dependencies_array[%d], key);\n",
+                f->task_class_id);
+    } else if( !(f->user_defines & JDF_FUNCTION_HAS_UD_DEPENDENCIES_FUNS) ) {
         coutput("    parsec_hash_table_t *ht = (parsec_hash_table_t*)__parsec_tp->super.super.dependencies_array[%d];\n"
                 "    parsec_key_t key = this_task->task_class->make_key((const parsec_taskpool_t*)__parsec_tp, (const parsec_assignment_t*)&this_task->locals);\n"
                 "    parsec_hashable_dependency_t *hash_dep = (parsec_hashable_dependency_t *)parsec_hash_table_remove(ht, key);\n",
@@ -4296,7 +4450,13 @@ static void jdf_generate_one_function( const jdf_t *jdf, jdf_function_entry_t *f
             sprintf(prefix, "find_deps_%s_%s", jdf_basename, f->fname);
             jdf_generate_code_find_deps(jdf, f, prefix);
             (void)jdf_add_function_property(&f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME, prefix);
-        } else if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ) {
+        } else if( f->flags & JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES ) {
+            sprintf(prefix, "find_deps_%s_%s", jdf_basename, f->fname);
+            jdf_generate_code_flat_find_deps(jdf, f, prefix);
+            (void)jdf_add_function_property(&f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME, prefix);
+        } else if( f->flags & JDF_FUNCTION_FLAG_OA_DEPENDENCIES ) {
+            (void)jdf_add_function_property(&f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME, "parsec_oa_hash_find_deps");
+        } else {
             (void)jdf_add_function_property(&f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME, "parsec_hash_find_deps");
         }
     }
@@ -4349,7 +4509,7 @@ static void jdf_generate_one_function( const jdf_t *jdf, jdf_function_entry_t *f
      */
     if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
         string_arena_add_string(sa, "  .release_task = (parsec_hook_t*)parsec_release_task_to_mempool_update_nbtasks,\n");
-    } else if ( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ) {
+    } else {
         /* If we have a user-defined find_deps function, don't generate the hashtable_dep release task, keep
          * just counting, if needed */
         sprintf(prefix, "release_task_of_%s_%s", jdf_basename, f->fname);
@@ -4439,6 +4599,397 @@ static void jdf_generate_priority_prototypes( const jdf_t *jdf )
     }
 }
 
+/**
+ * Critical path priorities: the priority of a task is the estimated length of
+ * the longest path from the task to a sink of the DAG (its bottom level), in
+ * number of tasks, or in time if some task classes define a time_estimate.
+ * The bottom level of a task is evaluated when its priority is needed, by
+ * walking the symbolic dataflow of its task class:
+ *  - the successors of another task class are evaluated recursively, with the
+ *    parameters of the call (the lower bound for the ranges);
+ *  - a successor of the same task class that shifts one of the parameters by
+ *    a constant is the start of a chain that ends at the bound of the range of
+ *    this parameter. The chain is accounted in closed form, and only the task
+ *    at the end of the chain is evaluated recursively.
+ * To bound the cost of the evaluation, the successors that close a cycle
+ * between task classes, the other successors of the same task class and the
+ * successors defined with local definitions are not followed, and the
+ * bottom level of each task is kept in a flat array of its task class,
+ * indexed as the flat dependencies, so that it is evaluated once however
+ * many predecessors reach it.
+ */
+static void jdf_critical_path_postorder( const jdf_t *jdf, const jdf_function_entry_t *f,
+                                         int *order, int *next )
+{
+    jdf_function_entry_t *targetf;
+    jdf_dataflow_t *fl;
+    jdf_dep_t *dep;
+    jdf_call_t *calls[2];
+
+    order[f->task_class_id] = -2;  /* on the stack */
+    for( fl = f->dataflow; NULL != fl; fl = fl->next ) {
+        for( dep = fl->deps; NULL != dep; dep = dep->next ) {
+            if( !(dep->dep_flags & JDF_DEP_FLOW_OUT) ) continue;
+            calls[0] = dep->guard->calltrue;
+            calls[1] = (JDF_GUARD_TERNARY == dep->guard->guard_type) ? dep->guard->callfalse : NULL;
+            for( int i = 0; i < 2; i++ ) {
+                if( NULL == calls[i] ) continue;
+                targetf = find_target_function(jdf, calls[i]->func_or_mem);
+                if( (NULL != targetf) && (-1 == order[targetf->task_class_id]) )
+                    jdf_critical_path_postorder(jdf, targetf, order, next);
+            }
+        }
+    }
+    order[f->task_class_id] = (*next)++;
+}
+
+/**
+ * If the call to the same task class shifts one of the parameters by a
+ * constant, and if this parameter spans a range, returns the local of this
+ * parameter and sets the shift. Returns NULL otherwise.
+ */
+static const jdf_variable_list_t *
+jdf_critical_path_chain( const jdf_function_entry_t *f, const jdf_call_t *call, int *shift )
+{
+    const jdf_param_list_t *pl;
+    const jdf_variable_list_t *vl;
+    const jdf_expr_t *le, *var, *cst;
+
+    for( pl = f->parameters, le = call->parameters; (NULL != pl) && (NULL != le); pl = pl->next, le = le->next ) {
+        if( (JDF_PLUS != le->op) && (JDF_MINUS != le->op) ) continue;
+        var = le->jdf_ba1;
+        cst = le->jdf_ba2;
+        if( (JDF_PLUS == le->op) && (JDF_CST == var->op) ) {
+            var = le->jdf_ba2;
+            cst = le->jdf_ba1;
+        }
+        if( (JDF_VAR != var->op) || strcmp(var->jdf_var, pl->name) ||
+            (JDF_CST != cst->op) || (EXPR_TYPE_FLOAT == cst->jdf_type) || (EXPR_TYPE_DOUBLE == cst->jdf_type) )
+            continue;
+        *shift = (JDF_PLUS == le->op) ? cst->jdf_cst : -cst->jdf_cst;
+        if( 0 == *shift ) continue;
+        for( vl = f->locals; NULL != vl; vl = vl->next ) {
+            if( !strcmp(vl->name, pl->name) ) break;
+        }
+        if( (NULL != vl) && (JDF_RANGE == vl->expr->op) )
+            return vl;
+    }
+    return NULL;
+}
+
+static int jdf_critical_path_is_param( const jdf_function_entry_t *f, const char *name )
+{
+    const jdf_param_list_t *pl;
+    for( pl = f->parameters; NULL != pl; pl = pl->next ) {
+        if( !strcmp(pl->name, name) ) return 1;
+    }
+    return 0;
+}
+
+static void jdf_generate_critical_path_successor( const jdf_t *jdf, const jdf_function_entry_t *f,
+                                                  const jdf_call_t *call, const char *cond,
+                                                  const int *order, string_arena_t *sa_edge )
+{
+    string_arena_t *sa2 = string_arena_new(64);
+    expr_info_t info = EMPTY_EXPR_INFO;
+    const jdf_function_entry_t *targetf;
+    const jdf_variable_list_t *chain = NULL;
+    const jdf_param_list_t *pl;
+    const jdf_expr_t *le;
+    const char *ind;
+    int shift = 0;
+
+    info.sa = sa2;
+    info.prefix = "";
+    info.suffix = "";
+    info.assignments = "&locals";
+
+    string_arena_init(sa_edge);
+    targetf = find_target_function(jdf, call->func_or_mem);
+    if( NULL == targetf )  /* data collection, NEW or NULL */
+        goto done;
+    if( NULL != call->local_defs ) {
+        string_arena_add_string(sa_edge, "  /* %s %s(...) uses local definitions: not followed */\n",
+                                call->var, targetf->fname);
+        goto done;
+    }
+    if( targetf == f ) {
+        if( NULL == (chain = jdf_critical_path_chain(f, call, &shift)) ) {
+            string_arena_add_string(sa_edge, "  /* %s %s(...) is not a chain of constant stride: not followed */\n",
+                                    call->var, targetf->fname);
+            goto done;
+        }
+    } else if( order[targetf->task_class_id] > order[f->task_class_id] ) {
+        string_arena_add_string(sa_edge, "  /* %s %s(...) closes a cycle between task classes: not followed */\n",
+                                call->var, targetf->fname);
+        goto done;
+    }
+
+    ind = (targetf == f) ? "      " : "    ";
+    string_arena_add_string(sa_edge, "  if( %s ) {  /* %s %s */\n", NULL == cond ? "1" : cond, call->var, targetf->fname);
+    if( targetf == f ) {
+        if( shift > 0 )
+            string_arena_add_string(sa_edge, "    int steps = ((%s) - %s) / %d;\n",
+                                    dump_expr((void**)chain->expr->jdf_ta2, &info), chain->name, shift);
+        else
+            string_arena_add_string(sa_edge, "    int steps = (%s - (%s)) / %d;\n",
+                                    chain->name, dump_expr((void**)chain->expr->jdf_ta1, &info), -shift);
+        string_arena_add_string(sa_edge, "    if( steps > 0 ) {\n");
+    }
+    string_arena_add_string(sa_edge, "%s%s next = {", ind, parsec_get_name(jdf, targetf, "parsec_assignment_t"));
+    for( pl = targetf->parameters, le = call->parameters; (NULL != pl) && (NULL != le); pl = pl->next, le = le->next ) {
+        if( (targetf == f) && !strcmp(pl->name, chain->name) ) {
+            string_arena_add_string(sa_edge, " .%s.value = %s + steps * (%d),", pl->name, pl->name, shift);
+        } else {
+            string_arena_add_string(sa_edge, " .%s.value = %s,", pl->name,
+                                    dump_expr((void**)(JDF_RANGE == le->op ? le->jdf_ta1 : le), &info));
+        }
+    }
+    string_arena_add_string(sa_edge, " };\n");
+    if( targetf == f ) {
+        /* the tasks between this one and the end of the chain */
+        string_arena_add_string(sa_edge,
+                                "%sb = (int64_t)(steps - 1) * weight + bottom_level_of_%s_%s_depth(__parsec_tp, &next, depth + 1);\n"
+                                "%sif( b > bl ) bl = b;\n"
+                                "    }\n",
+                                ind, jdf_basename, targetf->fname, ind);
+    } else {
+        string_arena_add_string(sa_edge,
+                                "%sb = bottom_level_of_%s_%s_depth(__parsec_tp, &next, depth + 1);\n"
+                                "%sif( b > bl ) bl = b;\n",
+                                ind, jdf_basename, targetf->fname, ind);
+    }
+    string_arena_add_string(sa_edge, "  }\n");
+  done:
+    string_arena_free(sa2);
+}
+
+static void jdf_generate_critical_path_function( const jdf_t *jdf, const jdf_function_entry_t *f,
+                                                 const int *order, int max_depth, int use_time_estimate )
+{
+    string_arena_t *sa = string_arena_new(64);
+    string_arena_t *sa_edge = string_arena_new(256);
+    string_arena_t *sa_edges = string_arena_new(1024);
+    expr_info_t info = EMPTY_EXPR_INFO;
+    const jdf_variable_list_t *vl;
+    const jdf_param_list_t *pl;
+    const jdf_dataflow_t *fl;
+    const jdf_dep_t *dep;
+    jdf_def_list_t *prop = NULL;
+    char *cond, *notcond;
+    int opaque = 0, rc;
+
+    info.sa = sa;
+    info.prefix = "";
+    info.suffix = "";
+    info.assignments = "&locals";
+
+    coutput("static int64_t bottom_level_of_%s_%s_eval(const __parsec_%s_internal_taskpool_t *__parsec_tp, const %s *assignments, int depth)\n"
+            "{\n"
+            "  %s locals = *assignments;\n"
+            "  int64_t weight, bl = 0, b;\n"
+            "  (void)__parsec_tp;\n",
+            jdf_basename, f->fname, jdf_basename, parsec_get_name(jdf, f, "parsec_assignment_t"),
+            parsec_get_name(jdf, f, "parsec_assignment_t"));
+    /* The caller only sets the parameters, the other locals are computed here */
+    for( vl = f->locals; NULL != vl; vl = vl->next ) {
+        if( NULL != vl->expr->local_variables ) opaque = 1;
+    }
+    for( vl = f->locals; (NULL != vl) && !opaque; vl = vl->next ) {
+        if( jdf_critical_path_is_param(f, vl->name) ) {
+            coutput("  const int %s = locals.%s.value;\n", vl->name, vl->name);
+        } else {
+            coutput("  const int %s = locals.%s.value = %s;\n", vl->name, vl->name,
+                    dump_expr((void**)(JDF_RANGE == vl->expr->op ? vl->expr->jdf_ta1 : vl->expr), &info));
+        }
+    }
+    if( !opaque ) {
+        coutput("%s\n",
+                UTIL_DUMP_LIST_FIELD(sa, f->locals, next, name, dump_string, NULL,
+                                     "  ", "(void)", "; ", ";"));
+    }
+
+    if( !use_time_estimate ) {
+        coutput("  weight = 1;\n");
+    } else if( NULL != jdf_find_property(f->properties, "time_estimate", &prop) ) {
+        coutput("  {\n"
+                "    %s task;\n"
+                "    memset(&task, 0, sizeof(task));\n"
+                "    task.taskpool = (parsec_taskpool_t*)__parsec_tp;\n"
+                "    task.task_class = __parsec_tp->super.super.task_classes_array[%d];\n"
+                "    task.locals = locals;\n"
+                "    weight = %s((const parsec_task_t*)&task, parsec_mca_device_get(0));  /* on the CPU */\n"
+                "  }\n"
+                "  if( weight < 1 ) weight = 1;\n",
+                parsec_get_name(jdf, f, "task_t"), f->task_class_id, prop->expr->jdf_var);
+    } else {
+        coutput("  weight = parsec_mca_device_get(0)->time_estimate_default;\n"
+                "  if( weight < 1 ) weight = 1;\n");
+    }
+
+    if( opaque ) {
+        coutput("  /* The locals of %s use local definitions: its successors are not followed */\n"
+                "  (void)locals; (void)bl; (void)b; (void)depth;\n"
+                "  return weight;\n"
+                "}\n\n",
+                f->fname);
+        goto done;
+    }
+
+    coutput("  if( depth >= %d ) return weight;\n", max_depth);
+    for( fl = f->dataflow; NULL != fl; fl = fl->next ) {
+        for( dep = fl->deps; NULL != dep; dep = dep->next ) {
+            if( !(dep->dep_flags & JDF_DEP_FLOW_OUT) ) continue;
+            if( NULL != dep->local_defs ) {
+                coutput("  /* Flow %s: a dependency uses local definitions: not followed */\n", fl->varname);
+                continue;
+            }
+            cond = notcond = NULL;
+            if( JDF_GUARD_UNCONDITIONAL != dep->guard->guard_type ) {
+                cond = strdup(dump_expr((void**)dep->guard->guard, &info));
+                rc = asprintf(&notcond, "!(%s)", cond);
+                assert(rc != -1); (void)rc;
+            }
+            jdf_generate_critical_path_successor(jdf, f, dep->guard->calltrue, cond, order, sa_edge);
+            /* Several flows usually go to the same successors, evaluate them once */
+            if( NULL == strstr(string_arena_get_string(sa_edges), string_arena_get_string(sa_edge)) )
+                string_arena_add_string(sa_edges, "%s", string_arena_get_string(sa_edge));
+            if( JDF_GUARD_TERNARY == dep->guard->guard_type ) {
+                jdf_generate_critical_path_successor(jdf, f, dep->guard->callfalse, notcond, order, sa_edge);
+                if( NULL == strstr(string_arena_get_string(sa_edges), string_arena_get_string(sa_edge)) )
+                    string_arena_add_string(sa_edges, "%s", string_arena_get_string(sa_edge));
+            }
+            free(cond);
+            free(notcond);
+        }
+    }
+    coutput("%s"
+            "  (void)b;\n"
+            "  return weight + bl;\n"
+            "}\n\n",
+            string_arena_get_string(sa_edges));
+
+  done:
+    coutput("static inline int64_t bottom_level_of_%s_%s_depth(const __parsec_%s_internal_taskpool_t *__parsec_tp, const %s *assignments, int depth)\n"
+            "{\n",
+            jdf_basename, f->fname, jdf_basename, parsec_get_name(jdf, f, "parsec_assignment_t"));
+    if( f->user_defines & JDF_FUNCTION_HAS_UD_MAKE_KEY ) {
+        /* Without the ranges of the parameters, the tasks cannot be indexed */
+        coutput("  return bottom_level_of_%s_%s_eval(__parsec_tp, assignments, depth);\n"
+                "}\n\n",
+                jdf_basename, f->fname);
+        goto release;
+    }
+    coutput("  int32_t *cache = __parsec_tp->bottom_levels[%d];\n"
+            "  size_t idx = 0, size = 1;\n"
+            "  int64_t bl;\n"
+            "\n",
+            f->task_class_id);
+    for( pl = f->parameters; NULL != pl; pl = pl->next ) {
+        /* Horner scheme, the first parameter varies the slowest */
+        coutput("  if( (assignments->%s.value < __parsec_tp->%s_%s_min) ||\n"
+                "      (assignments->%s.value - __parsec_tp->%s_%s_min >= __parsec_tp->%s_%s_range) )\n"
+                "    return bottom_level_of_%s_%s_eval(__parsec_tp, assignments, depth);\n"
+                "  idx = idx * (size_t)__parsec_tp->%s_%s_range + (size_t)(assignments->%s.value - __parsec_tp->%s_%s_min);\n"
+                "  size *= (size_t)__parsec_tp->%s_%s_range;\n",
+                pl->name, f->fname, pl->name,
+                pl->name, f->fname, pl->name, f->fname, pl->name,
+                jdf_basename, f->fname,
+                f->fname, pl->name, pl->name, f->fname, pl->name,
+                f->fname, pl->name);
+    }
+    coutput("  if( NULL == cache ) {\n"
+            "    /* the ranges are known once the task classes are initialized */\n"
+            "    cache = (int32_t*)calloc(size, sizeof(int32_t));\n"
+            "    if( !parsec_atomic_cas_ptr(&((__parsec_%s_internal_taskpool_t*)__parsec_tp)->bottom_levels[%d], NULL, cache) ) {\n"
+            "      free(cache);\n"
+            "      cache = __parsec_tp->bottom_levels[%d];\n"
+            "    }\n"
+            "  }\n"
+            "  /* 0 until evaluated, concurrent evaluations store the same value */\n"
+            "  if( 0 != cache[idx] ) return cache[idx];\n"
+            "  bl = bottom_level_of_%s_%s_eval(__parsec_tp, assignments, depth);\n"
+            "  cache[idx] = (int32_t)(bl > INT32_MAX ? INT32_MAX : bl);\n"
+            "  return bl;\n"
+            "}\n\n",
+            jdf_basename, f->task_class_id, f->task_class_id,
+            jdf_basename, f->fname);
+
+  release:
+    string_arena_free(sa);
+    string_arena_free(sa_edge);
+    string_arena_free(sa_edges);
+}
+
+static void jdf_generate_critical_path_priorities( const jdf_t *jdf )
+{
+    jdf_function_entry_t *f;
+    jdf_def_list_t *prop = NULL;
+    jdf_expr_t *e;
+    int nb_classes = 0, use_critical_path = 0, use_time_estimate = 0, next = 0, rc;
+    int *order;
+
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        if( f->task_class_id >= nb_classes ) nb_classes = f->task_class_id + 1;
+        if( f->flags & JDF_FUNCTION_FLAG_CRITICAL_PATH ) use_critical_path = 1;
+        if( NULL != jdf_find_property(f->properties, "time_estimate", &prop) ) use_time_estimate = 1;
+    }
+    if( !use_critical_path ) return;
+
+    /* Follow only the successors that do not close a cycle between task classes:
+     * a task class finishes after all its successors in a depth first traversal,
+     * unless the successor is part of a cycle. Start from the task classes
+     * without predecessors, the sources of the DAG. */
+    order = (int*)malloc(nb_classes * sizeof(int));
+    for( int i = 0; i < nb_classes; order[i++] = -1 );
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        if( (f->flags & JDF_FUNCTION_FLAG_NO_PREDECESSORS) && (-1 == order[f->task_class_id]) )
+            jdf_critical_path_postorder(jdf, f, order, &next);
+    }
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        if( -1 == order[f->task_class_id] )
+            jdf_critical_path_postorder(jdf, f, order, &next);
+    }
+
+    coutput("/** Estimated bottom levels of the tasks, used as critical path priorities */\n");
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        coutput("static inline int64_t bottom_level_of_%s_%s_depth(const __parsec_%s_internal_taskpool_t *__parsec_tp, const %s *assignments, int depth);\n",
+                jdf_basename, f->fname, jdf_basename, parsec_get_name(jdf, f, "parsec_assignment_t"));
+    }
+    coutput("\n");
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        /* Each recursion either changes of task class or ends a chain */
+        jdf_generate_critical_path_function(jdf, f, order, 4 * nb_classes, use_time_estimate);
+    }
+
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        if( !(f->flags & JDF_FUNCTION_FLAG_CRITICAL_PATH) ) continue;
+        coutput("static inline int32_t bottom_level_of_%s_%s(const __parsec_%s_internal_taskpool_t *__parsec_tp, const %s *assignments)\n"
+                "{\n"
+                "  int64_t bl = bottom_level_of_%s_%s_depth(__parsec_tp, assignments, 0);\n"
+                "  /* leave room for the priority of the taskpool */\n"
+                "  return (int32_t)(bl > (INT32_MAX / 2) ? (INT32_MAX / 2) : bl);\n"
+                "}\n\n",
+                jdf_basename, f->fname, jdf_basename, parsec_get_name(jdf, f, "parsec_assignment_t"),
+                jdf_basename, f->fname);
+
+        /* The priority is an inline C expression already generated */
+        e = (jdf_expr_t*)calloc(1, sizeof(jdf_expr_t));
+        JDF_OBJECT_LINENO(e) = JDF_OBJECT_LINENO(f);
+        e->op = JDF_C_CODE;
+        e->jdf_type = EXPR_TYPE_INT32;
+        e->scope = -1;
+        e->ldef_index = -1;
+        e->jdf_c_code.lineno = JDF_OBJECT_LINENO(f);
+        e->jdf_c_code.function_context = f;
+        rc = asprintf(&e->jdf_c_code.fname, "bottom_level_of_%s_%s", jdf_basename, f->fname);
+        assert(rc != -1); (void)rc;
+        e->jdf_c_code.code = strdup("  /* critical path priority, generated by the compiler */");
+        f->priority = e;
+    }
+    free(order);
+}
+
 static void jdf_generate_startup_hook( const jdf_t *jdf )
 {
     string_arena_t *sa1 = string_arena_new(64);
@@ -4572,7 +5123,13 @@ static void jdf_generate_destructor( const jdf_t *jdf )
                 coutput("  if(NULL != __parsec_tp->super.super.dependencies_array[%d])\n"
                         "    dependencies_size += parsec_destruct_dependencies( __parsec_tp->super.super.dependencies_array[%d] );\n",
                         f->task_class_id, f->task_class_id);
-            } else if (JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ) {
+            } else if( f->flags & JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES ) {
+                coutput("  free(__parsec_tp->super.super.dependencies_array[%d]);\n",
+                        f->task_class_id);
+            } else if( f->flags & JDF_FUNCTION_FLAG_OA_DEPENDENCIES ) {
+                coutput("  PARSEC_OBJ_RELEASE(__parsec_tp->super.super.dependencies_array[%d]);\n",
+                        f->task_class_id);
+            } else {
                 coutput("  parsec_hash_table_fini( (parsec_hash_table_t*)__parsec_tp->super.super.dependencies_array[%d] );\n"
                         "  PARSEC_OBJ_RELEASE(__parsec_tp->super.super.dependencies_array[%d]);\n",
                         f->task_class_id, f->task_class_id);
@@ -4589,6 +5146,15 @@ static void jdf_generate_destructor( const jdf_t *jdf )
     coutput("  free( __parsec_tp->super.super.dependencies_array );\n"
             "  __parsec_tp->super.super.dependencies_array = NULL;\n");
 
+    if( jdf_uses_critical_path(jdf) ) {
+        coutput("  /* Release the bottom levels of the critical path priorities */\n"
+                "  for( i = 0; i < PARSEC_%s_NB_TASK_CLASSES; i++ ) {\n"
+                "    free(__parsec_tp->bottom_levels[i]);\n"
+                "    __parsec_tp->bottom_levels[i] = NULL;\n"
+                "  }\n",
+                jdf_basename);
+    }
+
     if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
         coutput("#if defined(PARSEC_PROF_TRACE)\n"
                 "  {\n"
@@ -4673,6 +5239,10 @@ static void jdf_generate_constructor( const jdf_t* jdf )
             jdf_basename, jdf_basename,
             string_arena_get_string(sa1));
 
+    if( jdf_uses_critical_path(jdf) ) {
+        coutput("  memset(__parsec_tp->bottom_levels, 0, sizeof(__parsec_tp->bottom_levels));\n");
+    }
+
     /* Prepare the functions */
     coutput("  for( i = 0; i < __parsec_tp->super.super.nb_task_classes; i++ ) {\n"
             "    __parsec_tp->super.super.task_classes_array[i] = tc = malloc(sizeof(parsec_task_class_t));\n"
@@ -8159,6 +8729,58 @@ static void jdf_generate_inline_c_functions(jdf_t* jdf)
     }
 }
 
+/**
+ * An expression is affine (in the loose sense we need to bound an
+ * execution space) if it only combines constants and variables with
+ * arithmetic operators and conditionals. Inline C code is opaque.
+ */
+static int jdf_expr_is_affine( const jdf_expr_t *e )
+{
+    switch( e->op ) {
+    case JDF_CST:
+    case JDF_VAR:
+        return 1;
+    case JDF_PLUS:
+    case JDF_MINUS:
+    case JDF_TIMES:
+    case JDF_DIV:
+        return jdf_expr_is_affine(e->jdf_ba1) && jdf_expr_is_affine(e->jdf_ba2);
+    case JDF_TERNARY:
+        return !JDF_OP_IS_C_CODE(e->jdf_tat->op) &&
+            jdf_expr_is_affine(e->jdf_ta1) && jdf_expr_is_affine(e->jdf_ta2);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * The dependencies of a task class can be tracked in a flat array if the
+ * taskpool computes the bounding box of its execution space (no
+ * user-defined make_key), and if each parameter is either a range with
+ * affine bounds or a value derived from the other parameters.
+ */
+static int jdf_function_has_affine_space( const jdf_function_entry_t *f )
+{
+    jdf_variable_list_t *vl;
+    jdf_param_list_t *pl;
+
+    if( f->user_defines & JDF_FUNCTION_HAS_UD_MAKE_KEY )
+        return 0;
+    for( pl = f->parameters; NULL != pl; pl = pl->next ) {
+        for( vl = f->locals; NULL != vl; vl = vl->next )
+            if( 0 == strcmp(pl->name, vl->name) )
+                break;
+        if( NULL == vl || NULL != vl->expr->local_variables )
+            return 0;
+        if( JDF_RANGE == vl->expr->op &&
+            !(jdf_expr_is_affine(vl->expr->jdf_ta1) &&
+              jdf_expr_is_affine(vl->expr->jdf_ta2) &&
+              jdf_expr_is_affine(vl->expr->jdf_ta3)) )
+            return 0;
+    }
+    return 1;
+}
+
 static void jdf_check_user_defined_internals(jdf_t *jdf)
 {
     jdf_function_entry_t *f;
@@ -8274,12 +8896,47 @@ static void jdf_check_user_defined_internals(jdf_t *jdf)
             }
             f->user_defines |= JDF_FUNCTION_HAS_UD_DEPENDENCIES_FUNS;
         } else {
+            f->flags &= ~(JDF_FUNCTION_FLAG_OA_DEPENDENCIES | JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES);
             if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
                 (void)jdf_add_function_property(&f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME, "parsec_default_find_deps");
-            } else if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ) {
-                (void)jdf_add_function_property(&f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME, "parsec_hash_find_deps");
             } else {
-                assert(0);
+                /* The hash based and flat tracking can be selected for each task class */
+                const char *dm = jdf_property_get_string(f->properties, JDF_PROP_DEP_MANAGEMENT_NAME,
+                                                         JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_OPEN_ADDRESSING ?
+                                                         DEP_MANAGEMENT_OPEN_ADDRESSING_STRING :
+                                                         (JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_FLAT_ARRAY ?
+                                                          DEP_MANAGEMENT_FLAT_ARRAY_STRING : DEP_MANAGEMENT_DYNAMIC_HASH_TABLE_STRING));
+                if( 0 == strcmp(dm, DEP_MANAGEMENT_FLAT_ARRAY_STRING) ) {
+                    /* Task classes with a non affine execution space silently fall back to the
+                     * dynamic hash table, unless the flat array was explicitly requested */
+                    if( jdf_function_has_affine_space(f) ) {
+                        f->flags |= JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES;
+                    } else if( NULL != jdf_find_property(f->properties, JDF_PROP_DEP_MANAGEMENT_NAME, &property) ) {
+                        jdf_warn(JDF_OBJECT_LINENO(f),
+                                 "The execution space of function %s is not affine, its dependencies are tracked with a '"
+                                 DEP_MANAGEMENT_DYNAMIC_HASH_TABLE_STRING"' instead of '"DEP_MANAGEMENT_FLAT_ARRAY_STRING"'\n",
+                                 f->fname);
+                    }
+                } else if( 0 == strcmp(dm, DEP_MANAGEMENT_OPEN_ADDRESSING_STRING) ) {
+                    if( f->user_defines & JDF_FUNCTION_HAS_UD_HASH_STRUCT ) {
+                        /* the open addressing table compares the keys by value */
+                        jdf_warn(JDF_OBJECT_LINENO(f),
+                                 "Function %s defines a "JDF_PROP_UD_HASH_STRUCT_NAME", its dependencies are tracked with a '"
+                                 DEP_MANAGEMENT_DYNAMIC_HASH_TABLE_STRING"' instead of '"DEP_MANAGEMENT_OPEN_ADDRESSING_STRING"'\n",
+                                 f->fname);
+                    } else {
+                        f->flags |= JDF_FUNCTION_FLAG_OA_DEPENDENCIES;
+                    }
+                } else if( 0 != strcmp(dm, DEP_MANAGEMENT_DYNAMIC_HASH_TABLE_STRING) ) {
+                    jdf_warn(JDF_OBJECT_LINENO(f), "'%s' is not a recognized value for property '%s' of function %s -- property ignored\n",
+                             dm, JDF_PROP_DEP_MANAGEMENT_NAME, f->fname);
+                }
+                if( !(f->flags & JDF_FUNCTION_FLAG_FLAT_DEPENDENCIES) ) {
+                    /* the flat find_deps is generated with the task class */
+                    (void)jdf_add_function_property(&f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME,
+                                                    (f->flags & JDF_FUNCTION_FLAG_OA_DEPENDENCIES) ?
+                                                    "parsec_oa_hash_find_deps" : "parsec_hash_find_deps");
+                }
             }
             f->user_defines &= ~JDF_FUNCTION_HAS_UD_DEPENDENCIES_FUNS;
         }
@@ -8336,6 +8993,45 @@ jdf_generate_code_find_deps(const jdf_t *jdf,
     (void)jdf;
 }
 
+/**
+ * The flat dependencies are stored in row-major order of the range
+ * parameters, within the bounding box computed by the internal init.
+ */
+static void
+jdf_generate_code_flat_find_deps(const jdf_t *jdf,
+                                 const jdf_function_entry_t *f,
+                                 const char *name)
+{
+    jdf_l2p_t *l2p = NULL, *l2p_item;
+
+    coutput("parsec_dependency_t*\n"
+            "%s(const parsec_taskpool_t*__tp,\n"
+            "   parsec_execution_stream_t *es,\n"
+            "   const parsec_task_t* PARSEC_RESTRICT __task)\n"
+            "{\n"
+            "  const __parsec_%s_internal_taskpool_t *__parsec_tp = (const __parsec_%s_internal_taskpool_t*)__tp;\n"
+            "  const __parsec_%s_%s_task_t* task = (const __parsec_%s_%s_task_t*)__task;\n"
+            "  parsec_dependency_t *deps = (parsec_dependency_t*)%sdependencies_array[%d];\n"
+            "  size_t idx = 0;\n"
+            "  (void)es; (void)task;\n",
+            name,
+            jdf_basename, jdf_basename,
+            jdf_basename, f->fname, jdf_basename, f->fname,
+            TASKPOOL_GLOBAL_PREFIX"super.", f->task_class_id);
+
+    l2p = build_l2p(f);
+    for(l2p_item = l2p; NULL != l2p_item; l2p_item = l2p_item->next) {
+        if( NULL == l2p_item->pl || JDF_RANGE != l2p_item->vl->expr->op ) continue;
+        /* Horner scheme, the first parameter varies the slowest */
+        coutput("  idx = idx * (size_t)__parsec_tp->%s_%s_range + (size_t)(task->locals.%s.value - __parsec_tp->%s_%s_min);\n",
+                f->fname, l2p_item->pl->name, l2p_item->pl->name, f->fname, l2p_item->pl->name);
+    }
+    coutput("  return &deps[idx];\n"
+            "}\n\n");
+    free_l2p(l2p);
+    (void)jdf;
+}
+
 /**
  * Analyze the code to optimize the output
  */
@@ -8359,6 +9055,12 @@ int jdf_optimize( jdf_t* jdf )
         if( high_priority ) {
             f->flags |= JDF_FUNCTION_FLAG_HIGH_PRIORITY;
         }
+        /* A user defined priority always takes precedence over the critical path */
+        if( (NULL == f->priority) &&
+            jdf_property_get_int(f->properties, JDF_PROP_CRITICAL_PATH_PRIORITY_NAME,
+                                 JDF_COMPILER_GLOBAL_ARGS.critical_path_priority) ) {
+            f->flags |= JDF_FUNCTION_FLAG_CRITICAL_PATH;
+        }
         /* Check if the function has any successors and predecessors */
         jdf_check_relatives(f, JDF_DEP_FLOW_OUT, JDF_FUNCTION_FLAG_NO_SUCCESSORS);
         jdf_check_relatives(f, JDF_DEP_FLOW_IN, JDF_FUNCTION_FLAG_NO_PREDECESSORS);
@@ -8556,6 +9258,7 @@ int jdf2c(const char *output_c, const char *output_h, const char *_jdf_basename,
     jdf_generate_structure(jdf);
     jdf_generate_inline_c_functions(jdf);
     jdf_generate_makekey_and_hashstruct(jdf);
+    jdf_generate_critical_path_priorities(jdf);
     jdf_generate_priority_prototypes(jdf);
     jdf_generate_functions_statics(jdf); // PETER generates startup tasks
     jdf_generate_startup_hook(jdf);
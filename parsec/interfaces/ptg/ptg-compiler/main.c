@@ -35,6 +35,7 @@ static jdf_compiler_global_args_t DEFAULTS = {
     .compile = 1,  /* by default the file must be compiled */
     .dep_management = DEP_MANAGEMENT_DYNAMIC_HASH_TABLE,
     .termdet = TERMDET_DEFAULT,
+    .critical_path_priority = 0,
 #if defined(PARSEC_HAVE_INDENT) && !defined(PARSEC_HAVE_AWK)
     .noline = 1, /*< By default, don't print the #line per default if can't fix the line numbers with awk */
 #else
@@ -65,8 +66,12 @@ static void usage(void)
             "                     (default %s)\n"
             "\n"
             "  --dep-management|-M Select how dependencies tracking is managed. Possible choices\n"
-            "                      are '"DEP_MANAGEMENT_INDEX_ARRAY_STRING"' or '"DEP_MANAGEMENT_DYNAMIC_HASH_TABLE_STRING"'\n"
-            "                      (default '%s')\n"
+            "                      are '"DEP_MANAGEMENT_INDEX_ARRAY_STRING"', '"DEP_MANAGEMENT_DYNAMIC_HASH_TABLE_STRING"',\n"
+            "                      '"DEP_MANAGEMENT_OPEN_ADDRESSING_STRING"' or '"DEP_MANAGEMENT_FLAT_ARRAY_STRING"' (default '%s').\n"
+            "                      With '"DEP_MANAGEMENT_FLAT_ARRAY_STRING"', task classes whose parameters are ranges\n"
+            "                      with affine bounds use a flat array, the others a dynamic hash table.\n"
+            "                      All choices but '"DEP_MANAGEMENT_INDEX_ARRAY_STRING"' can be overridden for each\n"
+            "                      task class with the '"JDF_PROP_DEP_MANAGEMENT_NAME"' property.\n"
             "\n"
             "  --dynamic-termdet|-D  Use dynamic termination detection, even for PTGs that can use\n"
             "                     local (i.e. pre-counted number of tasks) termination detection\n"
@@ -74,6 +79,12 @@ static void usage(void)
             "                     detection continue to rely on user-trigger termination detection.\n"
             "                     (default: use local termination detection)\n"
             "\n"
+            "  --critical-path-priority|-P  Give the task classes without a priority the estimated\n"
+            "                     length of the longest path from each task to the end of the DAG,\n"
+            "                     weighted by the time_estimate of the task classes if any define one.\n"
+            "                     Can be overridden for each task class with the\n"
+            "                     '"JDF_PROP_CRITICAL_PATH_PRIORITY_NAME"' property (default: off)\n"
+            "\n"
             "  --noline           Do not dump the JDF line number in the .c output file\n"
             "  --line             Force dumping the JDF line number in the .c output file\n"
             "                     Default: %s\n"
@@ -99,7 +110,9 @@ static void usage(void)
             DEFAULTS.funcid,
             (DEFAULTS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ? DEP_MANAGEMENT_INDEX_ARRAY_STRING :
              (DEFAULTS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ? DEP_MANAGEMENT_DYNAMIC_HASH_TABLE_STRING :
-              ("Unknown dep management string"))),
+              (DEFAULTS.dep_management == DEP_MANAGEMENT_OPEN_ADDRESSING ? DEP_MANAGEMENT_OPEN_ADDRESSING_STRING :
+               (DEFAULTS.dep_management == DEP_MANAGEMENT_FLAT_ARRAY ? DEP_MANAGEMENT_FLAT_ARRAY_STRING :
+                ("Unknown dep management string"))))),
             DEFAULTS.noline?"--noline":"--line");
 }
 
@@ -195,16 +208,18 @@ static void parse_args(int argc, char *argv[])
         { "force-profile", no_argument,             NULL,   2  },
         { "ignore-properties", required_argument,   NULL,  'I' },
         { "dynamic-termdet", no_argument,           NULL,  'D' },
+        { "critical-path-priority", no_argument,    NULL,  'P' },
         { NULL,            0,                       NULL,   0  }
     };
 
     JDF_COMPILER_GLOBAL_ARGS.wmask = JDF_ALL_WARNINGS;
     JDF_COMPILER_GLOBAL_ARGS.dep_management = DEFAULTS.dep_management;
     JDF_COMPILER_GLOBAL_ARGS.ignore_properties = NULL;
+    JDF_COMPILER_GLOBAL_ARGS.critical_path_priority = DEFAULTS.critical_path_priority;
 
     print_jdf_line = !DEFAULTS.noline;
 
-    while( (ch = getopt_long(argc, argv, "dDi:C:H:o:f:hEsIO:M:I:", longopts, NULL)) != -1) {
+    while( (ch = getopt_long(argc, argv, "dDPi:C:H:o:f:hEsIO:M:I:", longopts, NULL)) != -1) {
         switch(ch) {
         case 'd':
             yydebug = 1;
@@ -213,6 +228,9 @@ static void parse_args(int argc, char *argv[])
         case 'D':
             JDF_COMPILER_GLOBAL_ARGS.termdet = TERMDET_DYNAMIC;
             break;
+        case 'P':
+            JDF_COMPILER_GLOBAL_ARGS.critical_path_priority = 1;
+            break;
         case 'i':
             if( NULL != JDF_COMPILER_GLOBAL_ARGS.input )
                 free(JDF_COMPILER_GLOBAL_ARGS.input);
@@ -263,6 +281,10 @@ static void parse_args(int argc, char *argv[])
                 JDF_COMPILER_GLOBAL_ARGS.dep_management = DEP_MANAGEMENT_DYNAMIC_HASH_TABLE;
             else if( strcmp(optarg, DEP_MANAGEMENT_INDEX_ARRAY_STRING) == 0 )
                 JDF_COMPILER_GLOBAL_ARGS.dep_management = DEP_MANAGEMENT_INDEX_ARRAY;
+            else if( strcmp(optarg, DEP_MANAGEMENT_OPEN_ADDRESSING_STRING) == 0 )
+                JDF_COMPILER_GLOBAL_ARGS.dep_management = DEP_MANAGEMENT_OPEN_ADDRESSING;
+            else if( strcmp(optarg, DEP_MANAGEMENT_FLAT_ARRAY_STRING) == 0 )
+                JDF_COMPILER_GLOBAL_ARGS.dep_management = DEP_MANAGEMENT_FLAT_ARRAY;
             else {
                 fprintf(stderr, "Unknown dependencies management method: '%s'\n", optarg);
                 usage();
@@ -14,6 +14,7 @@
 #include "parsec/execution_stream.h"
 #include "parsec/utils/argv.h"
 #include "parsec/parsec_internal.h"
+#include "parsec/utils/zone_malloc.h"
 
 #include <stdlib.h>
 #if defined(PARSEC_HAVE_ERRNO_H)
@@ -32,6 +33,7 @@
 #endif  /* defined(__WINDOWS__) */
 int parsec_device_output = 0;
 static int parsec_device_verbose = 0;
+int parsec_device_zone_allocator = ZONE_MALLOC_FIRST_FIT;
 uint32_t parsec_nb_devices = 0;
 static uint32_t parsec_nb_max_devices = 0;
 static uint32_t parsec_mca_device_are_freezed = 0;
@@ -325,6 +327,9 @@ int parsec_mca_device_init(void)
     (void)parsec_mca_param_reg_int_name("device", "load_balance_allow_cpu",
                                         "Allow load balancing tasks with GPU incarnations to CPU cores",
                                         false, false, parsec_device_load_balance_allow_cpu, NULL);
+    (void)parsec_mca_param_reg_int_name("device", "zone_allocator",
+                                        "Policy of the device memory allocator: 0 for first fit, 1 for segregated size classes",
+                                        false, false, parsec_device_zone_allocator, &parsec_device_zone_allocator);
     if( 0 < (rc = parsec_mca_param_find("device", NULL, "load_balance_skew")) ) {
         parsec_mca_param_lookup_int(rc, &parsec_device_load_balance_skew);
     }
@@ -189,6 +189,7 @@ PARSEC_OBJ_CLASS_DECLARATION(parsec_device_module_t);
 
 extern uint32_t parsec_nb_devices;
 extern int parsec_device_output;
+extern int parsec_device_zone_allocator;  /**< ZONE_MALLOC_FIRST_FIT or ZONE_MALLOC_SEGREGATED */
 
 /**
  * @brief Find the best device to execute the kernel based on the compute
@@ -701,7 +701,8 @@ parsec_device_memory_reserve( parsec_device_gpu_module_t* gpu_device,
 
         assert(alloc_size % eltsize == 0); /* we rounded up earlier... */
         mem_elem_per_gpu = alloc_size / eltsize;
-        gpu_device->memory = zone_malloc_init( base_ptr, mem_elem_per_gpu, eltsize );
+        gpu_device->memory = zone_malloc_init_policy( base_ptr, mem_elem_per_gpu, eltsize,
+                                                     parsec_device_zone_allocator );
         if( gpu_device->memory == NULL ) {
             parsec_warning("GPU[%d:%s] Failed trying to allocate %zu bytes. We tried to do so based on an initial_free_mem of %zu bytes and elt_size of %zu bytes",
                            gpu_device->super.device_index, gpu_device->super.name, alloc_size, initial_free_mem, eltsize);
@@ -0,0 +1,36 @@
+#ifndef PINS_INJECT_COUNT_H
+#define PINS_INJECT_COUNT_H
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/**
+ * @file
+ *
+ * Number of rings and of tasks injected into each execution stream, i.e.
+ * made ready outside of its virtual process (by another virtual process or
+ * by the communication thread) and delivered to it according to the
+ * runtime_inject_policy MCA parameter. The counters of each execution stream
+ * are printed when the thread is finalized.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/runtime.h"
+#include "parsec/mca/mca.h"
+#include "parsec/mca/pins/pins.h"
+
+BEGIN_C_DECLS
+
+/**
+ * Globally exported variable
+ */
+PARSEC_DECLSPEC extern const parsec_pins_base_component_t parsec_pins_inject_count_component;
+PARSEC_DECLSPEC extern const parsec_pins_module_t parsec_pins_inject_count_module;
+/* static accessor */
+mca_base_component_t * pins_inject_count_static_component(void);
+
+END_C_DECLS
+
+#endif
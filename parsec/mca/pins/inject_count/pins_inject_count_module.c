@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "pins_inject_count.h"
+#include "parsec/mca/pins/pins.h"
+#include "parsec/utils/debug.h"
+#include "parsec/execution_stream.h"
+#include "parsec/class/list_item.h"
+#include "parsec/sys/atomic.h"
+
+static void pins_init_inject_count(parsec_context_t* master);
+static void pins_thread_init_inject_count(parsec_execution_stream_t* es);
+static void pins_thread_fini_inject_count(parsec_execution_stream_t* es);
+
+const parsec_pins_module_t parsec_pins_inject_count_module = {
+    &parsec_pins_inject_count_component,
+    {
+        pins_init_inject_count,
+        NULL,
+        NULL,
+        NULL,
+        pins_thread_init_inject_count,
+        pins_thread_fini_inject_count
+    },
+    { NULL }
+};
+
+typedef struct parsec_pins_inject_count_data_s {
+    parsec_pins_next_callback_t cb_data;
+    volatile int64_t nb_rings;
+    volatile int64_t nb_tasks;
+} parsec_pins_inject_count_data_t;
+
+static void inject_count(parsec_execution_stream_t* es,
+                         parsec_task_t* ring,
+                         parsec_pins_next_callback_t* data);
+
+static void pins_init_inject_count(parsec_context_t* master)
+{
+    /* The injection events are not enabled by default */
+    parsec_pins_enable_mask |= PARSEC_PINS_FLAG_MASK(INJECT_BEGIN);
+    (void)master;
+}
+
+static void pins_thread_init_inject_count(parsec_execution_stream_t* es)
+{
+    parsec_pins_inject_count_data_t* event_cb =
+        (parsec_pins_inject_count_data_t*)calloc(1, sizeof(parsec_pins_inject_count_data_t));
+    PARSEC_PINS_REGISTER(es, INJECT_BEGIN, inject_count,
+                         (parsec_pins_next_callback_t*)event_cb);
+}
+
+static void pins_thread_fini_inject_count(parsec_execution_stream_t* es)
+{
+    parsec_pins_inject_count_data_t* event_cb;
+
+    PARSEC_PINS_UNREGISTER(es, INJECT_BEGIN, inject_count,
+                           (parsec_pins_next_callback_t**)&event_cb);
+    if( NULL == event_cb )
+        return;
+
+    printf("inject_count %d:%d rings %7"PRId64" tasks %7"PRId64"\n",
+           es->virtual_process->vp_id, es->th_id, event_cb->nb_rings, event_cb->nb_tasks);
+    free(event_cb);
+}
+
+/* Called by the injecting thread, concurrently with the other injectors */
+static void inject_count(parsec_execution_stream_t* es,
+                         parsec_task_t* ring,
+                         parsec_pins_next_callback_t* data)
+{
+    parsec_pins_inject_count_data_t* event_cb = (parsec_pins_inject_count_data_t*)data;
+    int64_t nb = 0;
+
+    _LIST_ITEM_ITERATOR(ring, (parsec_list_item_t*)ring, item, nb++);
+    (void)parsec_atomic_fetch_add_int64(&event_cb->nb_rings, 1);
+    (void)parsec_atomic_fetch_add_int64(&event_cb->nb_tasks, nb);
+    (void)es;
+}
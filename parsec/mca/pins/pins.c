@@ -129,6 +129,10 @@ PARSEC_PINS_FLAG parsec_pins_name_to_begin_flag(const char *name)
         val = COMPLETE_EXEC_BEGIN;
     } else if (0 == strncasecmp(name, "schedule", 8)) {
         val = SCHEDULE_BEGIN;
+    } else if (0 == strncasecmp(name, "park", 4)) {
+        val = PARK_BEGIN;
+    } else if (0 == strncasecmp(name, "inject", 6)) {
+        val = INJECT_BEGIN;
     }
 
     if (val == PARSEC_PINS_FLAG_COUNT) {
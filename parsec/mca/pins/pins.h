@@ -40,6 +40,10 @@ typedef enum PARSEC_PINS_FLAG {
     COMPLETE_EXEC_END,   // called after scheduler adds a newly-enabled task
     SCHEDULE_BEGIN,      // called before scheduling a ring of tasks
     SCHEDULE_END,        // called after scheduling a ring of tasks
+    PARK_BEGIN,          // called before an idle thread parks itself waiting for tasks
+    PARK_END,            // called after an idle thread is woken up
+    INJECT_BEGIN,        // called, by the injecting thread, with the target stream before a ring of tasks made ready outside of its vp is scheduled on it
+    INJECT_END,          // called, by the injecting thread, with the target stream after a ring of tasks made ready outside of its vp is scheduled on it
     /* what follows are Special Events. They do not necessarily
      * obey the 'exec unit, exec context' contract.
      */
@@ -57,7 +61,7 @@ typedef enum PARSEC_PINS_FLAG {
 extern uint64_t parsec_pins_enable_mask;
 extern const char *parsec_pins_enable_default_names;
 
-#define PARSEC_PINS_FLAG_MASK(_flag) ((_flag)>>1)
+#define PARSEC_PINS_FLAG_MASK(_flag) (((uint64_t)1)<<((_flag)>>1))
 #define PARSEC_PINS_FLAG_ENABLED(_flag) (parsec_pins_enable_mask & PARSEC_PINS_FLAG_MASK(_flag))
 
 BEGIN_C_DECLS
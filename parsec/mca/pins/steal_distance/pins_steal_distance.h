@@ -0,0 +1,39 @@
+#ifndef PINS_STEAL_DISTANCE_H
+#define PINS_STEAL_DISTANCE_H
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/**
+ * @file
+ *
+ * Histogram of the distances returned by the scheduler when selecting
+ * tasks. Distance 0 means the task was found in the local queue, larger
+ * distances are scheduler specific (e.g. the locality level of the victim
+ * for the lws scheduler). The histogram of each execution stream is
+ * printed when the thread is finalized.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/runtime.h"
+#include "parsec/mca/mca.h"
+#include "parsec/mca/pins/pins.h"
+
+/* Distances larger or equal to this are accounted in the last bucket */
+#define PINS_STEAL_DISTANCE_MAX 16
+
+BEGIN_C_DECLS
+
+/**
+ * Globally exported variable
+ */
+PARSEC_DECLSPEC extern const parsec_pins_base_component_t parsec_pins_steal_distance_component;
+PARSEC_DECLSPEC extern const parsec_pins_module_t parsec_pins_steal_distance_module;
+/* static accessor */
+mca_base_component_t * pins_steal_distance_static_component(void);
+
+END_C_DECLS
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "pins_steal_distance.h"
+#include "parsec/mca/pins/pins.h"
+#include "parsec/utils/debug.h"
+#include "parsec/execution_stream.h"
+
+static void pins_init_steal_distance(parsec_context_t* master);
+static void pins_thread_init_steal_distance(parsec_execution_stream_t* es);
+static void pins_thread_fini_steal_distance(parsec_execution_stream_t* es);
+
+const parsec_pins_module_t parsec_pins_steal_distance_module = {
+    &parsec_pins_steal_distance_component,
+    {
+        pins_init_steal_distance,
+        NULL,
+        NULL,
+        NULL,
+        pins_thread_init_steal_distance,
+        pins_thread_fini_steal_distance
+    },
+    { NULL }
+};
+
+typedef struct parsec_pins_steal_distance_data_s {
+    parsec_pins_next_callback_t cb_data;
+    long distance_counters[PINS_STEAL_DISTANCE_MAX];
+} parsec_pins_steal_distance_data_t;
+
+static void steal_distance_count(parsec_execution_stream_t* es,
+                                 parsec_task_t* task,
+                                 parsec_pins_next_callback_t* data);
+
+static void pins_init_steal_distance(parsec_context_t* master)
+{
+    /* The selection events are not enabled by default */
+    parsec_pins_enable_mask |= PARSEC_PINS_FLAG_MASK(SELECT_BEGIN);
+    (void)master;
+}
+
+static void pins_thread_init_steal_distance(parsec_execution_stream_t* es)
+{
+    parsec_pins_steal_distance_data_t* event_cb =
+        (parsec_pins_steal_distance_data_t*)calloc(1, sizeof(parsec_pins_steal_distance_data_t));
+    PARSEC_PINS_REGISTER(es, SELECT_END, steal_distance_count,
+                         (parsec_pins_next_callback_t*)event_cb);
+}
+
+static void pins_thread_fini_steal_distance(parsec_execution_stream_t* es)
+{
+    parsec_pins_steal_distance_data_t* event_cb;
+    int k, last;
+
+    PARSEC_PINS_UNREGISTER(es, SELECT_END, steal_distance_count,
+                           (parsec_pins_next_callback_t**)&event_cb);
+    if( NULL == event_cb )
+        return;
+
+    for( last = PINS_STEAL_DISTANCE_MAX - 1; last > 0 && 0 == event_cb->distance_counters[last]; last-- );
+    printf("steal_distance %d:%d", es->virtual_process->vp_id, es->th_id);
+    for( k = 0; k <= last; k++ )
+        printf(" %7ld", event_cb->distance_counters[k]);
+    printf("\n");
+    free(event_cb);
+}
+
+static void steal_distance_count(parsec_execution_stream_t* es,
+                                 parsec_task_t* task,
+                                 parsec_pins_next_callback_t* data)
+{
+    parsec_pins_steal_distance_data_t* event_cb = (parsec_pins_steal_distance_data_t*)data;
+    int d;
+
+    /* SELECT_END is also triggered without a task when leaving the main loop */
+    if( NULL == task )
+        return;
+    d = es->select_distance;
+    if( d < 0 ) d = 0;
+    if( d >= PINS_STEAL_DISTANCE_MAX ) d = PINS_STEAL_DISTANCE_MAX - 1;
+    event_cb->distance_counters[d]++;
+}
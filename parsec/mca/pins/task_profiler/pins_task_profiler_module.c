@@ -69,6 +69,12 @@ static void task_profiler_schedule_begin(struct parsec_execution_stream_s*    es
 static void task_profiler_schedule_end(struct parsec_execution_stream_s*     es,
                                        struct parsec_task_s*                 task,
                                        struct parsec_pins_next_callback_s*   cb_data);
+static void task_profiler_park_begin(struct parsec_execution_stream_s*    es,
+                                     struct parsec_task_s*                task,
+                                     struct parsec_pins_next_callback_s*  cb_data);
+static void task_profiler_park_end(struct parsec_execution_stream_s*     es,
+                                   struct parsec_task_s*                 task,
+                                   struct parsec_pins_next_callback_s*   cb_data);
 
 static void task_profiler_exec_count_begin(struct parsec_execution_stream_s*   es,
                                            struct parsec_task_s*               task,
@@ -104,7 +110,7 @@ static void pins_init_task_profiler(parsec_context_t *master_context)
         char *event = events[i];
         PARSEC_PINS_FLAG flag = parsec_pins_name_to_begin_flag(event);
         if (flag < PARSEC_PINS_FLAG_COUNT) {
-            parsec_pins_enable_mask |= flag;
+            parsec_pins_enable_mask |= PARSEC_PINS_FLAG_MASK(flag);
         }
         free(event);
         ++i;
@@ -166,6 +172,14 @@ static void pins_init_task_profiler(parsec_context_t *master_context)
                                                 &trace_keys[COMPLETE_EXEC_BEGIN],
                                                 &trace_keys[COMPLETE_EXEC_END]);
     }
+
+    if (PARSEC_PINS_FLAG_ENABLED(PARK_BEGIN)) {
+        parsec_profiling_add_dictionary_keyword("PARSEC RUNTIME::PARK", "fill:#CCCCCC",
+                                                0,
+                                                "",
+                                                &trace_keys[PARK_BEGIN],
+                                                &trace_keys[PARK_END]);
+    }
 }
 
 static void pins_fini_task_profiler(parsec_context_t *master_context)
@@ -232,6 +246,13 @@ static void pins_thread_init_task_profiler(struct parsec_execution_stream_s * es
         event_cb = (parsec_pins_next_callback_t*)malloc(sizeof(parsec_pins_next_callback_t));
         PARSEC_PINS_REGISTER(es, COMPLETE_EXEC_END, task_profiler_complete_exec_end, event_cb);
     }
+
+    if (PARSEC_PINS_FLAG_ENABLED(PARK_BEGIN)) {
+        event_cb = (parsec_pins_next_callback_t*)malloc(sizeof(parsec_pins_next_callback_t));
+        PARSEC_PINS_REGISTER(es, PARK_BEGIN, task_profiler_park_begin, event_cb);
+        event_cb = (parsec_pins_next_callback_t*)malloc(sizeof(parsec_pins_next_callback_t));
+        PARSEC_PINS_REGISTER(es, PARK_END, task_profiler_park_end, event_cb);
+    }
 }
 
 static void pins_thread_fini_task_profiler(struct parsec_execution_stream_s * es)
@@ -293,6 +314,13 @@ static void pins_thread_fini_task_profiler(struct parsec_execution_stream_s * es
         PARSEC_PINS_UNREGISTER(es, COMPLETE_EXEC_END, task_profiler_complete_exec_end, &event_cb);
         free(event_cb);
     }
+
+    if (PARSEC_PINS_FLAG_ENABLED(PARK_BEGIN)) {
+        PARSEC_PINS_UNREGISTER(es, PARK_BEGIN, task_profiler_park_begin, &event_cb);
+        free(event_cb);
+        PARSEC_PINS_UNREGISTER(es, PARK_END, task_profiler_park_end, &event_cb);
+        free(event_cb);
+    }
 }
 
 /*
@@ -492,6 +520,33 @@ task_profiler_complete_exec_end(struct parsec_execution_stream_s*   es,
     (void)cb_data;(void)task;
 }
 
+static void
+task_profiler_park_begin(struct parsec_execution_stream_s*   es,
+                         struct parsec_task_s*               task,
+                         struct parsec_pins_next_callback_s* cb_data)
+{
+    PARSEC_PROFILING_TRACE(es->es_profile,
+                           trace_keys[PARK_BEGIN],
+                           0,
+                           -1,
+                           NULL);
+
+    (void)cb_data;(void)task;
+}
+
+static void
+task_profiler_park_end(struct parsec_execution_stream_s*   es,
+                       struct parsec_task_s*               task,
+                       struct parsec_pins_next_callback_s* cb_data)
+{
+    PARSEC_PROFILING_TRACE(es->es_profile,
+                           trace_keys[PARK_END],
+                           0,
+                           -1,
+                           NULL);
+    (void)cb_data;(void)task;
+}
+
 static void
 task_profiler_exec_count_begin(struct parsec_execution_stream_s*   es,
                                struct parsec_task_s*               task,
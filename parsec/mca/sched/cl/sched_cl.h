@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * Chase-Lev work-stealing scheduler.
+ * Each thread owns a Chase-Lev deque of tasks: the owner pushes and pops
+ * at the bottom end with plain loads and stores (a CAS is only needed to
+ * take the last task), while thieves take tasks from the top end with a
+ * single CAS per task. A thief steals up to half of the tasks of its
+ * victim (bounded by the sched_cl_steal_batch MCA parameter) and keeps
+ * the extra tasks in its own deque.
+ * The rings provided to schedule() are pushed so that their highest
+ * priority task ends up at the bottom of the deque, and is thus selected
+ * first. Rings scheduled by a thread on another thread's stream (e.g. by
+ * the communication thread) are stored in a locked, priority-sorted
+ * inbox that the owner drains into its deque when the deque is empty,
+ * and that thieves can also steal from.
+ */
+
+
+#ifndef MCA_SCHED_CL_H
+#define MCA_SCHED_CL_H
+
+#include "parsec/parsec_config.h"
+#include "parsec/mca/mca.h"
+#include "parsec/mca/sched/sched.h"
+
+
+BEGIN_C_DECLS
+
+/**
+ * Globally exported variable
+ */
+PARSEC_DECLSPEC extern const parsec_sched_base_component_t parsec_sched_cl_component;
+PARSEC_DECLSPEC extern const parsec_sched_module_t parsec_sched_cl_module;
+/* static accessor */
+mca_base_component_t *sched_cl_static_component(void);
+
+/* MCA parameters */
+extern int sched_cl_steal_batch;
+extern int sched_cl_initial_capacity;
+
+
+END_C_DECLS
+#endif /* MCA_SCHED_CL_H */
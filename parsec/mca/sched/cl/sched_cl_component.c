@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ * 
+ * Additional copyrights may follow
+ * 
+ * $HEADER$
+ *
+ * These symbols are in a file by themselves to provide nice linker
+ * semantics.  Since linkers generally pull in symbols by object
+ * files, keeping these symbols as the only symbols in this file
+ * prevents utility programs such as "ompi_info" from having to import
+ * entire components just to query their version and parameters.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/runtime.h"
+
+#include "parsec/mca/sched/sched.h"
+#include "parsec/mca/sched/cl/sched_cl.h"
+#include "parsec/papi_sde.h"
+#include "parsec/utils/mca_param.h"
+
+/*
+ * Local function
+ */
+static int sched_cl_component_query(mca_base_module_t **module, int *priority);
+static int sched_cl_component_register(void);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+const parsec_sched_base_component_t parsec_sched_cl_component = {
+
+    /* First, the mca_component_t struct containing meta information
+       about the component itsell */
+
+    {
+        PARSEC_SCHED_BASE_VERSION_2_0_0,
+
+        /* Component name and version */
+        "cl",
+        "", /* options */
+        PARSEC_VERSION_MAJOR,
+        PARSEC_VERSION_MINOR,
+
+        /* Component open and close functions */
+        NULL, /*< No open: sched_cl is always available, no need to check at runtime */
+        NULL, /*< No close: open did not allocate any resource, no need to release them */
+        sched_cl_component_query, 
+        /*< specific query to return the module and add it to the list of available modules */
+        sched_cl_component_register, /*< Register at least the SDE events */
+        "", /*< no reserve */
+    },
+    {
+        /* The component has no metada */
+        MCA_BASE_METADATA_PARAM_NONE,
+        "", /*< no reserve */
+    }
+};
+mca_base_component_t *sched_cl_static_component(void)
+{
+    return (mca_base_component_t *)&parsec_sched_cl_component;
+}
+
+static int sched_cl_component_query(mca_base_module_t **module, int *priority)
+{
+    /* module type shoull be: const mca_base_module_t ** */
+    void *ptr = (void*)&parsec_sched_cl_module;
+    *priority = 1;
+    *module = (mca_base_module_t *)ptr;
+    return MCA_SUCCESS;
+}
+
+int sched_cl_steal_batch = 32;
+int sched_cl_initial_capacity = 256;
+
+static int sched_cl_component_register(void)
+{
+    parsec_mca_param_reg_int_name("sched_cl", "steal_batch",
+                                  "Maximum number of tasks stolen at once by the CL scheduler (a thief steals up to\n"
+                                  "half of the tasks of its victim, within this limit). 1 disables batch stealing.\n",
+                                  false, false, sched_cl_steal_batch, &sched_cl_steal_batch);
+    if( sched_cl_steal_batch < 1 ) sched_cl_steal_batch = 1;
+    parsec_mca_param_reg_int_name("sched_cl", "initial_capacity",
+                                  "Initial number of tasks each CL deque can hold before growing (rounded up to a power of 2).\n",
+                                  false, false, sched_cl_initial_capacity, &sched_cl_initial_capacity);
+
+    PARSEC_PAPI_SDE_DESCRIBE_COUNTER("SCHEDULER::PENDING_TASKS::SCHED=CL",
+                              "the number of pending tasks for the CL scheduler");
+    PARSEC_PAPI_SDE_DESCRIBE_COUNTER("SCHEDULER::PENDING_TASKS::QUEUE=<VPID>::SCHED=CL",
+                              "the number of pending tasks that end up in the virtual process <VPID> for the CL scheduler");
+    return MCA_SUCCESS;
+}
@@ -0,0 +1,437 @@
+/**
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/class/list.h"
+
+#include "parsec/mca/sched/sched.h"
+#include "parsec/mca/sched/cl/sched_cl.h"
+#include "parsec/mca/pins/pins.h"
+#include "parsec/papi_sde.h"
+
+/**
+ * Module functions
+ */
+static int sched_cl_install(parsec_context_t* master);
+static int sched_cl_schedule(parsec_execution_stream_t* es,
+                             parsec_task_t* new_context,
+                             int32_t distance);
+static parsec_task_t*
+sched_cl_select(parsec_execution_stream_t *es,
+                int32_t* distance);
+static void sched_cl_remove(parsec_context_t* master);
+static int flow_cl_init(parsec_execution_stream_t* es, struct parsec_barrier_t* barrier);
+
+const parsec_sched_module_t parsec_sched_cl_module = {
+    &parsec_sched_cl_component,
+    {
+        sched_cl_install,
+        flow_cl_init,
+        sched_cl_schedule,
+        sched_cl_select,
+        NULL,
+        sched_cl_remove
+    }
+};
+
+/**
+ * @brief circular array of a Chase-Lev deque
+ *
+ * @details the arrays are never released while the deque is in use: when
+ *   the owner grows the deque, the previous array is chained in prev, as
+ *   thieves might still be reading from it, and all arrays are released
+ *   when the deque is destroyed.
+ */
+typedef struct sched_cl_array_s {
+    struct sched_cl_array_s *prev;
+    int64_t                  mask;
+    parsec_list_item_t      *items[1];
+} sched_cl_array_t;
+
+/**
+ * @brief Chase-Lev work-stealing deque
+ *
+ * @details bottom is only written by the owner, top is only modified using
+ *   CAS, by the thieves or by the owner when it competes for the last item.
+ *   Both indexes grow monotonically, and the content of the deque is
+ *   [top, bottom[ (modulo the size of the array).
+ */
+typedef struct {
+    volatile int64_t            top;
+    char                        pad[64 - sizeof(int64_t)];
+    volatile int64_t            bottom;
+    sched_cl_array_t * volatile array;
+} sched_cl_deque_t;
+
+typedef struct {
+    sched_cl_deque_t deque;  /**< tasks scheduled by the owner */
+    parsec_list_t    inbox;  /**< tasks scheduled by other threads, or at a positive distance */
+} parsec_mca_sched_cl_object_t;
+
+#define PARSEC_MCA_SCHED_CL_OBJECT(es) ((parsec_mca_sched_cl_object_t*)(es)->scheduler_object)
+
+static sched_cl_array_t *sched_cl_array_new(int64_t size, sched_cl_array_t *prev)
+{
+    sched_cl_array_t *a = (sched_cl_array_t*)malloc(sizeof(sched_cl_array_t) +
+                                                    (size - 1) * sizeof(parsec_list_item_t*));
+    a->prev = prev;
+    a->mask = size - 1;
+    return a;
+}
+
+static void sched_cl_deque_construct(sched_cl_deque_t *d, int capacity)
+{
+    int64_t size = 2;
+    while( size < capacity ) size <<= 1;
+    d->top    = 0;
+    d->bottom = 0;
+    d->array  = sched_cl_array_new(size, NULL);
+}
+
+static void sched_cl_deque_destruct(sched_cl_deque_t *d)
+{
+    sched_cl_array_t *a = d->array, *prev;
+    assert(d->top >= d->bottom);
+    while( NULL != a ) {
+        prev = a->prev;
+        free(a);
+        a = prev;
+    }
+    d->array = NULL;
+}
+
+static inline int64_t sched_cl_deque_size(sched_cl_deque_t *d)
+{
+    int64_t size = d->bottom - d->top;
+    return size < 0 ? 0 : size;
+}
+
+/**
+ * @brief Push an item at the bottom of the deque. Owner only.
+ */
+static inline void sched_cl_deque_push(sched_cl_deque_t *d, parsec_list_item_t *item)
+{
+    int64_t b = d->bottom, t = d->top;
+    sched_cl_array_t *a = d->array;
+
+    if( b - t > a->mask ) {
+        /* The deque is full: double its size, keeping the items at the same
+         * indexes so that concurrent thieves remain correct */
+        sched_cl_array_t *na = sched_cl_array_new(2 * (a->mask + 1), a);
+        for( int64_t i = t; i < b; i++ )
+            na->items[i & na->mask] = a->items[i & a->mask];
+        parsec_atomic_wmb();
+        d->array = a = na;
+    }
+    a->items[b & a->mask] = item;
+    parsec_atomic_wmb();
+    d->bottom = b + 1;
+}
+
+/**
+ * @brief Pop the item at the bottom of the deque. Owner only.
+ */
+static inline parsec_list_item_t *sched_cl_deque_pop(sched_cl_deque_t *d)
+{
+    int64_t b = d->bottom - 1, t;
+    sched_cl_array_t *a = d->array;
+    parsec_list_item_t *item = NULL;
+
+    d->bottom = b;
+    parsec_mfence();  /* the write of bottom must be visible before reading top */
+    t = d->top;
+    if( t <= b ) {
+        item = a->items[b & a->mask];
+        if( t == b ) {
+            /* Last item: race with the thieves */
+            if( !parsec_atomic_cas_int64(&d->top, t, t + 1) )
+                item = NULL;
+            d->bottom = b + 1;
+        }
+    } else {
+        d->bottom = b + 1;
+    }
+    return item;
+}
+
+/**
+ * @brief Steal the item at the top of the deque. Any thread.
+ *
+ * @return the stolen item, or NULL if the deque is empty or if the item
+ *         was taken by another thread.
+ */
+static inline parsec_list_item_t *sched_cl_deque_steal(sched_cl_deque_t *d)
+{
+    int64_t t = d->top, b;
+    sched_cl_array_t *a;
+    parsec_list_item_t *item;
+
+    parsec_mfence();  /* read top before bottom */
+    b = d->bottom;
+    if( t >= b )
+        return NULL;
+    parsec_atomic_rmb();
+    a = d->array;
+    item = a->items[t & a->mask];
+    if( !parsec_atomic_cas_int64(&d->top, t, t + 1) )
+        return NULL;
+    return item;
+}
+
+/**
+ * @brief Push a ring of tasks in the deque of the owner, so that the highest
+ *   priority task is at the bottom of the deque, and is selected first.
+ *   Unsorted rings are sorted before being pushed.
+ */
+static void sched_cl_push_ring(parsec_mca_sched_cl_object_t *sched_obj, parsec_list_item_t *ring)
+{
+    parsec_list_item_t *item, *prev;
+
+    for( item = ring; item->list_next != ring; item = (parsec_list_item_t*)item->list_next ) {
+        if( A_HIGHER_PRIORITY_THAN_B(item->list_next, item, parsec_execution_context_priority_comparator) ) {
+            parsec_list_t sorted;
+            PARSEC_OBJ_CONSTRUCT(&sorted, parsec_list_t);
+            parsec_list_nolock_chain_sorted(&sorted, ring, parsec_execution_context_priority_comparator);
+            ring = parsec_list_nolock_unchain(&sorted);
+            PARSEC_OBJ_DESTRUCT(&sorted);
+            break;
+        }
+    }
+
+    /* Walk from the tail (lowest priority) to the head. Once pushed, an item
+     * can be stolen and its links overwritten: read them before. */
+    item = (parsec_list_item_t*)ring->list_prev;
+    do {
+        prev = (parsec_list_item_t*)item->list_prev;
+        sched_cl_deque_push(&sched_obj->deque, item);
+        if( item == ring ) break;
+        item = prev;
+    } while(1);
+}
+
+#if defined(PARSEC_PAPI_SDE)
+static long long int parsec_mca_sched_cl_length( parsec_vp_t *vp )
+{
+    int t;
+    long long int sum = 0;
+
+    for(t = 0; t < vp->nb_cores; t++) {
+        sum += sched_cl_deque_size(&PARSEC_MCA_SCHED_CL_OBJECT(vp->execution_streams[t])->deque);
+    }
+    return sum;
+}
+#endif
+
+/**
+ * @brief
+ *   Installs the scheduler on a parsec context
+ *
+ * @details
+ *   This function has nothing to do, as all operations are done in
+ *   init.
+ *
+ *  @param[INOUT] master the parsec_context_t on which this scheduler should be installed
+ *  @return PARSEC_SUCCESS iff this scheduler has been installed
+ */
+static int sched_cl_install( parsec_context_t *master )
+{
+    (void)master;
+    return PARSEC_SUCCESS;
+}
+
+/**
+ * @brief
+ *    Initialize the scheduler on the calling execution stream
+ *
+ * @details
+ *    Creates a deque and an inbox per execution stream, store them into
+ *    es->scheduling_object, and synchronize with the other execution streams
+ *    using the barrier
+ *
+ *  @param[INOUT] es      the calling execution stream
+ *  @param[INOUT] barrier the barrier used to synchronize all the es
+ *  @return PARSEC_SUCCESS in case of success, a negative number otherwise
+ */
+static int flow_cl_init(parsec_execution_stream_t* es, struct parsec_barrier_t* barrier)
+{
+    parsec_mca_sched_cl_object_t *sched_obj;
+
+    sched_obj = (parsec_mca_sched_cl_object_t*)calloc(1, sizeof(parsec_mca_sched_cl_object_t));
+    sched_cl_deque_construct(&sched_obj->deque, sched_cl_initial_capacity);
+    PARSEC_OBJ_CONSTRUCT(&sched_obj->inbox, parsec_list_t);
+    es->scheduler_object = sched_obj;
+
+    /* All local allocations are now completed. Synchronize with the other
+     threads before setting up the entire queues hierarchy. */
+    parsec_barrier_wait(barrier);
+
+#if defined(PARSEC_PAPI_SDE)
+    if( 0 == es->th_id ) {
+        char event_name[PARSEC_PAPI_SDE_MAX_COUNTER_NAME_LEN];
+        snprintf(event_name, PARSEC_PAPI_SDE_MAX_COUNTER_NAME_LEN, "SCHEDULER::PENDING_TASKS::QUEUE=%d::SCHED=CL", es->virtual_process->vp_id);
+        parsec_papi_sde_register_fp_counter(event_name, PAPI_SDE_RO|PAPI_SDE_INSTANT,
+                                     PAPI_SDE_int, (papi_sde_fptr_t)parsec_mca_sched_cl_length, es->virtual_process);
+        parsec_papi_sde_add_counter_to_group(event_name, "SCHEDULER::PENDING_TASKS", PAPI_SDE_SUM);
+        parsec_papi_sde_add_counter_to_group(event_name, "SCHEDULER::PENDING_TASKS::SCHED=CL", PAPI_SDE_SUM);
+    }
+#endif
+
+    return PARSEC_SUCCESS;
+}
+
+/**
+ * @brief
+ *   Steal a batch of tasks from a victim
+ *
+ * @details
+ *   Steal up to half of the tasks of the victim deque (within the
+ *   sched_cl_steal_batch limit), one CAS per task. The first task is
+ *   returned, the others are pushed into the thief own deque.
+ */
+static parsec_task_t* sched_cl_steal(parsec_mca_sched_cl_object_t *es_sched_obj,
+                                     parsec_mca_sched_cl_object_t *sched_obj)
+{
+    parsec_list_item_t *first, *item;
+    int64_t k = sched_cl_deque_size(&sched_obj->deque) / 2;
+
+    if( NULL == (first = sched_cl_deque_steal(&sched_obj->deque)) )
+        return NULL;
+    if( k > sched_cl_steal_batch ) k = sched_cl_steal_batch;
+    for( ; k > 1; k-- ) {
+        if( NULL == (item = sched_cl_deque_steal(&sched_obj->deque)) )
+            break;
+        sched_cl_deque_push(&es_sched_obj->deque, item);
+    }
+    return (parsec_task_t*)first;
+}
+
+/**
+ * @brief
+ *   Selects a task to run
+ *
+ * @details
+ *   Pop the bottom of the calling execution stream deque; if the deque is
+ *   empty, drain the inbox into the deque and retry. Otherwise, iterate over
+ *   all other execution streams, stealing from their deque first, and then
+ *   from their inbox, using the th_id as an index (modulo the number of
+ *   execution streams in this virtual process).
+ *
+ *   @param[INOUT] es     the calling execution stream
+ *   @param[OUT] distance the distance of the selected task. We return here
+ *                        how many victims were tried
+ *   @return the selected task
+ */
+static parsec_task_t* sched_cl_select(parsec_execution_stream_t *es,
+                                      int32_t* distance)
+{
+    parsec_mca_sched_cl_object_t *es_sched_obj = PARSEC_MCA_SCHED_CL_OBJECT(es);
+    parsec_mca_sched_cl_object_t *sched_obj;
+    parsec_vp_t *vp = es->virtual_process;
+    parsec_list_item_t *ring;
+    parsec_task_t *task;
+    int i, d = 0;
+
+    task = (parsec_task_t*)sched_cl_deque_pop(&es_sched_obj->deque);
+    if( NULL == task && !parsec_list_is_empty(&es_sched_obj->inbox) ) {
+        if( NULL != (ring = parsec_list_unchain(&es_sched_obj->inbox)) ) {
+            sched_cl_push_ring(es_sched_obj, ring);
+            task = (parsec_task_t*)sched_cl_deque_pop(&es_sched_obj->deque);
+        }
+    }
+    if( NULL != task ) {
+        *distance = 0;
+        return task;
+    }
+
+    for(i = (es->th_id + 1) % vp->nb_cores;
+        i != es->th_id;
+        i = (i+1) % vp->nb_cores) {
+        d++;
+        sched_obj = PARSEC_MCA_SCHED_CL_OBJECT(vp->execution_streams[i]);
+        task = sched_cl_steal(es_sched_obj, sched_obj);
+        if( NULL == task )
+            task = (parsec_task_t*)parsec_list_try_pop_front(&sched_obj->inbox);
+        if( NULL != task ) {
+            *distance = d;
+            return task;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief
+ *  Schedule a set of ready tasks on the calling execution stream
+ *
+ * @details
+ *  If the target execution stream is the calling one and the distance is 0,
+ *  push the tasks in its deque. Otherwise, chain them (sorted) into the inbox
+ *  of the target execution stream: the deque cannot be modified by other
+ *  threads, and tasks scheduled at a positive distance will only be
+ *  considered once the local deque is empty.
+ *
+ *   @param[INOUT] es          the target execution stream
+ *   @param[INOUT] new_context the ring of ready tasks to schedule
+ *   @param[IN] distance       the distance hint
+ *   @return PARSEC_SUCCESS in case of success, a negative number
+ *                          otherwise.
+ */
+static int sched_cl_schedule(parsec_execution_stream_t* es,
+                             parsec_task_t* new_context,
+                             int32_t distance)
+{
+    parsec_mca_sched_cl_object_t *sched_obj = PARSEC_MCA_SCHED_CL_OBJECT(es);
+
+    if( 0 == distance && es == parsec_my_execution_stream() ) {
+        sched_cl_push_ring(sched_obj, &new_context->super);
+    } else {
+        parsec_list_chain_sorted(&sched_obj->inbox, &new_context->super,
+                                 parsec_execution_context_priority_comparator);
+    }
+    return PARSEC_SUCCESS;
+}
+
+/**
+ * @brief
+ *  Removes the scheduler from the parsec_context_t
+ *
+ * @details
+ *  Release the deque and the inbox of each execution stream
+ *
+ *  @param[INOUT] master the parsec_context_t from which the scheduler should
+ *                       be removed
+ */
+static void sched_cl_remove( parsec_context_t *master )
+{
+    int p, t;
+    parsec_execution_stream_t *es;
+    parsec_vp_t *vp;
+    parsec_mca_sched_cl_object_t *sched_obj;
+
+    for(p = 0; p < master->nb_vp; p++) {
+        vp = master->virtual_processes[p];
+        for(t = 0; t < vp->nb_cores; t++) {
+            es = vp->execution_streams[t];
+            if (es != NULL) {
+                sched_obj = PARSEC_MCA_SCHED_CL_OBJECT(es);
+                sched_cl_deque_destruct(&sched_obj->deque);
+                PARSEC_OBJ_DESTRUCT(&sched_obj->inbox);
+                free(sched_obj);
+                es->scheduler_object = NULL;
+            }
+        }
+        PARSEC_PAPI_SDE_UNREGISTER_COUNTER("SCHEDULER::PENDING_TASKS::QUEUE=%d::SCHED=CL", vp->vp_id);
+    }
+    PARSEC_PAPI_SDE_UNREGISTER_COUNTER("SCHEDULER::PENDING_TASKS::SCHED=CL");
+}
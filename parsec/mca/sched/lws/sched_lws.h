@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * Locality-aware Work Stealing scheduler.
+ * Each thread maintains a LIFO of tasks, like the LL scheduler. When
+ * its own LIFO is empty, a thread steals from the other threads of its
+ * virtual process, visiting them by increasing topological distance
+ * (shared L2, shared L3, same NUMA domain, same socket, remote socket),
+ * as reported by hwloc. Within a locality level, the first victim is
+ * picked at random to spread the contention over all the LIFOs of that
+ * level. The distance returned by the selection is 1 + the locality
+ * level of the victim, so the steal distance can be monitored using
+ * the steal_distance PINS module.
+ */
+
+
+#ifndef MCA_SCHED_LWS_H
+#define MCA_SCHED_LWS_H
+
+#include "parsec/parsec_config.h"
+#include "parsec/mca/mca.h"
+#include "parsec/mca/sched/sched.h"
+
+
+BEGIN_C_DECLS
+
+/**
+ * Globally exported variable
+ */
+PARSEC_DECLSPEC extern const parsec_sched_base_component_t parsec_sched_lws_component;
+PARSEC_DECLSPEC extern const parsec_sched_module_t parsec_sched_lws_module;
+/* static accessor */
+mca_base_component_t *sched_lws_static_component(void);
+
+
+END_C_DECLS
+#endif /* MCA_SCHED_LWS_H */
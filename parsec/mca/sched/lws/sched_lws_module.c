@@ -0,0 +1,346 @@
+/**
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/class/lifo.h"
+
+#include "parsec/mca/sched/sched.h"
+#include "parsec/mca/sched/lws/sched_lws.h"
+#include "parsec/mca/pins/pins.h"
+#include "parsec/parsec_hwloc.h"
+#include "parsec/papi_sde.h"
+
+/**
+ * Module functions
+ */
+static int sched_lws_install(parsec_context_t* master);
+static int sched_lws_schedule(parsec_execution_stream_t* es,
+                              parsec_task_t* new_context,
+                              int32_t distance);
+static parsec_task_t*
+sched_lws_select(parsec_execution_stream_t *es,
+                 int32_t* distance);
+static void sched_lws_remove(parsec_context_t* master);
+static int flow_lws_init(parsec_execution_stream_t* es, struct parsec_barrier_t* barrier);
+static int sched_lws_warning_issued = 0;
+
+const parsec_sched_module_t parsec_sched_lws_module = {
+    &parsec_sched_lws_component,
+    {
+        sched_lws_install,
+        flow_lws_init,
+        sched_lws_schedule,
+        sched_lws_select,
+        NULL,
+        sched_lws_remove
+    }
+};
+
+/**
+ * @brief the per execution stream scheduling object
+ *
+ * @details the LIFO holds the ready tasks of this execution stream.
+ *   The other execution streams of the virtual process are stored in
+ *   victims, grouped by locality level: the victims of level l are
+ *   victims[level_start[l]] to victims[level_start[l+1]-1], and the
+ *   levels are sorted by increasing topological distance.
+ *
+ *   local_counter follows the same semantic as in the LL scheduler:
+ *   it counts the insertions / removals made by this thread, not the
+ *   number of items in this LIFO.
+ */
+typedef struct {
+    parsec_lifo_t lifo;
+    int           nb_levels;
+    int          *level_start;
+    int          *victims;
+#if defined(PARSEC_PAPI_SDE)
+    int           local_counter;
+#endif
+} parsec_mca_sched_lws_object_t;
+
+#define PARSEC_MCA_SCHED_LWS_OBJECT(es) ((parsec_mca_sched_lws_object_t*)(es)->scheduler_object)
+
+/* Core used to compute the topological distances: the core on which the
+ * stream is bound if any, the thread index otherwise (as the pbq
+ * and ltq schedulers do) */
+#define LWS_CORE(es) ( (es)->core_id >= 0 ? (es)->core_id : (es)->th_id )
+
+typedef struct {
+    int key;
+    int th_id;
+} lws_victim_t;
+
+static int lws_victim_compare(const void *a, const void *b)
+{
+    const lws_victim_t *va = (const lws_victim_t*)a;
+    const lws_victim_t *vb = (const lws_victim_t*)b;
+    if( va->key != vb->key )
+        return va->key < vb->key ? -1 : 1;
+    return va->th_id - vb->th_id;
+}
+
+/**
+ * @brief Compute the locality key between two execution streams
+ *
+ * @details The key is ordered like the sharing level: parsec_hwloc_distance
+ *   grows with the depth of the first common ancestor (L2, L3, socket, machine),
+ *   and streams on different NUMA domains under the same ancestor (e.g.
+ *   sub-NUMA clustering) are pushed after the ones that share the NUMA domain.
+ *   Without hwloc, all keys are 0 and stealing becomes uniformly random.
+ */
+static int lws_locality_key(parsec_execution_stream_t *es, parsec_execution_stream_t *victim)
+{
+    int key = 2 * parsec_hwloc_distance(LWS_CORE(es), LWS_CORE(victim));
+    if( parsec_hwloc_numa_id(LWS_CORE(es)) != parsec_hwloc_numa_id(LWS_CORE(victim)) )
+        key++;
+    return key;
+}
+
+#if defined(PARSEC_PAPI_SDE)
+static long long int parsec_mca_sched_lws_length( parsec_vp_t *vp )
+{
+    int t;
+    long long int sum = 0;
+
+    for(t = 0; t < vp->nb_cores; t++) {
+        sum += PARSEC_MCA_SCHED_LWS_OBJECT(vp->execution_streams[t])->local_counter;
+    }
+    return sum;
+}
+#endif
+
+/**
+ * @brief
+ *   Installs the scheduler on a parsec context
+ *
+ * @details
+ *   This function has nothing to do, as all operations are done in
+ *   init.
+ *
+ *  @param[INOUT] master the parsec_context_t on which this scheduler should be installed
+ *  @return PARSEC_SUCCESS iff this scheduler has been installed
+ */
+static int sched_lws_install( parsec_context_t *master )
+{
+    sched_lws_warning_issued = 0;
+    (void)master;
+    return PARSEC_SUCCESS;
+}
+
+/**
+ * @brief
+ *    Initialize the scheduler on the calling execution stream
+ *
+ * @details
+ *    Creates a LIFO per execution stream, store it into es->scheduling_object,
+ *    synchronize with the other execution streams using the barrier, then
+ *    sort the other execution streams of the virtual process by locality
+ *    level to build the victims list.
+ *
+ *  @param[INOUT] es      the calling execution stream
+ *  @param[INOUT] barrier the barrier used to synchronize all the es
+ *  @return PARSEC_SUCCESS in case of success, a negative number otherwise
+ */
+static int flow_lws_init(parsec_execution_stream_t* es, struct parsec_barrier_t* barrier)
+{
+    parsec_mca_sched_lws_object_t *sched_obj;
+    parsec_vp_t *vp = es->virtual_process;
+    lws_victim_t *order;
+    int t, n, l;
+
+    sched_obj = (parsec_mca_sched_lws_object_t*)calloc(1, sizeof(parsec_mca_sched_lws_object_t));
+    PARSEC_OBJ_CONSTRUCT(&sched_obj->lifo, parsec_lifo_t);
+    es->scheduler_object = sched_obj;
+
+    /* All local allocations are now completed, and all execution streams
+     * know their binding. Synchronize with the other threads before
+     * looking at their topology. */
+    parsec_barrier_wait(barrier);
+
+    order = (lws_victim_t*)malloc(vp->nb_cores * sizeof(lws_victim_t));
+    for(n = 0, t = 0; t < vp->nb_cores; t++) {
+        if( t == es->th_id ) continue;
+        order[n].key   = lws_locality_key(es, vp->execution_streams[t]);
+        order[n].th_id = t;
+        n++;
+    }
+    qsort(order, n, sizeof(lws_victim_t), lws_victim_compare);
+
+    sched_obj->victims     = (int*)malloc((n + 1) * sizeof(int));
+    sched_obj->level_start = (int*)malloc((n + 1) * sizeof(int));
+    sched_obj->nb_levels   = 0;
+    for(t = 0; t < n; t++) {
+        if( 0 == t || order[t].key != order[t-1].key ) {
+            sched_obj->level_start[sched_obj->nb_levels++] = t;
+        }
+        sched_obj->victims[t] = order[t].th_id;
+    }
+    sched_obj->level_start[sched_obj->nb_levels] = n;
+    free(order);
+
+    for(l = 0; l < sched_obj->nb_levels; l++) {
+        PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "LWS %d:%d (core %d): locality level %d has %d victims, starting with %d",
+                             vp->vp_id, es->th_id, LWS_CORE(es), l,
+                             sched_obj->level_start[l+1] - sched_obj->level_start[l],
+                             sched_obj->victims[sched_obj->level_start[l]]);
+    }
+
+#if defined(PARSEC_PAPI_SDE)
+    if( 0 == es->th_id ) {
+        char event_name[PARSEC_PAPI_SDE_MAX_COUNTER_NAME_LEN];
+        snprintf(event_name, PARSEC_PAPI_SDE_MAX_COUNTER_NAME_LEN, "SCHEDULER::PENDING_TASKS::QUEUE=%d::SCHED=LWS", vp->vp_id);
+        parsec_papi_sde_register_fp_counter(event_name, PAPI_SDE_RO|PAPI_SDE_INSTANT,
+                                     PAPI_SDE_int, (papi_sde_fptr_t)parsec_mca_sched_lws_length, vp);
+        parsec_papi_sde_add_counter_to_group(event_name, "SCHEDULER::PENDING_TASKS", PAPI_SDE_SUM);
+        parsec_papi_sde_add_counter_to_group(event_name, "SCHEDULER::PENDING_TASKS::SCHED=LWS", PAPI_SDE_SUM);
+    }
+#endif
+
+    return PARSEC_SUCCESS;
+}
+
+/**
+ * @brief
+ *   Selects a task to run
+ *
+ * @details
+ *   Take the head of the calling execution stream LIFO as the selected task;
+ *   if that LIFO is empty, try the victims level by level, from the closest
+ *   to the farthest. Inside a level, the victims are visited in a circular
+ *   order starting from a random one.
+ *
+ *   @param[INOUT] es     the calling execution stream
+ *   @param[OUT] distance the distance of the selected task: 0 if it comes
+ *                        from the local LIFO, 1 + the locality level of the
+ *                        victim otherwise
+ *   @return the selected task
+ */
+static parsec_task_t* sched_lws_select(parsec_execution_stream_t *es,
+                                       int32_t* distance)
+{
+    parsec_mca_sched_lws_object_t *es_sched_obj = PARSEC_MCA_SCHED_LWS_OBJECT(es);
+    parsec_vp_t *vp = es->virtual_process;
+    parsec_task_t *task;
+    int l, i, n, start;
+
+    task = (parsec_task_t*)parsec_lifo_pop(&es_sched_obj->lifo);
+    if( NULL != task ) {
+        *distance = 0;
+        goto found;
+    }
+    for(l = 0; l < es_sched_obj->nb_levels; l++) {
+        int *victims = es_sched_obj->victims + es_sched_obj->level_start[l];
+        n = es_sched_obj->level_start[l+1] - es_sched_obj->level_start[l];
+        start = (n > 1) ? (int)(rand_r(&es->rand_seed) % n) : 0;
+        for(i = 0; i < n; i++) {
+            parsec_mca_sched_lws_object_t *sched_obj =
+                PARSEC_MCA_SCHED_LWS_OBJECT(vp->execution_streams[victims[(start + i) % n]]);
+            task = (parsec_task_t*)parsec_lifo_pop(&sched_obj->lifo);
+            if( NULL != task ) {
+                *distance = l + 1;
+                goto found;
+            }
+        }
+    }
+    return NULL;
+
+  found:
+#if defined(PARSEC_PAPI_SDE)
+    es_sched_obj->local_counter--;
+#endif
+    return task;
+}
+
+/**
+ * @brief
+ *  Schedule a set of ready tasks on the calling execution stream
+ *
+ * @details
+ *  Chain the set of tasks into the local LIFO of the calling es if the
+ *  distance is 0. Otherwise, the tasks are pushed in the LIFO of the first
+ *  victim of the locality level matching the distance (or the farthest
+ *  level), so that the tasks remain reachable by the other threads of the
+ *  same locality domain.
+ *
+ *   @param[INOUT] es          the calling execution stream
+ *   @param[INOUT] new_context the ring of ready tasks to schedule
+ *   @param[IN] distance       the distance hint
+ *   @return PARSEC_SUCCESS in case of success, a negative number
+ *                          otherwise.
+ */
+static int sched_lws_schedule(parsec_execution_stream_t* es,
+                              parsec_task_t* new_context,
+                              int32_t distance)
+{
+    parsec_mca_sched_lws_object_t *es_sched_obj = PARSEC_MCA_SCHED_LWS_OBJECT(es);
+    parsec_mca_sched_lws_object_t *sched_obj = es_sched_obj;
+#if defined(PARSEC_PAPI_SDE)
+    int len = 0;
+    _LIST_ITEM_ITERATOR(new_context, &new_context->super, item, {len++; });
+    es_sched_obj->local_counter += len;
+#endif
+    if( distance > 0 ) {
+        parsec_vp_t *vp = es->virtual_process;
+        if( 0 == es_sched_obj->nb_levels ) {
+            if( 0 == sched_lws_warning_issued ) {
+                parsec_warning("Locality-aware Work Stealing scheduler is unable to implement active wait with a single thread.\n"
+                               "This run is at risk of live-lock\n");
+                sched_lws_warning_issued = 1;
+            }
+        } else {
+            int l = distance - 1;
+            if( l >= es_sched_obj->nb_levels )
+                l = es_sched_obj->nb_levels - 1;
+            sched_obj = PARSEC_MCA_SCHED_LWS_OBJECT(vp->execution_streams[es_sched_obj->victims[es_sched_obj->level_start[l]]]);
+        }
+    }
+    parsec_lifo_chain(&sched_obj->lifo, (parsec_list_item_t*)new_context);
+    return PARSEC_SUCCESS;
+}
+
+/**
+ * @brief
+ *  Removes the scheduler from the parsec_context_t
+ *
+ * @details
+ *  Release the LIFO and the victims list of each execution stream
+ *
+ *  @param[INOUT] master the parsec_context_t from which the scheduler should
+ *                       be removed
+ */
+static void sched_lws_remove( parsec_context_t *master )
+{
+    int p, t;
+    parsec_execution_stream_t *es;
+    parsec_vp_t *vp;
+    parsec_mca_sched_lws_object_t *sched_obj;
+
+    for(p = 0; p < master->nb_vp; p++) {
+        vp = master->virtual_processes[p];
+        for(t = 0; t < vp->nb_cores; t++) {
+            es = vp->execution_streams[t];
+            if (es != NULL) {
+                sched_obj = PARSEC_MCA_SCHED_LWS_OBJECT(es);
+                PARSEC_OBJ_DESTRUCT(&sched_obj->lifo);
+                free(sched_obj->victims);
+                free(sched_obj->level_start);
+                free(sched_obj);
+                es->scheduler_object = NULL;
+            }
+        }
+        PARSEC_PAPI_SDE_UNREGISTER_COUNTER("SCHEDULER::PENDING_TASKS::QUEUE=%d::SCHED=LWS", vp->vp_id);
+    }
+    PARSEC_PAPI_SDE_UNREGISTER_COUNTER("SCHEDULER::PENDING_TASKS::SCHED=LWS");
+}
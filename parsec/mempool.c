@@ -6,9 +6,175 @@
 
 #include "parsec/runtime.h"
 #include "mempool.h"
+#include "parsec/sys/atomic.h"
+#include "parsec/sys/tls.h"
+#include "parsec/utils/debug.h"
 #ifdef PARSEC_HAVE_STRING_H
 #include <string.h>
 #endif
+#include <unistd.h>
+#include <inttypes.h>
+
+size_t parsec_mempool_slab_size = 0;
+
+/**
+ * Header of a slab: a page-aligned block of memory carved into elements.
+ * Slabs are chained on the thread mempool that carved them and are
+ * released when the mempool is destructed.
+ */
+typedef struct parsec_mempool_slab_s {
+    struct parsec_mempool_slab_s *next;
+    uint32_t                      nb_elt;
+} parsec_mempool_slab_t;
+
+/* Elements of a slab are aligned on cache lines, to avoid false sharing
+ * between elements in use by different threads */
+#define PARSEC_MEMPOOL_SLAB_ALIGNMENT 64
+#define PARSEC_MEMPOOL_SLAB_ROUND(s)  (((s) + PARSEC_MEMPOOL_SLAB_ALIGNMENT - 1) & ~((size_t)PARSEC_MEMPOOL_SLAB_ALIGNMENT - 1))
+#define PARSEC_MEMPOOL_SLAB_HEADER    PARSEC_MEMPOOL_SLAB_ROUND(sizeof(parsec_mempool_slab_t))
+
+/* Identify the threads releasing elements: any non NULL value unique to
+ * the thread will do, so each thread takes a ticket the first time */
+static PARSEC_TLS_DECLARE(parsec_mempool_tls_token);
+static int parsec_mempool_tls_initialized = 0;
+static int32_t parsec_mempool_last_token = 0;
+
+static inline void *parsec_mempool_thread_token(void)
+{
+    void *token = PARSEC_TLS_GET_SPECIFIC(parsec_mempool_tls_token);
+    if( NULL == token ) {
+        token = (void*)(intptr_t)(parsec_atomic_fetch_inc_int32(&parsec_mempool_last_token) + 1);
+        PARSEC_TLS_SET_SPECIFIC(parsec_mempool_tls_token, token);
+    }
+    return token;
+}
+
+static inline void parsec_thread_mempool_init_elt( parsec_thread_mempool_t *thread_mempool,
+                                                   parsec_list_item_t *elt )
+{
+    parsec_thread_mempool_t **owner;
+
+    PARSEC_OBJ_CONSTRUCT(elt, parsec_list_item_t);
+    owner = (parsec_thread_mempool_t **)((char*)elt + thread_mempool->parent->pool_owner_offset);
+    *owner = thread_mempool;
+    if( NULL != thread_mempool->parent->obj_class ) {
+        PARSEC_OBJ_CONSTRUCT_INTERNAL(elt, thread_mempool->parent->obj_class);
+    }
+}
+
+/**
+ * Carves a new slab for the thread mempool, keeps one element for the
+ * caller and pushes all the others in the LIFO. The elements are
+ * constructed here, hence first touched by the calling thread.
+ */
+static void *parsec_thread_mempool_carve_slab( parsec_thread_mempool_t *thread_mempool )
+{
+    parsec_mempool_t *mempool = thread_mempool->parent;
+    size_t stride = mempool->slab_stride;
+    parsec_list_item_t *elt, *ring = NULL;
+    parsec_mempool_slab_t *slab;
+    void *memory = NULL;
+    uint32_t nb, i;
+    int rc;
+
+    nb = 1;
+    if( mempool->slab_size > PARSEC_MEMPOOL_SLAB_HEADER + stride )
+        nb = (mempool->slab_size - PARSEC_MEMPOOL_SLAB_HEADER) / stride;
+    if( thread_mempool->nb_reserved > (uint32_t)thread_mempool->nb_elt + nb )
+        nb = thread_mempool->nb_reserved - (uint32_t)thread_mempool->nb_elt;
+
+    rc = posix_memalign(&memory, (size_t)sysconf(_SC_PAGESIZE), PARSEC_MEMPOOL_SLAB_HEADER + nb * stride);
+    assert( 0 == rc && NULL != memory ); (void)rc;
+    slab = (parsec_mempool_slab_t*)memory;
+    slab->nb_elt = nb;
+    do {
+        slab->next = (parsec_mempool_slab_t*)thread_mempool->slabs;
+    } while( !parsec_atomic_cas_ptr(&thread_mempool->slabs, slab->next, slab) );
+
+    for( i = 1; i < nb; i++ ) {
+        elt = (parsec_list_item_t*)((char*)slab + PARSEC_MEMPOOL_SLAB_HEADER + i * stride);
+        parsec_thread_mempool_init_elt(thread_mempool, elt);
+        PARSEC_LIST_ITEM_SINGLETON(elt);
+        if( NULL == ring ) ring = elt;
+        else parsec_list_item_ring_push(ring, elt);
+    }
+    if( NULL != ring )
+        parsec_lifo_chain(&thread_mempool->mempool, ring);
+
+    elt = (parsec_list_item_t*)((char*)slab + PARSEC_MEMPOOL_SLAB_HEADER);
+    parsec_thread_mempool_init_elt(thread_mempool, elt);
+    (void)parsec_atomic_fetch_add_int32(&thread_mempool->nb_elt, (int32_t)nb);
+    return elt;
+}
+
+/**
+ * Raise the high water mark to in_use. Threads other than the owner allocate
+ * from the same thread mempool, so the update is a CAS loop.
+ */
+static inline void parsec_thread_mempool_update_high_water( parsec_thread_mempool_t *thread_mempool,
+                                                           int32_t in_use )
+{
+    int32_t high_water;
+    do {
+        high_water = thread_mempool->high_water;
+        if( in_use <= high_water ) return;
+    } while( !parsec_atomic_cas_int32(&thread_mempool->high_water, high_water, in_use) );
+}
+
+/**
+ * Detaches the stack of elements released by other threads. Returns NULL
+ * if it is empty.
+ */
+static parsec_list_item_t *parsec_thread_mempool_take_remote( parsec_thread_mempool_t *thread_mempool )
+{
+    parsec_list_item_t *head;
+    do {
+        head = thread_mempool->remote_free;
+        if( NULL == head ) return NULL;
+    } while( !parsec_atomic_cas_ptr(&thread_mempool->remote_free, head, NULL) );
+    return head;
+}
+
+/**
+ * Gives back to the LIFO, in a single operation, the elements released by
+ * other threads except the first one, which is returned. Sets *nb to the
+ * number of elements taken back.
+ */
+static void *parsec_thread_mempool_reclaim_remote( parsec_thread_mempool_t *thread_mempool, uint32_t *nb )
+{
+    parsec_list_item_t *head, *elt, *next, *ring = NULL;
+
+    *nb = 0;
+    if( NULL == (head = parsec_thread_mempool_take_remote(thread_mempool)) )
+        return NULL;
+    for( elt = (parsec_list_item_t*)head->list_next; NULL != elt; elt = next ) {
+        next = (parsec_list_item_t*)elt->list_next;
+        PARSEC_LIST_ITEM_SINGLETON(elt);
+        if( NULL == ring ) ring = elt;
+        else parsec_list_item_ring_push(ring, elt);
+        (*nb)++;
+    }
+    if( NULL != ring )
+        parsec_lifo_chain(&thread_mempool->mempool, ring);
+    (*nb)++;
+    parsec_atomic_fetch_add_int64(&thread_mempool->nb_remote_free, *nb);
+    return head;
+}
+
+void parsec_thread_mempool_free_to_slab( parsec_thread_mempool_t *thread_mempool, void *elt )
+{
+    parsec_list_item_t *item = (parsec_list_item_t*)elt, *head;
+
+    if( thread_mempool->owner == PARSEC_TLS_GET_SPECIFIC(parsec_mempool_tls_token) ) {
+        thread_mempool->nb_local_free++;
+        parsec_lifo_push(&thread_mempool->mempool, item);
+        return;
+    }
+    do {
+        head = thread_mempool->remote_free;
+        item->list_next = head;
+    } while( !parsec_atomic_cas_ptr(&thread_mempool->remote_free, head, item) );
+}
 
 /** parsec_thread_mempool_construct
  *    constructs the thread-specific memory pool.
@@ -21,9 +187,50 @@ static void parsec_thread_mempool_construct( parsec_thread_mempool_t *thread_mem
     thread_mempool->nb_elt = 0;
 }
 
+/**
+ * Releases the slabs of a thread mempool if all their elements came back.
+ * Otherwise, the slabs are leaked, as some elements are still in use.
+ */
+static void parsec_thread_mempool_destruct_slabs( parsec_thread_mempool_t *thread_mempool )
+{
+    parsec_list_item_t *elt, *next;
+    parsec_mempool_slab_t *slab;
+    uint64_t nb_back = 0, nb_carved = 0;
+
+    while(NULL != (elt = parsec_lifo_pop(&thread_mempool->mempool))) {
+        if(NULL != thread_mempool->parent->obj_class)
+            PARSEC_OBJ_DESTRUCT(elt);
+        nb_back++;
+    }
+    for( elt = parsec_thread_mempool_take_remote(thread_mempool); NULL != elt; elt = next ) {
+        next = (parsec_list_item_t*)elt->list_next;
+        if(NULL != thread_mempool->parent->obj_class)
+            PARSEC_OBJ_DESTRUCT(elt);
+        nb_back++;
+    }
+    for( slab = (parsec_mempool_slab_t*)thread_mempool->slabs; NULL != slab; slab = slab->next )
+        nb_carved += slab->nb_elt;
+    if( nb_back != nb_carved ) {
+        PARSEC_DEBUG_VERBOSE(4, parsec_debug_output, "Mempool %p: %"PRIu64" elements out of %"PRIu64" are still in use, "
+                             "their slabs are not released", thread_mempool, nb_carved - nb_back, nb_carved);
+    } else {
+        while( NULL != (slab = (parsec_mempool_slab_t*)thread_mempool->slabs) ) {
+            thread_mempool->slabs = slab->next;
+            free(slab);
+        }
+    }
+    thread_mempool->slabs = NULL;
+    PARSEC_OBJ_DESTRUCT(&thread_mempool->mempool);
+}
+
 static void parsec_thread_mempool_destruct( parsec_thread_mempool_t *thread_mempool )
 {
     void *elt;
+
+    if( 0 != thread_mempool->parent->slab_size ) {
+        parsec_thread_mempool_destruct_slabs(thread_mempool);
+        return;
+    }
     while(NULL != (elt = parsec_lifo_pop(&thread_mempool->mempool))) {
         if(NULL != thread_mempool->parent->obj_class) {
             parsec_lifo_item_free(elt);
@@ -41,11 +248,20 @@ void parsec_mempool_construct( parsec_mempool_t *mempool,
 {
     uint32_t tid;
 
+    if( !parsec_mempool_tls_initialized ) {
+        /* The first mempools are constructed during parsec_init, before
+         * any other thread can use them */
+        parsec_mempool_tls_initialized = 1;
+        PARSEC_TLS_KEY_CREATE(parsec_mempool_tls_token);
+    }
+
     mempool->nb_thread_mempools = nbthreads;
     mempool->elt_size = elt_size < sizeof(parsec_list_item_t) ? sizeof(parsec_list_item_t) : elt_size;
     mempool->pool_owner_offset = pool_offset;
     mempool->nb_max_elt = 0;
     mempool->obj_class = obj_class;
+    mempool->slab_size = parsec_mempool_slab_size;
+    mempool->slab_stride = PARSEC_MEMPOOL_SLAB_ROUND(mempool->elt_size);
     mempool->thread_mempools = (parsec_thread_mempool_t *)malloc(sizeof(parsec_thread_mempool_t) * nbthreads);
     memset( mempool->thread_mempools, 0, sizeof(parsec_thread_mempool_t) * nbthreads );
 
@@ -58,6 +274,16 @@ uint64_t parsec_mempool_destruct( parsec_mempool_t *mempool )
     uint32_t tid;
     uint64_t usage_counter = 0;
 
+#if defined(PARSEC_DEBUG_NOISIER)
+    if( 0 != mempool->slab_size ) {
+        parsec_mempool_usage_t usage;
+        parsec_mempool_usage(mempool, &usage);
+        PARSEC_DEBUG_VERBOSE(20, parsec_debug_output, "Mempool %p (elements of %zu bytes): %"PRIu64" elements, high water %"PRIu64", "
+                             "%"PRIu64" local and %"PRIu64" cross-thread frees", mempool, mempool->elt_size,
+                             usage.nb_elt, usage.high_water, usage.nb_local_free, usage.nb_remote_free);
+    }
+#endif  /* defined(PARSEC_DEBUG_NOISIER) */
+
     for(tid = 0; tid < mempool->nb_thread_mempools; tid++) {
         usage_counter += mempool->thread_mempools[tid].nb_elt;
         parsec_thread_mempool_destruct(&mempool->thread_mempools[tid]);
@@ -79,12 +305,53 @@ void *parsec_thread_mempool_allocate_when_empty( parsec_thread_mempool_t *thread
     void *elt;
     parsec_thread_mempool_t **owner;
 
+    if( 0 != thread_mempool->parent->slab_size ) {
+        uint32_t nb;
+        if( NULL == thread_mempool->owner ) {
+            (void)parsec_atomic_cas_ptr(&thread_mempool->owner, NULL, parsec_mempool_thread_token());
+        }
+        elt = parsec_thread_mempool_reclaim_remote(thread_mempool, &nb);
+        /* The LIFO is empty: all the elements that are not on the remote
+         * stack are in use */
+        parsec_thread_mempool_update_high_water(thread_mempool, thread_mempool->nb_elt - (int32_t)nb);
+        if( NULL != elt )
+            return elt;
+        return parsec_thread_mempool_carve_slab(thread_mempool);
+    }
+
     elt = parsec_lifo_item_alloc(&thread_mempool->mempool, thread_mempool->parent->elt_size );
     owner = (parsec_thread_mempool_t **)((char*)elt + thread_mempool->parent->pool_owner_offset);
     *owner = thread_mempool;
     if( NULL != thread_mempool->parent->obj_class ) {
         PARSEC_OBJ_CONSTRUCT_INTERNAL(elt, thread_mempool->parent->obj_class);
     }
-    thread_mempool->nb_elt++;
+    (void)parsec_atomic_fetch_inc_int32(&thread_mempool->nb_elt);
     return elt;
 }
+
+void parsec_mempool_reserve( parsec_mempool_t *mempool, uint32_t nb_elt )
+{
+    uint32_t tid, share;
+
+    if( 0 == mempool->slab_size || 0 == mempool->nb_thread_mempools )
+        return;
+    share = (nb_elt + mempool->nb_thread_mempools - 1) / mempool->nb_thread_mempools;
+    for(tid = 0; tid < mempool->nb_thread_mempools; tid++) {
+        if( share > mempool->thread_mempools[tid].nb_reserved )
+            mempool->thread_mempools[tid].nb_reserved = share;
+    }
+}
+
+void parsec_mempool_usage( const parsec_mempool_t *mempool, parsec_mempool_usage_t *usage )
+{
+    uint32_t tid;
+
+    memset(usage, 0, sizeof(parsec_mempool_usage_t));
+    for(tid = 0; tid < mempool->nb_thread_mempools; tid++) {
+        const parsec_thread_mempool_t *thread_mempool = &mempool->thread_mempools[tid];
+        usage->nb_elt         += thread_mempool->nb_elt;
+        usage->high_water     += thread_mempool->high_water;
+        usage->nb_local_free  += thread_mempool->nb_local_free;
+        usage->nb_remote_free += thread_mempool->nb_remote_free;
+    }
+}
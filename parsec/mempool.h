@@ -18,6 +18,13 @@ BEGIN_C_DECLS
 
 typedef struct parsec_mempool_s parsec_mempool_t;
 
+/**
+ * Size in bytes of the slabs carved by the mempools constructed from now on
+ * (runtime_mempool_slab_size MCA parameter). When 0, each element is
+ * allocated separately.
+ */
+PARSEC_DECLSPEC extern size_t parsec_mempool_slab_size;
+
 /**
  * each element that is allocated from a mempool must
  * keep somewhere a pointer to the thread_mempool that allocated it
@@ -40,15 +47,50 @@ struct parsec_mempool_s {
     volatile uint32_t       nb_max_elt;         /**< this reflects the maximum of the nb_elt of the other threads */
     parsec_class_t          *obj_class;         /**< the base class of the objects inside the mempool */
     parsec_thread_mempool_t *thread_mempools;   /**< Array of thread mempools (of size nb_thread_mempools) */
+    size_t                  slab_size;          /**< Size of the slabs carved by the thread mempools,
+                                                 *   0 if elements are allocated one by one */
+    size_t                  slab_stride;        /**< Distance between two elements of a slab */
 };
 
+/**
+ * When the mempool uses slabs, each thread mempool carves whole
+ * page-aligned slabs and constructs the elements from the thread that
+ * ran out of elements, so that the pages are first touched (and thus
+ * placed) on the NUMA node of that thread. The first thread to carve a
+ * slab becomes the owner of the thread mempool: elements it releases go
+ * straight back to the LIFO, elements released by other threads are
+ * pushed on a separate remote stack, and given back to the LIFO in a
+ * single batch the next time the thread mempool runs dry.
+ */
 struct parsec_thread_mempool_s {
     parsec_mempool_t  *parent;   /**<  back pointer to the mempool */
-    uint32_t nb_elt;             /**< this is the number of elements this thread
-                                  *   has allocated since the creation of the pool */
+    volatile int32_t nb_elt;     /**< this is the number of elements this thread mempool
+                                  *   has allocated since the creation of the pool. Any
+                                  *   thread can allocate from it, updated atomically */
     parsec_lifo_t mempool;       /**< Elements are stored in a LIFO */
+    parsec_list_item_t * volatile remote_free; /**< Elements released by other threads (slabs only) */
+    void * volatile owner;       /**< Token of the owner thread (slabs only) */
+    void * volatile slabs;       /**< Slabs carved by this thread mempool */
+    uint32_t nb_reserved;        /**< Number of elements to carve at once the next time
+                                  *   the thread mempool runs dry */
+    volatile int32_t high_water; /**< Highest number of elements observed in use at once,
+                                  *   sampled each time the thread mempool runs dry */
+    uint64_t nb_local_free;      /**< Elements released by the owner thread */
+    volatile int64_t nb_remote_free; /**< Elements released by other threads */
 };
 
+/**
+ * Usage statistics of a mempool, summed over its thread mempools.
+ * The high water mark and the free counters are only maintained by
+ * mempools that use slabs.
+ */
+typedef struct parsec_mempool_usage_s {
+    uint64_t nb_elt;             /**< Elements allocated by the thread mempools */
+    uint64_t high_water;         /**< Sum of the high water marks of the thread mempools */
+    uint64_t nb_local_free;      /**< Elements released by the thread that owns them */
+    uint64_t nb_remote_free;     /**< Elements released by another thread */
+} parsec_mempool_usage_t;
+
 /**
  * @brief constructs a mempool
  *
@@ -110,6 +152,19 @@ void parsec_mempool_construct( parsec_mempool_t *mempool,
  */
 void *parsec_thread_mempool_allocate_when_empty( parsec_thread_mempool_t *thread_mempool );
 
+/**
+ * @brief returns an element to a thread-mempool that uses slabs
+ *
+ * @details
+ *    Internal function, called by parsec_thread_mempool_free.
+ *    Elements released by the owner of the thread mempool are pushed
+ *    back in the LIFO, the others on the remote stack.
+ *
+ * @param[inout] thread_mempool the thread-mempool to which elt should be returned
+ * @param[inout] elt the element to free
+ */
+void parsec_thread_mempool_free_to_slab( parsec_thread_mempool_t *thread_mempool, void *elt );
+
 /**
  * @brief allocate an element from a mempool
  *
@@ -147,6 +202,10 @@ static inline void  parsec_thread_mempool_free( parsec_thread_mempool_t *thread_
     assert(owner == thread_mempool);
 #endif // PARSEC_DEBUG_ENABLE
 
+    if( 0 != thread_mempool->parent->slab_size ) {
+        parsec_thread_mempool_free_to_slab( thread_mempool, elt );
+        return;
+    }
     parsec_lifo_push( &(thread_mempool->mempool), (parsec_list_item_t*)elt );
 }
 
@@ -185,6 +244,27 @@ static inline void  parsec_mempool_free( parsec_mempool_t *mempool, void *elt )
  */
 uint64_t parsec_mempool_destruct( parsec_mempool_t *mempool );
 
+/**
+ * @brief prepares a mempool for an expected number of elements in use
+ *
+ * @details
+ *    Each thread mempool carves its share of nb_elt elements in a single
+ *    slab the next time it runs dry, from the thread that needs them.
+ *    This has no effect on mempools that do not use slabs.
+ *
+ * @param[inout] mempool the mempool to pre-warm
+ * @param[in] nb_elt the number of elements expected in use at once
+ */
+void parsec_mempool_reserve( parsec_mempool_t *mempool, uint32_t nb_elt );
+
+/**
+ * @brief collects the usage statistics of a mempool
+ *
+ * @param[in] mempool the mempool to inspect
+ * @param[out] usage the statistics summed over all thread mempools
+ */
+void parsec_mempool_usage( const parsec_mempool_t *mempool, parsec_mempool_usage_t *usage );
+
 /** @} */
 
 END_C_DECLS
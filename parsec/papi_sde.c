@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023 The University of Tennessee and The University
+ * Copyright (c) 2018-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -59,6 +59,24 @@ hl_counter_type_t hl_counters[PARSEC_PAPI_SDE_NB_HL_COUNTERS] = {
     { "TASKS_RETIRED",
       "the numbre of tasks that completed at this time",
       1, 0},
+    { "ARENA::CACHE_HITS",
+      "the number of temporary data allocations served from the arena caches",
+      1, 0 },
+    { "ARENA::CACHE_MISSES",
+      "the number of temporary data allocations that had to allocate new memory",
+      1, 0 },
+    { "ARENA::CROSS_NUMA",
+      "the number of temporary data allocations served from the arena cache"
+      " of another NUMA node than the one of the requesting thread",
+      1, 0 },
+    { "COMM::MESSAGES_SAVED",
+      "the number of activation messages saved by packing several activations"
+      " toward the same peer in the same message",
+      1, 0 },
+    { "COMM::AGGREGATION_LATENCY",
+      "the total time, in microseconds, activations waited in the aggregation"
+      " buffers before being sent",
+      1, 0 },
     { "SCHEDULER::PENDING_TASKS",
       "the number of pending tasks. A task is said pending if it is "
       "ready to execute but waits for execution in one of the scheduler queues.",
@@ -1,7 +1,7 @@
 #ifndef PAPI_SDE_H_INCLUDED
 #define PAPI_SDE_H_INCLUDED
 /*
- * Copyright (c) 2018-2023 The University of Tennessee and The University
+ * Copyright (c) 2018-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -18,12 +18,19 @@ typedef enum parsec_papi_sde_hl_counters_e {
                                               *   used by 'active' data allocated in arenas */
     PARSEC_PAPI_SDE_TASKS_ENABLED,           /**< How many tasks have become ready at this time */
     PARSEC_PAPI_SDE_TASKS_RETIRED,           /**< How many tasks are done at this time */
+    PARSEC_PAPI_SDE_ARENA_CACHE_HITS,        /**< How many arena elements were reused from a cache */
+    PARSEC_PAPI_SDE_ARENA_CACHE_MISSES,      /**< How many arena elements had to be allocated */
+    PARSEC_PAPI_SDE_ARENA_CROSS_NUMA,        /**< Out of ARENA_CACHE_HITS, how many elements came from
+                                              *   the cache of another NUMA node */
+    PARSEC_PAPI_SDE_COMM_MESSAGES_SAVED,     /**< How many activation messages were saved by aggregation */
+    PARSEC_PAPI_SDE_COMM_AGGREGATION_LATENCY,/**< Total time (in microseconds) activations waited in
+                                              *   the aggregation buffers */
     PARSEC_PAPI_SDE_SCHEDULER_PENDING_TASKS, /**< How many tasks are pending at a given time */
     PARSEC_PAPI_SDE_NB_HL_COUNTERS           /**< This must remain last */
 } parsec_papi_sde_hl_counters_t;
 
 #define PARSEC_PAPI_SDE_FIRST_BASIC_COUNTER  PARSEC_PAPI_SDE_MEM_ALLOC
-#define PARSEC_PAPI_SDE_LAST_BASIC_COUNTER   PARSEC_PAPI_SDE_TASKS_RETIRED
+#define PARSEC_PAPI_SDE_LAST_BASIC_COUNTER   PARSEC_PAPI_SDE_COMM_AGGREGATION_LATENCY
 #define PARSEC_PAPI_SDE_NB_BASIC_COUNTERS    ( (int)PARSEC_PAPI_SDE_LAST_BASIC_COUNTER - (int)PARSEC_PAPI_SDE_FIRST_BASIC_COUNTER + 1)
 
 /**
@@ -74,6 +74,7 @@ const char* parsec_hostname = parsec_hostname_array;
 
 size_t parsec_task_startup_iter = 64;
 size_t parsec_task_startup_chunk = 256;
+int    parsec_task_startup_split = 0;
 
 parsec_data_allocate_t parsec_data_allocate = malloc;
 parsec_data_free_t     parsec_data_free = free;
@@ -91,6 +92,7 @@ int device_delegate_begin, device_delegate_end;
 int arena_memory_alloc_key, arena_memory_free_key;
 int arena_memory_used_key, arena_memory_unused_key;
 int task_memory_alloc_key, task_memory_free_key;
+int time_to_first_task_begin, time_to_first_task_end;
 #endif  /* PARSEC_PROF_TRACE */
 
 parsec_info_t parsec_per_device_infos;
@@ -153,6 +155,10 @@ static int parsec_runtime_bind_main_thread = 0;
 static int parsec_runtime_bind_threads     = 0;
 
 int parsec_runtime_keep_highest_priority_task = 1;
+int parsec_runtime_idle_spin = 64;
+int parsec_runtime_idle_park_timeout = 1000;
+int parsec_runtime_inject_policy = PARSEC_INJECT_FIRST;
+int parsec_runtime_mempool_prewarm = 256;
 
 static PARSEC_TLS_DECLARE(parsec_tls_execution_stream);
 
@@ -190,6 +196,7 @@ static void __parsec_taskpool_constructor(parsec_taskpool_t* tp)
     tp->tdm.callback = NULL;
     tp->tdm.monitor = NULL;
     tp->tdm.module = NULL;
+    tp->time_to_first_task = -1;
 }
 
 static void __parsec_taskpool_destructor(parsec_taskpool_t* tp)
@@ -271,6 +278,12 @@ static void* __parsec_thread_init( __parsec_temporary_thread_initialization_t* s
     es->rand_seed        = tv_now.tv_usec + startup->th_id;
     es->scheduler_object = NULL;
     es->next_task        = NULL;
+    es->ready_scratch    = NULL;
+    es->ready_scratch_size = 0;
+    es->inject_pending   = 0;
+#if defined(PARSEC_PROF_PINS)
+    es->select_distance  = 0;
+#endif  /* defined(PARSEC_PROF_PINS) */
     startup->virtual_process->execution_streams[startup->th_id] = es;
     es->core_id          = startup->bindto;
 #if defined(PARSEC_HAVE_HWLOC)
@@ -541,6 +554,44 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
     parsec_mca_param_reg_int_name("runtime", "keep_highest_priority_task", "Allow a compute thread to retain the highest priority task to be executed locally. This change makes the scheduling decision non-deterministic because some tasks will never be handled to the scheduler.", false, false,
                                   parsec_runtime_keep_highest_priority_task, &parsec_runtime_keep_highest_priority_task);
 
+    /* MCA params controlling how the execution streams wait when they run
+     * out of tasks: they retry for a while, then park until new tasks are
+     * scheduled.
+     */
+    parsec_mca_param_reg_int_name("runtime", "idle_spin", "Number of consecutive failed attempts to select a task before an execution stream parks itself "
+                                  "until new tasks are scheduled (-1 to never park)", false, false,
+                                  parsec_runtime_idle_spin, &parsec_runtime_idle_spin);
+    parsec_mca_param_reg_int_name("runtime", "idle_park_timeout", "Maximum time in microseconds a parked execution stream sleeps before looking "
+                                  "for tasks again, even when it was not woken up (-1 for no limit)", false, false,
+                                  parsec_runtime_idle_park_timeout, &parsec_runtime_idle_park_timeout);
+
+    /* MCA param selecting the execution stream receiving the tasks made
+     * ready outside of its virtual process.
+     */
+    parsec_mca_param_reg_int_name("runtime", "inject_policy", "Execution stream of a virtual process receiving the tasks made ready by another "
+                                  "virtual process or by the communication thread.\n"
+                                  "  0: the first execution stream of the virtual process.\n"
+                                  "  1: round robin over the execution streams.\n"
+                                  "  2: the execution stream with the fewest injected tasks not yet compensated by its own selections.\n"
+                                  "  3: data affinity, each task goes to the execution stream its affinity data hashes to.\n",
+                                  false, false, parsec_runtime_inject_policy, &parsec_runtime_inject_policy);
+    if( (parsec_runtime_inject_policy < PARSEC_INJECT_FIRST) || (parsec_runtime_inject_policy > PARSEC_INJECT_AFFINITY) ) {
+        parsec_warning("Unknown runtime_inject_policy %d, using the first execution stream", parsec_runtime_inject_policy);
+        parsec_runtime_inject_policy = PARSEC_INJECT_FIRST;
+    }
+
+    /* MCA params controlling the memory pools of tasks, data repositories and
+     * dependencies: the size of the slabs they carve at once (0 to allocate
+     * the elements one by one), and how many tasks per execution stream are
+     * carved ahead of time when a taskpool with a known number of tasks starts.
+     */
+    parsec_mca_param_reg_sizet_name("runtime", "mempool_slab_size", "Size in bytes of the slabs carved by the memory pools "
+                                    "(0 to allocate each element separately)", false, false,
+                                    parsec_mempool_slab_size, &parsec_mempool_slab_size);
+    parsec_mca_param_reg_int_name("runtime", "mempool_prewarm", "Maximum number of tasks per execution stream carved ahead of time "
+                                  "when a taskpool starts (only with slabs, 0 to disable)", false, false,
+                                  parsec_runtime_mempool_prewarm, &parsec_runtime_mempool_prewarm);
+
     /*
      * Initialize the VPMAP, the discrete domains hosting
      * execution flows but where work stealing is prevented.
@@ -642,6 +693,7 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
         vp = (parsec_vp_t *)malloc(sizeof(parsec_vp_t) + (vpmap_get_nb_threads_in_vp(p)-1) * sizeof(parsec_execution_stream_t*));
         vp->parsec_context = context;
         vp->vp_id = p;
+        vp->inject_next = 0;
         context->virtual_processes[p] = vp;
         /*
          * Set the threads local variables from startup[t] -> startup[t+nb_cores].
@@ -664,6 +716,9 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
     parsec_mca_param_reg_sizet_name("arena", "max_cached", "The maximum amount of memory each arena can"
                                    " cache in a freelist (0=no caching)",
                                    false, false, parsec_arena_max_cached_memory, &parsec_arena_max_cached_memory);
+    parsec_mca_param_reg_int_name("arena", "magazine_size", "The number of single elements each execution stream"
+                                  " caches privately in each arena, before sharing them with its NUMA node (0=disabled)",
+                                  false, false, parsec_arena_magazine_size, &parsec_arena_magazine_size);
 
     parsec_mca_param_reg_sizet_name("task", "startup_iter", "The number of ready tasks to be generated during the startup "
                                    "before allowing the scheduler to distribute them across the entire execution context.",
@@ -672,6 +727,11 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
                                    "before delaying the remaining of the startup. The startup process will be "
                                    "continued at a later moment once the number of ready tasks decreases.",
                                    false, false, parsec_task_startup_chunk, &parsec_task_startup_chunk);
+    parsec_mca_param_reg_int_name("task", "startup_split", "The number of slices the outermost loop of the startup "
+                                  "tasks generation of each task class is split into. Each slice enumerates and schedules "
+                                  "its startup tasks from a different execution stream (0 for one slice per execution "
+                                  "stream, 1 for a sequential enumeration).",
+                                  false, false, parsec_task_startup_split, &parsec_task_startup_split);
 
     parsec_mca_param_reg_string_name("profile", "filename",
 #if defined(PARSEC_PROF_TRACE)
@@ -762,6 +822,9 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
         parsec_profiling_add_dictionary_keyword( "Device delegate", "fill:#EAE7C6",
                                                 0, NULL,
                                                 &device_delegate_begin, &device_delegate_end);
+        parsec_profiling_add_dictionary_keyword( "TIME_TO_FIRST_TASK", "fill:#7FB3D5",
+                                                sizeof(int64_t), "delay{int64_t}",
+                                                &time_to_first_task_begin, &time_to_first_task_end);
     }
 #endif  /* PARSEC_PROF_TRACE */
     assert (NULL != parsec_enable_profiling);
@@ -818,6 +881,7 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
 
     /* Initialize the barriers */
     parsec_barrier_init( &(context->barrier), NULL, nb_total_comp_threads );
+    parsec_eventcount_init( &(context->idle) );
 
     /* Load the default scheduler. User can change it afterward,
      * but we need to ensure that one is loadable and here.
@@ -1083,6 +1147,21 @@ static void parsec_mempool_stats(parsec_context_t *context)
     snprintf(meminfo, 128, "MEMPOOL - Contexts - %zu bytes", m_usage);
     parsec_profiling_add_information("MEMORY_USAGE", meminfo);
 
+    if( 0 != parsec_mempool_slab_size ) {
+        parsec_mempool_usage_t usage;
+        uint64_t high_water = 0, nb_local_free = 0, nb_remote_free = 0;
+        for(p = 0; p < context->nb_vp; p++) {
+            parsec_mempool_usage(&context->virtual_processes[p]->context_mempool, &usage);
+            high_water     += usage.high_water;
+            nb_local_free  += usage.nb_local_free;
+            nb_remote_free += usage.nb_remote_free;
+        }
+        snprintf(meminfo, 128, "MEMPOOL - Contexts - high water %"PRIu64" tasks - %.1f%% cross-thread frees",
+                 high_water, (0 == nb_local_free + nb_remote_free) ? 0.0 :
+                 (100.0 * nb_remote_free) / (double)(nb_local_free + nb_remote_free));
+        parsec_profiling_add_information("MEMORY_USAGE", meminfo);
+    }
+
     m_usage = 0;
     for(p = 0; p < context->nb_vp; p++) {
         vp = context->virtual_processes[p];
@@ -1118,6 +1197,7 @@ static void parsec_vp_fini( parsec_vp_t *vp )
     }
 
     for(i = 0; i < vp->nb_cores; i++) {
+        free(vp->execution_streams[i]->ready_scratch);
         free(vp->execution_streams[i]);
         vp->execution_streams[i] = NULL;
     }
@@ -1257,6 +1337,7 @@ int parsec_fini( parsec_context_t** pcontext )
     }
     /* Destroy all resources allocated for the barrier */
     parsec_barrier_destroy( &(context->barrier) );
+    parsec_eventcount_fini( &(context->idle) );
 
 #if defined(PARSEC_HAVE_HWLOC_BITMAP)
     /* Release thread binding masks */
@@ -1536,6 +1617,22 @@ parsec_hash_find_deps(const parsec_taskpool_t *tp,
     return &hd->dependency;
 }
 
+parsec_dependency_t*
+parsec_oa_hash_find_deps(const parsec_taskpool_t *tp,
+                         parsec_execution_stream_t *es,
+                         const parsec_task_t* PARSEC_RESTRICT task)
+{
+    parsec_oa_hash_table_t *ht = (parsec_oa_hash_table_t*)tp->dependencies_array[task->task_class->task_class_id];
+    parsec_key_t key = task->task_class->make_key(tp, task->locals);
+
+    assert(NULL != ht);
+    if( NULL == es ) {
+        /* This is a call for debugging purpose, do not insert the task */
+        return (parsec_dependency_t*)parsec_oa_hash_table_find(ht, key);
+    }
+    return (parsec_dependency_t*)parsec_oa_hash_table_find_or_insert(ht, key);
+}
+
 int
 parsec_update_deps_with_counter(parsec_taskpool_t *tp,
                                 const parsec_task_t* PARSEC_RESTRICT task,
@@ -1750,10 +1847,10 @@ parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
                 *pimmediate_ring = new_context;
 #endif
             } else {
+                /* The ring is sorted by priority once, when scheduled */
                 *pready_ring = (parsec_task_t*)
-                    parsec_list_item_ring_push_sorted( (parsec_list_item_t*)(*pready_ring),
-                                                       &new_context->super,
-                                                       parsec_execution_context_priority_comparator );
+                    parsec_list_item_ring_push_head( (parsec_list_item_t*)(*pready_ring),
+                                                     &new_context->super );
             }
         }
     } else { /* Service not ready */
@@ -2189,6 +2286,23 @@ int parsec_taskpool_enable(parsec_taskpool_t* tp,
     parsec_taskpool_register(tp);
     PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Register a new taskpool %p: %d", tp, tp->taskpool_id);
 
+    /* Now that the number of local tasks is known, let the task mempools
+     * carve what they will need in one go */
+    if( (parsec_runtime_mempool_prewarm > 0) && (NULL != tp->context) &&
+        (tp->nb_tasks > 0) && (PARSEC_UNDETERMINED_NB_TASKS != tp->nb_tasks) ) {
+        parsec_context_t *context = tp->context;
+        parsec_vp_t *vp;
+        int64_t nb;
+        int p;
+        for(p = 0; p < context->nb_vp; p++) {
+            vp = context->virtual_processes[p];
+            nb = tp->nb_tasks / context->nb_vp;
+            if( nb > (int64_t)parsec_runtime_mempool_prewarm * vp->nb_cores )
+                nb = (int64_t)parsec_runtime_mempool_prewarm * vp->nb_cores;
+            parsec_mempool_reserve(&vp->context_mempool, (uint32_t)nb);
+        }
+    }
+
     if( NULL != startup_queue ) {
         parsec_list_item_t *ring = NULL;
         parsec_task_t* ttask = (parsec_task_t*)*startup_queue;
@@ -2213,6 +2327,28 @@ int parsec_taskpool_enable(parsec_taskpool_t* tp,
     return PARSEC_HOOK_RETURN_DONE;
 }
 
+void parsec_taskpool_mark_first_ready(parsec_taskpool_t *tp)
+{
+    int64_t delay;
+
+    if( 0 <= tp->time_to_first_task )
+        return;
+    delay = (int64_t)diff_time(tp->enqueue_date, take_time());
+    if( !parsec_atomic_cas_int64(&tp->time_to_first_task, -1, delay) )
+        return;
+    parsec_debug_verbose(3, parsec_debug_output, "Taskpool %d: first ready task after %"PRId64" (%s)",
+                         tp->taskpool_id, delay, TIMER_UNIT);
+#if defined(PARSEC_PROF_TRACE)
+    /* Only the thread that won the CAS gets here, once per taskpool, and it
+     * traces in its own profiling stream: the event ends now and carries
+     * the delay since the enqueue. */
+    parsec_profiling_ts_trace_flags_info_fn(time_to_first_task_begin, tp->taskpool_id, tp->taskpool_id,
+                                            memcpy, &delay, PARSEC_PROFILING_EVENT_HAS_INFO);
+    parsec_profiling_ts_trace_flags_info_fn(time_to_first_task_end, tp->taskpool_id, tp->taskpool_id,
+                                            NULL, NULL, 0);
+#endif  /* defined(PARSEC_PROF_TRACE) */
+}
+
 /* Print PaRSEC usage message */
 void parsec_usage(void)
 {
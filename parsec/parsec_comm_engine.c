@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include "parsec/parsec_mpi_funnelled.h"
+#include "parsec/parsec_mpi_shm.h"
 #include "parsec/remote_dep.h"
 
 parsec_comm_engine_t parsec_ce;
@@ -16,6 +17,9 @@ parsec_comm_engine_init(parsec_context_t *parsec_context)
 {
     /* call the selected module init */
     parsec_comm_engine_t *ce = mpi_funnelled_init(parsec_context);
+    /* and layer the intra-node transport on top of it */
+    if( NULL != ce )
+        ce = mpi_shm_init(ce);
 
     assert(ce->capabilites.sided > 0 && ce->capabilites.sided < 3);
     return ce;
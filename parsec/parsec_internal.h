@@ -16,8 +16,10 @@
 #include "parsec/data_internal.h"
 #include "parsec/class/list_item.h"
 #include "parsec/class/parsec_hash_table.h"
+#include "parsec/class/parsec_oa_hash_table.h"
 #include "parsec/parsec_description_structures.h"
 #include "parsec/profiling.h"
+#include "parsec/os-spec-timing.h"
 #include "parsec/mempool.h"
 #include "parsec/arena.h"
 #include "parsec/datarepo.h"
@@ -164,6 +166,9 @@ struct parsec_taskpool_s {
                                                      *   Indexed on the same index as task_classes_array */
     data_repo_t**               repo_array; /**< Array of data repositories
                                              *   Indexed on the same index as functions array */
+    parsec_time_t               enqueue_date;       /**< When the taskpool was added to its context */
+    volatile int64_t            time_to_first_task; /**< Delay between the enqueue and the first ready
+                                                     *   task, in TIMER_UNIT, -1 until it is known */
 };
 
 PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_taskpool_t);
@@ -362,6 +367,9 @@ parsec_dependency_t *parsec_default_find_deps(const parsec_taskpool_t *tp,
 parsec_dependency_t *parsec_hash_find_deps(const parsec_taskpool_t *tp,
                                            parsec_execution_stream_t *es,
                                            const parsec_task_t* task);
+parsec_dependency_t *parsec_oa_hash_find_deps(const parsec_taskpool_t *tp,
+                                              parsec_execution_stream_t *es,
+                                              const parsec_task_t* task);
 typedef int (parsec_update_dependency_fn_t)(parsec_taskpool_t* tp,
                                             const parsec_task_t* PARSEC_RESTRICT task,
                                             parsec_dependency_t *deps,
@@ -474,6 +482,15 @@ struct parsec_data_pair_s {
  */
 PARSEC_DECLSPEC extern size_t parsec_task_startup_iter;
 PARSEC_DECLSPEC extern size_t parsec_task_startup_chunk;
+PARSEC_DECLSPEC extern int parsec_task_startup_split;
+
+/**
+ * Record the time-to-first-task of a taskpool, the delay between its enqueue
+ * in a context and the moment the first of its tasks becomes ready. Only the
+ * first call for each taskpool has an effect. In profiling builds the delay
+ * is traced as a TIME_TO_FIRST_TASK event of the taskpool.
+ */
+PARSEC_DECLSPEC void parsec_taskpool_mark_first_ready(parsec_taskpool_t *tp);
 
 /**
  * @brief Global configuration variable controlling the getrusage report.
@@ -493,6 +510,35 @@ PARSEC_DECLSPEC extern int parsec_slow_bind_warning;
  */
 PARSEC_DECLSPEC extern int parsec_runtime_keep_highest_priority_task;
 
+/**
+ * Global configuration variables controlling the idle execution streams.
+ * After parsec_runtime_idle_spin consecutive failures to select a task, an
+ * execution stream parks on the idle event count of its context, for at most
+ * parsec_runtime_idle_park_timeout microseconds, until __parsec_schedule
+ * wakes it up. A negative parsec_runtime_idle_spin disables parking.
+ */
+PARSEC_DECLSPEC extern int parsec_runtime_idle_spin;
+PARSEC_DECLSPEC extern int parsec_runtime_idle_park_timeout;
+
+/**
+ * Global configuration variable selecting the execution stream of a virtual
+ * process to which the rings of tasks made ready outside of it (by another
+ * virtual process, or by a thread that is not a worker such as the
+ * communication thread) are delivered.
+ */
+#define PARSEC_INJECT_FIRST        0  /**< the first execution stream of the virtual process */
+#define PARSEC_INJECT_ROUND_ROBIN  1  /**< each execution stream in turn */
+#define PARSEC_INJECT_LEAST_LOADED 2  /**< the stream with the fewest injected tasks not yet compensated by its selections */
+#define PARSEC_INJECT_AFFINITY     3  /**< each task to the stream its affinity data hashes to */
+PARSEC_DECLSPEC extern int parsec_runtime_inject_policy;
+
+/**
+ * Maximum number of tasks per execution stream the task mempools carve
+ * ahead of time when a taskpool with a known number of local tasks is
+ * enabled. Only used when the mempools carve slabs.
+ */
+PARSEC_DECLSPEC extern int parsec_runtime_mempool_prewarm;
+
 /**
  * Description of the state of the task. It indicates what will be the next
  * next stage in the life-time of a task to be executed.
@@ -23,18 +23,6 @@ mpi_no_thread_push_posted_req(parsec_comm_engine_t *ce);
 // TODO put all the active ones(for debug) in a table and create a mempool
 parsec_mempool_t *mpi_funnelled_mem_reg_handle_mempool = NULL;
 
-/* Memory handles, opaque to upper layers */
-typedef struct mpi_funnelled_mem_reg_handle_s {
-    parsec_list_item_t        super;
-    parsec_thread_mempool_t *mempool_owner;
-    void *self;
-    void *mem;
-    parsec_datatype_t datatype;
-    int count;
-} mpi_funnelled_mem_reg_handle_t;
-
-PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(mpi_funnelled_mem_reg_handle_t);
-
 /* To create object of class mpi_funnelled_mem_reg_handle_t that inherits
  * parsec_list_item_t class
  */
@@ -238,7 +226,8 @@ typedef struct mpi_funnelled_handshake_info_s {
     parsec_ce_mem_reg_handle_t source_memory_handle;
     parsec_ce_mem_reg_handle_t remote_memory_handle;
     uintptr_t cb_fn;
-
+    ptrdiff_t rdispl;  /**< PUT only: displacement in bytes in the remote memory */
+    size_t size;       /**< PUT only: size in bytes of the transfer, 0 for the whole remote memory */
 } mpi_funnelled_handshake_info_t;
 
 /* This is the callback that is triggered on the sender side for a
@@ -358,8 +347,14 @@ mpi_funnelled_internal_put_am_callback(parsec_comm_engine_t *ce,
         cb = &item->cb;
     }
 
-    MPI_Irecv(remote_memory_handle->mem, remote_memory_handle->count, remote_memory_handle->datatype,
-              src, handshake_info->tag, parsec_ce_mpi_comm, request);
+    if( 0 != handshake_info->size ) {
+        /* Only a part of the registered memory is targeted, which must then be contiguous */
+        MPI_Irecv((char*)remote_memory_handle->mem + handshake_info->rdispl, (int)handshake_info->size, MPI_BYTE,
+                  src, handshake_info->tag, parsec_ce_mpi_comm, request);
+    } else {
+        MPI_Irecv(remote_memory_handle->mem, remote_memory_handle->count, remote_memory_handle->datatype,
+                  src, handshake_info->tag, parsec_ce_mpi_comm, request);
+    }
 
     /* we(the remote side) requested the source to forward us callback data that will be passed
      * to the callback function to notify upper level that the data has reached. We are copying
@@ -810,6 +805,31 @@ mpi_funnelled_tag_unregister_unsafe_internal(parsec_ce_tag_t tag)
     return PARSEC_SUCCESS;
 }
 
+/**
+ * @brief Retrieve the callback, callback data and maximum message length of
+ *        a registered tag. Returns PARSEC_ERR_NOT_FOUND if the tag has no
+ *        callback attached.
+ */
+int
+mpi_no_thread_tag_lookup(parsec_ce_tag_t tag,
+                         parsec_ce_am_callback_t *callback,
+                         void **cb_data,
+                         size_t *msg_length)
+{
+    mpi_funnelled_tag_t *tag_struct;
+
+    if( tag >= PARSEC_MAX_REGISTERED_TAGS ) return PARSEC_ERR_VALUE_OUT_OF_BOUNDS;
+    tag_struct = &parsec_mpi_funnelled_array_of_registered_tags[tag];
+    if( (NULL == tag_struct->callback) ||
+        (PARSEC_CE_TAG_STATUS_INACTIVE == tag_struct->status) ||
+        (PARSEC_CE_TAG_STATUS_DISABLE == tag_struct->status) )
+        return PARSEC_ERR_NOT_FOUND;
+    *callback   = tag_struct->callback;
+    *cb_data    = tag_struct->cb_data;
+    *msg_length = tag_struct->msg_length;
+    return PARSEC_SUCCESS;
+}
+
 int
 mpi_no_thread_tag_unregister(parsec_ce_tag_t tag)
 {
@@ -857,6 +877,21 @@ mpi_no_thread_mem_register(void *mem, parsec_mem_type_t mem_type,
     handle->mem  = mem;
     handle->datatype = datatype;
     handle->count = count;
+    handle->contig_size = 0;
+
+    /* Record the size of the memory region if the layout describes a single
+     * dense block, to allow the intra-node layer to move it with a single copy. */
+    {
+        MPI_Aint lb, extent, true_lb, true_extent;
+        int type_size;
+        MPI_Type_size(datatype, &type_size);
+        MPI_Type_get_extent(datatype, &lb, &extent);
+        MPI_Type_get_true_extent(datatype, &true_lb, &true_extent);
+        if( (0 == true_lb) && (type_size == true_extent) &&
+            ((1 == count) || (extent == true_extent)) ) {
+            handle->contig_size = (size_t)type_size * count;
+        }
+    }
 
     // Push in a table
 
@@ -907,7 +942,7 @@ mpi_no_thread_put(parsec_comm_engine_t *ce,
 {
     assert(mpi_funnelled_last_active_req < current_size_of_total_reqs);
 
-    (void)r_cb_data; (void) size;
+    (void)r_cb_data;
 
     mpi_funnelled_callback_t *cb;
 
@@ -925,6 +960,8 @@ mpi_no_thread_put(parsec_comm_engine_t *ce,
                                                                          instead of copying the whole
                                                                          memory_handle */
     handshake_info.cb_fn = (uintptr_t) r_tag;
+    handshake_info.rdispl = rdispl;
+    handshake_info.size = size;
 
     /* We pack the static message(handshake_info) and the callback data
      * the other side have sent us, to be forwarded.
@@ -1017,6 +1054,8 @@ mpi_no_thread_get(parsec_comm_engine_t *ce,
     handshake_info.remote_memory_handle = remote_memory_handle->self; /* we store the actual pointer, as we
                                                                          do not pass the while handle */
     handshake_info.cb_fn = r_tag; /* This is what the other side has passed to us to invoke when the GET is done */
+    handshake_info.rdispl = 0;
+    handshake_info.size = 0;
 
     /* Packing the callback data the other side has sent us and sending it back to them */
     int buf_size = sizeof(mpi_funnelled_handshake_info_t) + r_cb_data_size;
@@ -8,7 +8,24 @@
 
 #include "parsec/parsec_comm_engine.h"
 
+#include "parsec/class/list_item.h"
+#include "parsec/mempool.h"
+
 /* ------- Funnelled MPI implementation below ------- */
+
+/* Memory handles, opaque to upper layers */
+typedef struct mpi_funnelled_mem_reg_handle_s {
+    parsec_list_item_t        super;
+    parsec_thread_mempool_t *mempool_owner;
+    void *self;
+    void *mem;
+    parsec_datatype_t datatype;
+    int count;
+    size_t contig_size;  /* size in bytes if the region is a single dense block, 0 otherwise */
+} mpi_funnelled_mem_reg_handle_t;
+
+PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(mpi_funnelled_mem_reg_handle_t);
+
 parsec_comm_engine_t * mpi_funnelled_init(parsec_context_t *parsec_context);
 int mpi_funnelled_fini(parsec_comm_engine_t *comm_engine);
 
@@ -19,6 +36,11 @@ int mpi_no_thread_tag_register(parsec_ce_tag_t tag,
 
 int mpi_no_thread_tag_unregister(parsec_ce_tag_t tag);
 
+int mpi_no_thread_tag_lookup(parsec_ce_tag_t tag,
+                             parsec_ce_am_callback_t *callback,
+                             void **cb_data,
+                             size_t *msg_length);
+
 int
 mpi_no_thread_mem_register(void *mem, parsec_mem_type_t mem_type,
                            size_t count, parsec_datatype_t datatype,
@@ -0,0 +1,670 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+
+#include <mpi.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#if defined(PARSEC_HAVE_SHM_OPEN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif  /* defined(PARSEC_HAVE_SHM_OPEN) */
+#if defined(PARSEC_HAVE_PROCESS_VM_READV)
+#include <sys/uio.h>
+#endif  /* defined(PARSEC_HAVE_PROCESS_VM_READV) */
+#include "parsec/parsec_mpi_shm.h"
+#include "parsec/parsec_mpi_funnelled.h"
+#include "parsec/remote_dep.h"
+#include "parsec/class/list.h"
+#include "parsec/execution_stream.h"
+#include "parsec/sys/atomic.h"
+#include "parsec/utils/debug.h"
+#include "parsec/utils/mca_param.h"
+
+static int parsec_param_comm_shm = 0;
+static int parsec_param_comm_shm_ring_size = 32768;
+static int parsec_param_comm_shm_single_copy = 1;
+
+#if defined(PARSEC_HAVE_MPI_30) && defined(PARSEC_HAVE_SHM_OPEN)
+
+/* Every entry in a ring starts on its own cache line */
+#define MPI_SHM_CACHE_LINE 64
+#define MPI_SHM_ALIGN(s) (((s) + MPI_SHM_CACHE_LINE - 1) & ~((size_t)MPI_SHM_CACHE_LINE - 1))
+
+/* Internal message types, beyond the range of the registered tags */
+#define MPI_SHM_TAG_ONESIDED (PARSEC_MAX_REGISTERED_TAGS)      /* completion of a single-copy PUT or GET */
+#define MPI_SHM_TAG_WRAP     (PARSEC_MAX_REGISTERED_TAGS + 1)  /* skip to the beginning of the ring */
+
+/* Producer and consumer counters of a ring live on different cache lines, the
+ * counters are monotonic and the position in the ring is their value modulo
+ * the ring size.
+ */
+typedef struct mpi_shm_ring_ctrl_s {
+    volatile uint64_t tail;
+    char pad0[MPI_SHM_CACHE_LINE - sizeof(uint64_t)];
+    volatile uint64_t head;
+    char pad1[MPI_SHM_CACHE_LINE - sizeof(uint64_t)];
+} mpi_shm_ring_ctrl_t;
+
+typedef struct mpi_shm_msg_hdr_s {
+    int32_t  tag;
+    int32_t  src;   /* rank of the sender in the communicator of the engine */
+    uint64_t size;  /* size of the payload following the header */
+} mpi_shm_msg_hdr_t;
+
+/* Payload of a MPI_SHM_TAG_ONESIDED message, followed by the callback data */
+typedef struct mpi_shm_onesided_notify_s {
+    uintptr_t cb_fn;
+    uintptr_t handle;
+} mpi_shm_onesided_notify_t;
+
+/* Information exchanged between the local processes at startup */
+typedef struct mpi_shm_peer_s {
+    int       rank;
+    pid_t     pid;
+    uintptr_t probe;
+} mpi_shm_peer_t;
+
+/* Messages that did not fit in a full ring, in order of submission */
+typedef struct mpi_shm_pending_msg_s {
+    parsec_list_item_t super;
+    int     tag;
+    size_t  size;
+    char    data[];
+} mpi_shm_pending_msg_t;
+
+/* A completed single-copy transfer waiting for its callbacks */
+typedef struct mpi_shm_onesided_op_s {
+    parsec_list_item_t super;
+    int peer;
+    int remote;
+    parsec_ce_mem_reg_handle_t lreg;
+    ptrdiff_t ldispl;
+    parsec_ce_mem_reg_handle_t rreg;
+    ptrdiff_t rdispl;
+    size_t size;
+    parsec_ce_onesided_callback_t l_cb;
+    void *l_cb_data;
+    mpi_shm_onesided_notify_t notify;
+    size_t r_cb_data_size;
+    char r_cb_data[];
+} mpi_shm_onesided_op_t;
+
+static MPI_Comm  mpi_shm_comm       = MPI_COMM_NULL;  /* the engine communicator the layer was built for */
+static MPI_Comm  mpi_shm_local_comm = MPI_COMM_NULL;
+static int       mpi_shm_nb_local   = 0;
+static int       mpi_shm_local_rank = -1;
+static int       mpi_shm_cma = 0;
+static int      *mpi_shm_local_of   = NULL;  /* communicator rank to local index, -1 if not on the node */
+static mpi_shm_peer_t *mpi_shm_peers = NULL;
+static void     *mpi_shm_segment    = NULL;
+static size_t    mpi_shm_segment_size = 0;
+static size_t    mpi_shm_ring_size  = 0;
+static size_t    mpi_shm_max_msg    = 0;
+static mpi_shm_ring_ctrl_t *mpi_shm_ctrl = NULL;
+static char     *mpi_shm_buffers    = NULL;
+static parsec_atomic_lock_t *mpi_shm_send_locks = NULL;
+static parsec_list_t *mpi_shm_overflow = NULL;
+static volatile int32_t mpi_shm_nb_overflow = 0;
+static parsec_list_t mpi_shm_onesided_ops;
+static volatile uint64_t mpi_shm_cma_probe = 0;
+static int mpi_shm_segment_id = 0;
+
+#define MPI_SHM_CMA_MAGIC 0x70617273656373ULL
+
+static inline mpi_shm_ring_ctrl_t *mpi_shm_ring_ctrl(int from, int to)
+{
+    return &mpi_shm_ctrl[from * mpi_shm_nb_local + to];
+}
+
+static inline char *mpi_shm_ring_buffer(int from, int to)
+{
+    return mpi_shm_buffers + (size_t)(from * mpi_shm_nb_local + to) * mpi_shm_ring_size;
+}
+
+/* Local index of a peer reachable through shared memory, -1 otherwise */
+static inline int mpi_shm_peer(int remote)
+{
+    int peer;
+    if( NULL == mpi_shm_local_of ) return -1;
+    peer = mpi_shm_local_of[remote];
+    return (peer == mpi_shm_local_rank) ? -1 : peer;
+}
+
+/**
+ * Copy a message made of two parts in the ring toward a local peer. Returns 0
+ * if the ring does not have enough room. Must be called with the send lock of
+ * the peer held.
+ */
+static int mpi_shm_ring_push(int peer, int tag,
+                             const void *a, size_t asize,
+                             const void *b, size_t bsize)
+{
+    mpi_shm_ring_ctrl_t *ctrl = mpi_shm_ring_ctrl(mpi_shm_local_rank, peer);
+    char *buffer = mpi_shm_ring_buffer(mpi_shm_local_rank, peer);
+    size_t need = MPI_SHM_ALIGN(sizeof(mpi_shm_msg_hdr_t) + asize + bsize);
+    uint64_t tail = ctrl->tail, head = ctrl->head;
+    size_t pos = tail & (mpi_shm_ring_size - 1), pad = 0;
+    mpi_shm_msg_hdr_t *hdr;
+
+    parsec_atomic_rmb();
+    if( pos + need > mpi_shm_ring_size )
+        pad = mpi_shm_ring_size - pos;
+    if( (tail + pad + need - head) > mpi_shm_ring_size )
+        return 0;
+    if( 0 != pad ) {
+        hdr = (mpi_shm_msg_hdr_t*)(buffer + pos);
+        hdr->tag = MPI_SHM_TAG_WRAP;
+        tail += pad;
+        pos = 0;
+    }
+    hdr = (mpi_shm_msg_hdr_t*)(buffer + pos);
+    hdr->tag  = tag;
+    hdr->src  = mpi_shm_peers[mpi_shm_local_rank].rank;
+    hdr->size = asize + bsize;
+    memcpy((char*)(hdr + 1), a, asize);
+    if( 0 != bsize )
+        memcpy((char*)(hdr + 1) + asize, b, bsize);
+    parsec_atomic_wmb();
+    ctrl->tail = tail + need;
+    return 1;
+}
+
+/**
+ * Post a message to a local peer. Once a message has been delayed, all the
+ * following messages toward the same peer are delayed as well to preserve
+ * the ordering.
+ */
+static void mpi_shm_post(int peer, int tag,
+                         const void *a, size_t asize,
+                         const void *b, size_t bsize)
+{
+    mpi_shm_pending_msg_t *msg;
+
+    parsec_atomic_lock(&mpi_shm_send_locks[peer]);
+    if( parsec_list_nolock_is_empty(&mpi_shm_overflow[peer]) &&
+        mpi_shm_ring_push(peer, tag, a, asize, b, bsize) ) {
+        parsec_atomic_unlock(&mpi_shm_send_locks[peer]);
+        return;
+    }
+    msg = (mpi_shm_pending_msg_t*)malloc(sizeof(mpi_shm_pending_msg_t) + asize + bsize);
+    PARSEC_OBJ_CONSTRUCT(msg, parsec_list_item_t);
+    msg->tag  = tag;
+    msg->size = asize + bsize;
+    memcpy(msg->data, a, asize);
+    if( 0 != bsize )
+        memcpy(msg->data + asize, b, bsize);
+    parsec_list_nolock_push_back(&mpi_shm_overflow[peer], &msg->super);
+    parsec_atomic_fetch_inc_int32(&mpi_shm_nb_overflow);
+    parsec_atomic_unlock(&mpi_shm_send_locks[peer]);
+}
+
+/**
+ * Post a message to a local peer only if it can go in the ring right away.
+ * Returns 0 if the message must be posted again later.
+ */
+static int mpi_shm_try_post(int peer, int tag,
+                            const void *a, size_t asize,
+                            const void *b, size_t bsize)
+{
+    int ret = 0;
+
+    parsec_atomic_lock(&mpi_shm_send_locks[peer]);
+    if( parsec_list_nolock_is_empty(&mpi_shm_overflow[peer]) )
+        ret = mpi_shm_ring_push(peer, tag, a, asize, b, bsize);
+    parsec_atomic_unlock(&mpi_shm_send_locks[peer]);
+    return ret;
+}
+
+static int mpi_shm_flush_overflow(void)
+{
+    mpi_shm_pending_msg_t *msg;
+    int peer, ret = 0;
+
+    for( peer = 0; peer < mpi_shm_nb_local; peer++ ) {
+        if( parsec_list_nolock_is_empty(&mpi_shm_overflow[peer]) ) continue;
+        parsec_atomic_lock(&mpi_shm_send_locks[peer]);
+        while( NULL != (msg = (mpi_shm_pending_msg_t*)parsec_list_nolock_pop_front(&mpi_shm_overflow[peer])) ) {
+            if( !mpi_shm_ring_push(peer, msg->tag, msg->data, msg->size, NULL, 0) ) {
+                parsec_list_nolock_push_front(&mpi_shm_overflow[peer], &msg->super);
+                break;
+            }
+            PARSEC_OBJ_DESTRUCT(msg);
+            free(msg);
+            parsec_atomic_fetch_dec_int32(&mpi_shm_nb_overflow);
+            ret++;
+        }
+        parsec_atomic_unlock(&mpi_shm_send_locks[peer]);
+    }
+    return ret;
+}
+
+/**
+ * Deliver all the messages available in the ring from a local peer. A
+ * message for a tag not yet registered stays in the ring, together with all
+ * the following ones, until the tag becomes available.
+ */
+static int mpi_shm_ring_poll(parsec_comm_engine_t *ce, int peer)
+{
+    mpi_shm_ring_ctrl_t *ctrl = mpi_shm_ring_ctrl(peer, mpi_shm_local_rank);
+    char *buffer = mpi_shm_ring_buffer(peer, mpi_shm_local_rank);
+    uint64_t head = ctrl->head, tail = ctrl->tail;
+    parsec_ce_am_callback_t callback;
+    mpi_shm_onesided_notify_t *notify;
+    mpi_shm_msg_hdr_t *hdr;
+    size_t pos, msg_length;
+    void *cb_data;
+    int ret = 0;
+
+    parsec_atomic_rmb();
+    while( head != tail ) {
+        pos = head & (mpi_shm_ring_size - 1);
+        hdr = (mpi_shm_msg_hdr_t*)(buffer + pos);
+        if( MPI_SHM_TAG_WRAP == hdr->tag ) {
+            head += mpi_shm_ring_size - pos;
+            continue;
+        }
+        if( MPI_SHM_TAG_ONESIDED == hdr->tag ) {
+            notify = (mpi_shm_onesided_notify_t*)(hdr + 1);
+            ((parsec_ce_am_callback_t)notify->cb_fn)(ce, hdr->tag, notify + 1,
+                                                      hdr->size - sizeof(mpi_shm_onesided_notify_t),
+                                                      hdr->src, (void*)notify->handle);
+        } else {
+            if( PARSEC_SUCCESS != mpi_no_thread_tag_lookup(hdr->tag, &callback, &cb_data, &msg_length) )
+                break;
+            callback(ce, hdr->tag, hdr + 1, hdr->size, hdr->src, cb_data);
+        }
+        head += MPI_SHM_ALIGN(sizeof(mpi_shm_msg_hdr_t) + hdr->size);
+        /* Release the entry as soon as it has been consumed */
+        parsec_atomic_wmb();
+        ctrl->head = head;
+        ret++;
+    }
+    ctrl->head = head;
+    return ret;
+}
+
+static int mpi_shm_onesided_progress(parsec_comm_engine_t *ce)
+{
+    mpi_shm_onesided_op_t *op;
+    int ret = 0;
+
+    while( NULL != (op = (mpi_shm_onesided_op_t*)parsec_list_pop_front(&mpi_shm_onesided_ops)) ) {
+        /* The local completion is only reported once the notification is in
+         * the ring: a completed sender may turn its engine off, and nobody
+         * would flush an overflowing notification anymore. */
+        if( !mpi_shm_try_post(op->peer, MPI_SHM_TAG_ONESIDED,
+                              &op->notify, sizeof(mpi_shm_onesided_notify_t),
+                              op->r_cb_data, op->r_cb_data_size) ) {
+            parsec_list_push_front(&mpi_shm_onesided_ops, &op->super);
+            break;
+        }
+        if( NULL != op->l_cb ) {
+            op->l_cb(ce, op->lreg, op->ldispl, op->rreg, op->rdispl,
+                     op->size, op->remote, op->l_cb_data);
+        }
+        PARSEC_OBJ_DESTRUCT(op);
+        free(op);
+        ret++;
+    }
+    return ret;
+}
+
+static int
+mpi_shm_send_active_message(parsec_comm_engine_t *ce,
+                            parsec_ce_tag_t tag,
+                            int remote,
+                            void *addr, size_t size)
+{
+    parsec_ce_am_callback_t callback;
+    size_t msg_length;
+    void *cb_data;
+    int peer = mpi_shm_peer(remote);
+
+    /* The route depends only on the tag and the peer, so that all messages of
+     * a tag toward a peer are delivered in order. */
+    if( (peer < 0) ||
+        (PARSEC_SUCCESS != mpi_no_thread_tag_lookup(tag, &callback, &cb_data, &msg_length)) ||
+        (msg_length > mpi_shm_max_msg) ) {
+        return mpi_no_thread_send_active_message(ce, tag, remote, addr, size);
+    }
+    assert(size <= msg_length);
+    mpi_shm_post(peer, (int)tag, addr, size, NULL, 0);
+    return 1;
+}
+
+/**
+ * Move the data of a one-sided operation with a single copy between the
+ * address spaces. Returns 0 if the operation cannot be served this way and
+ * must go through MPI.
+ */
+static int
+mpi_shm_single_copy(parsec_comm_engine_t *ce, int is_put,
+                    parsec_ce_mem_reg_handle_t lreg, ptrdiff_t ldispl,
+                    parsec_ce_mem_reg_handle_t rreg, ptrdiff_t rdispl,
+                    size_t size, int remote,
+                    parsec_ce_onesided_callback_t l_cb, void *l_cb_data,
+                    parsec_ce_tag_t r_tag, void *r_cb_data, size_t r_cb_data_size)
+{
+#if defined(PARSEC_HAVE_PROCESS_VM_READV)
+    mpi_funnelled_mem_reg_handle_t *lh = (mpi_funnelled_mem_reg_handle_t*)lreg;
+    mpi_funnelled_mem_reg_handle_t *rh = (mpi_funnelled_mem_reg_handle_t*)rreg;
+    int peer = mpi_shm_peer(remote);
+    size_t length, done = 0;
+    struct iovec liov, riov;
+    mpi_shm_onesided_op_t *op;
+    ssize_t rc;
+
+    if( !mpi_shm_cma || (peer < 0) ||
+        (0 == lh->contig_size) || (0 == rh->contig_size) ||
+        ((sizeof(mpi_shm_onesided_notify_t) + r_cb_data_size) > mpi_shm_max_msg) )
+        return 0;
+    /* As with MPI, the size of the transfer is defined by the sender, and
+     * both regions must hold it past their displacement */
+    length = is_put ? lh->contig_size : rh->contig_size;
+    if( (ldispl < 0) || (rdispl < 0) ||
+        (((size_t)ldispl + length) > lh->contig_size) ||
+        (((size_t)rdispl + length) > rh->contig_size) )
+        return 0;
+
+    while( done < length ) {
+        liov.iov_base = (char*)lh->mem + ldispl + done;
+        liov.iov_len  = length - done;
+        riov.iov_base = (char*)rh->mem + rdispl + done;
+        riov.iov_len  = length - done;
+        if( is_put )
+            rc = process_vm_writev(mpi_shm_peers[peer].pid, &liov, 1, &riov, 1, 0);
+        else
+            rc = process_vm_readv(mpi_shm_peers[peer].pid, &liov, 1, &riov, 1, 0);
+        if( rc <= 0 ) {
+            if( (rc < 0) && (EINTR == errno) ) continue;
+            if( 0 == done ) return 0;  /* nothing moved yet, MPI can take over */
+            parsec_fatal("MPI:\tsingle copy %s of %zu bytes with rank %d failed after %zu bytes (%s)",
+                         is_put ? "PUT" : "GET", length, remote, done, strerror(errno));
+        }
+        done += (size_t)rc;
+    }
+
+    /* The callbacks are delayed until the next progress, as they are with MPI */
+    op = (mpi_shm_onesided_op_t*)malloc(sizeof(mpi_shm_onesided_op_t) + r_cb_data_size);
+    PARSEC_OBJ_CONSTRUCT(op, parsec_list_item_t);
+    op->peer      = peer;
+    op->remote    = remote;
+    op->lreg      = lh->self;
+    op->ldispl    = ldispl;
+    op->rreg      = rreg;
+    op->rdispl    = rdispl;
+    op->size      = is_put ? (size_t)lh->count : size;
+    op->l_cb      = l_cb;
+    op->l_cb_data = l_cb_data;
+    op->notify.cb_fn  = (uintptr_t)r_tag;
+    op->notify.handle = (uintptr_t)rh->self;
+    op->r_cb_data_size = r_cb_data_size;
+    memcpy(op->r_cb_data, r_cb_data, r_cb_data_size);
+    parsec_list_push_back(&mpi_shm_onesided_ops, &op->super);
+    (void)ce;
+    return 1;
+#else
+    (void)ce; (void)is_put; (void)lreg; (void)ldispl; (void)rreg; (void)rdispl; (void)size; (void)remote;
+    (void)l_cb; (void)l_cb_data; (void)r_tag; (void)r_cb_data; (void)r_cb_data_size;
+    return 0;
+#endif  /* defined(PARSEC_HAVE_PROCESS_VM_READV) */
+}
+
+static int
+mpi_shm_put(parsec_comm_engine_t *ce,
+            parsec_ce_mem_reg_handle_t lreg,
+            ptrdiff_t ldispl,
+            parsec_ce_mem_reg_handle_t rreg,
+            ptrdiff_t rdispl,
+            size_t size,
+            int remote,
+            parsec_ce_onesided_callback_t l_cb, void *l_cb_data,
+            parsec_ce_tag_t r_tag, void *r_cb_data, size_t r_cb_data_size)
+{
+    if( mpi_shm_single_copy(ce, 1, lreg, ldispl, rreg, rdispl, size, remote,
+                            l_cb, l_cb_data, r_tag, r_cb_data, r_cb_data_size) )
+        return 1;
+    return mpi_no_thread_put(ce, lreg, ldispl, rreg, rdispl, size, remote,
+                             l_cb, l_cb_data, r_tag, r_cb_data, r_cb_data_size);
+}
+
+static int
+mpi_shm_get(parsec_comm_engine_t *ce,
+            parsec_ce_mem_reg_handle_t lreg,
+            ptrdiff_t ldispl,
+            parsec_ce_mem_reg_handle_t rreg,
+            ptrdiff_t rdispl,
+            size_t size,
+            int remote,
+            parsec_ce_onesided_callback_t l_cb, void *l_cb_data,
+            parsec_ce_tag_t r_tag, void *r_cb_data, size_t r_cb_data_size)
+{
+    if( mpi_shm_single_copy(ce, 0, lreg, ldispl, rreg, rdispl, size, remote,
+                            l_cb, l_cb_data, r_tag, r_cb_data, r_cb_data_size) )
+        return 1;
+    return mpi_no_thread_get(ce, lreg, ldispl, rreg, rdispl, size, remote,
+                             l_cb, l_cb_data, r_tag, r_cb_data, r_cb_data_size);
+}
+
+static int
+mpi_shm_progress(parsec_comm_engine_t *ce)
+{
+    int peer, ret;
+
+    ret = mpi_no_thread_progress(ce);
+    ret += mpi_shm_onesided_progress(ce);
+    if( 0 != mpi_shm_nb_overflow )
+        ret += mpi_shm_flush_overflow();
+    for( peer = 0; peer < mpi_shm_nb_local; peer++ ) {
+        if( peer == mpi_shm_local_rank ) continue;
+        ret += mpi_shm_ring_poll(ce, peer);
+    }
+    return ret;
+}
+
+static void mpi_shm_teardown(void)
+{
+    mpi_shm_pending_msg_t *msg;
+    int peer;
+
+    if( NULL != mpi_shm_segment ) {
+        munmap(mpi_shm_segment, mpi_shm_segment_size);
+        mpi_shm_segment = NULL;
+        mpi_shm_ctrl = NULL;
+        mpi_shm_buffers = NULL;
+        for( peer = 0; peer < mpi_shm_nb_local; peer++ ) {
+            while( NULL != (msg = (mpi_shm_pending_msg_t*)parsec_list_nolock_pop_front(&mpi_shm_overflow[peer])) ) {
+                PARSEC_OBJ_DESTRUCT(msg);
+                free(msg);
+            }
+            PARSEC_OBJ_DESTRUCT(&mpi_shm_overflow[peer]);
+        }
+        free(mpi_shm_overflow); mpi_shm_overflow = NULL;
+        free((void*)mpi_shm_send_locks); mpi_shm_send_locks = NULL;
+        assert(parsec_list_is_empty(&mpi_shm_onesided_ops));
+        PARSEC_OBJ_DESTRUCT(&mpi_shm_onesided_ops);
+        mpi_shm_nb_overflow = 0;
+    }
+    free(mpi_shm_local_of); mpi_shm_local_of = NULL;
+    free(mpi_shm_peers); mpi_shm_peers = NULL;
+    if( MPI_COMM_NULL != mpi_shm_local_comm )
+        MPI_Comm_free(&mpi_shm_local_comm);
+    mpi_shm_nb_local = 0;
+    mpi_shm_local_rank = -1;
+    mpi_shm_cma = 0;
+}
+
+/**
+ * Build the shared memory segment hosting the rings between all the processes
+ * of the communicator located on the same node. This is collective over the
+ * communicator, and all processes on a node agree on the outcome: if any of
+ * them fails, they all keep using MPI.
+ */
+static int mpi_shm_setup(parsec_comm_engine_t *ce)
+{
+    parsec_context_t *context = ce->parsec_context;
+    char name[64] = { 0 };
+    int i, fd = -1, ok, all_ok;
+    size_t nb_rings;
+
+    MPI_Comm_split_type(mpi_shm_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &mpi_shm_local_comm);
+    MPI_Comm_size(mpi_shm_local_comm, &mpi_shm_nb_local);
+    MPI_Comm_rank(mpi_shm_local_comm, &mpi_shm_local_rank);
+    if( 1 == mpi_shm_nb_local ) {
+        mpi_shm_teardown();
+        return PARSEC_ERR_NOT_FOUND;
+    }
+
+    mpi_shm_cma_probe = MPI_SHM_CMA_MAGIC ^ (uint64_t)context->my_rank;
+    mpi_shm_peers = (mpi_shm_peer_t*)calloc(mpi_shm_nb_local, sizeof(mpi_shm_peer_t));
+    mpi_shm_peers[mpi_shm_local_rank].rank  = context->my_rank;
+    mpi_shm_peers[mpi_shm_local_rank].pid   = getpid();
+    mpi_shm_peers[mpi_shm_local_rank].probe = (uintptr_t)&mpi_shm_cma_probe;
+    MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                  mpi_shm_peers, sizeof(mpi_shm_peer_t), MPI_BYTE, mpi_shm_local_comm);
+
+    /* Round the ring size to a power of two, large enough for a few messages */
+    for( mpi_shm_ring_size = 4096;
+         mpi_shm_ring_size < (size_t)parsec_param_comm_shm_ring_size;
+         mpi_shm_ring_size <<= 1 );
+    mpi_shm_max_msg = mpi_shm_ring_size / 4 - sizeof(mpi_shm_msg_hdr_t);
+    nb_rings = (size_t)mpi_shm_nb_local * mpi_shm_nb_local;
+    mpi_shm_segment_size = nb_rings * (sizeof(mpi_shm_ring_ctrl_t) + mpi_shm_ring_size);
+
+    ok = 1;
+    if( 0 == mpi_shm_local_rank ) {
+        snprintf(name, sizeof(name), "/parsec_shm.%d.%d", (int)getpid(), mpi_shm_segment_id++);
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if( (fd < 0) || (0 != ftruncate(fd, mpi_shm_segment_size)) ) {
+            parsec_debug_verbose(3, parsec_comm_output_stream,
+                                 "MPI:\tcannot create the shared memory segment %s of %zu bytes (%s)",
+                                 name, mpi_shm_segment_size, strerror(errno));
+            ok = 0;
+        }
+    }
+    MPI_Bcast(name, sizeof(name), MPI_CHAR, 0, mpi_shm_local_comm);
+    MPI_Bcast(&ok, 1, MPI_INT, 0, mpi_shm_local_comm);
+    if( ok ) {
+        if( 0 != mpi_shm_local_rank )
+            fd = shm_open(name, O_RDWR, 0600);
+        if( fd >= 0 ) {
+            mpi_shm_segment = mmap(NULL, mpi_shm_segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if( MAP_FAILED == mpi_shm_segment ) mpi_shm_segment = NULL;
+            close(fd);
+        }
+        ok = (NULL != mpi_shm_segment);
+    } else if( fd >= 0 ) {
+        close(fd);
+    }
+    /* Everybody attached (or failed to), the name can go away */
+    MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, mpi_shm_local_comm);
+    if( (0 == mpi_shm_local_rank) && ('\0' != name[0]) )
+        shm_unlink(name);
+    if( !all_ok ) {
+        if( NULL != mpi_shm_segment ) {
+            munmap(mpi_shm_segment, mpi_shm_segment_size);
+            mpi_shm_segment = NULL;
+        }
+        mpi_shm_teardown();
+        return PARSEC_ERROR;
+    }
+    mpi_shm_ctrl    = (mpi_shm_ring_ctrl_t*)mpi_shm_segment;
+    mpi_shm_buffers = (char*)mpi_shm_segment + nb_rings * sizeof(mpi_shm_ring_ctrl_t);
+
+    mpi_shm_send_locks = (parsec_atomic_lock_t*)malloc(mpi_shm_nb_local * sizeof(parsec_atomic_lock_t));
+    mpi_shm_overflow = (parsec_list_t*)malloc(mpi_shm_nb_local * sizeof(parsec_list_t));
+    for( i = 0; i < mpi_shm_nb_local; i++ ) {
+        parsec_atomic_lock_init(&mpi_shm_send_locks[i]);
+        PARSEC_OBJ_CONSTRUCT(&mpi_shm_overflow[i], parsec_list_t);
+    }
+    PARSEC_OBJ_CONSTRUCT(&mpi_shm_onesided_ops, parsec_list_t);
+    mpi_shm_nb_overflow = 0;
+
+    mpi_shm_local_of = (int*)malloc(context->nb_nodes * sizeof(int));
+    for( i = 0; i < context->nb_nodes; i++ ) mpi_shm_local_of[i] = -1;
+    for( i = 0; i < mpi_shm_nb_local; i++ ) mpi_shm_local_of[mpi_shm_peers[i].rank] = i;
+
+    /* Single copy requires the permission to access the memory of the other
+     * processes, which depends on the system configuration. Check it once. */
+    ok = 0;
+#if defined(PARSEC_HAVE_PROCESS_VM_READV)
+    if( parsec_param_comm_shm_single_copy ) {
+        mpi_shm_peer_t *next = &mpi_shm_peers[(mpi_shm_local_rank + 1) % mpi_shm_nb_local];
+        uint64_t value = 0;
+        struct iovec liov = { .iov_base = &value, .iov_len = sizeof(uint64_t) };
+        struct iovec riov = { .iov_base = (void*)next->probe, .iov_len = sizeof(uint64_t) };
+        ok = (sizeof(uint64_t) == process_vm_readv(next->pid, &liov, 1, &riov, 1, 0)) &&
+             (value == (MPI_SHM_CMA_MAGIC ^ (uint64_t)next->rank));
+    }
+#endif  /* defined(PARSEC_HAVE_PROCESS_VM_READV) */
+    MPI_Allreduce(&ok, &mpi_shm_cma, 1, MPI_INT, MPI_MIN, mpi_shm_local_comm);
+
+    parsec_debug_verbose(3, parsec_comm_output_stream,
+                         "MPI:\tshared memory transport between %d local processes (rings of %zu bytes, single copy %s)",
+                         mpi_shm_nb_local, mpi_shm_ring_size, mpi_shm_cma ? "enabled" : "disabled");
+    return PARSEC_SUCCESS;
+}
+
+int
+mpi_shm_enable(parsec_comm_engine_t *ce)
+{
+    parsec_context_t *context = ce->parsec_context;
+    int rc = mpi_no_thread_enable(ce);
+
+    /* Nothing to do if the layer was already built for this communicator */
+    if( mpi_shm_comm == (MPI_Comm)context->comm_ctx )
+        return rc;
+    mpi_shm_teardown();
+    mpi_shm_comm = (MPI_Comm)context->comm_ctx;
+    if( !parsec_param_comm_shm || (context->nb_nodes < 2) )
+        return rc;
+    if( PARSEC_SUCCESS != mpi_shm_setup(ce) )
+        return rc;
+
+    parsec_ce.send_am  = mpi_shm_send_active_message;
+    parsec_ce.put      = mpi_shm_put;
+    parsec_ce.get      = mpi_shm_get;
+    parsec_ce.progress = mpi_shm_progress;
+    return rc;
+}
+
+int
+mpi_shm_fini(parsec_comm_engine_t *ce)
+{
+    mpi_shm_teardown();
+    mpi_shm_comm = MPI_COMM_NULL;
+    return mpi_funnelled_fini(ce);
+}
+
+#endif  /* defined(PARSEC_HAVE_MPI_30) && defined(PARSEC_HAVE_SHM_OPEN) */
+
+parsec_comm_engine_t *
+mpi_shm_init(parsec_comm_engine_t *ce)
+{
+    parsec_mca_param_reg_int_name("runtime", "comm_shm",
+                                  "Exchange messages with the processes on the same node through shared memory rings (0: no, 1: yes)",
+                                  false, false, parsec_param_comm_shm, &parsec_param_comm_shm);
+    parsec_mca_param_reg_int_name("runtime", "comm_shm_ring_size",
+                                  "Size in bytes of each shared memory ring, rounded up to a power of two. Tags with messages"
+                                  " larger than a quarter of the ring use MPI",
+                                  false, false, parsec_param_comm_shm_ring_size, &parsec_param_comm_shm_ring_size);
+    parsec_mca_param_reg_int_name("runtime", "comm_shm_single_copy",
+                                  "Move contiguous data between processes on the same node with a single copy"
+                                  " using Cross Memory Attach, when allowed by the system (0: no, 1: yes)",
+                                  false, false, parsec_param_comm_shm_single_copy, &parsec_param_comm_shm_single_copy);
+#if defined(PARSEC_HAVE_MPI_30) && defined(PARSEC_HAVE_SHM_OPEN)
+    ce->enable = mpi_shm_enable;
+    ce->fini   = mpi_shm_fini;
+#endif  /* defined(PARSEC_HAVE_MPI_30) && defined(PARSEC_HAVE_SHM_OPEN) */
+    return ce;
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+#ifndef __USE_PARSEC_MPI_SHM_H__
+#define __USE_PARSEC_MPI_SHM_H__
+
+#include "parsec/parsec_comm_engine.h"
+
+/**
+ * Intra-node transport layered on top of the funnelled MPI communication
+ * engine. Processes sharing a node exchange active messages through
+ * single-producer single-consumer rings in a shared memory segment, and
+ * move contiguous data with a single copy using Cross Memory Attach.
+ * Everything else (inter-node peers, large AM tags, non-contiguous data)
+ * is forwarded to the MPI implementation.
+ */
+parsec_comm_engine_t *mpi_shm_init(parsec_comm_engine_t *ce);
+int mpi_shm_fini(parsec_comm_engine_t *ce);
+int mpi_shm_enable(parsec_comm_engine_t *ce);
+
+#endif /* __USE_PARSEC_MPI_SHM_H__ */
@@ -40,8 +40,10 @@ static int remote_dep_bcast_star_child(int me, int him);
 #ifdef PARSEC_DIST_COLLECTIVES
 /* comm_coll_bcast: see values in the corresponding mca_register */
 static int parsec_param_comm_coll_bcast = 1;
+static int parsec_param_comm_dtd_relay = 0;
 static int remote_dep_bcast_chainpipeline_child(int me, int him);
 static int remote_dep_bcast_binomial_child(int me, int him);
+static int remote_dep_bcast_binary_child(int me, int him);
 static int (*remote_dep_bcast_child)(int me, int him) = remote_dep_bcast_chainpipeline_child;
 #else
 #define remote_dep_bcast_child(me, him) remote_dep_bcast_start_child(me, him)
@@ -167,6 +169,7 @@ parsec_remote_deps_t* remote_deps_allocate( parsec_lifo_t* lifo )
             remote_deps->output[i].deps_mask  = 0;
             remote_deps->output[i].count_bits = 0;
             remote_deps->output[i].priority   = 0xffffffff;
+            remote_deps->output[i].pipeline   = NULL;
             ptr += rank_bit_size;
         }
         /* fw_mask immediately follows outputs */
@@ -184,6 +187,8 @@ parsec_remote_deps_t* remote_deps_allocate( parsec_lifo_t* lifo )
     remote_deps->pending_ack     = 0;
     remote_deps->incoming_mask   = 0;
     remote_deps->outgoing_mask   = 0;
+    remote_deps->relayed_mask    = 0;
+    remote_deps->route_mask      = 0;
     PARSEC_DEBUG_VERBOSE(30, parsec_comm_output_stream, "remote_deps_allocate: %p", remote_deps);
     return remote_deps;
 }
@@ -263,7 +268,10 @@ int parsec_remote_dep_init(parsec_context_t* context)
     parsec_mca_param_reg_int_name("runtime", "comm_coll_bcast", "Controls the default broadcast algorithm topology.\n"
                                                                 "  0: star topology (direct one to all).\n"
                                                                 "  1: chain topology.\n"
-                                                                "  2: binomial topology.\n",
+                                                                "  2: binomial topology.\n"
+                                                                "  3: binary tree topology.\n"
+                                                                "Large data are forwarded in fragments (see runtime_comm_fragment_size) "
+                                                                "along the chain and tree topologies.\n",
                                   false, false, parsec_param_comm_coll_bcast, &parsec_param_comm_coll_bcast);
     switch(parsec_param_comm_coll_bcast) {
     case 0:
@@ -275,11 +283,18 @@ int parsec_remote_dep_init(parsec_context_t* context)
     case 2:
         remote_dep_bcast_child = remote_dep_bcast_binomial_child;
         break;
+    case 3:
+        remote_dep_bcast_child = remote_dep_bcast_binary_child;
+        break;
     default:
         parsec_warning("Invalid collective type requested %d; using star topology.", parsec_param_comm_coll_bcast);
         remote_dep_bcast_child = remote_dep_bcast_star_child;
         break;
     }
+    parsec_mca_param_reg_int_name("runtime", "comm_dtd_relay", "Let the DTD broadcasts follow the runtime_comm_coll_bcast topology, the ranks"
+                                  " receiving the data forwarding it down the tree (experimental). Otherwise DTD"
+                                  " broadcasts use the star topology.",
+                                  false, false, parsec_param_comm_dtd_relay, &parsec_param_comm_dtd_relay);
 #endif
 
     (void)remote_dep_dequeue_init(context);
@@ -324,6 +339,15 @@ static int remote_dep_bcast_star_child(int me, int him)
     else return 0;
 }
 
+int parsec_remote_dep_dtd_relays(void)
+{
+#ifdef PARSEC_DIST_COLLECTIVES
+    return parsec_param_comm_dtd_relay && (remote_dep_bcast_child != remote_dep_bcast_star_child);
+#else
+    return 0;
+#endif  /* PARSEC_DIST_COLLECTIVES */
+}
+
 #ifdef PARSEC_DIST_COLLECTIVES
 
 static int remote_dep_bcast_chainpipeline_child(int me, int him)
@@ -357,6 +381,14 @@ static int remote_dep_bcast_binomial_child(int me, int him)
     return him == me;
 }
 
+static int remote_dep_bcast_binary_child(int me, int him)
+{
+    assert(him >= 0);
+    if(him == 0) return 0; /* root is child to nobody */
+    if(me == -1) return 0;
+    return ((him - 1) / 2) == me;
+}
+
 /**
  * This function is called from the successor iterator in order to rebuilt
  * the information needed to propagate the collective in a meaningful way. In
@@ -527,8 +559,10 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
                         tmp, remote_deps->root, es->virtual_process->parsec_context->my_rank, my_idx, rank);
 
                 int remote_dep_bcast_child_permits = 0;
-                /* Right now DTD only supports a star broadcast topology */
-                if( PARSEC_TASKPOOL_TYPE_DTD == task->taskpool->taskpool_type ) {
+                /* DTD receivers cannot rebuild the rank set from the task, it travels
+                 * with the activation (see route_mask) when runtime_comm_dtd_relay is
+                 * set. Otherwise DTD only supports a star broadcast topology */
+                if( (PARSEC_TASKPOOL_TYPE_DTD == task->taskpool->taskpool_type) && !parsec_remote_dep_dtd_relays() ) {
                     remote_dep_bcast_child_permits = remote_dep_bcast_star_child(my_idx, idx);
                 } else {
 #ifdef PARSEC_DIST_COLLECTIVES
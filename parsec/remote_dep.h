@@ -46,6 +46,8 @@ typedef struct remote_dep_wire_activate_s {
     uint16_t             task_class_id;
     uint16_t             length;
     uint32_t             root;
+    uint32_t             fragment_mask; /**< the outputs the source can deliver in fragments */
+    uint32_t             route_mask;    /**< the outputs whose broadcast rank set follows the header */
     parsec_assignment_t  locals[MAX_LOCAL_COUNT];
 } remote_dep_wire_activate_t;
 
@@ -54,6 +56,7 @@ typedef struct remote_dep_wire_get_s {
     remote_dep_datakey_t       remote_callback_data;
     remote_dep_datakey_t       output_mask;
     uintptr_t                  callback_fn;
+    remote_dep_datakey_t       fragment_size;  /**< 0 to receive the data in a single transfer */
     parsec_ce_mem_reg_handle_t remote_memory_handle;
 } remote_dep_wire_get_t;
 
@@ -127,6 +130,8 @@ struct remote_dep_output_param_s {
     int32_t                              priority;    /**< the priority of the message */
     uint32_t                             count_bits;  /**< The number of participants */
     uint32_t*                            rank_bits;   /**< The array of bits representing the propagation path */
+    struct remote_dep_pipeline_s        *pipeline;    /**< The fragments landed so far, while the data is received
+                                                       in fragments, or NULL */
 };
 
 struct parsec_remote_deps_s {
@@ -138,6 +143,9 @@ struct parsec_remote_deps_s {
     int32_t                          root;          /**< The root of the control message */
     uint32_t                         incoming_mask; /**< track all incoming actions (receives) */
     uint32_t                         outgoing_mask; /**< track all outgoing actions (send) */
+    uint32_t                         relayed_mask;  /**< the received outputs, when the propagation started
+                                                     * before the end of their reception */
+    uint32_t                         route_mask;    /**< the outputs whose rank set came with the activation (DTD) */
     remote_dep_wire_activate_t       msg;           /**< A copy of the message control */
     void                            *eager_msg;     /**< A pointer to the eager buffer if this is an eager msg, otherwise NULL */
     int32_t                          max_priority;
@@ -243,6 +251,9 @@ int parsec_remote_dep_propagate(parsec_execution_stream_t* es,
                                parsec_remote_deps_t* deps);
 #endif
 
+/* Returns 1 if the DTD broadcasts forward the data through the receivers (runtime_comm_dtd_relay) */
+int parsec_remote_dep_dtd_relays(void);
+
 #else
 #define parsec_remote_dep_init(ctx)            0
 #define parsec_remote_dep_fini(ctx)            0
@@ -295,6 +306,7 @@ union dep_cmd_u {
     struct {
         remote_dep_wire_get_t      task;
         int                        peer;
+        uint32_t                   next_fragment;
         parsec_ce_mem_reg_handle_t remote_memory_handle;
     } activate;
     struct {
@@ -48,6 +48,15 @@ static int parsec_param_nb_tasks_extracted = 20;
  */
 static size_t parsec_param_short_limit = RDEP_MSG_SHORT_LIMIT;
 static int parsec_param_enable_aggregate = 0;
+/* Number of threads progressing the command queue, see comm_threads */
+static int parsec_param_comm_threads = 1;
+/* Size of the fragments of the large transfers, see comm_fragment_size */
+static size_t parsec_param_fragment_size = 1024 * 1024;
+/* Flush policy of the per peer coalescing buffers, see comm_aggregate_delay */
+static int parsec_param_aggregate_delay = 0;
+static int parsec_param_aggregate_bytes = 0;
+static int parsec_param_aggregate_msgs = 0;
+static int parsec_param_aggregate_flush_idle = 1;
 
 parsec_mempool_t *parsec_remote_dep_cb_data_mempool = NULL;
 
@@ -67,6 +76,74 @@ PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(remote_dep_cb_data_t);
 PARSEC_OBJ_CLASS_INSTANCE(remote_dep_cb_data_t, parsec_list_item_t,
                    NULL, NULL);
 
+/**
+ * Reception state of a data transferred in fragments. The fragments can land
+ * in any order, the prefix is the number of leading fragments that landed, and
+ * thus the part of the data that can already be forwarded. The requests to
+ * forward the data that catch up with the prefix wait in the deferred list.
+ * Only manipulated by the communication thread.
+ */
+typedef struct remote_dep_pipeline_s {
+    size_t        size;
+    size_t        fragment_size;
+    uint32_t      nb_fragments;
+    uint32_t      nb_landed;
+    uint32_t      prefix;
+    parsec_list_t deferred;
+    uint8_t       landed[1];
+} remote_dep_pipeline_t;
+
+/**
+ * Returns the size in bytes of count elements of the datatype if they form a
+ * single dense block starting at the data pointer, or 0 otherwise.
+ */
+static size_t remote_dep_mpi_dense_size(parsec_datatype_t dtt, uint64_t count)
+{
+    MPI_Aint lb, extent, true_lb, true_extent;
+    int size;
+
+    if( (PARSEC_DATATYPE_NULL == dtt) || (PARSEC_DATATYPE_PACKED == dtt) || (0 == count) )
+        return 0;
+    MPI_Type_size(dtt, &size);
+    MPI_Type_get_extent(dtt, &lb, &extent);
+    MPI_Type_get_true_extent(dtt, &true_lb, &true_extent);
+    if( (0 != true_lb) || (size != true_extent) || ((1 != count) && (extent != true_extent)) )
+        return 0;
+    return (size_t)size * count;
+}
+
+static inline int remote_dep_mpi_fragmented(size_t size)
+{
+    return (0 != parsec_param_fragment_size) && (size > parsec_param_fragment_size);
+}
+
+static void remote_dep_mpi_register_bytes(void *mem, size_t size,
+                                          parsec_ce_mem_reg_handle_t *handle,
+                                          size_t *handle_size)
+{
+    if(parsec_ce.capabilites.supports_noncontiguous_datatype) {
+        parsec_ce.mem_register(mem, PARSEC_MEM_TYPE_NONCONTIGUOUS,
+                               size, parsec_datatype_uint8_t,
+                               -1, handle, handle_size);
+    } else {
+        parsec_ce.mem_register(mem, PARSEC_MEM_TYPE_CONTIGUOUS,
+                               -1, parsec_datatype_uint8_t,
+                               size, handle, handle_size);
+    }
+}
+
+static remote_dep_pipeline_t* remote_dep_mpi_pipeline_new(size_t size, size_t fragment_size)
+{
+    uint32_t nb_fragments = (uint32_t)((size + fragment_size - 1) / fragment_size);
+    remote_dep_pipeline_t* pipeline = (remote_dep_pipeline_t*)calloc(1, sizeof(remote_dep_pipeline_t) + nb_fragments);
+
+    pipeline->size          = size;
+    pipeline->fragment_size = fragment_size;
+    pipeline->nb_fragments  = nb_fragments;
+    PARSEC_OBJ_CONSTRUCT(&pipeline->deferred, parsec_list_t);
+    return pipeline;
+}
+
 char*
 remote_dep_cmd_to_string(remote_dep_wire_activate_t* origin,
                          char* str,
@@ -96,17 +173,100 @@ remote_dep_cmd_to_string(remote_dep_wire_activate_t* origin,
 #define datakey_count 3
 
 static pthread_t dep_thread_id;
-parsec_dequeue_t dep_cmd_queue;
-parsec_list_t    dep_cmd_fifo;             /* ordered non threaded fifo */
 parsec_list_t    dep_activates_fifo;       /* ordered non threaded fifo */
 parsec_list_t    dep_activates_noobj_fifo; /* non threaded fifo of dep activates related to taskpools not actually known */
 parsec_list_t    dep_put_fifo;             /* ordered non threaded fifo */
 
-/* help manage the messages in the same category, where a category is either messages
- * to the same destination, or with the same action key.
+/**
+ * Activations toward a peer packed together while waiting to be sent. The
+ * packed commands are only released once the buffer is sent, as they keep
+ * the deps and the taskpool alive. Only used by the shard owning the peer.
+ */
+typedef struct remote_dep_coalesce_s {
+    parsec_list_item_t  super;          /* in the pending list of the shard while not empty */
+    parsec_list_item_t *ring;           /* the packed commands */
+    int                 position;       /* bytes used in the buffer */
+    int                 nb_items;
+    double              first;          /* when the oldest command was packed */
+    double              packed;         /* sum of the packing times of the commands */
+    char                buffer[DEP_SHORT_BUFFER_SIZE];
+} remote_dep_coalesce_t;
+
+/**
+ * The commands are distributed among shards, each progressed by its own
+ * thread. The activations are assigned to a shard based on their destination,
+ * so that all messages toward a peer are ordered and aggregated by the same
+ * thread. All the other commands go to the first shard, progressed by the
+ * communication thread which is also the only one to progress the
+ * communication engine and to handle the GET and PUT protocols.
  */
-static dep_cmd_item_t** parsec_mpi_same_pos_items;
-static int parsec_mpi_same_pos_items_size = 0;
+typedef struct remote_dep_shard_s {
+    parsec_dequeue_t  cmd_queue;
+    parsec_list_t     cmd_fifo;             /* ordered non threaded fifo */
+    /* help manage the messages in the same category, where a category is either messages
+     * to the same destination, or with the same action key.
+     */
+    dep_cmd_item_t  **same_pos_items;
+    int               same_pos_items_size;
+    volatile int32_t  depth;                /* commands pushed and not yet completed */
+    volatile int32_t  busy;                 /* the shard thread is working on the commands */
+    int32_t           max_depth;
+    uint64_t          nb_messages;          /* activation messages sent since the engine was enabled */
+    uint64_t          nb_saved;             /* activations that did not need a message of their own */
+    uint64_t          nb_delayed;           /* activations that waited in a coalescing buffer */
+    double            added_latency;        /* total time spent by these activations in the buffers */
+    remote_dep_coalesce_t **coalesce;       /* per peer coalescing buffers, allocated on demand */
+    int               coalesce_size;
+    parsec_list_t     coalesce_pending;     /* the non empty coalescing buffers, oldest first */
+    double            start;
+    int               id;
+    pthread_t         thread_id;
+    parsec_execution_stream_t es;           /* only for the additional shards */
+} remote_dep_shard_t;
+
+static remote_dep_shard_t *remote_dep_shards = NULL;
+static int remote_dep_nb_shards = 1;
+static volatile int remote_dep_shards_running = 0;
+static volatile int remote_dep_shards_enabled = 0;
+
+static inline remote_dep_shard_t* remote_dep_shard_of(int peer)
+{
+    return &remote_dep_shards[peer % remote_dep_nb_shards];
+}
+
+static inline void remote_dep_cmd_push(remote_dep_shard_t* shard, dep_cmd_item_t* item)
+{
+    int32_t depth = parsec_atomic_fetch_inc_int32(&shard->depth) + 1;
+    if( depth > shard->max_depth ) shard->max_depth = depth;  /* statistics only */
+    parsec_dequeue_push_back(&shard->cmd_queue, (parsec_list_item_t*)item);
+}
+
+static int remote_dep_shard_progress(remote_dep_shard_t* shard,
+                                     parsec_execution_stream_t* es,
+                                     int cycles);
+static void* remote_dep_shard_main(remote_dep_shard_t* shard);
+static void remote_dep_shards_reset_stats(void);
+static int remote_dep_coalesce_send(parsec_execution_stream_t* es,
+                                    remote_dep_shard_t* shard,
+                                    dep_cmd_item_t **head_item);
+static void remote_dep_coalesce_flush(parsec_execution_stream_t* es,
+                                      remote_dep_shard_t* shard,
+                                      remote_dep_coalesce_t* co);
+static void remote_dep_coalesce_expire(parsec_execution_stream_t* es,
+                                       remote_dep_shard_t* shard,
+                                       int all);
+static void remote_dep_shard_count(remote_dep_shard_t* shard, int nb_items, double latency);
+
+static void remote_dep_coalesce_release(remote_dep_shard_t* shard)
+{
+    for(int i = 0; i < shard->coalesce_size; i++) {
+        assert((NULL == shard->coalesce[i]) || (NULL == shard->coalesce[i]->ring));
+        free(shard->coalesce[i]);
+    }
+    free(shard->coalesce);
+    shard->coalesce = NULL;
+    shard->coalesce_size = 0;
+}
 
 static int mpi_initialized = 0;
 #if defined(PARSEC_REMOTE_DEP_USE_THREADS)
@@ -123,6 +283,9 @@ parsec_execution_stream_t parsec_comm_es = {
 #endif /* PARSEC_PROF_TRACE */
     .scheduler_object = NULL,
     .next_task = NULL,
+    .ready_scratch = NULL,
+    .ready_scratch_size = 0,
+    .inject_pending = 0,
 #if defined(PARSEC_SIM)
     .largest_simulation_date = 0,
 #endif
@@ -209,6 +372,33 @@ static void remote_dep_mpi_params(parsec_context_t* context) {
 #endif
     parsec_mca_param_reg_int_name("runtime", "comm_aggregate", "Aggregate multiple dependencies in the same short message (1=true,0=false).",
                                   false, false, parsec_param_enable_aggregate, &parsec_param_enable_aggregate);
+    parsec_mca_param_reg_int_name("runtime", "comm_aggregate_delay", "Maximum time in microseconds an activation can wait in the buffer"
+                                  " of its destination for more activations toward the same peer (0 to send the activations as soon"
+                                  " as they are extracted). A positive value enables comm_aggregate. The buffer is also sent once it"
+                                  " holds comm_aggregate_bytes or comm_aggregate_msgs, or when the communication thread is idle"
+                                  " (see comm_aggregate_flush_idle).",
+                                  false, false, parsec_param_aggregate_delay, &parsec_param_aggregate_delay);
+    parsec_mca_param_reg_int_name("runtime", "comm_aggregate_bytes", "Send an aggregation buffer once it holds this many bytes (0 or more than"
+                                  " the short buffer size to only send full buffers).",
+                                  false, false, parsec_param_aggregate_bytes, &parsec_param_aggregate_bytes);
+    parsec_mca_param_reg_int_name("runtime", "comm_aggregate_msgs", "Send an aggregation buffer once it holds this many activations (0 for no limit).",
+                                  false, false, parsec_param_aggregate_msgs, &parsec_param_aggregate_msgs);
+    parsec_mca_param_reg_int_name("runtime", "comm_aggregate_flush_idle", "Send the aggregation buffers as soon as the communication thread"
+                                  " has no more commands to handle, instead of waiting for comm_aggregate_delay (1=true,0=false).",
+                                  false, false, parsec_param_aggregate_flush_idle, &parsec_param_aggregate_flush_idle);
+    if( parsec_param_aggregate_delay > 0 ) {
+        parsec_param_enable_aggregate = 1;
+        if( (parsec_param_aggregate_bytes <= 0) || (parsec_param_aggregate_bytes > (int)DEP_SHORT_BUFFER_SIZE) )
+            parsec_param_aggregate_bytes = DEP_SHORT_BUFFER_SIZE;
+    }
+    parsec_mca_param_reg_int_name("runtime", "comm_threads", "Number of threads progressing the outgoing communications. The activations are"
+                                  " distributed among the threads based on their destination, while the first thread also progresses the"
+                                  " communication engine. More than one thread requires MPI_THREAD_MULTIPLE.",
+                                  false, false, parsec_param_comm_threads, &parsec_param_comm_threads);
+    parsec_mca_param_reg_sizet_name("runtime", "comm_fragment_size", "Size in bytes of the fragments used to transfer large contiguous data (0 to disable)."
+                                    " The ranks relaying a broadcast forward each fragment as soon as it lands, instead of waiting for the"
+                                    " entire data.",
+                                    false, false, parsec_param_fragment_size, &parsec_param_fragment_size);
 }
 
 int
@@ -267,8 +457,22 @@ remote_dep_dequeue_init(parsec_context_t* context)
         }
     }
 
-    PARSEC_OBJ_CONSTRUCT(&dep_cmd_queue, parsec_dequeue_t);
-    PARSEC_OBJ_CONSTRUCT(&dep_cmd_fifo, parsec_list_t);
+    remote_dep_nb_shards = 1;
+    if( parsec_param_comm_threads > 1 ) {
+        if( thread_level_support >= MPI_THREAD_MULTIPLE ) {
+            remote_dep_nb_shards = parsec_param_comm_threads;
+        } else {
+            parsec_warning("Requested %d communication threads, but MPI is not initialized with MPI_THREAD_MULTIPLE.\n"
+                           "\t* PaRSEC will continue with a single communication thread.\n", parsec_param_comm_threads);
+        }
+    }
+    remote_dep_shards = (remote_dep_shard_t*)calloc(remote_dep_nb_shards, sizeof(remote_dep_shard_t));
+    for(int i = 0; i < remote_dep_nb_shards; i++) {
+        PARSEC_OBJ_CONSTRUCT(&remote_dep_shards[i].cmd_queue, parsec_dequeue_t);
+        PARSEC_OBJ_CONSTRUCT(&remote_dep_shards[i].cmd_fifo, parsec_list_t);
+        PARSEC_OBJ_CONSTRUCT(&remote_dep_shards[i].coalesce_pending, parsec_list_t);
+        remote_dep_shards[i].id = i;
+    }
 
     /* Build the condition used to drive the MPI thread */
     pthread_mutex_init( &mpi_thread_mutex, NULL );
@@ -305,6 +509,17 @@ remote_dep_dequeue_init(parsec_context_t* context)
     mpi_initialized = 1;  /* up and running */
     remote_dep_ce_init(context);
 
+    if( context->nb_nodes > 1 ) {
+        /* The additional shard threads only handle activations once the engine is on */
+        remote_dep_shards_running = 1;
+        for(int i = 1; i < remote_dep_nb_shards; i++) {
+            pthread_create(&remote_dep_shards[i].thread_id,
+                           &thread_attr,
+                           (void* (*)(void*))remote_dep_shard_main,
+                           (void*)&remote_dep_shards[i]);
+        }
+    }
+
     return PARSEC_SUCCESS;
 }
 
@@ -328,7 +543,7 @@ remote_dep_dequeue_fini(parsec_context_t* context)
         item->action = DEP_CTL;
         item->cmd.ctl.enable = -1;  /* turn off and return from the MPI thread */
         item->priority = 0;
-        parsec_dequeue_push_back(&dep_cmd_queue, (parsec_list_item_t*) item);
+        remote_dep_cmd_push(&remote_dep_shards[0], item);
 
         /* I am supposed to own the lock. Wake the MPI thread */
         pthread_cond_signal(&mpi_thread_condition);
@@ -336,11 +551,30 @@ remote_dep_dequeue_fini(parsec_context_t* context)
         pthread_join(dep_thread_id, &ret);
         assert((parsec_context_t*)ret == context);
     }
+    if( remote_dep_shards_running ) {
+        remote_dep_shards_running = 0;
+        for(int i = 1; i < remote_dep_nb_shards; i++) {
+            void *ret;
+            pthread_join(remote_dep_shards[i].thread_id, &ret);
+        }
+    }
 
-    assert(NULL == parsec_dequeue_pop_front(&dep_cmd_queue));
-    PARSEC_OBJ_DESTRUCT(&dep_cmd_queue);
-    assert(NULL == parsec_dequeue_pop_front(&dep_cmd_fifo));
-    PARSEC_OBJ_DESTRUCT(&dep_cmd_fifo);
+    for(int i = 0; i < remote_dep_nb_shards; i++) {
+        assert(NULL == parsec_dequeue_pop_front(&remote_dep_shards[i].cmd_queue));
+        PARSEC_OBJ_DESTRUCT(&remote_dep_shards[i].cmd_queue);
+        assert(NULL == parsec_list_nolock_pop_front(&remote_dep_shards[i].cmd_fifo));
+        PARSEC_OBJ_DESTRUCT(&remote_dep_shards[i].cmd_fifo);
+        assert(parsec_list_nolock_is_empty(&remote_dep_shards[i].coalesce_pending));
+        PARSEC_OBJ_DESTRUCT(&remote_dep_shards[i].coalesce_pending);
+        free(remote_dep_shards[i].same_pos_items);
+        remote_dep_coalesce_release(&remote_dep_shards[i]);
+        if( i > 0 ) free(remote_dep_shards[i].es.ready_scratch);
+    }
+    free(remote_dep_shards); remote_dep_shards = NULL;
+    free(parsec_comm_es.ready_scratch);
+    parsec_comm_es.ready_scratch = NULL;
+    parsec_comm_es.ready_scratch_size = 0;
+    remote_dep_nb_shards = 1;
     mpi_initialized = 0;
 
     PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Process has reshaped %zu tiles.", count_reshaping);
@@ -401,7 +635,7 @@ remote_dep_dequeue_off(parsec_context_t* context)
     while( 3 != parsec_communication_engine_up ) sched_yield();
     PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "MPI: comm engine signalled OFF on process %d/%d",
                          context->my_rank, context->nb_nodes);
-    parsec_dequeue_push_back(&dep_cmd_queue, (parsec_list_item_t*) item);
+    remote_dep_cmd_push(&remote_dep_shards[0], item);
 
     /* wait until we own the PaRSEC MPI synchronization mutex */
     pthread_mutex_lock(&mpi_thread_mutex);
@@ -470,6 +704,17 @@ void* remote_dep_dequeue_main(parsec_context_t* context)
             }
             parsec_comm_es.dependencies_mempool = &(parsec_comm_es.virtual_process->dependencies_mempool.thread_mempools[0]);
         }
+        /* The additional shards are idle, give them an up-to-date execution stream */
+        for(int i = 1; i < remote_dep_nb_shards; i++) {
+            parsec_task_t **scratch = remote_dep_shards[i].es.ready_scratch;
+            size_t scratch_size = remote_dep_shards[i].es.ready_scratch_size;
+            remote_dep_shards[i].es = parsec_comm_es;
+            remote_dep_shards[i].es.ready_scratch = scratch;  /* keep their own */
+            remote_dep_shards[i].es.ready_scratch_size = scratch_size;
+        }
+        remote_dep_shards_reset_stats();
+        parsec_mfence();
+        remote_dep_shards_enabled = 1;
 
         whatsup = remote_dep_dequeue_nothread_progress(&parsec_comm_es, -1 /* loop till explicitly asked to return */);
         PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "MPI: comm engine OFF on process %d/%d",
@@ -492,7 +737,7 @@ int remote_dep_dequeue_new_taskpool(parsec_taskpool_t* tp)
     item->action = DEP_NEW_TASKPOOL;
     item->priority = 0;
     item->cmd.new_taskpool.tp = tp;
-    parsec_dequeue_push_back(&dep_cmd_queue, (parsec_list_item_t*)item);
+    remote_dep_cmd_push(&remote_dep_shards[0], item);
     return 1;
 }
 
@@ -505,7 +750,7 @@ remote_dep_dequeue_delayed_dep_release(parsec_remote_deps_t *deps)
     item->action = DEP_DTD_DELAYED_RELEASE;
     item->priority = 0;
     item->cmd.release.deps = deps;
-    parsec_dequeue_push_back(&dep_cmd_queue, (parsec_list_item_t*)item);
+    remote_dep_cmd_push(&remote_dep_shards[0], item);
     return 1;
 }
 
@@ -530,7 +775,7 @@ remote_dep_dequeue_send(parsec_execution_stream_t* es, int rank,
         remote_dep_nothread_send(es, &item);
     }
     else {
-        parsec_dequeue_push_back(&dep_cmd_queue, (parsec_list_item_t*)item);
+        remote_dep_cmd_push(remote_dep_shard_of(rank), item);
     }
     return 1;
 }
@@ -568,7 +813,7 @@ void parsec_remote_dep_memcpy(parsec_execution_stream_t* es,
     PARSEC_OBJ_RETAIN(src);
     remote_dep_inc_flying_messages(tp);
 
-    parsec_dequeue_push_back(&dep_cmd_queue, (parsec_list_item_t*) item);
+    remote_dep_cmd_push(&remote_dep_shards[0], item);
 }
 
 static inline parsec_data_copy_t*
@@ -706,7 +951,7 @@ void parsec_local_reshape_cb(parsec_base_future_t *future, ... )
     item->cmd.memcpy_reshape.task = task;
 
     remote_dep_inc_flying_messages(tp);
-    parsec_dequeue_push_back(&dep_cmd_queue, (parsec_list_item_t*) item);
+    remote_dep_cmd_push(&remote_dep_shards[0], item);
 }
 
 #define is_inplace(ctx,dep) NULL
@@ -945,6 +1190,67 @@ remote_dep_get_datatypes(parsec_execution_stream_t* es,
     return 0;
 }
 
+#if defined(PARSEC_DIST_COLLECTIVES)
+/**
+ * Returns 1 if this rank might have to forward the activation further down the
+ * broadcast tree. PTG receivers rebuild the tree from the task, while DTD
+ * receivers get it with the activation.
+ */
+static inline int remote_dep_mpi_may_relay(parsec_remote_deps_t* deps)
+{
+    return (PARSEC_TASKPOOL_TYPE_PTG == deps->taskpool->taskpool_type) || (0 != deps->route_mask);
+}
+
+/**
+ * Forward the activation to our children in the broadcast tree. The
+ * outgoing_mask must have been cleared by the caller.
+ */
+static void remote_dep_mpi_relay(parsec_execution_stream_t* es,
+                                 parsec_task_t* task,
+                                 parsec_remote_deps_t* deps)
+{
+    assert(0 == deps->outgoing_mask);
+    if( PARSEC_TASKPOOL_TYPE_PTG == deps->taskpool->taskpool_type ) {
+        parsec_remote_dep_propagate(es, task, deps);
+        return;
+    }
+    /* The data consumed locally are protected from the local writers by the
+     * readers count until the forwarding completes (see remote_dep_release_incoming) */
+    deps->outgoing_mask = deps->route_mask;
+    parsec_remote_dep_activate(es, task, deps, deps->route_mask);
+}
+
+/**
+ * All the data still expected by this rank are received in fragments, start
+ * the propagation right away so that our children can retrieve each fragment
+ * as soon as it lands. The received outputs are kept in the relayed_mask until
+ * the end of the reception.
+ */
+static void remote_dep_mpi_relay_early(parsec_execution_stream_t* es,
+                                       parsec_remote_deps_t* deps)
+{
+    parsec_task_t task;
+    int i;
+
+    task.taskpool = deps->taskpool;
+    task.task_class = task.taskpool->task_classes_array[deps->msg.task_class_id];
+    task.priority = deps->priority;
+    for(i = 0; i < task.task_class->nb_locals;
+        task.locals[i] = deps->msg.locals[i], i++);
+    for(i = 0; i < task.task_class->nb_flows;
+        task.data[i].data_in = task.data[i].data_out = NULL, task.data[i].source_repo_entry = NULL, task.data[i].source_repo = NULL, i++);
+    task.repo_entry = NULL;
+
+    /* Same as in remote_dep_release_incoming once everything is received */
+    remote_dep_inc_flying_messages(task.taskpool);
+    (void)parsec_atomic_fetch_inc_int32(&deps->pending_ack);
+
+    deps->relayed_mask = deps->outgoing_mask;
+    deps->outgoing_mask = 0;
+    remote_dep_mpi_relay(es, &task, deps);
+}
+#endif  /* PARSEC_DIST_COLLECTIVES */
+
 /**
  * Trigger the local reception of a remote task data. Upon completion of all
  * pending receives related to a remote task completion, we call the
@@ -993,10 +1299,16 @@ remote_dep_release_incoming(parsec_execution_stream_t* es,
 
 #ifdef PARSEC_DIST_COLLECTIVES
     /* Corresponding comment below on the propagation part */
-    if(0 == origin->incoming_mask && PARSEC_TASKPOOL_TYPE_PTG == origin->taskpool->taskpool_type) {
+    if(0 == origin->incoming_mask && 0 == origin->relayed_mask && remote_dep_mpi_may_relay(origin)) {
         remote_dep_inc_flying_messages(task.taskpool);
         (void)parsec_atomic_fetch_inc_int32(&origin->pending_ack);
     }
+    /* DTD tasks do not wait for the readers of their input before writing into it */
+    if( PARSEC_TASKPOOL_TYPE_DTD == origin->taskpool->taskpool_type ) {
+        for(i = 0; (complete_mask & origin->route_mask) >> i; i++)
+            if( ((1U<<i) & complete_mask & origin->route_mask) && (NULL != origin->output[i].data.data) )
+                (void)parsec_atomic_fetch_inc_int32(&origin->output[i].data.data->readers);
+    }
 #endif  /* PARSEC_DIST_COLLECTIVES */
 
     if(PARSEC_TASKPOOL_TYPE_PTG == origin->taskpool->taskpool_type) {
@@ -1032,12 +1344,21 @@ remote_dep_release_incoming(parsec_execution_stream_t* es,
      * lines above). Once the propagation is started we can release the
      * references on the allocated data and on the dependency.
      */
-    uint32_t mask = origin->outgoing_mask;
-    origin->outgoing_mask = 0;
-
+    uint32_t mask;
 #if defined(PARSEC_DIST_COLLECTIVES)
-    if( PARSEC_TASKPOOL_TYPE_PTG == origin->taskpool->taskpool_type ) /* indicates it is a PTG taskpool */
-        parsec_remote_dep_propagate(es, &task, origin);
+    if( 0 != origin->relayed_mask ) {
+        /* the propagation started with the reception, the outgoing_mask now tracks it */
+        mask = origin->relayed_mask;
+        origin->relayed_mask = 0;
+    } else {
+        mask = origin->outgoing_mask;
+        origin->outgoing_mask = 0;
+        if( remote_dep_mpi_may_relay(origin) )
+            remote_dep_mpi_relay(es, &task, origin);
+    }
+#else
+    mask = origin->outgoing_mask;
+    origin->outgoing_mask = 0;
 #endif  /* PARSEC_DIST_COLLECTIVES */
     /**
      * Release the dependency owned by the communication engine for all data
@@ -1050,7 +1371,7 @@ remote_dep_release_incoming(parsec_execution_stream_t* es,
             PARSEC_DATA_COPY_RELEASE(origin->output[i].data.data);
     }
 #if defined(PARSEC_DIST_COLLECTIVES)
-    if(PARSEC_TASKPOOL_TYPE_PTG == origin->taskpool->taskpool_type) {
+    if( remote_dep_mpi_may_relay(origin) ) {
         remote_dep_complete_and_cleanup(&origin, 1);
     } else {
         remote_deps_free(origin);
@@ -1065,27 +1386,91 @@ remote_dep_release_incoming(parsec_execution_stream_t* es,
 int
 remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
                                      int cycles)
+{
+    return remote_dep_shard_progress(&remote_dep_shards[0], es, cycles);
+}
+
+/**
+ * Wait until the additional shards have completed all the commands pushed
+ * before the engine was turned off, while keeping the network progressing.
+ */
+static void remote_dep_shards_drain(parsec_execution_stream_t* es)
+{
+    int i;
+    for(i = 1; i < remote_dep_nb_shards; i++) {
+        while( 0 != remote_dep_shards[i].depth ) {
+            if( 0 == remote_dep_mpi_progress(es) )
+                sched_yield();
+        }
+    }
+    remote_dep_shards_enabled = 0;
+    parsec_mfence();
+    for(i = 1; i < remote_dep_nb_shards; i++) {
+        while( remote_dep_shards[i].busy ) sched_yield();
+    }
+}
+
+/* Report the activity of each shard since the engine was turned on */
+static void remote_dep_shards_report(parsec_context_t* context)
+{
+    double now = MPI_Wtime(), duration;
+    for(int i = 0; i < remote_dep_nb_shards; i++) {
+        remote_dep_shard_t* shard = &remote_dep_shards[i];
+        duration = now - shard->start;
+        parsec_debug_verbose(4, parsec_comm_output_stream,
+                             "MPI:\trank %d shard %d: %"PRIu64" activation messages in %.3f s (%.1f msg/s), max queue depth %d,"
+                             " %"PRIu64" messages saved by aggregation, %.1f us added latency on average",
+                             context->my_rank, i, shard->nb_messages, duration,
+                             duration > 0.0 ? (double)shard->nb_messages / duration : 0.0,
+                             shard->max_depth, shard->nb_saved,
+                             shard->nb_delayed > 0 ? 1e6 * shard->added_latency / (double)shard->nb_delayed : 0.0);
+    }
+}
+
+static void remote_dep_shards_reset_stats(void)
+{
+    double now = MPI_Wtime();
+    for(int i = 0; i < remote_dep_nb_shards; i++) {
+        remote_dep_shards[i].nb_messages = 0;
+        remote_dep_shards[i].nb_saved = 0;
+        remote_dep_shards[i].nb_delayed = 0;
+        remote_dep_shards[i].added_latency = 0.0;
+        remote_dep_shards[i].max_depth = remote_dep_shards[i].depth;
+        remote_dep_shards[i].start = now;
+    }
+}
+
+static int
+remote_dep_shard_progress(remote_dep_shard_t* shard,
+                          parsec_execution_stream_t* es,
+                          int cycles)
 {
     parsec_context_t* context = es->virtual_process->parsec_context;
     parsec_list_item_t *items;
     dep_cmd_item_t *item, *same_pos = NULL;
     parsec_list_t temp_list;
-    int ret = 0, how_many, position, executed_tasks = 0;
+    int ret = 0, how_many, position, executed_tasks = 0, nb_sent;
 
     PARSEC_OBJ_CONSTRUCT(&temp_list, parsec_list_t);
  check_pending_queues:
     if( cycles >= 0 )
-        if( 0 == cycles--) return executed_tasks;  /* report how many events were progressed */
+        if( 0 == cycles--) {
+            PARSEC_OBJ_DESTRUCT(&temp_list);
+            return executed_tasks;  /* report how many events were progressed */
+        }
+    /* Send the aggregation buffers that waited long enough */
+    if( !parsec_list_nolock_is_empty(&shard->coalesce_pending) )
+        remote_dep_coalesce_expire(es, shard, 0);
 
     /* Move a number of transfers from the shared dequeue into our ordered lifo. */
     how_many = 0;
-    while( NULL != (item = (dep_cmd_item_t*) parsec_dequeue_try_pop_front(&dep_cmd_queue)) ) {
+    while( NULL != (item = (dep_cmd_item_t*) parsec_dequeue_try_pop_front(&shard->cmd_queue)) ) {
         if( DEP_CTL == item->action ) {
             /* A DEP_CTL is a barrier that must not be crossed, flush the
              * ordered fifo and don't add anything until it is consumed */
-            if( parsec_list_nolock_is_empty(&dep_cmd_fifo) && parsec_list_nolock_is_empty(&temp_list) )
+            if( parsec_list_nolock_is_empty(&shard->cmd_fifo) && parsec_list_nolock_is_empty(&temp_list) )
                 goto handle_now;
-            parsec_dequeue_push_front(&dep_cmd_queue, (parsec_list_item_t*)item);
+            parsec_dequeue_push_front(&shard->cmd_queue, (parsec_list_item_t*)item);
             break;
         }
         how_many++;
@@ -1094,7 +1479,7 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
         position = (DEP_ACTIVATE == item->action) ? item->cmd.activate.peer : (context->nb_nodes + item->action);
 
         parsec_list_item_singleton(&item->pos_list);
-        same_pos = parsec_mpi_same_pos_items[position];
+        same_pos = shard->same_pos_items[position];
         if((NULL != same_pos) && (same_pos->priority >= item->priority)) {
             /* insert the item in the peer list */
             parsec_list_item_ring_push_sorted(&same_pos->pos_list, &item->pos_list, dep_mpi_pos_list);
@@ -1103,7 +1488,7 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
                 /* this is the new head of the list. */
                 parsec_list_item_ring_push(&same_pos->pos_list, &item->pos_list);
                 /* Remove previous elem from the priority list. The element
-                 might be either in the dep_cmd_fifo if it is old enough to be
+                 might be either in the cmd_fifo if it is old enough to be
                  pushed there, or in the temp_list waiting to be moved
                  upstream. Pay attention from which queue it is removed. */
 #if defined(PARSEC_DEBUG_PARANOID)
@@ -1113,7 +1498,7 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
 #endif
                 parsec_list_item_singleton((parsec_list_item_t*)same_pos);
             }
-            parsec_mpi_same_pos_items[position] = item;
+            shard->same_pos_items[position] = item;
             /* And add ourselves in the temp list */
             parsec_list_nolock_push_front(&temp_list, (parsec_list_item_t*)item);
         }
@@ -1126,12 +1511,14 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
         /* Remove the ordered items from the list, and clean the list */
         items = parsec_list_nolock_unchain(&temp_list);
         /* Insert them into the locally ordered cmd_fifo */
-        parsec_list_nolock_chain_sorted(&dep_cmd_fifo, items, dep_cmd_prio);
+        parsec_list_nolock_chain_sorted(&shard->cmd_fifo, items, dep_cmd_prio);
     }
     /* Extract the head of the list and point the array to the correct value */
-    if(NULL == (item = (dep_cmd_item_t*)parsec_list_nolock_pop_front(&dep_cmd_fifo)) ) {
-        /* only progress MPI if necessary */
-        if (context->nb_nodes > 1) {
+    if(NULL == (item = (dep_cmd_item_t*)parsec_list_nolock_pop_front(&shard->cmd_fifo)) ) {
+        if( parsec_param_aggregate_flush_idle && !parsec_list_nolock_is_empty(&shard->coalesce_pending) )
+            remote_dep_coalesce_expire(es, shard, 1);
+        /* only progress MPI if necessary, and only from the first shard */
+        if( (context->nb_nodes > 1) && (0 == shard->id) ) {
             ret = remote_dep_mpi_progress(es);
             if( 0 == ret
                 && ((comm_yield == 2)
@@ -1153,8 +1540,14 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
     case DEP_CTL:
         ret = item->cmd.ctl.enable;
         PARSEC_OBJ_DESTRUCT(&temp_list);
+        /* The activations handled by the other shards must be out before turning off */
+        remote_dep_coalesce_expire(es, shard, 1);
+        remote_dep_shards_drain(es);
+        if( parsec_output_get_verbosity(parsec_comm_output_stream) >= 4 )
+            remote_dep_shards_report(context);
         PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, "rank %d DISABLE MPI communication engine", parsec_debug_rank);
         free(item);
+        parsec_atomic_fetch_dec_int32(&shard->depth);
         return ret;  /* FINI or OFF */
     case DEP_NEW_TASKPOOL:
         remote_dep_mpi_new_taskpool(es, item);
@@ -1163,7 +1556,13 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
         remote_dep_mpi_release_delayed_deps(es, item);
         break;
     case DEP_ACTIVATE:
-        remote_dep_nothread_send(es, &item);
+        if( parsec_param_aggregate_delay > 0 ) {
+            remote_dep_coalesce_send(es, shard, &item);
+        } else {
+            nb_sent = remote_dep_nothread_send(es, &item);
+            parsec_atomic_fetch_sub_int32(&shard->depth, nb_sent);
+            remote_dep_shard_count(shard, nb_sent, 0.0);
+        }
         same_pos = item;
         goto have_same_pos;
     case DEP_MEMCPY:
@@ -1182,17 +1581,62 @@ remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es,
     if( NULL != same_pos)
         same_pos = container_of(same_pos, dep_cmd_item_t, pos_list);
     free(item);
+    parsec_atomic_fetch_dec_int32(&shard->depth);
   have_same_pos:
     if( NULL != same_pos) {
         parsec_list_nolock_push_front(&temp_list, (parsec_list_item_t*)same_pos);
         /* if we still have pending messages of the same type, stay here for an extra loop */
         if( cycles >= 0 ) cycles++;
     }
-    parsec_mpi_same_pos_items[position] = same_pos;
+    shard->same_pos_items[position] = same_pos;
 
     goto check_pending_queues;
 }
 
+/**
+ * Main loop of the additional shard threads. They only handle the activations
+ * toward their peers, and only while the communication engine is on.
+ */
+static void* remote_dep_shard_main(remote_dep_shard_t* shard)
+{
+    struct timespec ts;
+    int done;
+
+    remote_dep_bind_thread(parsec_comm_es.virtual_process->parsec_context);
+    parsec_set_my_execution_stream(&shard->es);
+    PARSEC_PAPI_SDE_THREAD_INIT();
+#ifdef PARSEC_PROF_TRACE
+    parsec_profiling_stream_t *profile = parsec_profiling_stream_init( 2*1024*1024, "Comm thread %d", shard->id);
+    parsec_profiling_set_default_thread(profile);
+#endif // PARSEC_PROF_TRACE
+
+    while( remote_dep_shards_running ) {
+        shard->busy = 1;
+        parsec_mfence();
+        if( !remote_dep_shards_enabled ) {
+            shard->busy = 0;
+            ts.tv_sec = 0; ts.tv_nsec = comm_yield_ns;
+            nanosleep(&ts, NULL);
+            continue;
+        }
+#ifdef PARSEC_PROF_TRACE
+        shard->es.es_profile = profile;
+#endif // PARSEC_PROF_TRACE
+        done = remote_dep_shard_progress(shard, &shard->es, parsec_param_nb_tasks_extracted);
+        shard->busy = 0;
+        if( 0 == done ) {
+            if( comm_yield ) {
+                ts.tv_sec = 0; ts.tv_nsec = comm_yield_ns;
+                nanosleep(&ts, NULL);
+            } else {
+                sched_yield();
+            }
+        }
+    }
+
+    PARSEC_PAPI_SDE_THREAD_FINI();
+    return NULL;
+}
 
 #ifdef PARSEC_PROF_TRACE
 static int MPI_Activate_sk, MPI_Activate_ek;
@@ -1275,8 +1719,14 @@ static int remote_dep_mpi_pack_dep(int peer,
 {
     parsec_remote_deps_t *deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
     remote_dep_wire_activate_t* msg = &deps->msg;
-    int k, dsize, data_idx, saved_position = *position;
-    uint32_t peer_bank, peer_bit, peer_mask, expected = 0, *data_sizes;
+    /* The header depends on the peer, and the same deps can be packed for
+     * several peers concurrently: work on a private copy */
+    remote_dep_wire_activate_t wire = *msg;
+    int k, dsize, data_idx, nb_routes = 0, saved_position = *position;
+    uint32_t peer_bank, peer_bit, peer_mask, expected = 0, *data_sizes, *routes;
+    uint32_t rank_words = (parsec_remote_dep_context.max_nodes_number + 31) / 32;
+    /* DTD receivers cannot rebuild the broadcast tree, send them the rank set */
+    int relay = (PARSEC_TASKPOOL_TYPE_DTD == deps->taskpool->taskpool_type) && parsec_remote_dep_dtd_relays();
 #if defined(PARSEC_DEBUG) || defined(PARSEC_DEBUG_NOISIER)
     char tmp[MAX_TASK_STRLEN];
     remote_dep_cmd_to_string(&deps->msg, tmp, 128);
@@ -1290,14 +1740,22 @@ static int remote_dep_mpi_pack_dep(int peer,
     /* reserve space for the termination detection piggybacked message */
     dsize += deps->taskpool->tdm.module->outgoing_message_piggyback_size;
     /* count the number of data to prepare the space for their length */
+    wire.fragment_mask = 0;
+    wire.route_mask = 0;
+    /* the owner of the task, the peer might get the activation from a relay */
+    wire.root = (uint32_t)deps->root;
     for(k = 0, data_idx = 0; deps->outgoing_mask >> k; k++) {
         if( !((1U << k) & deps->outgoing_mask )) continue;
         if( !(deps->output[k].rank_bits[peer_bank] & peer_mask) ) continue;
         data_idx++;
+        if( relay && (deps->output[k].count_bits > 1) ) {
+            wire.route_mask |= (1U << k);
+            nb_routes++;
+        }
     }
-    if( (length - (*position)) < (dsize + (data_idx + 1) * (int)sizeof(uint32_t)) ) {  /* no room. bail out */
+    if( (length - (*position)) < (dsize + (data_idx + 1 + nb_routes * (int)rank_words) * (int)sizeof(uint32_t)) ) {  /* no room. bail out */
         PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "Can't pack at %d/%d. Bail out!", *position, length);
-        if( length < (dsize + (data_idx + 1) * (int)sizeof(uint32_t)) ) {
+        if( length < (dsize + (data_idx + 1 + nb_routes * (int)rank_words) * (int)sizeof(uint32_t)) ) {
             parsec_fatal("The header plus data cannot be sent on a single message "
                          "(need %zd but have %zd)\n",
                          length, dsize + data_idx * sizeof(uint32_t));
@@ -1311,10 +1769,17 @@ static int remote_dep_mpi_pack_dep(int peer,
     data_sizes[0] = data_idx;  /* save the total number of data */
     assert((0 != msg->output_mask) &&   /* this should be preset */
            (msg->output_mask & deps->outgoing_mask) == deps->outgoing_mask);
+    /* followed by the rank set of the outputs relayed by the receiver */
+    routes = data_sizes + data_idx + 1;
+    for(k = 0; wire.route_mask >> k; k++) {
+        if( !((1U << k) & wire.route_mask) ) continue;
+        memcpy(routes, deps->output[k].rank_bits, rank_words * sizeof(uint32_t));
+        routes += rank_words;
+    }
     /* update the length of the message */
-    msg->length  = deps->taskpool->tdm.module->outgoing_message_piggyback_size;
-    msg->length += (data_idx + 1) * (uint32_t)sizeof(uint32_t);
-    *position += msg->length;
+    wire.length  = deps->taskpool->tdm.module->outgoing_message_piggyback_size;
+    wire.length += (data_idx + 1 + nb_routes * rank_words) * (uint32_t)sizeof(uint32_t);
+    *position += wire.length;
     item->cmd.activate.task.output_mask = 0;  /* clean start */
     /* Treat for special cases: CTL, Short, etc... */
     for(k = 0, data_idx = 1; deps->outgoing_mask >> k; k++) {
@@ -1344,9 +1809,11 @@ static int remote_dep_mpi_pack_dep(int peer,
         data_sizes[data_idx++] = dsize;
 #ifdef PARSEC_RESHAPE_BEFORE_SEND_TO_REMOTE
         /* If we want to reshape before sending, we don't do short messages. */
-        if( (deps->output[k].data.data_future == NULL) && (parsec_param_short_limit) ) {
+        if( (deps->output[k].data.data_future == NULL) && (parsec_param_short_limit) &&
+            (NULL == deps->output[k].pipeline) ) {
 #else
-        if( parsec_param_short_limit ) {
+        /* Data still landing (relayed in fragments) can only be sent on demand */
+        if( parsec_param_short_limit && (NULL == deps->output[k].pipeline) ) {
 #endif
             if((length - (*position)) >= dsize) {
                 parsec_ce.pack(&parsec_ce, ((char*)PARSEC_DATA_COPY_GET_PTR(data_desc->data)) + type_desc->src_displ,
@@ -1354,7 +1821,7 @@ static int remote_dep_mpi_pack_dep(int peer,
                                packed_buffer, length, position);
                 PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, " EGR\t%s\tparam %d\tshort piggyback in the activate msg (%d/%d)",
                                      tmp, k, *position, length);
-                msg->length += dsize;
+                wire.length += dsize;
                 continue;  /* go to the next */
             } else if( 0 != saved_position ) {
                 PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "DATA\t%s\tparam %d\texceed buffer length. Start again from here next iteration",
@@ -1366,6 +1833,11 @@ static int remote_dep_mpi_pack_dep(int peer,
         }
         expected++;
         item->cmd.activate.task.output_mask |= (1U<<k);
+#ifdef PARSEC_RESHAPE_BEFORE_SEND_TO_REMOTE
+        if( NULL == deps->output[k].data.data_future )
+#endif
+        if( remote_dep_mpi_fragmented(remote_dep_mpi_dense_size(type_desc->src_datatype, type_desc->src_count)) )
+            wire.fragment_mask |= (1U<<k);
         PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, "DATA\t%s\tparam %d\tdeps %p send on demand (increase deps counter by %d [%d])",
                              tmp, k, deps, expected, deps->pending_ack);
     }
@@ -1376,11 +1848,10 @@ static int remote_dep_mpi_pack_dep(int peer,
     parsec_debug_verbose(6, parsec_comm_output_stream, "MPI:\tTO\t%d\tActivate\t% -8s\n"
                          "    \t\t\twith datakey %lx\tmask %lx short mask %lu length %d",
                          peer, tmp, msg->deps, msg->output_mask,
-                         msg->output_mask ^ item->cmd.activate.task.output_mask, msg->length);
+                         msg->output_mask ^ item->cmd.activate.task.output_mask, wire.length);
 #endif
-    /* And now pack the updated message (msg->length and msg->output_mask) itself. */
-    parsec_ce.pack(&parsec_ce, msg, dep_count, dep_dtt, packed_buffer, length, &saved_position);
-    msg->length = dsize + deps->taskpool->tdm.module->outgoing_message_piggyback_size;
+    /* And now pack the updated message (length, fragment and route masks) itself. */
+    parsec_ce.pack(&parsec_ce, &wire, dep_count, dep_dtt, packed_buffer, length, &saved_position);
     deps->taskpool->tdm.module->outgoing_message_pack(deps->taskpool, peer, packed_buffer, &saved_position, length);
     return 0;
 }
@@ -1454,18 +1925,50 @@ static int local_dep_nothread_reshape(parsec_execution_stream_t* es,
     return (MPI_SUCCESS == rc ? 0 : -1);
 }
 
+/**
+ * Send a buffer of packed activations to the peer, and release the ring of
+ * commands packed in it. Returns the number of commands released.
+ */
+static int remote_dep_mpi_send_ring(parsec_execution_stream_t* es,
+                                    int peer, char* packed_buffer, int position,
+                                    parsec_list_item_t* ring)
+{
+    parsec_remote_deps_t *deps = (parsec_remote_deps_t*)((dep_cmd_item_t*)ring)->cmd.activate.task.source_deps;
+    dep_cmd_item_t *item;
+    int nb_sent = 0;
+
+    (void)es;
+    /* dep index is meaningless in this context, set to -1 */
+    TAKE_TIME_WITH_INFO(es->es_profile, MPI_Activate_sk, 0, -1,
+                        es->virtual_process->parsec_context->my_rank, peer,
+                        deps->msg, position, PARSEC_DATATYPE_PACKED);
+    parsec_ce.send_am(&parsec_ce, PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG, peer, packed_buffer, position);
+    TAKE_TIME(es->es_profile, MPI_Activate_ek, 0);
+    DEBUG_MARK_CTL_MSG_ACTIVATE_SENT(peer, (void*)&deps->msg, &deps->msg);
+
+    do {
+        item = (dep_cmd_item_t*)ring;
+        ring = parsec_list_item_ring_chop(ring);
+        deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
+
+        free(item);  /* only large messages are left */
+        nb_sent++;
+
+        remote_dep_complete_and_cleanup(&deps, 1);
+    } while( NULL != ring );
+    return nb_sent;
+}
+
 /**
  * Starting with a particular item pack as many remote_dep_wire_activate
  * messages with the same destination (from the item ring associated with
  * pos_list) into a buffer. Upon completion the entire buffer is send to the
  * remote peer, the completed messages are released and the header is updated to
- * the next unsent message.
+ * the next unsent message. Returns the number of commands released.
  */
 static int remote_dep_nothread_send(parsec_execution_stream_t* es,
                                     dep_cmd_item_t **head_item)
 {
-    (void)es;
-    parsec_remote_deps_t *deps;
     dep_cmd_item_t *item = *head_item;
     parsec_list_item_t* ring = NULL;
     char packed_buffer[DEP_SHORT_BUFFER_SIZE];
@@ -1475,7 +1978,6 @@ static int remote_dep_nothread_send(parsec_execution_stream_t* es,
 
   pack_more:
     assert(peer == item->cmd.activate.peer);
-    deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
 
     parsec_list_item_singleton((parsec_list_item_t*)item);
     if( 0 == remote_dep_mpi_pack_dep(peer, item, packed_buffer,
@@ -1494,24 +1996,117 @@ static int remote_dep_nothread_send(parsec_execution_stream_t* es,
     *head_item = item;
     assert(NULL != ring);
 
-    /* dep index is meaningless in this context, set to -1 */
-    TAKE_TIME_WITH_INFO(es->es_profile, MPI_Activate_sk, 0, -1,
-                        es->virtual_process->parsec_context->my_rank, peer,
-                        deps->msg, position, PARSEC_DATATYPE_PACKED);
-    parsec_ce.send_am(&parsec_ce, PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG, peer, packed_buffer, position);
-    TAKE_TIME(es->es_profile, MPI_Activate_ek, 0);
-    DEBUG_MARK_CTL_MSG_ACTIVATE_SENT(peer, (void*)&deps->msg, &deps->msg);
+    return remote_dep_mpi_send_ring(es, peer, packed_buffer, position, ring);
+}
 
-    do {
-        item = (dep_cmd_item_t*)ring;
-        ring = parsec_list_item_ring_chop(ring);
-        deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
+/**
+ * Account for an activation message carrying nb_items activations, which
+ * waited latency seconds in total in a coalescing buffer.
+ */
+static void remote_dep_shard_count(remote_dep_shard_t* shard, int nb_items, double latency)
+{
+    shard->nb_messages++;
+    shard->nb_saved += nb_items - 1;
+    PARSEC_PAPI_SDE_COUNTER_ADD(PARSEC_PAPI_SDE_COMM_MESSAGES_SAVED, nb_items - 1);
+    if( latency > 0.0 ) {
+        shard->nb_delayed += nb_items;
+        shard->added_latency += latency;
+        PARSEC_PAPI_SDE_COUNTER_ADD(PARSEC_PAPI_SDE_COMM_AGGREGATION_LATENCY, (long long int)(1e6 * latency));
+    }
+}
 
-        free(item);  /* only large messages are left */
+/**
+ * Send the coalescing buffer toward a peer, and release the commands it holds.
+ */
+static void remote_dep_coalesce_flush(parsec_execution_stream_t* es,
+                                      remote_dep_shard_t* shard,
+                                      remote_dep_coalesce_t* co)
+{
+    int nb_items = co->nb_items, peer;
+    double latency = (double)nb_items * MPI_Wtime() - co->packed;
+
+    assert(NULL != co->ring);
+    peer = ((dep_cmd_item_t*)co->ring)->cmd.activate.peer;
+    parsec_list_nolock_remove(&shard->coalesce_pending, &co->super);
+    parsec_list_item_singleton(&co->super);
+    remote_dep_mpi_send_ring(es, peer, co->buffer, co->position, co->ring);
+    co->ring = NULL;
+    co->position = 0;
+    co->nb_items = 0;
+    co->packed = 0.0;
+    parsec_atomic_fetch_sub_int32(&shard->depth, nb_items);
+    remote_dep_shard_count(shard, nb_items, latency);
+}
 
-        remote_dep_complete_and_cleanup(&deps, 1);
-    } while( NULL != ring );
-    return 0;
+/**
+ * Send the coalescing buffers whose oldest activation waited at least
+ * comm_aggregate_delay, or all of them.
+ */
+static void remote_dep_coalesce_expire(parsec_execution_stream_t* es,
+                                       remote_dep_shard_t* shard,
+                                       int all)
+{
+    double deadline = MPI_Wtime() - 1e-6 * (double)parsec_param_aggregate_delay;
+    remote_dep_coalesce_t* co;
+
+    /* the buffers are in the order of their oldest activation */
+    while( NULL != (co = (remote_dep_coalesce_t*)PARSEC_LIST_ITERATOR_FIRST(&shard->coalesce_pending)) &&
+           (co != (remote_dep_coalesce_t*)PARSEC_LIST_ITERATOR_END(&shard->coalesce_pending)) ) {
+        if( !all && (co->first > deadline) ) break;
+        remote_dep_coalesce_flush(es, shard, co);
+    }
+}
+
+/**
+ * Same as remote_dep_nothread_send, but the activations stay in the
+ * coalescing buffer of the peer until the flush policy sends it, possibly
+ * with activations extracted later. The commands are released when the
+ * buffer is sent.
+ */
+static int remote_dep_coalesce_send(parsec_execution_stream_t* es,
+                                    remote_dep_shard_t* shard,
+                                    dep_cmd_item_t **head_item)
+{
+    dep_cmd_item_t *item = *head_item, *next;
+    parsec_list_item_t *pos;
+    int peer = item->cmd.activate.peer, nb_packed = 0;
+    remote_dep_coalesce_t* co = shard->coalesce[peer];
+    double now;
+
+    if( NULL == co ) {
+        co = (remote_dep_coalesce_t*)calloc(1, sizeof(remote_dep_coalesce_t));
+        PARSEC_OBJ_CONSTRUCT(&co->super, parsec_list_item_t);
+        shard->coalesce[peer] = co;
+    }
+    while( NULL != item ) {
+        assert(peer == item->cmd.activate.peer);
+        parsec_list_item_singleton((parsec_list_item_t*)item);
+        if( 0 != remote_dep_mpi_pack_dep(peer, item, co->buffer,
+                                         DEP_SHORT_BUFFER_SIZE, &co->position) ) {
+            /* no room left, send the buffer and pack the item in the next one */
+            remote_dep_coalesce_flush(es, shard, co);
+            continue;
+        }
+        now = MPI_Wtime();
+        pos = parsec_list_item_ring_chop(&item->pos_list);
+        if( NULL == co->ring ) {
+            co->ring = (parsec_list_item_t*)item;
+            co->first = now;
+            parsec_list_nolock_push_back(&shard->coalesce_pending, &co->super);
+        } else {
+            parsec_list_item_ring_push(co->ring, (parsec_list_item_t*)item);
+        }
+        co->nb_items++;
+        co->packed += now;
+        nb_packed++;
+        if( (co->position >= parsec_param_aggregate_bytes) ||
+            ((parsec_param_aggregate_msgs > 0) && (co->nb_items >= parsec_param_aggregate_msgs)) )
+            remote_dep_coalesce_flush(es, shard, co);
+        next = (NULL == pos) ? NULL : container_of(pos, dep_cmd_item_t, pos_list);
+        item = next;
+    }
+    *head_item = NULL;
+    return nb_packed;
 }
 
 /**
@@ -1563,6 +2158,7 @@ remote_dep_mpi_save_put_cb(parsec_comm_engine_t *ce,
     PARSEC_OBJ_CONSTRUCT(&item->super, parsec_list_item_t);
     item->action = DEP_GET_DATA;
     item->cmd.activate.peer = src;
+    item->cmd.activate.next_fragment = 0;
 
     task = &(item->cmd.activate.task);
     /* copy the static part of the message, the part after this contains the memory_handle
@@ -1600,6 +2196,87 @@ remote_dep_mpi_save_put_cb(parsec_comm_engine_t *ce,
     return 1;
 }
 
+#if !defined(PARSEC_PROF_DRY_DEP)
+/**
+ * Put the fragments of the output k requested by the item. If the local copy
+ * of the data is itself still landing, only the fragments already received are
+ * sent, and the item is deferred until more fragments land. The item also goes
+ * back in the put queue when the engine cannot accept more transfers. Returns 1
+ * once all the fragments have been posted, 0 if the item has been deferred.
+ */
+static int
+remote_dep_mpi_put_fragments(parsec_execution_stream_t* es,
+                             dep_cmd_item_t* item,
+                             parsec_remote_deps_t* deps,
+                             int k, void* dataptr, size_t size)
+{
+    remote_dep_wire_get_t* task = &(item->cmd.activate.task);
+    remote_dep_pipeline_t* pipeline = deps->output[k].pipeline;
+    size_t fragment_size = task->fragment_size, offset, len;
+    uint32_t f = item->cmd.activate.next_fragment, limit;
+    uint32_t nb_fragments = (uint32_t)((size + fragment_size - 1) / fragment_size);
+    remote_dep_datakey_t notify[2];
+    parsec_ce_mem_reg_handle_t source_memory_handle;
+    size_t source_memory_handle_size;
+
+    (void)es;
+    assert(0 != size);
+    /* The requester allocated its state for the same number of fragments */
+    assert(nb_fragments > 1);
+    /* Only the complete fragments within the landed prefix can be forwarded */
+    limit = nb_fragments;
+    if( NULL != pipeline )
+        limit = (uint32_t)(((size_t)pipeline->prefix * pipeline->fragment_size) / fragment_size);
+
+    notify[0] = task->remote_callback_data;
+    for( ; (f < limit) && parsec_ce.can_serve(&parsec_ce); f++ ) {
+        if( 0 == f ) {
+            /* each fragment is completed independently */
+            (void)parsec_atomic_fetch_add_int32(&deps->pending_ack, nb_fragments - 1);
+        }
+        offset = (size_t)f * fragment_size;
+        len = (size - offset) < fragment_size ? (size - offset) : fragment_size;
+        remote_dep_mpi_register_bytes((char*)dataptr + offset, len,
+                                      &source_memory_handle, &source_memory_handle_size);
+
+        remote_dep_cb_data_t *cb_data = (remote_dep_cb_data_t *) parsec_thread_mempool_allocate
+                                            (parsec_remote_dep_cb_data_mempool->thread_mempools);
+        cb_data->deps  = deps;
+        cb_data->k     = k;
+#if defined(PARSEC_PROF_TRACE)
+        uint64_t event_id = remote_dep_mpi_profiling_event_id();
+        cb_data->event_id = event_id;
+#endif /* PARSEC_PROF_TRACE */
+        TAKE_TIME_WITH_INFO(es->es_profile, MPI_Data_plds_sk, event_id, k,
+                            es->virtual_process->parsec_context->my_rank,
+                            item->cmd.activate.peer, deps->msg, (int)len, parsec_datatype_uint8_t);
+
+        /* the remote side identifies the fragment with the second word of the notification */
+        notify[1] = f;
+        parsec_ce.put(&parsec_ce, source_memory_handle, 0,
+                      item->cmd.activate.remote_memory_handle, offset,
+                      len, item->cmd.activate.peer,
+                      remote_dep_mpi_put_end_cb, cb_data,
+                      (parsec_ce_tag_t)task->callback_fn, notify, sizeof(notify));
+        parsec_comm_puts++;
+    }
+    item->cmd.activate.next_fragment = f;
+    if( f < limit ) {
+        /* the engine is saturated, try again once it progressed */
+        parsec_list_nolock_push_front(&dep_put_fifo, (parsec_list_item_t*)item);
+        return 0;
+    }
+    if( f < nb_fragments ) {
+        PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, "MPI:\tTO\t%d\tPut DEFER\tk=%d\twith deps %p after %u/%u fragments",
+                             item->cmd.activate.peer, k, deps, f, nb_fragments);
+        parsec_list_nolock_push_back(&pipeline->deferred, (parsec_list_item_t*)item);
+        return 0;
+    }
+    item->cmd.activate.next_fragment = 0;
+    return 1;
+}
+#endif  /* !defined(PARSEC_PROF_DRY_DEP) */
+
 static void
 remote_dep_mpi_put_start(parsec_execution_stream_t* es,
                          dep_cmd_item_t* item)
@@ -1678,6 +2355,14 @@ remote_dep_mpi_put_start(parsec_execution_stream_t* es,
         nbdtt   = deps->output[k].data.remote.src_count;
         (void) nbdtt;
 
+        if( 0 != task->fragment_size ) {
+            if( !remote_dep_mpi_put_fragments(es, item, deps, k, dataptr,
+                                              remote_dep_mpi_dense_size(dtt, nbdtt)) )
+                return;  /* the item waits for more fragments to land */
+            task->output_mask ^= (1U<<k);
+            continue;
+        }
+
         task->output_mask ^= (1U<<k);
 
         parsec_ce_mem_reg_handle_t source_memory_handle;
@@ -1810,6 +2495,24 @@ static void remote_dep_mpi_recv_activate(parsec_execution_stream_t* es,
     *position += (data_sizes[0] + 1) * (uint32_t)sizeof(uint32_t);
     ds_idx = 0;
 
+    /* Import the rank set of the outputs we must relay */
+    if( 0 != deps->msg.route_mask ) {
+        uint32_t a, bits, rank_words = (parsec_remote_dep_context.max_nodes_number + 31) / 32;
+        uint32_t *routes = (uint32_t*)(packed_buffer + *position);
+        for(k = 0; deps->msg.route_mask >> k; k++) {
+            if( !((1U<<k) & deps->msg.route_mask) ) continue;
+            deps->output[k].count_bits = 0;
+            for(a = 0; a < rank_words; a++) {
+                deps->output[k].rank_bits[a] = routes[a];
+                for(bits = routes[a]; 0 != bits; bits &= bits - 1)
+                    deps->output[k].count_bits++;
+            }
+            routes += rank_words;
+            *position += rank_words * (uint32_t)sizeof(uint32_t);
+        }
+        deps->route_mask = deps->msg.route_mask & deps->incoming_mask;
+    }
+
     for(k = 0; deps->incoming_mask>>k; k++) {
         if(!(deps->incoming_mask & (1U<<k))) continue;
 
@@ -2043,7 +2746,7 @@ static void remote_dep_mpi_get_start(parsec_execution_stream_t* es,
                                      parsec_remote_deps_t* deps)
 {
     remote_dep_wire_activate_t* task = &(deps->msg);
-    int from = deps->from, k, count, nbdtt;
+    int from = deps->from, k, count, nbdtt, nb_fragmented = 0;
     remote_dep_wire_get_t msg;
     MPI_Datatype dtt;
 #if defined(PARSEC_DEBUG_NOISIER)
@@ -2068,6 +2771,7 @@ static void remote_dep_mpi_get_start(parsec_execution_stream_t* es,
         if( !((1U<<k) & deps->incoming_mask) ) continue;
         msg.output_mask = 0;  /* Only get what I need */
         msg.output_mask |= (1U<<k);
+        msg.fragment_size = 0;
 
         /* We pack the callback data that should be passed to us when the other side
          * notifies us to invoke the callback_fn we have assigned above
@@ -2121,6 +2825,16 @@ static void remote_dep_mpi_get_start(parsec_execution_stream_t* es,
 
         callback_data->memory_handle = receiver_memory_handle;
 
+        /* Large dense data are requested in fragments, if the source can provide them */
+        if( task->fragment_mask & (1U<<k) ) {
+            size_t size = remote_dep_mpi_dense_size(dtt, nbdtt);
+            if( remote_dep_mpi_fragmented(size) ) {
+                deps->output[k].pipeline = remote_dep_mpi_pipeline_new(size, parsec_param_fragment_size);
+                msg.fragment_size = parsec_param_fragment_size;
+                nb_fragmented++;
+            }
+        }
+
         /* We need multiple information to be passed to the callback_fn we have assigned above.
          * We pack the pointer to this callback_data and pass to the other side so we can complete
          * cleanup and take necessary action when the data is available on our side */
@@ -2157,6 +2871,10 @@ static void remote_dep_mpi_get_start(parsec_execution_stream_t* es,
 
         parsec_comm_gets++;
     }
+#if defined(PARSEC_DIST_COLLECTIVES)
+    if( (count == nb_fragmented) && remote_dep_mpi_may_relay(deps) )
+        remote_dep_mpi_relay_early(es, deps);
+#endif  /* PARSEC_DIST_COLLECTIVES */
 }
 
 static void remote_dep_mpi_get_end(parsec_execution_stream_t* es,
@@ -2167,6 +2885,44 @@ static void remote_dep_mpi_get_end(parsec_execution_stream_t* es,
     remote_dep_release_incoming(es, deps, (1U<<idx));
 }
 
+/**
+ * A fragment of the output k landed. Resume the forwarding requests waiting
+ * for it, and returns 1 once all the fragments have landed.
+ */
+static int
+remote_dep_mpi_fragment_end(parsec_execution_stream_t* es,
+                            parsec_remote_deps_t* deps,
+                            int k, uint32_t fragment)
+{
+    remote_dep_pipeline_t* pipeline = deps->output[k].pipeline;
+    parsec_list_item_t *ring;
+    dep_cmd_item_t* item;
+    int done;
+
+    assert(fragment < pipeline->nb_fragments);
+    assert(0 == pipeline->landed[fragment]);
+    pipeline->landed[fragment] = 1;
+    pipeline->nb_landed++;
+    while( (pipeline->prefix < pipeline->nb_fragments) && pipeline->landed[pipeline->prefix] )
+        pipeline->prefix++;
+    done = (pipeline->nb_landed == pipeline->nb_fragments);
+
+    ring = parsec_list_nolock_unchain(&pipeline->deferred);
+    if( done ) {
+        deps->output[k].pipeline = NULL;
+        PARSEC_OBJ_DESTRUCT(&pipeline->deferred);
+        free(pipeline);
+    }
+    /* The resumed requests either complete, or go back in the deferred list */
+    while( NULL != ring ) {
+        item = (dep_cmd_item_t*)ring;
+        ring = parsec_list_item_ring_chop(ring);
+        PARSEC_LIST_ITEM_SINGLETON(item);
+        remote_dep_mpi_put_start(es, item);
+    }
+    return done;
+}
+
 static int
 remote_dep_mpi_get_end_cb(parsec_comm_engine_t *ce,
                           parsec_ce_tag_t tag,
@@ -2189,6 +2945,12 @@ remote_dep_mpi_get_end_cb(parsec_comm_engine_t *ce,
     char tmp[MAX_TASK_STRLEN];
 #endif
 
+    if( NULL != deps->output[callback_data->k].pipeline ) {
+        if( !remote_dep_mpi_fragment_end(es, deps, callback_data->k,
+                                         (uint32_t)((remote_dep_datakey_t*)msg)[1]) )
+            return 1;  /* more fragments to come */
+    }
+
     PARSEC_DEBUG_VERBOSE(6, parsec_debug_output, "MPI:\tFROM\t%d\tGet END  \t% -8s\tk=%d\twith datakey na\tparams %lx\t(tag=%d)",
             src, remote_dep_cmd_to_string(&deps->msg, tmp, MAX_TASK_STRLEN),
             callback_data->k, deps->incoming_mask, src);
@@ -2218,10 +2980,8 @@ remote_dep_mpi_get_end_cb(parsec_comm_engine_t *ce,
  */
 int remote_dep_ce_reconfigure(parsec_context_t* context)
 {
-    if( NULL != parsec_mpi_same_pos_items ) {
-        free(parsec_mpi_same_pos_items); parsec_mpi_same_pos_items = NULL;
-        parsec_mpi_same_pos_items_size = 0;
-    }
+    remote_dep_shard_t* shard;
+    int i;
     /**
      * Finalize the initialization of the upper level structures
      * Worst case: one of the DAGs is going to use up to
@@ -2229,10 +2989,22 @@ int remote_dep_ce_reconfigure(parsec_context_t* context)
      */
     remote_deps_allocation_init(context->nb_nodes, MAX_PARAM_COUNT);
 
-    parsec_mpi_same_pos_items_size = context->nb_nodes + (int)DEP_LAST;
-    assert( NULL == parsec_mpi_same_pos_items );
-    parsec_mpi_same_pos_items = (dep_cmd_item_t**)calloc(parsec_mpi_same_pos_items_size,
-                                                        sizeof(dep_cmd_item_t*));
+    /* The additional shards are idle while the engine is being reconfigured */
+    for(i = 0; i < remote_dep_nb_shards; i++) {
+        shard = &remote_dep_shards[i];
+        if( shard->same_pos_items_size != (context->nb_nodes + (int)DEP_LAST) ) {
+            free(shard->same_pos_items);
+            shard->same_pos_items_size = context->nb_nodes + (int)DEP_LAST;
+            shard->same_pos_items = (dep_cmd_item_t**)calloc(shard->same_pos_items_size,
+                                                             sizeof(dep_cmd_item_t*));
+        }
+        if( shard->coalesce_size != context->nb_nodes ) {
+            remote_dep_coalesce_release(shard);
+            shard->coalesce_size = context->nb_nodes;
+            shard->coalesce = (remote_dep_coalesce_t**)calloc(shard->coalesce_size,
+                                                              sizeof(remote_dep_coalesce_t*));
+        }
+    }
 
     if(1 < context->nb_nodes) {
         /* if nb_nodes==1, the parsec comm engine does not run with its own thread, so don't change the thread
@@ -2294,9 +3066,11 @@ int remote_dep_ce_fini(parsec_context_t* context)
         parsec_mempool_destruct(parsec_remote_dep_cb_data_mempool);
         free(parsec_remote_dep_cb_data_mempool); parsec_remote_dep_cb_data_mempool = NULL;
     }
-    if( NULL != parsec_mpi_same_pos_items ) {
-        free(parsec_mpi_same_pos_items); parsec_mpi_same_pos_items = NULL;
-        parsec_mpi_same_pos_items_size = 0;
+    for(int i = 0; (NULL != remote_dep_shards) && (i < remote_dep_nb_shards); i++) {
+        free(remote_dep_shards[i].same_pos_items);
+        remote_dep_shards[i].same_pos_items = NULL;
+        remote_dep_shards[i].same_pos_items_size = 0;
+        remote_dep_coalesce_release(&remote_dep_shards[i]);
     }
 
     PARSEC_OBJ_DESTRUCT(&dep_activates_fifo);
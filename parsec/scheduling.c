@@ -192,11 +192,16 @@ static inline int all_tasks_done(parsec_context_t* context)
 
 void parsec_taskpool_termination_detected(parsec_taskpool_t *tp)
 {
+    parsec_context_t *context = tp->context;
+
     if( NULL != tp->on_complete ) {
         (void)tp->on_complete( tp, tp->on_complete_data );
     }
-    (void)parsec_atomic_fetch_dec_int32( &(tp->context->active_taskpools) );
     PARSEC_PINS_TASKPOOL_FINI(tp);
+    if( 1 == parsec_atomic_fetch_dec_int32( &(context->active_taskpools) ) ) {
+        /* the parked execution streams must notice that all the work is done */
+        (void)parsec_eventcount_notify(&context->idle, -1);
+    }
 }
 
 parsec_sched_module_t *parsec_current_scheduler           = NULL;
@@ -255,7 +260,7 @@ __parsec_schedule(parsec_execution_stream_t* es,
                   parsec_task_t* tasks_ring,
                   int32_t distance)
 {
-    int ret;
+    int ret, nb_tasks = 0;
 #ifdef PARSEC_PROF_PINS
     parsec_execution_stream_t* local_es = parsec_my_execution_stream();
 #endif  /* PARSEC_PROF_PINS */
@@ -303,22 +308,199 @@ __parsec_schedule(parsec_execution_stream_t* es,
     }
 #endif  /* defined(PARSEC_PAPI_SDE) */
 
+    /* The ring belongs to the scheduler once delivered, count the tasks
+     * before to know how many parked execution streams can be put to work */
+    if( parsec_runtime_idle_spin >= 0 ) {
+        parsec_task_t *task = tasks_ring;
+        _LIST_ITEM_ITERATOR(task, &task->super, item, {nb_tasks++; });
+    }
+
     ret = parsec_current_scheduler->module.schedule(es, tasks_ring, distance);
 
+    if( nb_tasks > 0 ) {
+        (void)parsec_eventcount_notify(&es->virtual_process->parsec_context->idle, nb_tasks);
+    }
+
     PARSEC_PINS(local_es, SCHEDULE_END, tasks_ring);
 
     return ret;
 }
 
+parsec_task_t* parsec_ready_ring_sort(parsec_execution_stream_t* es,
+                                      parsec_task_t* ring,
+                                      size_t* nb_tasks)
+{
+    parsec_list_item_t *item;
+    parsec_task_t **tasks, **tmp, *task;
+    size_t nb = 1, i, j, count[4][256];
+    int sorted = 1, pass;
+
+    for( item = (parsec_list_item_t*)ring->super.list_next; item != &ring->super;
+         item = (parsec_list_item_t*)item->list_next, nb++ ) {
+        if( ((parsec_task_t*)item)->priority > ((parsec_task_t*)item->list_prev)->priority )
+            sorted = 0;
+    }
+    *nb_tasks = nb;
+    if( sorted ) return ring;
+
+    if( nb > es->ready_scratch_size ) {
+        size_t size = (0 == es->ready_scratch_size) ? 2 * PARSEC_READY_RING_INSERTION_SORT : es->ready_scratch_size;
+        while( size < nb ) size <<= 1;
+        tasks = (parsec_task_t**)realloc(es->ready_scratch, 2 * size * sizeof(parsec_task_t*));
+        if( NULL == tasks ) {
+            /* Fall back to sorting the ring in place, one insertion at a time */
+            parsec_list_item_t *prev, *sorted_ring = NULL;
+            item = (parsec_list_item_t*)ring->super.list_prev;
+            for( i = 0; i < nb; i++, item = prev ) {
+                prev = (parsec_list_item_t*)item->list_prev;
+                sorted_ring = parsec_list_item_ring_push_sorted(sorted_ring, item,
+                                                                parsec_execution_context_priority_comparator);
+            }
+            return (parsec_task_t*)sorted_ring;
+        }
+        es->ready_scratch = tasks;
+        es->ready_scratch_size = size;
+    }
+    tasks = es->ready_scratch;
+    tmp = es->ready_scratch + es->ready_scratch_size;
+
+    /* Push_sorted puts the newest of the tasks with the same priority first,
+     * and so does a stable sort of a ring built by pushing at the head. */
+    item = &ring->super;
+    for( i = 0; i < nb; i++, item = (parsec_list_item_t*)item->list_next )
+        tasks[i] = (parsec_task_t*)item;
+
+    if( nb <= PARSEC_READY_RING_INSERTION_SORT ) {
+        for( i = 1; i < nb; i++ ) {
+            task = tasks[i];
+            for( j = i; (j > 0) && (tasks[j-1]->priority < task->priority); j-- )
+                tasks[j] = tasks[j-1];
+            tasks[j] = task;
+        }
+    } else {
+        /* LSD radix sort on the bytes of the priority, mapped to an unsigned
+         * key that increases when the priority decreases. The passes on the
+         * bytes shared by all the tasks are skipped. */
+        memset(count, 0, sizeof(count));
+        for( i = 0; i < nb; i++ ) {
+            uint32_t key = ~((uint32_t)tasks[i]->priority ^ 0x80000000u);
+            for( pass = 0; pass < 4; pass++ )
+                count[pass][(key >> (8 * pass)) & 0xff]++;
+        }
+        for( pass = 0; pass < 4; pass++ ) {
+            size_t offset = 0, c;
+            uint32_t key = ~((uint32_t)tasks[0]->priority ^ 0x80000000u);
+            if( nb == count[pass][(key >> (8 * pass)) & 0xff] ) continue;
+            for( j = 0; j < 256; j++ ) {
+                c = count[pass][j];
+                count[pass][j] = offset;
+                offset += c;
+            }
+            for( i = 0; i < nb; i++ ) {
+                key = ~((uint32_t)tasks[i]->priority ^ 0x80000000u);
+                tmp[count[pass][(key >> (8 * pass)) & 0xff]++] = tasks[i];
+            }
+            parsec_task_t **swap = tasks; tasks = tmp; tmp = swap;
+        }
+    }
+
+    for( i = 0; i < nb; i++ ) {
+        tasks[i]->super.list_next = &tasks[(i + 1) % nb]->super;
+        tasks[i]->super.list_prev = &tasks[(i + nb - 1) % nb]->super;
+    }
+    return tasks[0];
+}
+
+/*
+ * Deliver a sorted ring of nb_tasks tasks made ready outside of the virtual
+ * process vp, by an execution stream of another virtual process or by a
+ * thread that is not a worker (e.g. the communication thread), to one or
+ * several execution streams of vp according to parsec_runtime_inject_policy.
+ */
+static int __parsec_inject(parsec_vp_t* vp,
+                           parsec_task_t* ring,
+                           size_t nb_tasks,
+                           int32_t distance)
+{
+    parsec_execution_stream_t* target_es = vp->execution_streams[0];
+    int ret, i, th;
+
+    switch( parsec_runtime_inject_policy ) {
+    case PARSEC_INJECT_ROUND_ROBIN:
+        th = (int)((uint32_t)parsec_atomic_fetch_inc_int32(&vp->inject_next) % (uint32_t)vp->nb_cores);
+        target_es = vp->execution_streams[th];
+        break;
+    case PARSEC_INJECT_LEAST_LOADED: {
+        /* Start from a different stream each time to spread the ties */
+        int32_t load, min_load = INT32_MAX;
+        th = (int)((uint32_t)parsec_atomic_fetch_inc_int32(&vp->inject_next) % (uint32_t)vp->nb_cores);
+        for( i = 0; i < vp->nb_cores; i++, th = (th + 1) % vp->nb_cores ) {
+            load = vp->execution_streams[th]->inject_pending;
+            if( load < min_load ) {
+                min_load = load;
+                target_es = vp->execution_streams[th];
+            }
+        }
+        (void)parsec_atomic_fetch_add_int32(&target_es->inject_pending, (int32_t)nb_tasks);
+        break;
+    }
+    case PARSEC_INJECT_AFFINITY: {
+        /* Split the ring by the stream the affinity data of each task
+         * hashes to, the sub-rings remain sorted. The tasks without
+         * affinity all go to the same stream, chosen round robin. */
+        parsec_task_t **rings = (parsec_task_t**)alloca(vp->nb_cores * sizeof(parsec_task_t*));
+        parsec_task_t *task;
+        parsec_data_ref_t ref;
+        int rr = -1;
+
+        if( 1 == vp->nb_cores ) break;
+        for( i = 0; i < vp->nb_cores; rings[i++] = NULL );
+        while( NULL != ring ) {
+            task = ring;
+            ring = (parsec_task_t*)parsec_list_item_ring_chop(&task->super);
+            parsec_list_item_singleton(&task->super);
+            if( (NULL != task->task_class->data_affinity) &&
+                task->task_class->data_affinity(task, &ref) ) {
+                th = (int)(((((uint64_t)ref.key ^ (uint64_t)(uintptr_t)ref.dc) * 0x9E3779B97F4A7C15ULL) >> 32) % (uint64_t)vp->nb_cores);
+            } else {
+                if( -1 == rr )
+                    rr = (int)((uint32_t)parsec_atomic_fetch_inc_int32(&vp->inject_next) % (uint32_t)vp->nb_cores);
+                th = rr;
+            }
+            rings[th] = (NULL == rings[th]) ? task :
+                (parsec_task_t*)parsec_list_item_ring_push(&rings[th]->super, &task->super);
+        }
+        for( i = 0; i < vp->nb_cores; i++ ) {
+            if( NULL == rings[i] ) continue;
+            target_es = vp->execution_streams[i];
+            PARSEC_PINS(target_es, INJECT_BEGIN, rings[i]);
+            ret = __parsec_schedule(target_es, rings[i], distance);
+            PARSEC_PINS(target_es, INJECT_END, rings[i]);
+            if( 0 != ret )
+                return ret;
+        }
+        return PARSEC_SUCCESS;
+    }
+    default:
+        break;
+    }
+    PARSEC_PINS(target_es, INJECT_BEGIN, ring);
+    ret = __parsec_schedule(target_es, ring, distance);
+    PARSEC_PINS(target_es, INJECT_END, ring);
+    return ret;
+}
+
 /*
  * Schedule an array of rings of tasks with one entry per virtual process.
- * If an execution stream is provided, this function will save the highest
- * priority task (assuming the ring is ordered or the first task in the ring
- * otherwise) on the current execution stream virtual process as the next
+ * The rings are first sorted by decreasing priority. If an execution stream
+ * is provided, this function will save the highest priority task
+ * on the current execution stream virtual process as the next
  * task to be executed on the provided execution stream. Everything else gets
  * pushed into the execution stream 0 of the corresponding virtual process.
  * If the provided execution stream is NULL, all tasks are delivered to their
- * respective vp.
+ * respective vp. The rings of the other vps (of all the vps when the
+ * provided stream is not a worker, e.g. the communication thread) are
+ * delivered according to the injection policy (see __parsec_inject).
  *
  * Beware, as the manipulation of next_task is not protected, an execution
  * stream should never be used concurrently in two call to this function (or
@@ -330,6 +512,7 @@ int __parsec_schedule_vp(parsec_execution_stream_t* submission_es,
 {
     parsec_execution_stream_t *target_es,
                               *es = (NULL == submission_es ? parsec_my_execution_stream() : submission_es);
+    size_t nb_tasks;
     int ret = 0;
 
     if( NULL == submission_es || !parsec_runtime_keep_highest_priority_task ||
@@ -339,9 +522,13 @@ int __parsec_schedule_vp(parsec_execution_stream_t* submission_es,
             parsec_task_t* ring = task_rings[vp];
             if( NULL == ring ) continue;
 
-            target_es = context->virtual_processes[vp]->execution_streams[0];
-
-            ret = __parsec_schedule(target_es, ring, distance);
+            ring = parsec_ready_ring_sort(es, ring, &nb_tasks);
+            if( (NULL == es->scheduler_object) || (vp != es->virtual_process->vp_id) ) {
+                ret = __parsec_inject(context->virtual_processes[vp], ring, nb_tasks, distance);
+            } else {
+                target_es = context->virtual_processes[vp]->execution_streams[0];
+                ret = __parsec_schedule(target_es, ring, distance);
+            }
             if( 0 != ret )
                 return ret;
 
@@ -360,8 +547,7 @@ int __parsec_schedule_vp(parsec_execution_stream_t* submission_es,
         parsec_task_t* ring = task_rings[vp];
         if( NULL == ring ) continue;
 
-        target_es = context->virtual_processes[vp]->execution_streams[0];
-
+        ring = parsec_ready_ring_sort(submission_es, ring, &nb_tasks);
         if( vp == submission_es->virtual_process->vp_id ) {
             if( NULL == submission_es->next_task ) {
                 submission_es->next_task = ring;
@@ -372,9 +558,10 @@ int __parsec_schedule_vp(parsec_execution_stream_t* submission_es,
                 }
             }
             /* Beware we are changing the submission execution stream for the local vp */
-            target_es = submission_es;
+            ret = __parsec_schedule(submission_es, ring, distance);
+        } else {
+            ret = __parsec_inject(context->virtual_processes[vp], ring, nb_tasks, distance);
         }
-        ret = __parsec_schedule(target_es, ring, distance);
         if( 0 != ret )
             return ret;
 
@@ -549,13 +736,58 @@ __parsec_get_next_task( parsec_execution_stream_t *es,
 
     if( NULL == (task = es->next_task) ) {
         task = parsec_current_scheduler->module.select(es, distance);
+        /* Most schedulers only try to lock their shared queues, a stream
+         * that looked for a task while we were holding them may have parked
+         * with tasks left behind: hand the wake up over to another stream.
+         * Nothing to hand over if no stream is parked. */
+        if( (NULL != task) && (parsec_runtime_idle_spin >= 0) &&
+            (0 < es->virtual_process->parsec_context->idle.nb_waiters) ) {
+            (void)parsec_eventcount_notify(&es->virtual_process->parsec_context->idle, 1);
+        }
+        /* Whatever queue it came from, a selected task compensates one of
+         * the tasks injected into this stream */
+        if( (NULL != task) && (es->inject_pending > 0) ) {
+            (void)parsec_atomic_fetch_dec_int32(&es->inject_pending);
+        }
     } else {
         es->next_task = NULL;
         *distance = 1;
     }
+#if defined(PARSEC_PROF_PINS)
+    if( NULL != task ) es->select_distance = *distance;
+#endif  /* defined(PARSEC_PROF_PINS) */
     return task;
 }
 
+/*
+ * Park the execution stream until some tasks are scheduled, or until all the
+ * taskpools of the context complete. The stream is registered as a waiter
+ * before looking for a task one last time, so a task scheduled concurrently
+ * is either found here or wakes the stream up. Returns that last task, if
+ * any.
+ */
+static parsec_task_t*
+__parsec_park( parsec_execution_stream_t *es,
+               int* distance )
+{
+    parsec_context_t* parsec_context = es->virtual_process->parsec_context;
+    parsec_task_t* task;
+    int32_t key;
+
+    key = parsec_eventcount_prepare_wait(&parsec_context->idle);
+    task = __parsec_get_next_task(es, distance);
+    if( (NULL != task) || all_tasks_done(parsec_context) ) {
+        parsec_eventcount_cancel_wait(&parsec_context->idle);
+        return task;
+    }
+    PARSEC_PINS(es, PARK_BEGIN, NULL);
+    (void)parsec_eventcount_wait(&parsec_context->idle, key,
+                                 parsec_runtime_idle_park_timeout < 0 ? -1 :
+                                 1000 * (int64_t)parsec_runtime_idle_park_timeout);
+    PARSEC_PINS(es, PARK_END, NULL);
+    return NULL;
+}
+
 static int __parsec_taskpool_test( parsec_taskpool_t* tp, parsec_execution_stream_t *es )
 {
     parsec_context_t* parsec_context = es->virtual_process->parsec_context;
@@ -697,7 +929,7 @@ int __parsec_context_wait( parsec_execution_stream_t* es )
     parsec_context_t* parsec_context = es->virtual_process->parsec_context;
     int32_t my_barrier_counter = parsec_context->__parsec_internal_finalization_counter;
     parsec_task_t* task;
-    int nbiterations = 0, distance, rc;
+    int nbiterations = 0, distance, rc, can_park;
     struct timespec rqtp;
 
     rqtp.tv_sec = 0;
@@ -753,6 +985,15 @@ int __parsec_context_wait( parsec_execution_stream_t* es )
         return -1;
     }
   skip_first_barrier:
+    /* A thread in charge of progressing the communications cannot sleep */
+    can_park = (parsec_runtime_idle_spin >= 0);
+#if defined(DISTRIBUTED)
+    if( (1 == parsec_communication_engine_up) &&
+        (es->virtual_process[0].parsec_context->nb_nodes == 1) &&
+        PARSEC_THREAD_IS_MASTER(es) ) {
+        can_park = 0;
+    }
+#endif /* defined(DISTRIBUTED) */
     while( !all_tasks_done(parsec_context) ) {
 #if defined(DISTRIBUTED)
         if( (1 == parsec_communication_engine_up) &&
@@ -765,13 +1006,17 @@ int __parsec_context_wait( parsec_execution_stream_t* es )
         }
 #endif /* defined(DISTRIBUTED) */
 
-        if( misses_in_a_row > 1 ) {
-            rqtp.tv_nsec = parsec_exponential_backoff(es, misses_in_a_row);
-            nanosleep(&rqtp, NULL);
+        if( can_park && (misses_in_a_row > (uint64_t)parsec_runtime_idle_spin) ) {
+            task = __parsec_park(es, &distance);
+        } else {
+            if( !can_park && (misses_in_a_row > 1) ) {
+                rqtp.tv_nsec = parsec_exponential_backoff(es, misses_in_a_row);
+                nanosleep(&rqtp, NULL);
+            }
+            task = __parsec_get_next_task(es, &distance);
         }
         misses_in_a_row++;  /* assume we fail to extract a task */
 
-        task = __parsec_get_next_task(es, &distance);
         if( NULL != task ) {
             misses_in_a_row = 0;  /* reset the misses counter */
 
@@ -836,6 +1081,7 @@ int parsec_context_add_taskpool( parsec_context_t* context, parsec_taskpool_t* t
     }
 
     tp->context = context;  /* save the context */
+    tp->enqueue_date = take_time();
 
     PARSEC_PINS_TASKPOOL_INIT(tp);  /* PINS taskpool initialization */
 
@@ -981,6 +1227,10 @@ int parsec_context_wait( parsec_context_t* context )
         (void)parsec_atomic_fetch_inc_int32( &context->active_taskpools );
         return PARSEC_ERR_NOT_SUPPORTED;
     }
+    if( 0 == active ) {
+        /* all the taskpools completed before the wait, release the parked streams */
+        (void)parsec_eventcount_notify(&context->idle, -1);
+    }
 
     ret = __parsec_context_wait( parsec_my_execution_stream() );
 
@@ -68,6 +68,32 @@ int __parsec_schedule_vp( parsec_execution_stream_t*,
                           parsec_task_t**,
                           int32_t distance);
 
+/**
+ * Rings of more than PARSEC_READY_RING_INSERTION_SORT tasks are radix sorted
+ * by parsec_ready_ring_sort, shorter ones are insertion sorted.
+ */
+#define PARSEC_READY_RING_INSERTION_SORT 32
+
+/**
+ * Sort a ring of ready tasks by decreasing priority, keeping the order of the
+ * tasks with the same priority. The successors of a task are pushed at the
+ * head of their ring as they become ready, and the ring is sorted here once,
+ * instead of keeping it sorted at each insertion (quadratic in the number of
+ * successors). The result is the ring parsec_list_item_ring_push_sorted would
+ * build from the tasks pushed from the tail to the head of the ring. Rings
+ * already in order are only scanned, short rings are insertion sorted, and
+ * longer ones radix sorted on the priority in the scratch space of es.
+ *
+ * @param[in] es The execution stream owning the scratch space.
+ * @param[in] ring The ring of tasks to sort.
+ * @param[out] nb_tasks The number of tasks in the ring.
+ *
+ * @return the first (highest priority) task of the sorted ring.
+ */
+parsec_task_t* parsec_ready_ring_sort(parsec_execution_stream_t* es,
+                                      parsec_task_t* ring,
+                                      size_t* nb_tasks);
+
 /**
  * Some runtime systems (e.g. MADNESS) that use PaRSEC as a task scheduler may detect
  * late that a task that already scheduled new work may block on the
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2024 The University of Tennessee and The University
+ * Copyright (c) 2012-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -24,7 +24,132 @@ static inline segment_t *SEGMENT_AT_TID(zone_malloc_t *gdata, int tid)
     return &gdata->segments[tid];
 }
 
+/* Index of the least (resp. most) significant bit set in a non-zero word */
+static inline int zone_ffs(uint32_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(word);
+#else
+    int bit = 0;
+    while( !(word & 1) ) { word >>= 1; bit++; }
+    return bit;
+#endif  /* defined(__GNUC__) */
+}
+
+static inline int zone_fls(uint32_t word)
+{
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(word);
+#else
+    int bit = 0;
+    while( word >>= 1 ) bit++;
+    return bit;
+#endif  /* defined(__GNUC__) */
+}
+
+/**
+ * Size class of a segment of nb_units units: segments smaller than
+ * ZONE_MALLOC_SL_COUNT units have an exact class in the first row, larger
+ * segments go in the row of their most significant bit, sub-divided
+ * linearly according to the next ZONE_MALLOC_SL_LOG2 bits.
+ */
+static inline void zone_mapping_insert(uint32_t nb_units, int *fl, int *sl)
+{
+    if( nb_units < ZONE_MALLOC_SL_COUNT ) {
+        *fl = 0;
+        *sl = (int)nb_units;
+    } else {
+        int f = zone_fls(nb_units);
+        *sl = (int)(nb_units >> (f - ZONE_MALLOC_SL_LOG2)) - ZONE_MALLOC_SL_COUNT;
+        *fl = f - ZONE_MALLOC_SL_LOG2 + 1;
+    }
+}
+
+/**
+ * Smallest class whose segments are all at least nb_units large.
+ */
+static inline void zone_mapping_search(uint32_t nb_units, int *fl, int *sl)
+{
+    if( nb_units >= ZONE_MALLOC_SL_COUNT ) {
+        nb_units += (1U << (zone_fls(nb_units) - ZONE_MALLOC_SL_LOG2)) - 1;
+    }
+    zone_mapping_insert(nb_units, fl, sl);
+}
+
+static void zone_free_list_insert(zone_malloc_t *gdata, int tid)
+{
+    segment_t *segment = SEGMENT_AT_TID(gdata, tid);
+    int fl, sl;
+
+    zone_mapping_insert(segment->nb_units, &fl, &sl);
+    segment->prev_free = -1;
+    segment->next_free = gdata->free_heads[fl][sl];
+    if( -1 != segment->next_free )
+        SEGMENT_AT_TID(gdata, segment->next_free)->prev_free = tid;
+    gdata->free_heads[fl][sl] = tid;
+    gdata->fl_bitmap     |= (1U << fl);
+    gdata->sl_bitmap[fl] |= (1U << sl);
+}
+
+static void zone_free_list_remove(zone_malloc_t *gdata, int tid)
+{
+    segment_t *segment = SEGMENT_AT_TID(gdata, tid);
+    int fl, sl;
+
+    zone_mapping_insert(segment->nb_units, &fl, &sl);
+    if( -1 != segment->next_free )
+        SEGMENT_AT_TID(gdata, segment->next_free)->prev_free = segment->prev_free;
+    if( -1 != segment->prev_free ) {
+        SEGMENT_AT_TID(gdata, segment->prev_free)->next_free = segment->next_free;
+    } else {
+        assert(gdata->free_heads[fl][sl] == tid);
+        gdata->free_heads[fl][sl] = segment->next_free;
+        if( -1 == segment->next_free ) {
+            gdata->sl_bitmap[fl] &= ~(1U << sl);
+            if( 0 == gdata->sl_bitmap[fl] )
+                gdata->fl_bitmap &= ~(1U << fl);
+        }
+    }
+}
+
+/**
+ * Return the tid of a free segment of at least nb_units units, or -1.
+ */
+static int zone_free_list_find(zone_malloc_t *gdata, int nb_units)
+{
+    uint32_t sl_map, fl_map;
+    int fl, sl, tid;
+
+    zone_mapping_search(nb_units, &fl, &sl);
+    if( fl < ZONE_MALLOC_FL_COUNT ) {
+        sl_map = gdata->sl_bitmap[fl] & (~0U << sl);
+        if( 0 == sl_map ) {
+            fl_map = (fl + 1 < ZONE_MALLOC_FL_COUNT) ? (gdata->fl_bitmap & (~0U << (fl + 1))) : 0;
+            if( 0 != fl_map ) {
+                fl = zone_ffs(fl_map);
+                sl_map = gdata->sl_bitmap[fl];
+            }
+        }
+        if( 0 != sl_map ) {
+            return gdata->free_heads[fl][zone_ffs(sl_map)];
+        }
+    }
+    /* No class is guaranteed to fit, but the class nb_units belongs to
+     * might still hold a large enough segment. */
+    zone_mapping_insert(nb_units, &fl, &sl);
+    for( tid = gdata->free_heads[fl][sl]; -1 != tid; tid = SEGMENT_AT_TID(gdata, tid)->next_free ) {
+        if( SEGMENT_AT_TID(gdata, tid)->nb_units >= nb_units )
+            return tid;
+    }
+    return -1;
+}
+
 zone_malloc_t* zone_malloc_init(void* base_ptr, int _max_segment, size_t _unit_size)
+{
+    return zone_malloc_init_policy(base_ptr, _max_segment, _unit_size, ZONE_MALLOC_FIRST_FIT);
+}
+
+zone_malloc_t* zone_malloc_init_policy(void* base_ptr, int _max_segment, size_t _unit_size, int policy)
 {
     zone_malloc_t *gdata;
     segment_t *head;
@@ -39,6 +164,14 @@ zone_malloc_t* zone_malloc_init(void* base_ptr, int _max_segment, size_t _unit_s
     gdata->unit_size    = _unit_size;
     gdata->max_segment  = _max_segment;
     gdata->next_tid     = 0;
+    gdata->policy       = policy;
+    gdata->units_in_use = 0;
+    gdata->fl_bitmap    = 0;
+    for(int fl = 0; fl < ZONE_MALLOC_FL_COUNT; fl++) {
+        gdata->sl_bitmap[fl] = 0;
+        for(int sl = 0; sl < ZONE_MALLOC_SL_COUNT; sl++)
+            gdata->free_heads[fl][sl] = -1;
+    }
     gdata->segments     = (segment_t *)malloc(sizeof(segment_t) * _max_segment);
     parsec_atomic_lock_init(&gdata->lock);
 #if defined(PARSEC_DEBUG)
@@ -50,6 +183,8 @@ zone_malloc_t* zone_malloc_init(void* base_ptr, int _max_segment, size_t _unit_s
     head->status = SEGMENT_EMPTY;
     head->nb_units = _max_segment;
     head->nb_prev  = 1; /**< This is to force SEGMENT_OF_TID( 0 - prev ) to return NULL */
+    if( ZONE_MALLOC_SEGREGATED == policy )
+        zone_free_list_insert(gdata, 0);
 
     return gdata;
 }
@@ -68,12 +203,51 @@ void* zone_malloc_fini(zone_malloc_t** gdata)
     return base_ptr;
 }
 
+static void *zone_malloc_segregated(zone_malloc_t *gdata, size_t size)
+{
+    segment_t *current_segment, *next_segment, *new_segment;
+    int current_tid, new_tid, nb_units;
+
+    nb_units = (size + gdata->unit_size - 1) / gdata->unit_size;
+    if( 0 == nb_units ) nb_units = 1;
+
+    parsec_atomic_lock(&gdata->lock);
+    current_tid = zone_free_list_find(gdata, nb_units);
+    if( -1 == current_tid ) {
+        parsec_atomic_unlock(&gdata->lock);
+        return NULL;
+    }
+    current_segment = SEGMENT_AT_TID(gdata, current_tid);
+    zone_free_list_remove(gdata, current_tid);
+    current_segment->status = SEGMENT_FULL;
+    if( current_segment->nb_units > nb_units ) {
+        next_segment = SEGMENT_AT_TID(gdata, current_tid + current_segment->nb_units);
+        if( NULL != next_segment )
+            next_segment->nb_prev -= nb_units;
+
+        new_tid = current_tid + nb_units;
+        new_segment = SEGMENT_AT_TID(gdata, new_tid);
+        new_segment->status = SEGMENT_EMPTY;
+        new_segment->nb_prev  = nb_units;
+        new_segment->nb_units = current_segment->nb_units - nb_units;
+        zone_free_list_insert(gdata, new_tid);
+
+        current_segment->nb_units = nb_units;
+    }
+    gdata->units_in_use += nb_units;
+    parsec_atomic_unlock(&gdata->lock);
+    return (void*)(gdata->base + (current_tid * gdata->unit_size));
+}
+
 void *zone_malloc(zone_malloc_t *gdata, size_t size)
 {
     segment_t *current_segment, *next_segment, *new_segment;
     int next_tid, current_tid, new_tid;
     int cycled_through = 0, nb_units;
 
+    if( ZONE_MALLOC_SEGREGATED == gdata->policy )
+        return zone_malloc_segregated(gdata, size);
+
     parsec_atomic_lock(&gdata->lock);
     /* Let's start with the last remembered free slot */
     current_tid = gdata->next_tid;
@@ -109,6 +283,7 @@ void *zone_malloc(zone_malloc_t *gdata, size_t size)
 
                 current_segment->nb_units = nb_units;
             }
+            gdata->units_in_use += current_segment->nb_units;
             parsec_atomic_unlock(&gdata->lock);
             return (void*)(gdata->base + (current_tid * gdata->unit_size));
         }
@@ -145,6 +320,7 @@ void zone_free(zone_malloc_t *gdata, void *add)
     }
 
     current_segment->status = SEGMENT_EMPTY;
+    gdata->units_in_use -= current_segment->nb_units;
 
     prev_tid = current_tid - current_segment->nb_prev;
     prev_segment = SEGMENT_AT_TID(gdata, prev_tid);
@@ -154,6 +330,8 @@ void zone_free(zone_malloc_t *gdata, void *add)
 
     if( NULL != prev_segment && prev_segment->status == SEGMENT_EMPTY ) {
         /* We can merge prev and current */
+        if( ZONE_MALLOC_SEGREGATED == gdata->policy )
+            zone_free_list_remove(gdata, prev_tid);
         if( NULL != next_segment ) {
             next_segment->nb_prev += prev_segment->nb_units;
         }
@@ -169,6 +347,8 @@ void zone_free(zone_malloc_t *gdata, void *add)
 
     if( NULL != next_segment && next_segment->status == SEGMENT_EMPTY ) {
         /* We can merge current and next */
+        if( ZONE_MALLOC_SEGREGATED == gdata->policy )
+            zone_free_list_remove(gdata, next_tid);
         next_tid += next_segment->nb_units;
         current_segment->nb_units += next_segment->nb_units;
         next_segment = SEGMENT_AT_TID(gdata, next_tid);
@@ -176,22 +356,16 @@ void zone_free(zone_malloc_t *gdata, void *add)
             next_segment->nb_prev = current_segment->nb_units;
         }
     }
+    if( ZONE_MALLOC_SEGREGATED == gdata->policy )
+        zone_free_list_insert(gdata, current_tid);
     parsec_atomic_unlock(&gdata->lock);
 }
 
 size_t zone_in_use(zone_malloc_t *gdata)
 {
-    size_t ret = 0;
-    segment_t *current_segment;
-    int current_tid;
+    size_t ret;
     parsec_atomic_lock(&gdata->lock);
-    for(current_tid = 0;
-        (current_segment = SEGMENT_AT_TID(gdata, current_tid)) != NULL;
-        current_tid += current_segment->nb_units) {
-        if( current_segment->status == SEGMENT_FULL ) {
-            ret += gdata->unit_size * current_segment->nb_units;
-        }
-    }
+    ret = gdata->units_in_use * gdata->unit_size;
     parsec_atomic_unlock(&gdata->lock);
     return ret;
 }
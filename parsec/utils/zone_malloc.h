@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2024 The University of Tennessee and The University
+ * Copyright (c) 2012-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -19,10 +19,29 @@ BEGIN_C_DECLS
 #define SEGMENT_FULL       2
 #define SEGMENT_UNDEFINED  3
 
+/**
+ * Allocation policies:
+ *  - FIRST_FIT walks the segments from the last freed / split position,
+ *    and is linear in the number of segments in the worst case.
+ *  - SEGREGATED keeps the free segments in lists of size classes (a
+ *    power of 2 range split in ZONE_MALLOC_SL_COUNT sub-classes), with
+ *    bitmaps of the non-empty classes, so that a large enough segment is
+ *    found in constant time; neighbor segments are coalesced in constant
+ *    time on free.
+ */
+#define ZONE_MALLOC_FIRST_FIT   0
+#define ZONE_MALLOC_SEGREGATED  1
+
+#define ZONE_MALLOC_SL_LOG2     4
+#define ZONE_MALLOC_SL_COUNT    (1 << ZONE_MALLOC_SL_LOG2)
+#define ZONE_MALLOC_FL_COUNT    32
+
 typedef struct segment {
     int status;     /* True if this segment is full, false if it is free */
     int32_t nb_units;   /* Number of units on this segment */
     int32_t nb_prev;    /* Number of units on the segment before */
+    int32_t next_free;  /* Next free segment of the same size class (SEGREGATED only) */
+    int32_t prev_free;  /* Previous free segment of the same size class (SEGREGATED only) */
 } segment_t;
 
 typedef struct zone_malloc_s {
@@ -30,7 +49,12 @@ typedef struct zone_malloc_s {
     segment_t *segments;             /* Array of available segments */
     size_t     unit_size;            /* Basic Unit                */
     int        max_segment;          /* Maximum number of segment */
-    int        next_tid;             /* Next TID to look at for a malloc */
+    int        next_tid;             /* Next TID to look at for a malloc (FIRST_FIT only) */
+    int        policy;               /* ZONE_MALLOC_FIRST_FIT or ZONE_MALLOC_SEGREGATED */
+    size_t     units_in_use;         /* Number of allocated units */
+    uint32_t   fl_bitmap;            /* Non-empty power of 2 classes (SEGREGATED only) */
+    uint32_t   sl_bitmap[ZONE_MALLOC_FL_COUNT]; /* Non-empty sub-classes (SEGREGATED only) */
+    int32_t    free_heads[ZONE_MALLOC_FL_COUNT][ZONE_MALLOC_SL_COUNT]; /* (SEGREGATED only) */
     parsec_atomic_lock_t lock;
 } zone_malloc_t;
 
@@ -39,9 +63,16 @@ typedef struct zone_malloc_s {
  * Define a memory allocator starting from base_ptr, with a length of
  * _max_segment * _unit_size bytes. The base_ptr can be any type of
  * memory, it is not directly used by the allocator.
+ * The allocator uses the ZONE_MALLOC_FIRST_FIT policy.
  */
 zone_malloc_t* zone_malloc_init(void* base_ptr, int _max_segment, size_t _unit_size);
 
+/**
+ * Same as zone_malloc_init, using the provided allocation policy
+ * (ZONE_MALLOC_FIRST_FIT or ZONE_MALLOC_SEGREGATED).
+ */
+zone_malloc_t* zone_malloc_init_policy(void* base_ptr, int _max_segment, size_t _unit_size, int policy);
+
 /**
  * Release all resources related to the memory zone, including the zone itself.
  */
@@ -49,7 +80,8 @@ void* zone_malloc_fini(zone_malloc_t** gdata);
 
 /**
  * Allocate a memory area of length size bytes. In worst case the search is linear
- * with the number of existing allocations.
+ * with the number of existing allocations for the FIRST_FIT policy, and constant
+ * for the SEGREGATED policy.
  */
 void *zone_malloc(zone_malloc_t *gdata, size_t size);
 
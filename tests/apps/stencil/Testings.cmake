@@ -1,7 +1,20 @@
 parsec_addtest_cmd(apps/stencil ${SHM_TEST_CMD_LIST} apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1)
+parsec_addtest_cmd(apps/stencil:slab ${SHM_TEST_CMD_LIST} apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1 -- --mca runtime_mempool_slab_size 65536)
 if( MPI_C_FOUND )
   parsec_addtest_cmd(apps/stencil:mp ${MPI_TEST_CMD_LIST} 8 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1)
   if(TEST apps/stencil:mp)
     set_tests_properties(apps/stencil:mp PROPERTIES DEPENDS launch:mp)
   endif()
+  parsec_addtest_cmd(apps/stencil:mp:aggregate ${MPI_TEST_CMD_LIST} 8 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1 -- --mca runtime_comm_aggregate_delay 100)
+  if(TEST apps/stencil:mp:aggregate)
+    set_tests_properties(apps/stencil:mp:aggregate PROPERTIES DEPENDS launch:mp)
+  endif()
+  parsec_addtest_cmd(apps/stencil:mp:threads ${MPI_TEST_CMD_LIST} 8 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1 -- --mca runtime_comm_threads 2)
+  if(TEST apps/stencil:mp:threads)
+    set_tests_properties(apps/stencil:mp:threads PROPERTIES DEPENDS launch:mp)
+  endif()
+  parsec_addtest_cmd(apps/stencil:mp:shm ${MPI_TEST_CMD_LIST} 8 apps/stencil/testing_stencil_1D -t 100 -T 100 -N 1000 -M 1000 -I 10 -R 2 -m 1 -- --mca runtime_comm_shm 1)
+  if(TEST apps/stencil:mp:shm)
+    set_tests_properties(apps/stencil:mp:shm PROPERTIES DEPENDS launch:mp)
+  endif()
 endif( MPI_C_FOUND )
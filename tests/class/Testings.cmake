@@ -5,8 +5,16 @@ add_test(class/rwlock ${SHM_TEST_CMD_LIST} class/rwlock -c 4)
 add_test(class/lifo ${SHM_TEST_CMD_LIST} class/lifo -c 4)
 add_test(class/list ${SHM_TEST_CMD_LIST} class/list -c 4)
 add_test(class/hash ${SHM_TEST_CMD_LIST} class/hash -\# 65536 -r 4 -n)
+add_test(class/hash:oa ${SHM_TEST_CMD_LIST} class/hash -\# 65536 -r 4 -n -O)
+add_test(class/hash:deps ${SHM_TEST_CMD_LIST} class/hash -\# 65536 -r 4 -u 4)
+add_test(class/hash:deps:oa ${SHM_TEST_CMD_LIST} class/hash -\# 65536 -r 4 -u 4 -O)
 add_test(class/future ${SHM_TEST_CMD_LIST} class/future -c 4)
 add_test(class/future_datacopy ${SHM_TEST_CMD_LIST} class/future_datacopy)
+add_test(class/zone_malloc ${SHM_TEST_CMD_LIST} class/zone_malloc -n 100000 -r 1)
+add_test(class/mempool ${SHM_TEST_CMD_LIST} class/mempool -c 4)
+add_test(class/ready_ring ${SHM_TEST_CMD_LIST} class/ready_ring)
+add_test(class/arena ${SHM_TEST_CMD_LIST} class/arena -n 20)
+add_test(class/arena:large ${SHM_TEST_CMD_LIST} class/arena -n 1000)
 
 if(TARGET atomics_inline)
   add_test(class/atomics:inline ${SHM_TEST_CMD_LIST} class/atomics_inline -c 4)
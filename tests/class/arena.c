@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+#undef NDEBUG
+#include <pthread.h>
+#include <stdarg.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif
+#include "parsec/parsec_internal.h"
+#include "parsec/arena.h"
+#include "parsec/data_internal.h"
+
+/*
+ * Check the movements of single elements between the magazine of the main
+ * execution stream and the depots of an arena, through the released counter
+ * of the arena (which accounts for the elements in the depots and in the
+ * shared lifo, but not for those in the magazines) and the used counter
+ * (which only grows when a new element is allocated).
+ */
+
+#define ELEM_SIZE 64
+
+static int NBELEMS = 20;
+
+static void fatal(const char *format, ...)
+{
+    va_list va;
+    va_start(va, format);
+    vprintf(format, va);
+    va_end(va);
+    raise(SIGABRT);
+}
+
+static parsec_data_copy_t *get_copy(parsec_arena_t *arena)
+{
+    parsec_data_copy_t *copy = parsec_arena_get_copy(arena, 1, 0, PARSEC_DATATYPE_NULL);
+    if( NULL == copy )
+        fatal(" ! Error: cannot get a copy from the arena\n");
+    return copy;
+}
+
+static void *foreign_thread(void *_arena)
+{
+    parsec_arena_t *arena = (parsec_arena_t*)_arena;
+    parsec_data_copy_t *copy;
+
+    /* Not an execution stream: no magazine, the chunk has no NUMA node and
+     * goes back to the shared lifo */
+    copy = get_copy(arena);
+    if( -1 != copy->arena_chunk->numa )
+        fatal(" ! Error: chunk allocated outside of any execution stream is on NUMA node %d\n",
+              copy->arena_chunk->numa);
+    PARSEC_OBJ_RELEASE(copy);
+    return NULL;
+}
+
+static void usage(const char *name, const char *msg)
+{
+    if( NULL != msg ) {
+        fprintf(stderr, "%s\n", msg);
+    }
+    fprintf(stderr,
+            "Usage: \n"
+            "   %s [-n nbelems|-h|-?]\n"
+            " where\n"
+            "   -n nbelems: nbelems (integer >0) defines the number of elements to allocate and release (default %d)\n",
+            name,
+            NBELEMS);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    parsec_context_t *parsec;
+    parsec_arena_t arena;
+    parsec_data_copy_t **copies;
+    parsec_arena_chunk_t **chunks;
+    pthread_t thread;
+    int32_t mag_size = 8, in_mag = 0, in_depot = 0, numa;
+    int i, ch, pargc = 0;
+    char **pargv = NULL, *m;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+#endif
+
+    while( (ch = getopt(argc, argv, "n:h?")) != -1 ) {
+        switch(ch) {
+        case 'n':
+            NBELEMS = strtol(optarg, &m, 0);
+            if( (NBELEMS <= 0) || (m[0] != '\0') ) {
+                usage(argv[0], "invalid -n value");
+            }
+            break;
+        case 'h':
+        case '?':
+        default:
+            usage(argv[0], NULL);
+            break;
+        }
+    }
+
+    parsec = parsec_init(2, &pargc, &pargv);
+    if( NULL == parsec )
+        fatal(" ! Error: cannot initialize PaRSEC\n");
+    if( NULL == parsec_my_execution_stream() )
+        fatal(" ! Error: the main thread is not an execution stream\n");
+    parsec_arena_magazine_size = mag_size;
+
+    /* Bounded, so that the arena keeps track of the used and released elements,
+     * but large enough to never free an element nor reduce the magazine size */
+    PARSEC_OBJ_CONSTRUCT(&arena, parsec_arena_t);
+    if( PARSEC_SUCCESS != parsec_arena_construct_ex(&arena, ELEM_SIZE, PARSEC_ARENA_ALIGNMENT_SSE,
+                                                    1024 * 1024, 1024 * 1024) )
+        fatal(" ! Error: cannot construct the arena\n");
+    copies = (parsec_data_copy_t**)calloc(NBELEMS, sizeof(parsec_data_copy_t*));
+    chunks = (parsec_arena_chunk_t**)calloc(NBELEMS, sizeof(parsec_arena_chunk_t*));
+
+    printf("Allocate %d elements from an empty arena\n", NBELEMS);
+    for(i = 0; i < NBELEMS; i++) {
+        copies[i] = get_copy(&arena);
+        chunks[i] = copies[i]->arena_chunk;
+        if( 0 > chunks[i]->numa )
+            fatal(" ! Error: element %d allocated by an execution stream has no NUMA node\n", i);
+        if( chunks[i]->numa != chunks[0]->numa )
+            fatal(" ! Error: element %d is on NUMA node %d instead of %d\n", i, chunks[i]->numa, chunks[0]->numa);
+    }
+    numa = chunks[0]->numa;
+    if( NBELEMS != arena.used || 0 != arena.released )
+        fatal(" ! Error: after %d allocations the arena has %d used and %d released elements\n",
+              NBELEMS, arena.used, arena.released);
+
+    printf("Release them: a full magazine spills its oldest half into the depot\n");
+    for(i = 0; i < NBELEMS; i++) {
+        PARSEC_OBJ_RELEASE(copies[i]);
+        if( in_mag == mag_size ) {
+            in_depot += (in_mag + 1) / 2;
+            in_mag -= (in_mag + 1) / 2;
+        }
+        in_mag++;
+        if( in_depot != arena.released )
+            fatal(" ! Error: after %d releases the depot holds %d elements instead of %d\n",
+                  i + 1, arena.released, in_depot);
+    }
+    if( NBELEMS != arena.used )
+        fatal(" ! Error: releasing elements changed the number of used elements to %d\n", arena.used);
+
+    printf("Allocate them again: the magazine goes first, then refills from the depot\n");
+    for(i = 0; i < NBELEMS; i++) {
+        copies[i] = get_copy(&arena);
+        if( 0 == in_mag ) {
+            in_mag = (in_depot < (mag_size + 1) / 2) ? in_depot : (mag_size + 1) / 2;
+            in_depot -= in_mag;
+        }
+        in_mag--;
+        if( in_depot != arena.released )
+            fatal(" ! Error: after %d allocations the depot holds %d elements instead of %d\n",
+                  i + 1, arena.released, in_depot);
+        if( i < mag_size && copies[i]->arena_chunk != chunks[NBELEMS - 1 - i] )
+            fatal(" ! Error: allocation %d did not reuse the last element released in the magazine\n", i);
+        if( numa != copies[i]->arena_chunk->numa )
+            fatal(" ! Error: recycled element %d moved from NUMA node %d to %d\n",
+                  i, numa, copies[i]->arena_chunk->numa);
+    }
+    if( NBELEMS != arena.used || 0 != arena.released )
+        fatal(" ! Error: the elements were not recycled (%d used, %d released)\n",
+              arena.used, arena.released);
+
+    printf("An element released outside of the execution streams refills an empty magazine\n");
+    pthread_create(&thread, NULL, foreign_thread, &arena);
+    pthread_join(thread, NULL);
+    if( (NBELEMS + 1) != arena.used || 1 != arena.released )
+        fatal(" ! Error: the foreign element is not in the shared lifo (%d used, %d released)\n",
+              arena.used, arena.released);
+    for(i = 0; i < in_mag; i++) {  /* empty the magazine */
+        parsec_data_copy_t *copy = get_copy(&arena);
+        copies = (parsec_data_copy_t**)realloc(copies, (NBELEMS + i + 1) * sizeof(parsec_data_copy_t*));
+        copies[NBELEMS + i] = copy;
+    }
+    {
+        parsec_data_copy_t *copy = get_copy(&arena);
+        if( -1 != copy->arena_chunk->numa || 0 != arena.released || (NBELEMS + 1) != arena.used )
+            fatal(" ! Error: the empty magazine did not refill from the shared lifo\n");
+        PARSEC_OBJ_RELEASE(copy);
+        if( 1 != arena.released )
+            fatal(" ! Error: the foreign element did not return to the shared lifo\n");
+    }
+
+    for(i = 0; i < NBELEMS + in_mag; i++)
+        PARSEC_OBJ_RELEASE(copies[i]);
+    free(copies);
+    free(chunks);
+    PARSEC_OBJ_DESTRUCT(&arena);
+    parsec_fini(&parsec);
+
+    printf("Test passed.\n");
+
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
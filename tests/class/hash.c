@@ -18,15 +18,21 @@
 #include "parsec/bindthread.h"
 #include "parsec/parsec_hwloc.h"
 #include "parsec/os-spec-timing.h"
+#include "parsec/mempool.h"
 #include "parsec/utils/mca_param.h"
 #include "parsec/utils/debug.h"
 
 #include "parsec/class/parsec_hash_table.h"
+#include "parsec/class/parsec_oa_hash_table.h"
 
 #define START_BASE 4
 #define START_MASK (0xFFFFFFFF >> (32-START_BASE))
 
 static parsec_hash_table_t hash_table;
+static parsec_oa_hash_table_t oa_hash_table;
+static parsec_oa_hash_table_t oa_churn_table;
+static parsec_mempool_t deps_mempool;
+static int32_t oa_nb_errors = 0;
 static parsec_barrier_t barrier1;
 static parsec_barrier_t barrier2;
 static int nbcores;
@@ -38,6 +44,13 @@ typedef struct {
     int               thread_key; /* which of the keys is that key */
 } empty_hash_item_t;
 
+/* Same layout as parsec_hashable_dependency_t */
+typedef struct {
+    parsec_hash_table_item_t ht_item;
+    parsec_thread_mempool_t *mempool_owner;
+    int32_t                  dependency;
+} deps_hash_item_t;
+
 static parsec_key_fn_t key_functions = {
     .key_equal = parsec_hash_table_generic_64bits_key_equal,
     .key_print = parsec_hash_table_generic_64bits_key_print,
@@ -51,6 +64,8 @@ typedef struct {
     int nb_loops;
     int nb_tests;
     bool use_handle;
+    int open_addressing;
+    int nb_updates;
     uint64_t *keys;
 } param_t;
 
@@ -297,6 +312,265 @@ static void *do_test(void *_param)
     return (void*)(uintptr_t)duration;
 }
 
+/*
+ * Same as do_perf_test, on the open addressing hash table: each thread
+ * inserts its keys, then removes them.
+ */
+static void *do_oa_perf_test(void *_param)
+{
+    param_t *param = (param_t*)_param;
+    int id = param->id;
+    int nbthreads = param->nbthreads;
+    int nbtests = param->nb_tests / nbthreads + (id < (param->nb_tests % nbthreads));
+    parsec_time_t t0, t1;
+    int l, t;
+    uint64_t duration, max_duration = 0;
+
+    parsec_bindthread(id%nbcores, 0);
+
+    for(l = 0; l < param->nb_loops; l++) {
+        if( id == 0 && (l == 0 || param->new_table_each_time)) {
+            PARSEC_OBJ_CONSTRUCT(&oa_hash_table, parsec_oa_hash_table_t);
+            parsec_oa_hash_table_init(&oa_hash_table, param->nb_tests);
+        }
+
+        parsec_barrier_wait(&barrier1);
+        t0 = take_time();
+        for(t = 0; t < nbtests; t++) {
+            *parsec_oa_hash_table_find_or_insert(&oa_hash_table, param->keys[nbthreads * t + id]) = nbthreads * t + id;
+        }
+        t1 = take_time();
+        duration = diff_time(t0, t1);
+        if(duration > max_duration)
+            max_duration = duration;
+        parsec_barrier_wait(&barrier1);
+        printf("Time to do %d insertions on thread %d: %"PRIu64" ns\n", nbtests, id, duration);
+        if(0 == id)
+            parsec_oa_hash_table_stat(&oa_hash_table);
+        parsec_barrier_wait(&barrier1);
+        t0 = take_time();
+        for(t = 0; t < nbtests; t++) {
+            int rc = parsec_oa_hash_table_remove(&oa_hash_table, param->keys[nbthreads * t + id]);
+            assert(1 == rc); (void)rc;
+        }
+        t1 = take_time();
+        duration = diff_time(t0, t1);
+        if(duration > max_duration)
+            max_duration = duration;
+        parsec_barrier_wait(&barrier1);
+        printf("Time to do %d removals on thread %d: %"PRIu64" ns\n", nbtests, id, duration);
+
+        if( id == 0 && (l == param->nb_loops-1 || param->new_table_each_time) ) {
+            PARSEC_OBJ_DESTRUCT(&oa_hash_table);
+        }
+    }
+    return (void*)(uintptr_t)max_duration;
+}
+
+/*
+ * Compare the two tables on the dependency tracking of the PTG tasks: the
+ * counter of each key is found or inserted, and updated, nb_updates times
+ * (once per predecessor of the task), then the key is removed (when the task
+ * is released). With parsec_hash_table, this is what parsec_hash_find_deps
+ * and the generated release_task do: the bucket is locked, and a missing
+ * key gets an item from a per thread mempool.
+ */
+static void *do_deps_perf_test(void *_param)
+{
+    param_t *param = (param_t*)_param;
+    int id = param->id;
+    int nbthreads = param->nbthreads;
+    int nbtests = param->nb_tests / nbthreads + (id < (param->nb_tests % nbthreads));
+    parsec_thread_mempool_t *mempool = &deps_mempool.thread_mempools[id];
+    parsec_time_t t0, t1;
+    parsec_key_handle_t kh;
+    deps_hash_item_t *item;
+    parsec_key_t key;
+    int l, t, u;
+    uint64_t duration, max_duration = 0;
+
+    parsec_bindthread(id%nbcores, 0);
+
+    for(l = 0; l < param->nb_loops; l++) {
+        if( id == 0 && (l == 0 || param->new_table_each_time)) {
+            if( param->open_addressing ) {
+                PARSEC_OBJ_CONSTRUCT(&oa_hash_table, parsec_oa_hash_table_t);
+                parsec_oa_hash_table_init(&oa_hash_table, param->nb_tests);
+            } else {
+                parsec_hash_table_init(&hash_table, offsetof(deps_hash_item_t, ht_item), 10, key_functions, NULL);
+            }
+        }
+
+        parsec_barrier_wait(&barrier1);
+        t0 = take_time();
+        for(u = 0; u < param->nb_updates; u++) {
+            for(t = 0; t < nbtests; t++) {
+                key = param->keys[nbthreads * t + id];
+                if( param->open_addressing ) {
+                    parsec_atomic_fetch_inc_int32(parsec_oa_hash_table_find_or_insert(&oa_hash_table, key));
+                    continue;
+                }
+                parsec_hash_table_lock_bucket_handle(&hash_table, key, &kh);
+                item = parsec_hash_table_nolock_find_handle(&hash_table, &kh);
+                if( NULL == item ) {
+                    item = (deps_hash_item_t*)parsec_thread_mempool_allocate(mempool);
+                    item->dependency = 0;
+                    item->ht_item.key = key;
+                    parsec_hash_table_nolock_insert_handle(&hash_table, &kh, &item->ht_item);
+                }
+                parsec_hash_table_unlock_bucket_handle(&hash_table, &kh);
+                parsec_atomic_fetch_inc_int32(&item->dependency);
+            }
+        }
+        for(t = 0; t < nbtests; t++) {
+            key = param->keys[nbthreads * t + id];
+            if( param->open_addressing ) {
+                int rc = parsec_oa_hash_table_remove(&oa_hash_table, key);
+                assert(1 == rc); (void)rc;
+            } else {
+                item = parsec_hash_table_remove(&hash_table, key);
+                assert(NULL != item && param->nb_updates == item->dependency);
+                parsec_mempool_free(&deps_mempool, item);
+            }
+        }
+        t1 = take_time();
+        duration = diff_time(t0, t1);
+        if(duration > max_duration)
+            max_duration = duration;
+        parsec_barrier_wait(&barrier1);
+
+        if( id == 0 && (l == param->nb_loops-1 || param->new_table_each_time) ) {
+            if( param->open_addressing ) {
+                PARSEC_OBJ_DESTRUCT(&oa_hash_table);
+            } else {
+                parsec_hash_table_fini(&hash_table);
+            }
+        }
+    }
+    return (void*)(uintptr_t)max_duration;
+}
+
+/* Keys kept by each thread while it inserts and removes keys, and number
+ * of generations the open addressing table may chain to hold them */
+#define OA_LIVE_KEYS       8
+#define OA_MAX_GENERATIONS 4
+
+/*
+ * Checks the open addressing hash table: all threads find or insert all the
+ * keys concurrently and increment the associated counters, like the
+ * predecessors of a task update its dependencies. Every key must then be
+ * found exactly once with a counter equal to the number of threads. The
+ * table starts small, so that it grows while the keys are inserted.
+ */
+static void *do_oa_test(void *_param)
+{
+    param_t *param = (param_t*)_param;
+    int id = param->id;
+    int nbthreads = param->nbthreads;
+    int nbtests = param->nb_tests / nbthreads + (id < (param->nb_tests % nbthreads));
+    parsec_time_t t0, t1;
+    int l, t, k, max_generations;
+    int32_t *value;
+
+    parsec_bindthread(id%nbcores, 0);
+
+    parsec_barrier_wait(&barrier1);
+
+    t0 = take_time();
+    for(l = 0; l < param->nb_loops; l++) {
+        if( l==0 || param->new_table_each_time ) {
+            if(0 == id) {
+                PARSEC_OBJ_CONSTRUCT(&oa_hash_table, parsec_oa_hash_table_t);
+                parsec_oa_hash_table_init(&oa_hash_table, 0);
+            }
+            parsec_barrier_wait(&barrier2);
+        }
+
+        /* each thread starts at a different key, to mix insertions and lookups */
+        for(t = 0; t < param->nb_tests; t++) {
+            k = (t + id * (param->nb_tests / nbthreads)) % param->nb_tests;
+            value = parsec_oa_hash_table_find_or_insert(&oa_hash_table, param->keys[k]);
+            parsec_atomic_fetch_inc_int32(value);
+        }
+        parsec_barrier_wait(&barrier1);
+        if(0 == id)
+            parsec_oa_hash_table_stat(&oa_hash_table);
+
+        for(t = 0; t < nbtests; t++) {
+            k = nbthreads * t + id;
+            value = parsec_oa_hash_table_find(&oa_hash_table, param->keys[k]);
+            if( NULL == value ) {
+                fprintf(stderr, "Error in implementation of the open addressing hash table: item with key %"PRIu64" is not to be found in the hash table, but it was not removed yet\n",
+                        param->keys[k]);
+                parsec_atomic_fetch_inc_int32(&oa_nb_errors);
+            } else if( *value != nbthreads ) {
+                fprintf(stderr, "Error in implementation of the open addressing hash table: item with key %"PRIu64" was updated %d times instead of %d\n",
+                        param->keys[k], *value, nbthreads);
+                parsec_atomic_fetch_inc_int32(&oa_nb_errors);
+            }
+            if( 1 != parsec_oa_hash_table_remove(&oa_hash_table, param->keys[k]) ||
+                NULL != parsec_oa_hash_table_find(&oa_hash_table, param->keys[k]) ) {
+                fprintf(stderr, "Error in implementation of the open addressing hash table: item with key %"PRIu64" was not removed\n",
+                        param->keys[k]);
+                parsec_atomic_fetch_inc_int32(&oa_nb_errors);
+            }
+        }
+
+        parsec_barrier_wait(&barrier1);
+        if( l==param->nb_loops-1 || param->new_table_each_time ) {
+            if(0 == id) {
+                PARSEC_OBJ_DESTRUCT(&oa_hash_table);
+            }
+        }
+
+        /* Interleave insertions and removals in a new table, like the tasks
+         * that complete while their successors are discovered: each thread
+         * keeps at most OA_LIVE_KEYS keys in the table, which must reclaim
+         * the removed slots and the drained generations instead of chaining
+         * new generations forever */
+        if(0 == id) {
+            PARSEC_OBJ_CONSTRUCT(&oa_churn_table, parsec_oa_hash_table_t);
+            parsec_oa_hash_table_init(&oa_churn_table, 0);
+        }
+        parsec_barrier_wait(&barrier1);
+        max_generations = 0;
+        for(t = 0; t < nbtests + OA_LIVE_KEYS; t++) {
+            if( t < nbtests ) {
+                k = nbthreads * t + id;
+                parsec_atomic_fetch_inc_int32(parsec_oa_hash_table_find_or_insert(&oa_churn_table, param->keys[k]));
+            }
+            if( t >= OA_LIVE_KEYS ) {
+                k = nbthreads * (t - OA_LIVE_KEYS) + id;
+                value = parsec_oa_hash_table_find(&oa_churn_table, param->keys[k]);
+                if( NULL == value || 1 != *value ||
+                    1 != parsec_oa_hash_table_remove(&oa_churn_table, param->keys[k]) ) {
+                    fprintf(stderr, "Error in implementation of the open addressing hash table: item with key %"PRIu64" was lost while other keys were inserted and removed\n",
+                            param->keys[k]);
+                    parsec_atomic_fetch_inc_int32(&oa_nb_errors);
+                }
+            }
+            if( oa_churn_table.nb_generations > max_generations )
+                max_generations = oa_churn_table.nb_generations;
+        }
+        if( max_generations > OA_MAX_GENERATIONS ) {
+            fprintf(stderr, "Error in implementation of the open addressing hash table: %d generations were chained to hold at most %d keys\n",
+                    max_generations, nbthreads * OA_LIVE_KEYS);
+            parsec_atomic_fetch_inc_int32(&oa_nb_errors);
+        }
+
+        parsec_barrier_wait(&barrier1);
+        if(0 == id) {
+            parsec_oa_hash_table_stat(&oa_churn_table);
+            PARSEC_OBJ_DESTRUCT(&oa_churn_table);
+        }
+    }
+    t1 = take_time();
+
+    parsec_barrier_wait(&barrier2);
+
+    return (void*)(uintptr_t)diff_time(t0, t1);
+}
+
 typedef struct node_s {
     uint64_t value;
     struct node_s *smaller;
@@ -407,6 +681,8 @@ int main(int argc, char *argv[])
     int md_tuning_inc = 1;
     int md_tuning;
     int simple_perf = 0;
+    int deps_perf = 0;
+    int open_addressing = 0;
     bool use_handle = 0;
     int nb_tests = 30000;
     int nb_loops = 300;
@@ -430,7 +706,7 @@ int main(int argc, char *argv[])
         fprintf(stderr, "Warning: unable to find the hash table hint, tuning behavior will be disabled\n");
     }
 
-    while( (ch = getopt(argc, argv, "c:m:M:t:T:i:d:D:I:#:s:r:3hnpH?")) != -1 ) {
+    while( (ch = getopt(argc, argv, "c:m:M:t:T:i:d:D:I:#:s:r:u:3hnpHO?")) != -1 ) {
         switch(ch) {
         case 'c':
             ch = strtol(optarg, &m, 0);
@@ -523,9 +799,19 @@ int main(int argc, char *argv[])
         case 'p':
             simple_perf = 1;
             break;
+        case 'u':
+            ch = strtol(optarg, &m, 0);
+            if( (ch <= 0) || (m[0] != '\0') ) {
+                fprintf(stderr, "%s: %s\n", argv[0], "invalid -u value");
+            }
+            deps_perf = ch;
+            break;
         case 'H':
             use_handle = true;
             break;
+        case 'O':
+            open_addressing = 1;
+            break;
         case '3':
             structured_keys = 1;
             break;
@@ -538,9 +824,11 @@ int main(int argc, char *argv[])
                     "          [-d max_table_depth_min -D max_table_depth_max -I max_table_depth_inc]\n"
                     "          [-# number of items to insert][-r number of loops of the test][-n use a new hash table for each test]\n"
                     "          [-p (run simple performance test)]\n"
+                    "          [-u nb_updates (run the dependency tracking performance test, updating each key nb_updates times)]\n"
                     "          [-s key generator seed (default: -1, random)]\n"
                     "          [-3 use structured 3D key space instead of random keys (false)]\n"
-                    "          [-H (use key handles for locking buckets)]\n", argv[0]);
+                    "          [-H (use key handles for locking buckets)]\n"
+                    "          [-O (test the open addressing hash table)]\n", argv[0]);
             exit(1);
             break;
         }
@@ -621,12 +909,27 @@ int main(int argc, char *argv[])
                     params[e].nb_loops = nb_loops;
                     params[e].new_table_each_time = new_table_each_time;
                     params[e].use_handle = use_handle;
+                    params[e].open_addressing = open_addressing;
+                    params[e].nb_updates = deps_perf;
                 }
 
                 parsec_barrier_init(&barrier1, NULL, nbthreads+1);
                 parsec_barrier_init(&barrier2, NULL, nbthreads+1);
 
-                if( simple_perf ) {
+                if( deps_perf ) {
+                    parsec_mempool_construct(&deps_mempool, NULL, sizeof(deps_hash_item_t),
+                                             offsetof(deps_hash_item_t, mempool_owner), nbthreads+1);
+                    for(e = 0; e < nbthreads; e++) {
+                        pthread_create(&threads[e], NULL, do_deps_perf_test, &params[e]);
+                    }
+                    maxtime = (uint64_t)do_deps_perf_test(&params[nbthreads]);
+                } else if( open_addressing ) {
+                    void *(*fct)(void*) = simple_perf ? do_oa_perf_test : do_oa_test;
+                    for(e = 0; e < nbthreads; e++) {
+                        pthread_create(&threads[e], NULL, fct, &params[e]);
+                    }
+                    maxtime = (uint64_t)fct(&params[nbthreads]);
+                } else if( simple_perf ) {
                     for(e = 0; e < nbthreads; e++) {
                         pthread_create(&threads[e], NULL, do_perf_test, &params[e]);
                     }
@@ -642,6 +945,9 @@ int main(int argc, char *argv[])
                     if( (uint64_t)retval > maxtime )
                         maxtime = (uint64_t)retval;
                 }
+                if( deps_perf ) {
+                    parsec_mempool_destruct(&deps_mempool);
+                }
                 parsec_barrier_destroy(&barrier1);
                 parsec_barrier_destroy(&barrier2);
                 printf("%lu threads %"PRIu64" "TIMER_UNIT" max_coll %d max_table_depth %d\n",
@@ -653,4 +959,5 @@ int main(int argc, char *argv[])
     free(threads);
     free(keys);
     free(params);
+    return (0 == oa_nb_errors) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/runtime.h"
+#undef NDEBUG
+#include <pthread.h>
+#include <stdarg.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif
+
+#include "parsec/mempool.h"
+
+static unsigned int NBELT = 4096;
+static unsigned int NBROUNDS = 16;
+
+static void fatal(const char *format, ...)
+{
+    va_list va;
+    va_start(va, format);
+    vprintf(format, va);
+    va_end(va);
+    raise(SIGABRT);
+}
+
+typedef struct {
+    parsec_list_item_t       super;
+    parsec_thread_mempool_t *mempool_owner;
+    unsigned int             round;
+    unsigned int             thread;
+    unsigned int             index;
+} elt_t;
+
+static parsec_mempool_t mempool;
+static unsigned int nbthreads = 1;
+/* Elements allocated by thread t during a round are released by thread t+1 */
+static elt_t ***handoff;
+static uint64_t nb_elt_after_first_round;
+
+static pthread_mutex_t barrier_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  barrier_cond = PTHREAD_COND_INITIALIZER;
+static unsigned int    barrier_count = 0;
+static unsigned int    barrier_generation = 0;
+
+static void barrier(void)
+{
+    unsigned int generation;
+    pthread_mutex_lock(&barrier_lock);
+    generation = barrier_generation;
+    if( ++barrier_count == nbthreads ) {
+        barrier_count = 0;
+        barrier_generation++;
+        pthread_cond_broadcast(&barrier_cond);
+    } else {
+        while( generation == barrier_generation )
+            pthread_cond_wait(&barrier_cond, &barrier_lock);
+    }
+    pthread_mutex_unlock(&barrier_lock);
+}
+
+static void *alloc_and_release(void *params)
+{
+    unsigned int t = (unsigned int)(uintptr_t)params, from, r, e;
+    parsec_thread_mempool_t *thread_mempool = &mempool.thread_mempools[t];
+    parsec_mempool_usage_t usage;
+    elt_t *elt;
+
+    for(r = 0; r < NBROUNDS; r++) {
+        for(e = 0; e < NBELT; e++) {
+            elt = (elt_t*)parsec_thread_mempool_allocate(thread_mempool);
+            if( elt->mempool_owner != thread_mempool )
+                fatal(" ! Error: element %u of round %u of thread %u does not belong to the thread mempool\n", e, r, t);
+            elt->round = r;
+            elt->thread = t;
+            elt->index = e;
+            handoff[t][e] = elt;
+        }
+        barrier();
+        from = (t + 1) % nbthreads;
+        for(e = 0; e < NBELT; e++) {
+            elt = handoff[from][e];
+            if( elt->round != r || elt->thread != from || elt->index != e )
+                fatal(" ! Error: element %u of round %u of thread %u is corrupt (%u, %u, %u)\n",
+                      e, r, from, elt->round, elt->thread, elt->index);
+            parsec_mempool_free(&mempool, elt);
+        }
+        barrier();
+        if( 0 == t ) {
+            parsec_mempool_usage(&mempool, &usage);
+            if( 0 == r ) {
+                nb_elt_after_first_round = usage.nb_elt;
+            } else if( usage.nb_elt != nb_elt_after_first_round ) {
+                fatal(" ! Error: the mempool grew from %"PRIu64" to %"PRIu64" elements at round %u\n",
+                      nb_elt_after_first_round, usage.nb_elt, r);
+            }
+        }
+        barrier();
+    }
+    return NULL;
+}
+
+static void run_test(size_t slab_size)
+{
+    parsec_mempool_usage_t usage;
+    pthread_t *threads;
+    unsigned int t;
+    uint64_t nb_elt;
+
+    printf("Test with %s (slab size %zu), %u threads, %u elements per thread, %u rounds\n",
+           0 == slab_size ? "per-element allocations" : "slabs", slab_size, nbthreads, NBELT, NBROUNDS);
+
+    parsec_mempool_slab_size = slab_size;
+    parsec_mempool_construct(&mempool, NULL, sizeof(elt_t), offsetof(elt_t, mempool_owner), nbthreads);
+    if( 0 != slab_size )
+        parsec_mempool_reserve(&mempool, nbthreads * NBELT / 2);
+
+    threads = (pthread_t*)calloc(nbthreads, sizeof(pthread_t));
+    for(t = 0; t < nbthreads; t++)
+        pthread_create(&threads[t], NULL, alloc_and_release, (void*)(uintptr_t)t);
+    for(t = 0; t < nbthreads; t++)
+        pthread_join(threads[t], NULL);
+    free(threads);
+
+    parsec_mempool_usage(&mempool, &usage);
+    printf(" - %"PRIu64" elements, high water %"PRIu64", %"PRIu64" local and %"PRIu64" cross-thread frees\n",
+           usage.nb_elt, usage.high_water, usage.nb_local_free, usage.nb_remote_free);
+    if( usage.nb_elt < (uint64_t)nbthreads * NBELT )
+        fatal(" ! Error: only %"PRIu64" elements for %u elements in use\n", usage.nb_elt, nbthreads * NBELT);
+    if( 0 != slab_size ) {
+        if( 0 == usage.high_water || usage.high_water > usage.nb_elt )
+            fatal(" ! Error: high water %"PRIu64" is not in (0, %"PRIu64"]\n", usage.high_water, usage.nb_elt);
+        if( nbthreads > 1 && usage.nb_local_free != 0 )
+            fatal(" ! Error: %"PRIu64" elements were released by their owner\n", usage.nb_local_free);
+        if( nbthreads == 1 && usage.nb_remote_free != 0 )
+            fatal(" ! Error: %"PRIu64" elements were released by another thread\n", usage.nb_remote_free);
+    }
+
+    nb_elt = parsec_mempool_destruct(&mempool);
+    if( nb_elt != usage.nb_elt )
+        fatal(" ! Error: destruct reports %"PRIu64" elements instead of %"PRIu64"\n", nb_elt, usage.nb_elt);
+}
+
+static void usage(const char *name, const char *msg)
+{
+    if( NULL != msg ) {
+        fprintf(stderr, "%s\n", msg);
+    }
+    fprintf(stderr,
+            "Usage: \n"
+            "   %s [-c cores|-n nbelt|-r rounds|-h|-?]\n"
+            " where\n"
+            "   -c cores:   cores (integer >0) defines the number of cores to test\n"
+            "   -n nbelt:   nbelt (integer >0) defines the number of elements each thread allocates per round (default %u)\n"
+            "   -r rounds:  rounds (integer >0) defines the number of rounds (default %u)\n",
+            name,
+            NBELT,
+            NBROUNDS);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int t;
+    int ch;
+    char *m;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+#endif
+    while( (ch = getopt(argc, argv, "c:n:r:h?")) != -1 ) {
+        switch(ch) {
+        case 'c': {
+            long nth = strtol(optarg, &m, 0);
+            if( (nth <= 0) || (m[0] != '\0') ) {
+                usage(argv[0], "invalid -c value");
+            }
+            nbthreads = nth;
+            break;
+        }
+        case 'n':
+            NBELT = strtol(optarg, &m, 0);
+            if( (NBELT <= 0) || (m[0] != '\0') ) {
+                usage(argv[0], "invalid -n value");
+            }
+            break;
+        case 'r':
+            NBROUNDS = strtol(optarg, &m, 0);
+            if( (NBROUNDS <= 0) || (m[0] != '\0') ) {
+                usage(argv[0], "invalid -r value");
+            }
+            break;
+        case 'h':
+        case '?':
+        default:
+            usage(argv[0], NULL);
+            break;
+        }
+    }
+
+    handoff = (elt_t***)calloc(nbthreads, sizeof(elt_t**));
+    for(t = 0; t < nbthreads; t++)
+        handoff[t] = (elt_t**)calloc(NBELT, sizeof(elt_t*));
+
+    run_test(0);
+    run_test(64 * 1024);
+    run_test(1);  /* a single element per slab */
+
+    for(t = 0; t < nbthreads; t++)
+        free(handoff[t]);
+    free(handoff);
+
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Finalize();
+#endif
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+#undef NDEBUG
+#include <stdarg.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif
+#include "parsec/parsec_internal.h"
+#include "parsec/execution_stream.h"
+#include "parsec/scheduling.h"
+#include "parsec/class/list_item.h"
+
+static unsigned int NBTIMES = 16;
+
+static void fatal(const char *format, ...)
+{
+    va_list va;
+    va_start(va, format);
+    vprintf(format, va);
+    va_end(va);
+    raise(SIGABRT);
+}
+
+typedef enum {
+    PRIORITY_RANDOM,
+    PRIORITY_TIED,
+    PRIORITY_NEGATIVE,
+    PRIORITY_INCREASING,
+    PRIORITY_DECREASING,
+    PRIORITY_NB_KINDS
+} priority_kind_t;
+
+static const char *priority_kind_name[PRIORITY_NB_KINDS] = {
+    "random", "tied", "negative", "increasing", "decreasing"
+};
+
+static int32_t make_priority(priority_kind_t kind, size_t i)
+{
+    switch(kind) {
+    case PRIORITY_RANDOM:
+        return (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+    case PRIORITY_TIED:
+        return (rand() % 5) - 2;
+    case PRIORITY_NEGATIVE:
+        return -1 - (rand() % 1000);
+    case PRIORITY_INCREASING:
+        return (int32_t)i - 100;
+    case PRIORITY_DECREASING:
+    default:
+        return 100 - (int32_t)i;
+    }
+}
+
+/*
+ * Build the same ring twice: once as the runtime does, pushing each task at
+ * the head of the ring and sorting it with parsec_ready_ring_sort, and once
+ * with successive calls to parsec_list_item_ring_push_sorted. Both rings must
+ * hold the tasks in the same order.
+ */
+static void check_ready_ring_sort(parsec_execution_stream_t *es,
+                                  priority_kind_t kind, size_t nb)
+{
+    parsec_task_t *sorted_tasks, *ref_tasks, *task;
+    parsec_list_item_t *ring = NULL, *ref = NULL, *item, *ref_item;
+    size_t i, nb_tasks = 0;
+
+    sorted_tasks = (parsec_task_t*)calloc(nb, sizeof(parsec_task_t));
+    ref_tasks = (parsec_task_t*)calloc(nb, sizeof(parsec_task_t));
+    for(i = 0; i < nb; i++) {
+        PARSEC_OBJ_CONSTRUCT(&sorted_tasks[i].super, parsec_list_item_t);
+        PARSEC_OBJ_CONSTRUCT(&ref_tasks[i].super, parsec_list_item_t);
+        sorted_tasks[i].priority = ref_tasks[i].priority = make_priority(kind, i);
+        ring = parsec_list_item_ring_push_head(ring, &sorted_tasks[i].super);
+        ref = parsec_list_item_ring_push_sorted(ref, &ref_tasks[i].super,
+                                                parsec_execution_context_priority_comparator);
+    }
+
+    task = parsec_ready_ring_sort(es, (parsec_task_t*)ring, &nb_tasks);
+    if( nb_tasks != nb )
+        fatal(" ! Error: %s ring of %zu tasks sorted as a ring of %zu tasks\n",
+              priority_kind_name[kind], nb, nb_tasks);
+
+    item = &task->super;
+    ref_item = ref;
+    for(i = 0; i < nb; i++) {
+        size_t idx = (parsec_task_t*)item - sorted_tasks;
+        size_t ref_idx = (parsec_task_t*)ref_item - ref_tasks;
+        if( idx != ref_idx )
+            fatal(" ! Error: %s ring of %zu tasks: position %zu holds task %zu (priority %d) instead of task %zu (priority %d)\n",
+                  priority_kind_name[kind], nb, i,
+                  idx, sorted_tasks[idx].priority, ref_idx, ref_tasks[ref_idx].priority);
+        if( item->list_next->list_prev != item )
+            fatal(" ! Error: %s ring of %zu tasks: position %zu is not linked back\n",
+                  priority_kind_name[kind], nb, i);
+        item = (parsec_list_item_t*)item->list_next;
+        ref_item = (parsec_list_item_t*)ref_item->list_next;
+    }
+    if( item != &task->super )
+        fatal(" ! Error: %s ring of %zu tasks is not closed after %zu tasks\n",
+              priority_kind_name[kind], nb, nb);
+
+    for(i = 0; i < nb; i++) {
+        PARSEC_OBJ_DESTRUCT(&sorted_tasks[i].super);
+        PARSEC_OBJ_DESTRUCT(&ref_tasks[i].super);
+    }
+    free(sorted_tasks);
+    free(ref_tasks);
+}
+
+static void usage(const char *name, const char *msg)
+{
+    if( NULL != msg ) {
+        fprintf(stderr, "%s\n", msg);
+    }
+    fprintf(stderr,
+            "Usage: \n"
+            "   %s [-N nbtimes|-h|-?]\n"
+            " where\n"
+            "   -N nbtimes: nbtimes (integer >0) defines the number of rings of each kind and size to sort (default %u)\n",
+            name,
+            NBTIMES);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    /* On both sides of PARSEC_READY_RING_INSERTION_SORT, and long enough
+     * to grow the scratch space of the execution stream a few times. */
+    size_t sizes[] = { 1, 2, 3,
+                       PARSEC_READY_RING_INSERTION_SORT - 1,
+                       PARSEC_READY_RING_INSERTION_SORT,
+                       PARSEC_READY_RING_INSERTION_SORT + 1,
+                       2 * PARSEC_READY_RING_INSERTION_SORT + 1,
+                       1000, 4099 };
+    parsec_execution_stream_t es;
+    unsigned int t, s, k;
+    int ch;
+    char *m;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+#endif
+
+    while( (ch = getopt(argc, argv, "N:h?")) != -1 ) {
+        switch(ch) {
+        case 'N':
+            NBTIMES = strtol(optarg, &m, 0);
+            if( (NBTIMES <= 0) || (m[0] != '\0') ) {
+                usage(argv[0], "invalid -N value");
+            }
+            break;
+        case 'h':
+        case '?':
+        default:
+            usage(argv[0], NULL);
+            break;
+        }
+    }
+
+    memset(&es, 0, sizeof(es));
+    srand(1);
+
+    printf("Sort rings of ready tasks and compare with parsec_list_item_ring_push_sorted.\n");
+    for(k = 0; k < PRIORITY_NB_KINDS; k++) {
+        printf(" - %s priorities\n", priority_kind_name[k]);
+        for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            for(t = 0; t < NBTIMES; t++) {
+                check_ready_ring_sort(&es, (priority_kind_t)k, sizes[s]);
+            }
+        }
+    }
+    free(es.ready_scratch);
+
+    printf("Test passed.\n");
+
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
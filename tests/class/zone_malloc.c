@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/runtime.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "parsec/utils/zone_malloc.h"
+#include "parsec/os-spec-timing.h"
+
+/*
+ * Replays the same random trace of allocations and deallocations on a zone
+ * managed with each of the allocation policies. The trace mixes many small
+ * and a few large requests, and keeps a bounded set of live allocations
+ * released in random order, which fragments the zone like the GPU data
+ * copies do. The first replay of each policy checks that allocations never
+ * overlap and that the zone is empty at the end, the following ones are
+ * timed.
+ */
+
+#define UNIT_SIZE 64
+
+typedef struct {
+    int    is_alloc;
+    int    slot;
+    size_t size;
+} trace_op_t;
+
+static trace_op_t *build_trace(int nb_ops, int nb_slots, int max_units, unsigned int seed)
+{
+    trace_op_t *trace = (trace_op_t*)malloc(nb_ops * sizeof(trace_op_t));
+    char *live = (char*)calloc(nb_slots, 1);
+    int nb_live = 0, i, s;
+
+    for(i = 0; i < nb_ops; i++) {
+        s = rand_r(&seed) % nb_slots;
+        trace[i].slot = s;
+        if( live[s] ) {
+            trace[i].is_alloc = 0;
+            trace[i].size = 0;
+            live[s] = 0;
+            nb_live--;
+        } else {
+            trace[i].is_alloc = 1;
+            if( 0 == (rand_r(&seed) % 16) )
+                trace[i].size = (size_t)(1 + rand_r(&seed) % max_units) * UNIT_SIZE;
+            else
+                trace[i].size = 1 + rand_r(&seed) % (8 * UNIT_SIZE);
+            live[s] = 1;
+            nb_live++;
+        }
+    }
+    free(live);
+    return trace;
+}
+
+static int replay(zone_malloc_t *zone, const trace_op_t *trace, int nb_ops, int nb_slots,
+                  int *owners, int *nb_failed)
+{
+    void **ptrs = (void**)calloc(nb_slots, sizeof(void*));
+    size_t *sizes = (size_t*)calloc(nb_slots, sizeof(size_t));
+    int i, s, rc = 0;
+    size_t u, first, nb_units;
+
+    *nb_failed = 0;
+    for(i = 0; i < nb_ops; i++) {
+        s = trace[i].slot;
+        if( trace[i].is_alloc ) {
+            ptrs[s] = zone_malloc(zone, trace[i].size);
+            sizes[s] = trace[i].size;
+            if( NULL == ptrs[s] ) {
+                (*nb_failed)++;
+                continue;
+            }
+            if( NULL != owners ) {
+                first = ((char*)ptrs[s] - (char*)zone->base) / UNIT_SIZE;
+                nb_units = (trace[i].size + UNIT_SIZE - 1) / UNIT_SIZE;
+                for(u = first; u < first + nb_units; u++) {
+                    if( 0 != owners[u] ) {
+                        fprintf(stderr, "op %d: allocation of slot %d overlaps slot %d\n", i, s, owners[u]-1);
+                        rc = -1;
+                    }
+                    owners[u] = s + 1;
+                }
+            }
+        } else {
+            if( NULL == ptrs[s] ) continue;
+            if( NULL != owners ) {
+                first = ((char*)ptrs[s] - (char*)zone->base) / UNIT_SIZE;
+                nb_units = (sizes[s] + UNIT_SIZE - 1) / UNIT_SIZE;
+                for(u = first; u < first + nb_units; u++) {
+                    if( s + 1 != owners[u] ) {
+                        fprintf(stderr, "op %d: area of slot %d was corrupted\n", i, s);
+                        rc = -1;
+                    }
+                    owners[u] = 0;
+                }
+            }
+            zone_free(zone, ptrs[s]);
+            ptrs[s] = NULL;
+        }
+    }
+    for(s = 0; s < nb_slots; s++) {
+        if( NULL != ptrs[s] ) {
+            if( NULL != owners ) {
+                first = ((char*)ptrs[s] - (char*)zone->base) / UNIT_SIZE;
+                nb_units = (sizes[s] + UNIT_SIZE - 1) / UNIT_SIZE;
+                for(u = first; u < first + nb_units; u++) owners[u] = 0;
+            }
+            zone_free(zone, ptrs[s]);
+        }
+    }
+    if( 0 != zone_in_use(zone) ) {
+        fprintf(stderr, "%zu bytes still in use after releasing all allocations\n", zone_in_use(zone));
+        rc = -1;
+    }
+    free(ptrs);
+    free(sizes);
+    return rc;
+}
+
+int main(int argc, char *argv[])
+{
+    int nb_ops = 200000, nb_slots = 8192, max_units = 64, nb_runs = 3;
+    int nb_segments = 1<<18, ch, policy, r, nb_failed, ret = EXIT_SUCCESS;
+    unsigned int seed = 3872;
+    const char *policy_names[2] = { "first fit", "segregated" };
+    trace_op_t *trace;
+    int *owners;
+    char *base;
+    zone_malloc_t *zone;
+    parsec_time_t t0, t1;
+
+    while( (ch = getopt(argc, argv, "n:l:m:z:r:s:h")) != -1 ) {
+        switch(ch) {
+        case 'n': nb_ops = atoi(optarg); break;
+        case 'l': nb_slots = atoi(optarg); break;
+        case 'm': max_units = atoi(optarg); break;
+        case 'z': nb_segments = atoi(optarg); break;
+        case 'r': nb_runs = atoi(optarg); break;
+        case 's': seed = (unsigned int)atoi(optarg); break;
+        case 'h':
+        default:
+            fprintf(stderr,
+                    "Usage: %s [-n nb_ops] [-l nb_live_slots] [-m max_units] [-z zone_units] [-r nb_runs] [-s seed]\n",
+                    argv[0]);
+            exit(1);
+        }
+    }
+
+    trace = build_trace(nb_ops, nb_slots, max_units, seed);
+    base = (char*)malloc((size_t)nb_segments * UNIT_SIZE);
+    owners = (int*)calloc(nb_segments, sizeof(int));
+
+    for(policy = ZONE_MALLOC_FIRST_FIT; policy <= ZONE_MALLOC_SEGREGATED; policy++) {
+        zone = zone_malloc_init_policy(base, nb_segments, UNIT_SIZE, policy);
+        if( 0 != replay(zone, trace, nb_ops, nb_slots, owners, &nb_failed) ) {
+            fprintf(stderr, "%s: inconsistent allocations\n", policy_names[policy]);
+            ret = EXIT_FAILURE;
+        }
+        for(r = 0; r < nb_runs; r++) {
+            t0 = take_time();
+            replay(zone, trace, nb_ops, nb_slots, NULL, &nb_failed);
+            t1 = take_time();
+            printf("%-10s run %d: %d operations in %llu %s (%d allocations failed)\n",
+                   policy_names[policy], r, nb_ops, (unsigned long long)diff_time(t0, t1),
+                   TIMER_UNIT, nb_failed);
+        }
+        zone_malloc_fini(&zone);
+    }
+
+    free(owners);
+    free(base);
+    free(trace);
+    return ret;
+}
@@ -1,12 +1,26 @@
 
 parsec_addtest_cmd(collections/reduce ${SHM_TEST_CMD_LIST} collections/reduce)
 
+parsec_addtest_cmd(collections/matrix_io ${SHM_TEST_CMD_LIST} collections/matrix_io -N 1000 -t 100 -f matrix_io.dat)
+parsec_addtest_cmd(collections/matrix_io:direct ${SHM_TEST_CMD_LIST} collections/matrix_io -N 1000 -t 90 -f matrix_io_direct.dat -d)
+if( MPI_C_FOUND )
+  parsec_addtest_cmd(collections/matrix_io:mp ${MPI_TEST_CMD_LIST} 4 collections/matrix_io -N 1000 -t 100 -P 2 -f matrix_io_mp.dat)
+endif( MPI_C_FOUND )
+
 if( MPI_C_FOUND )
     parsec_addtest_cmd(collections/redistribute:mp ${MPI_TEST_CMD_LIST} 8 collections/redistribute/testing_redistribute -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -P 2 -Q 4 -p 4 -q 2)
+    parsec_addtest_cmd(collections/redistribute:mp:jdf ${MPI_TEST_CMD_LIST} 8 collections/redistribute/testing_redistribute -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -P 2 -Q 4 -p 4 -q 2 -- --mca redistribute_planner 0)
     parsec_addtest_cmd(collections/redistribute_random:mp ${MPI_TEST_CMD_LIST} 8 collections/redistribute/testing_redistribute_random -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -P 2 -Q 4 -p 4 -q 2)
+    parsec_addtest_cmd(collections/redistribute_random:mp:jdf ${MPI_TEST_CMD_LIST} 8 collections/redistribute/testing_redistribute_random -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -P 2 -Q 4 -p 4 -q 2 -- --mca redistribute_planner 0)
+    # Broadcasts forwarded in fragments along the chain (default) and the binary tree topologies
+    parsec_addtest_cmd(collections/redistribute:mp:jdf:chain ${MPI_TEST_CMD_LIST} 8 collections/redistribute/testing_redistribute -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -P 2 -Q 4 -p 4 -q 2 -- --mca redistribute_planner 0 --mca runtime_comm_coll_bcast 1 --mca runtime_comm_fragment_size 4096)
+    parsec_addtest_cmd(collections/redistribute:mp:jdf:binary ${MPI_TEST_CMD_LIST} 8 collections/redistribute/testing_redistribute -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -P 2 -Q 4 -p 4 -q 2 -- --mca redistribute_planner 0 --mca runtime_comm_coll_bcast 3 --mca runtime_comm_fragment_size 4096)
+    parsec_addtest_cmd(collections/redistribute_random:mp:jdf:binary ${MPI_TEST_CMD_LIST} 8 collections/redistribute/testing_redistribute_random -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -P 2 -Q 4 -p 4 -q 2 -- --mca redistribute_planner 0 --mca runtime_comm_coll_bcast 3 --mca runtime_comm_fragment_size 4096)
 else( MPI_C_FOUND )
     parsec_addtest_cmd(collections/redistribute ${MPI_TEST_CMD_LIST} collections/redistribute/testing_redistribute -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x)
+    parsec_addtest_cmd(collections/redistribute:jdf ${MPI_TEST_CMD_LIST} collections/redistribute/testing_redistribute -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -- --mca redistribute_planner 0)
     parsec_addtest_cmd(collections/redistribute_random ${MPI_TEST_CMD_LIST} collections/redistribute/testing_redistribute_random -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x)
+    parsec_addtest_cmd(collections/redistribute_random:jdf ${MPI_TEST_CMD_LIST} collections/redistribute/testing_redistribute_random -M 2400 -N 2400 -a 2400 -A 2400 -t 300 -T 300 -b 200 -B 200 -m 2000 -n 2000 -I 30 -J 40 -i 100 -j 121 -v -z -x -- --mca redistribute_planner 0)
 endif( MPI_C_FOUND )
 
 parsec_addtest_cmd(collections/reshape ${SHM_TEST_CMD_LIST} collections/reshape/reshape -N 120 -t 9 -c 10)
@@ -38,3 +52,7 @@ if( MPI_C_FOUND )
 else( MPI_C_FOUND )
   parsec_addtest_cmd(collections/matrix/band ${SHM_TEST_CMD_LIST} collections/two_dim_band/testing_band -N 3200 -T 160 -b 2)
 endif( MPI_C_FOUND )
+parsec_addtest_cmd(collections/matrix/band_count ${SHM_TEST_CMD_LIST} collections/two_dim_band/testing_band_count)
+if( MPI_C_FOUND )
+  parsec_addtest_cmd(collections/matrix/band_count:mp ${MPI_TEST_CMD_LIST} 4 collections/two_dim_band/testing_band_count)
+endif( MPI_C_FOUND )
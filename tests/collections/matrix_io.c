@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/*
+ * Write a block-cyclic matrix into a shared file and read it back into a
+ * matrix distributed on another process grid, with the taskpool of
+ * parsec_tiled_matrix_io() and with the collective MPI-IO transfer, checking
+ * the content and reporting the throughput of each transfer.
+ */
+
+#include "parsec/runtime.h"
+#include "parsec/data_dist/matrix/matrix.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+#include "tests/tests_timing.h"
+#include <string.h>
+#include <unistd.h>
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif
+
+static double value_of(const parsec_tiled_matrix_t *desc, int m, int n, int i, int j)
+{
+    return (double)(m * desc->mb + i) * 1e5 + (double)(n * desc->nb + j);
+}
+
+static int init_op(parsec_execution_stream_t *es, const parsec_tiled_matrix_t *desc,
+                   void *data, int uplo, int m, int n, void *args)
+{
+    double *tile = (double*)data;
+    int i, j, zero = *(int*)args;
+    (void)es; (void)uplo;
+
+    for(j = 0; j < desc->nb; j++)
+        for(i = 0; i < desc->mb; i++)
+            tile[j * desc->mb + i] = zero ? 0.0 : value_of(desc, m, n, i, j);
+    return 0;
+}
+
+static int check_op(parsec_execution_stream_t *es, const parsec_tiled_matrix_t *desc,
+                    void *data, int uplo, int m, int n, void *args)
+{
+    double *tile = (double*)data;
+    int i, j, errors = 0;
+    (void)es; (void)uplo;
+
+    for(j = 0; j < desc->nb; j++)
+        for(i = 0; i < desc->mb; i++)
+            if( tile[j * desc->mb + i] != value_of(desc, m, n, i, j) )
+                errors++;
+    if( errors > 0 ) {
+        fprintf(stderr, "tile (%d, %d): %d wrong elements\n", m, n, errors);
+        parsec_atomic_fetch_add_int32((int32_t*)args, errors);
+    }
+    return 0;
+}
+
+static void report(int rank, const char *what, int rc, double bytes, double time)
+{
+    if( 0 == rank ) {
+        printf("%-24s %s %10.3f s %10.2f MB/s\n", what, PARSEC_SUCCESS == rc ? "ok    " : "FAILED",
+               time, bytes / time / 1e6);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    parsec_context_t *parsec;
+    parsec_matrix_block_cyclic_t dcA, dcB;
+    int rank = 0, world = 1, rc, ret = 0, zero, a;
+    int N = 1000, NB = 100, P = 1, flags = 0;
+    int32_t errors = 0;
+    const char *filename = "matrix_io.dat";
+    double bytes, t;
+    int pargc = 0;
+    char **pargv = NULL;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+
+    for(a = 1; a < argc; a++) {
+        if( strcmp(argv[a], "--") == 0 ) {
+            pargc = argc - a;
+            pargv = argv + a;
+            break;
+        }
+        if( strcmp(argv[a], "-N") == 0 && a+1 < argc ) { N = atoi(argv[++a]); continue; }
+        if( strcmp(argv[a], "-t") == 0 && a+1 < argc ) { NB = atoi(argv[++a]); continue; }
+        if( strcmp(argv[a], "-P") == 0 && a+1 < argc ) { P = atoi(argv[++a]); continue; }
+        if( strcmp(argv[a], "-f") == 0 && a+1 < argc ) { filename = argv[++a]; continue; }
+        if( strcmp(argv[a], "-d") == 0 ) { flags |= PARSEC_MATRIX_IO_DIRECT; continue; }
+        fprintf(stderr, "Usage: %s [-N size] [-t tile size] [-P process rows] [-f file] [-d (O_DIRECT)] [-- <parsec parameters>]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    if( world % P != 0 ) P = 1;
+
+    parsec = parsec_init(-1, &pargc, &pargv);
+    if( NULL == parsec ) {
+        exit(-1);
+    }
+
+    /* A on a P x Q grid, B on a Q x P grid */
+    parsec_matrix_block_cyclic_init(&dcA, PARSEC_MATRIX_DOUBLE, PARSEC_MATRIX_TILE,
+                                    rank, NB, NB, N, N, 0, 0, N, N,
+                                    P, world / P, 1, 1, 0, 0);
+    dcA.mat = parsec_data_allocate((size_t)dcA.super.nb_local_tiles *
+                                   (size_t)dcA.super.bsiz *
+                                   (size_t)parsec_datadist_getsizeoftype(dcA.super.mtype));
+    parsec_data_collection_set_key(&dcA.super.super, "A");
+    parsec_matrix_block_cyclic_init(&dcB, PARSEC_MATRIX_DOUBLE, PARSEC_MATRIX_TILE,
+                                    rank, NB, NB, N, N, 0, 0, N, N,
+                                    world / P, P, 1, 1, 0, 0);
+    dcB.mat = parsec_data_allocate((size_t)dcB.super.nb_local_tiles *
+                                   (size_t)dcB.super.bsiz *
+                                   (size_t)parsec_datadist_getsizeoftype(dcB.super.mtype));
+    parsec_data_collection_set_key(&dcB.super.super, "B");
+    bytes = (double)dcA.super.mt * dcA.super.nt * dcA.super.bsiz * sizeof(double);
+
+    zero = 0;
+    parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcA.super, init_op, &zero);
+
+    /* Tasks backend */
+    zero = 1;
+    parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcB.super, init_op, &zero);
+    t = get_cur_time();
+    rc = parsec_tiled_matrix_io(parsec, &dcA.super, filename, flags | PARSEC_MATRIX_IO_WRITE);
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    report(rank, "tasks write", rc, bytes, get_cur_time() - t);
+    ret |= (PARSEC_SUCCESS != rc);
+    t = get_cur_time();
+    rc = parsec_tiled_matrix_io(parsec, &dcB.super, filename, flags | PARSEC_MATRIX_IO_READ);
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    report(rank, "tasks read", rc, bytes, get_cur_time() - t);
+    ret |= (PARSEC_SUCCESS != rc);
+    parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcB.super, check_op, &errors);
+
+    /* Collective backend, read back with the tasks to check the layout */
+    parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcB.super, init_op, &zero);
+    t = get_cur_time();
+    rc = parsec_tiled_matrix_io_collective(parsec, &dcA.super, filename, flags | PARSEC_MATRIX_IO_WRITE);
+    report(rank, "collective write", rc, bytes, get_cur_time() - t);
+    ret |= (PARSEC_SUCCESS != rc);
+    rc = parsec_tiled_matrix_io(parsec, &dcB.super, filename, flags | PARSEC_MATRIX_IO_READ);
+    ret |= (PARSEC_SUCCESS != rc);
+    parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcB.super, check_op, &errors);
+
+    parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcB.super, init_op, &zero);
+    t = get_cur_time();
+    rc = parsec_tiled_matrix_io_collective(parsec, &dcB.super, filename, flags | PARSEC_MATRIX_IO_READ);
+    report(rank, "collective read", rc, bytes, get_cur_time() - t);
+    ret |= (PARSEC_SUCCESS != rc);
+    parsec_apply(parsec, PARSEC_MATRIX_FULL, &dcB.super, check_op, &errors);
+
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Allreduce(MPI_IN_PLACE, &errors, 1, MPI_INT32_T, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &ret, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+#endif
+    if( 0 == rank ) {
+        if( errors > 0 )
+            fprintf(stderr, "%d elements were not read back correctly\n", errors);
+        unlink(filename);
+    }
+
+    parsec_data_free(dcA.mat);
+    parsec_tiled_matrix_destroy(&dcA.super);
+    parsec_data_free(dcB.mat);
+    parsec_tiled_matrix_destroy(&dcB.super);
+
+    parsec_fini(&parsec);
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Finalize();
+#endif
+
+    return (ret || errors > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
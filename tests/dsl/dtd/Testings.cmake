@@ -7,6 +7,9 @@ parsec_addtest_cmd(dsl/dtd/task_generation ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test
 parsec_addtest_cmd(dsl/dtd/task_inserting_task ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_task_inserting_task)
 parsec_addtest_cmd(dsl/dtd/task_insertion ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_task_insertion)
 parsec_addtest_cmd(dsl/dtd/war ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_war)
+parsec_addtest_cmd(dsl/dtd/insertion_scaling ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_insertion_scaling -t 1)
+parsec_addtest_cmd(dsl/dtd/insertion_scaling:adaptive ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_insertion_scaling -t 1 -w -- --mca runtime_num_cores 2 --mca dtd_adaptive_window 1 --mca dtd_window_size 256 --mca dtd_threshold_size 128 --mca dtd_memory_limit 1000000)
+parsec_addtest_cmd(dsl/dtd/insertion_scaling:adaptive:nopark ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_insertion_scaling -t 1 -w -- --mca runtime_num_cores 2 --mca runtime_idle_spin -1 --mca dtd_adaptive_window 1 --mca dtd_window_size 256 --mca dtd_threshold_size 128)
 parsec_addtest_cmd(dsl/dtd/new_tile:cpu ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_new_tile --mca device_cuda_enabled 0)
 if(PARSEC_HAVE_CUDA AND CMAKE_CUDA_COMPILER)
   parsec_addtest_cmd(dsl/dtd/new_tile:gpu ${SHM_TEST_CMD_LIST} ${CTEST_CUDA_LAUNCHER_OPTIONS} dsl/dtd/dtd_test_new_tile --mca device_cuda_enabled 1 --mca device cuda)
@@ -18,11 +21,17 @@ endif(PARSEC_HAVE_CUDA AND CMAKE_CUDA_COMPILER)
 if( MPI_C_FOUND )
   parsec_addtest_cmd(dsl/dtd/empty:mp ${MPI_TEST_CMD_LIST} 2 dsl/dtd/dtd_test_empty)
   parsec_addtest_cmd(dsl/dtd/pingpong:mp ${MPI_TEST_CMD_LIST} 2 dsl/dtd/dtd_test_pingpong)
+  parsec_addtest_cmd(dsl/dtd/pingpong:mp:shm ${MPI_TEST_CMD_LIST} 2 dsl/dtd/dtd_test_pingpong -- --mca runtime_comm_shm 1)
+  parsec_addtest_cmd(dsl/dtd/pingpong:mp:shm:nocma ${MPI_TEST_CMD_LIST} 2 dsl/dtd/dtd_test_pingpong -- --mca runtime_comm_shm 1 --mca runtime_comm_shm_single_copy 0)
   parsec_addtest_cmd(dsl/dtd/task_inserting_task:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_task_inserting_task)
   parsec_addtest_cmd(dsl/dtd/task_insertion:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_task_insertion)
   parsec_addtest_cmd(dsl/dtd/war:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_war)
   parsec_addtest_cmd(dsl/dtd/interleave_actions:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_interleave_actions)
   parsec_addtest_cmd(dsl/dtd/allreduce:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_allreduce)
+  parsec_addtest_cmd(dsl/dtd/insertion_scaling:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_insertion_scaling -t 1)
+  parsec_addtest_cmd(dsl/dtd/insertion_scaling:mp:sliced ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_insertion_scaling -t 1 -- --mca dtd_sliced_insertion 1)
+  parsec_addtest_cmd(dsl/dtd/insertion_scaling:mp:packed ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_insertion_scaling -t 1 -p)
+  parsec_addtest_cmd(dsl/dtd/insertion_scaling:mp:sliced:packed ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_insertion_scaling -t 1 -p -- --mca dtd_sliced_insertion 1)
   parsec_addtest_cmd(dsl/dtd/new_tile:mp:cpu ${MPI_TEST_CMD_LIST} 2 dsl/dtd/dtd_test_new_tile --mca device_cuda_enabled 0)
   if(PARSEC_HAVE_CUDA AND CMAKE_CUDA_COMPILER)
     parsec_addtest_cmd(dsl/dtd/new_tile:mp:gpu ${MPI_TEST_CMD_LIST} 2 ${CTEST_CUDA_LAUNCHER_OPTIONS} dsl/dtd/dtd_test_new_tile --mca device_cuda_enabled 1 --mca device cuda)
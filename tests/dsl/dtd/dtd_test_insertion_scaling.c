@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/*
+ * Derived from dtd_test_simple_gemm: inserts the tasks of a tiled C += A x B
+ * on a PxQ grid, with tiny tiles so that the cost of the insertion
+ * dominates, and reports how many tasks each rank discovers per second.
+ * Every rank inserts every task, so with the default insertion this rate
+ * is expected to stay flat as the number of processes grows, while the
+ * sliced insertion (--mca dtd_sliced_insertion 1) skips the tasks that do
+ * not concern the rank. With -p the tasks are inserted from a task
+ * signature, one batch per tile of C. With -w the test fails unless the
+ * adaptive window (--mca dtd_adaptive_window 1) grew at least once.
+ */
+
+#include "parsec.h"
+#include "parsec/arena.h"
+#include "parsec/data_dist/matrix/matrix.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <sys/time.h>
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+static int TILE_FULL = -1;
+static int packed = 0;
+static uint32_t window_grows = 0, window_shrinks = 0;
+
+static int gemm_kernel(parsec_execution_stream_t *es, parsec_task_t *this_task)
+{
+    double *A, *B, *C;
+    int mb, i, j, k;
+
+    (void)es;
+    parsec_dtd_unpack_args(this_task, &A, &B, &C, &mb);
+
+    for( j = 0; j < mb; j++ )
+        for( k = 0; k < mb; k++ )
+            for( i = 0; i < mb; i++ )
+                C[j * mb + i] += A[k * mb + i] * B[j * mb + k];
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+static parsec_matrix_block_cyclic_t *create_matrix(int rank, int mb, int mt, int nt,
+                                                   int P, int Q, double value)
+{
+    parsec_matrix_block_cyclic_t *dc;
+    size_t i, nb_elem;
+
+    dc = calloc(1, sizeof(parsec_matrix_block_cyclic_t));
+    parsec_matrix_block_cyclic_init(dc, PARSEC_MATRIX_DOUBLE, PARSEC_MATRIX_TILE, rank,
+                                    mb, mb, mt * mb, nt * mb, 0, 0, mt * mb, nt * mb,
+                                    P, Q, 1, 1, 0, 0);
+    nb_elem = (size_t)dc->super.nb_local_tiles * (size_t)dc->super.bsiz;
+    dc->mat = parsec_data_allocate(nb_elem * sizeof(double));
+    for( i = 0; i < nb_elem; i++ )
+        ((double *)dc->mat)[i] = value;
+    parsec_dtd_data_collection_init(&dc->super.super);
+    return dc;
+}
+
+static void destroy_matrix(parsec_matrix_block_cyclic_t *dc)
+{
+    parsec_dtd_data_collection_fini(&dc->super.super);
+    parsec_data_free(dc->mat);
+    parsec_tiled_matrix_destroy_data(&dc->super);
+    parsec_data_collection_destroy(&dc->super.super);
+    free(dc);
+}
+
+/* Returns the time spent inserting the tasks */
+static double gemm(parsec_context_t *parsec_context, parsec_matrix_block_cyclic_t *A,
+                   parsec_matrix_block_cyclic_t *B, parsec_matrix_block_cyclic_t *C)
+{
+    parsec_taskpool_t *tp = parsec_dtd_taskpool_new();
+    parsec_task_class_t *gemm_tc;
+    parsec_dtd_task_signature_t *gemm_sig = NULL;
+    parsec_dtd_tile_t **tiles = NULL;
+    parsec_data_key_t keyA, keyB, keyC;
+    struct timeval start, end, diff;
+    int perr, mb = C->super.mb;
+
+    perr = parsec_context_add_taskpool(parsec_context, tp);
+    PARSEC_CHECK_ERROR(perr, "parsec_context_add_taskpool");
+    perr = parsec_context_start(parsec_context);
+    PARSEC_CHECK_ERROR(perr, "parsec_context_start");
+
+    gemm_tc = parsec_dtd_create_task_class(tp, "GEMM",
+                                           PASSED_BY_REF, PARSEC_INPUT | TILE_FULL,                   /* A  */
+                                           PASSED_BY_REF, PARSEC_INPUT | TILE_FULL,                   /* B  */
+                                           PASSED_BY_REF, PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY, /* C  */
+                                           sizeof(int), PARSEC_VALUE,                                 /* mb */
+                                           PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(tp, gemm_tc, PARSEC_DEV_CPU, gemm_kernel);
+    if( packed ) {
+        gemm_sig = parsec_dtd_task_signature_new(tp, gemm_tc, PARSEC_DEV_CPU);
+        tiles = malloc(3 * A->super.nt * sizeof(parsec_dtd_tile_t *));
+    }
+
+    gettimeofday(&start, NULL);
+    for( int i = 0; i < C->super.mt; i++ ) {
+        for( int j = 0; j < C->super.nt; j++ ) {
+            keyC = C->super.super.data_key(&C->super.super, i, j);
+            if( packed ) {
+                /* all the tasks of the batch share the same value of mb */
+                for( int k = 0; k < A->super.nt; k++ ) {
+                    keyA = A->super.super.data_key(&A->super.super, i, k);
+                    keyB = B->super.super.data_key(&B->super.super, k, j);
+                    tiles[3 * k]     = PARSEC_DTD_TILE_OF_KEY(&A->super.super, keyA);
+                    tiles[3 * k + 1] = PARSEC_DTD_TILE_OF_KEY(&B->super.super, keyB);
+                    tiles[3 * k + 2] = PARSEC_DTD_TILE_OF_KEY(&C->super.super, keyC);
+                }
+                parsec_dtd_insert_packed_tasks(tp, gemm_sig, A->super.nt, 0, tiles, &mb, 0);
+                continue;
+            }
+            for( int k = 0; k < A->super.nt; k++ ) {
+                keyA = A->super.super.data_key(&A->super.super, i, k);
+                keyB = B->super.super.data_key(&B->super.super, k, j);
+                parsec_dtd_insert_task_with_task_class(tp, gemm_tc, 0, PARSEC_DEV_CPU,
+                                                       PARSEC_INPUT, PARSEC_DTD_TILE_OF_KEY(&A->super.super, keyA),
+                                                       PARSEC_INPUT, PARSEC_DTD_TILE_OF_KEY(&B->super.super, keyB),
+                                                       PARSEC_INOUT, PARSEC_DTD_TILE_OF_KEY(&C->super.super, keyC),
+                                                       PARSEC_DTD_EMPTY_FLAG, &mb,
+                                                       PARSEC_DTD_ARG_END);
+            }
+        }
+    }
+    gettimeofday(&end, NULL);
+
+    parsec_dtd_data_flush_all(tp, &A->super.super);
+    parsec_dtd_data_flush_all(tp, &B->super.super);
+    parsec_dtd_data_flush_all(tp, &C->super.super);
+
+    perr = parsec_taskpool_wait(tp);
+    PARSEC_CHECK_ERROR(perr, "parsec_taskpool_wait");
+    perr = parsec_context_wait(parsec_context);
+    PARSEC_CHECK_ERROR(perr, "parsec_context_wait");
+
+    if( packed ) {
+        parsec_dtd_task_signature_free(gemm_sig);
+        free(tiles);
+    }
+    parsec_dtd_task_class_release(tp, gemm_tc);
+    window_grows += ((parsec_dtd_taskpool_t *)tp)->window_grows;
+    window_shrinks += ((parsec_dtd_taskpool_t *)tp)->window_shrinks;
+    parsec_taskpool_free(tp);
+
+    timersub(&end, &start, &diff);
+    return (double)diff.tv_sec + (double)diff.tv_usec / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    parsec_context_t *parsec_context = NULL;
+    parsec_matrix_block_cyclic_t *dcA, *dcB, *dcC;
+    parsec_arena_datatype_t *adt;
+    int rank, world, ret = 0;
+    int mb = 2, MT = 32, NT = 32, KT = 32, P = -1, Q = -1, runs = 3, check_window = 0;
+    int pargc = 0;
+    char **pargv = NULL;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    for( int a = 1; a < argc; a++ ) {
+        if( strcmp(argv[a], "--") == 0 ) {
+            pargc = argc - a;
+            pargv = argv + a;
+            break;
+        }
+        if( a + 1 < argc ) {
+            if( strcmp(argv[a], "-M") == 0 ) { MT = atoi(argv[++a]); continue; }
+            if( strcmp(argv[a], "-N") == 0 ) { NT = atoi(argv[++a]); continue; }
+            if( strcmp(argv[a], "-K") == 0 ) { KT = atoi(argv[++a]); continue; }
+            if( strcmp(argv[a], "-b") == 0 ) { mb = atoi(argv[++a]); continue; }
+            if( strcmp(argv[a], "-P") == 0 ) { P = atoi(argv[++a]); continue; }
+            if( strcmp(argv[a], "-Q") == 0 ) { Q = atoi(argv[++a]); continue; }
+            if( strcmp(argv[a], "-t") == 0 ) { runs = atoi(argv[++a]); continue; }
+        }
+        if( strcmp(argv[a], "-p") == 0 ) { packed = 1; continue; }
+        if( strcmp(argv[a], "-w") == 0 ) { check_window = 1; continue; }
+        if( 0 == rank ) {
+            fprintf(stderr,
+                    "Usage: %s [-M MT] [-N NT] [-K KT] [-b tile size] [-P P] [-Q Q] [-t runs] [-p] [-w] [-- <parsec options>]\n"
+                    " Inserts the MTxNTxKT tasks of C += A x B with tiles of bxb doubles on a PxQ grid\n"
+                    " and reports the insertion rate of each rank. Use --mca dtd_sliced_insertion 1\n"
+                    " to only create the tasks that concern each rank, and -p to insert them packed.\n"
+                    " With -w, fails unless the adaptive window grew.\n", argv[0]);
+        }
+#if defined(PARSEC_HAVE_MPI)
+        MPI_Finalize();
+#endif
+        exit(EXIT_FAILURE);
+    }
+
+    if( -1 == P )
+        P = (int)sqrt(world);
+    if( -1 == Q )
+        Q = world / P;
+    while( P * Q != world ) {
+        P--;
+        Q = world / P;
+    }
+
+    parsec_context = parsec_init(-1, &pargc, &pargv);
+    if( NULL == parsec_context ) {
+        exit(-1);
+    }
+
+    adt = parsec_dtd_create_arena_datatype(parsec_context, &TILE_FULL);
+    parsec_add2arena_rect(adt, parsec_datatype_double_t, mb, mb, mb);
+
+    dcA = create_matrix(rank, mb, MT, KT, P, Q, 1.0);
+    parsec_data_collection_set_key(&dcA->super.super, "A");
+    dcB = create_matrix(rank, mb, KT, NT, P, Q, 1.0);
+    parsec_data_collection_set_key(&dcB->super.super, "B");
+    dcC = create_matrix(rank, mb, MT, NT, P, Q, 0.0);
+    parsec_data_collection_set_key(&dcC->super.super, "C");
+
+    /* the first run is a warmup, it also registers the DTD parameters */
+    for( int r = 0; r < runs + 1; r++ ) {
+        double t = gemm(parsec_context, dcA, dcB, dcC), tmin = t, tmax = t;
+#if defined(PARSEC_HAVE_MPI)
+        MPI_Reduce(&t, &tmin, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&t, &tmax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+#endif
+        if( 0 == rank && 0 == r ) {
+            printf("#DTD %sinsertion of %d tasks on %dx%d ranks, sliced insertion %s\n"
+                   "#run\tmin(s)\tmax(s)\ttasks/s per rank\n",
+                   packed ? "packed " : "", MT * NT * KT, P, Q, parsec_dtd_sliced_insertion ? "on" : "off");
+        }
+        if( 0 == rank && r > 0 ) {
+            printf("%d\t%g\t%g\t%g\n", r, tmin, tmax, (double)MT * NT * KT / tmax);
+        }
+    }
+
+    /* A and B are filled with ones: after each run every element of C grew by K */
+    {
+        size_t nb_elem = (size_t)dcC->super.nb_local_tiles * (size_t)dcC->super.bsiz;
+        double expected = (double)(runs + 1) * KT * mb;
+        for( size_t i = 0; i < nb_elem; i++ ) {
+            if( ((double *)dcC->mat)[i] != expected ) {
+                fprintf(stderr, "Rank %d: C has %g instead of %g at local index %zu\n",
+                        rank, ((double *)dcC->mat)[i], expected, i);
+                ret = 1;
+                break;
+            }
+        }
+    }
+
+    if( parsec_dtd_adaptive_window ) {
+        printf("Rank %d: the adaptive window grew %u times and shrank %u times\n",
+               rank, window_grows, window_shrinks);
+        if( check_window && 0 == window_grows ) {
+            fprintf(stderr, "Rank %d: the adaptive window never grew\n", rank);
+            ret = 1;
+        }
+    }
+
+    parsec_type_free(&adt->opaque_dtt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec_context, TILE_FULL);
+
+    destroy_matrix(dcA);
+    destroy_matrix(dcB);
+    destroy_matrix(dcC);
+
+    parsec_fini(&parsec_context);
+
+#if defined(PARSEC_HAVE_MPI)
+    MPI_Finalize();
+#endif
+
+    return ret;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2023 The University of Tennessee and The University
+ * Copyright (c) 2017-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -119,7 +119,7 @@ int main(int argc, char ** argv)
 {
     parsec_context_t* parsec;
     int rank, world, cores = -1;
-    int nb, nt, rc;
+    int nb, nt, rc, timed_tasks = 100000;
     parsec_tiled_matrix_t *dcA;
 
 #if defined(PARSEC_HAVE_MPI)
@@ -144,6 +144,9 @@ int main(int argc, char ** argv)
 
     if(argv[1] != NULL){
         cores = atoi(argv[1]);
+        if(argv[2] != NULL){
+            timed_tasks = atoi(argv[2]);
+        }
     }
 
     /* Creating parsec context and initializing dtd environment */
@@ -190,7 +193,7 @@ int main(int argc, char ** argv)
     /***** Start of timing overhead of task generation ******/
     int total_flows[6] = {1, 2, 3, 5, 10, 15};
     //int total_flows[6] = {1, 0, 0, 0, 0, 0};
-    total_tasks = 100000;
+    total_tasks = timed_tasks;
     //total_tasks = 1;
 
     if( 0 == rank ) {
@@ -304,6 +307,83 @@ int main(int argc, char ** argv)
 
     /***** End of timing overhead of task generation ******/
 
+
+    /***** Start of timing overhead of packed task generation ******/
+    parsec_dtd_funcptr_t *overhead_fcts[6] = {task_to_check_overhead_1, task_to_check_overhead_2,
+                                              task_to_check_overhead_3, task_to_check_overhead_5,
+                                              task_to_check_overhead_10, task_to_check_overhead_15};
+    enum { batch = 64 };
+    parsec_dtd_tile_t *tiles[batch * 15];
+    int args[batch];
+
+    if( 0 == rank ) {
+        parsec_output( 0, "\nChecking time of inserting the same tasks from a task signature, "
+                       "by batches of %d tasks.\n\n", batch );
+    }
+
+    for( i = 0; i < 6; i++ ) {
+        parsec_dtd_param_t params[16];
+        parsec_task_class_t *tc;
+        parsec_dtd_task_signature_t *sig;
+        int k, f;
+
+        nb = 1; /* size of each tile */
+        nt = total_flows[i]*total_tasks; /* total tiles */
+
+        dcA = create_and_distribute_empty_data(rank, world, nb, nt);
+        parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+
+        parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+        parsec_dtd_data_collection_init(A);
+
+        dtd_tp = parsec_dtd_taskpool_new(  );
+
+        rc = parsec_context_add_taskpool( parsec, dtd_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+
+        params[0].op = PARSEC_VALUE;
+        params[0].size = sizeof(int);
+        params[0].profile_info = NULL;
+        for( f = 1; f <= total_flows[i]; f++ ) {
+            params[f].op = PARSEC_INOUT;
+            params[f].size = PASSED_BY_REF;
+            params[f].profile_info = NULL;
+        }
+        tc = &parsec_dtd_create_task_classv("task_for_timing_overhead", total_flows[i] + 1, params)->super;
+        parsec_dtd_task_class_add_chore(dtd_tp, tc, PARSEC_DEV_CPU, overhead_fcts[i]);
+        sig = parsec_dtd_task_signature_new(dtd_tp, tc, PARSEC_DEV_CPU);
+        assert(NULL != sig && total_flows[i] == parsec_dtd_task_signature_nb_tiles(sig));
+        for( k = 0; k < batch; k++ ) {
+            args[k] = total_flows[i];
+        }
+
+        SYNC_TIME_START();
+
+        for( j = 0; j < total_flows[i] * total_tasks; j += total_flows[i] * k ) {
+            for( k = 0; k < batch && j + total_flows[i] * k < total_flows[i] * total_tasks; k++ ) {
+                for( f = 0; f < total_flows[i]; f++ ) {
+                    tiles[k * total_flows[i] + f] = PARSEC_DTD_TILE_OF_KEY(A, j + total_flows[i] * k + f);
+                }
+            }
+            parsec_dtd_insert_packed_tasks(dtd_tp, sig, k, 0, tiles, args, sizeof(int));
+        }
+        parsec_dtd_data_flush_all( dtd_tp, A );
+
+        /* finishing all the tasks inserted, but not finishing the handle */
+        rc = parsec_taskpool_wait( dtd_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+
+        SYNC_TIME_PRINT(rank, ("\tNo of flows : %d \tTime for each packed task : %lf\n\n", total_flows[i], sync_time_elapsed/total_tasks));
+
+        parsec_dtd_task_signature_free(sig);
+        parsec_dtd_task_class_release(dtd_tp, tc);
+        parsec_taskpool_free( dtd_tp );
+        parsec_dtd_data_collection_fini( A );
+        free_data(dcA);
+    }
+
+    /***** End of timing overhead of packed task generation ******/
+
     rc = parsec_context_wait(parsec);
     PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2024 The University of Tennessee and The University
+ * Copyright (c) 2017-2025 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  */
@@ -10,8 +10,11 @@
 /* system and io */
 #include <stdlib.h>
 #include <stdio.h>
+#include <pthread.h>
 
+#include "tests/tests_data.h"
 #include "tests/tests_timing.h"
+#include "parsec/class/barrier.h"
 #include "parsec/interfaces/dtd/insert_function_internal.h"
 #include "parsec/utils/debug.h"
 
@@ -78,6 +81,86 @@ test_task_generator( parsec_execution_stream_t *es,
     return PARSEC_HOOK_RETURN_DONE;
 }
 
+typedef struct inserter_arg_s {
+    parsec_taskpool_t *dtd_tp;
+    int index;
+    int nb_tasks;
+    int amount_of_work;
+} inserter_arg_t;
+
+static void *
+test_task_inserter( void *_arg )
+{
+    inserter_arg_t *arg = (inserter_arg_t *)_arg;
+    parsec_dtd_inserter_t *inserter;
+    int m;
+
+    inserter = parsec_dtd_inserter_new(arg->dtd_tp, arg->index);
+    if( NULL == inserter ) {
+        return (void*)-1;
+    }
+    for( m = 0; m < arg->nb_tasks; m++ ) {
+        parsec_dtd_insert_task(arg->dtd_tp, test_task, 0, PARSEC_DEV_CPU, "Test_Task",
+                               sizeof(int), &arg->amount_of_work, PARSEC_VALUE,
+                               PARSEC_DTD_ARG_END);
+    }
+    parsec_dtd_inserter_free(inserter);
+    return NULL;
+}
+
+int
+test_tile_task( parsec_execution_stream_t *es,
+                parsec_task_t *this_task )
+{
+    (void)es;
+    int *data;
+
+    parsec_dtd_unpack_args(this_task, &data);
+    *data += 1;
+    (void)parsec_atomic_fetch_inc_int32(&count);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+typedef struct tile_inserter_arg_s {
+    parsec_taskpool_t *dtd_tp;
+    parsec_data_collection_t *A;
+    parsec_barrier_t *barrier;
+    int32_t *nb_done;
+    int index;
+    int key;
+    int nb_tasks;
+} tile_inserter_arg_t;
+
+static void *
+test_tile_task_inserter( void *_arg )
+{
+    tile_inserter_arg_t *arg = (tile_inserter_arg_t *)_arg;
+    parsec_dtd_inserter_t *inserter;
+    int m;
+
+    inserter = parsec_dtd_inserter_new(arg->dtd_tp, arg->index);
+    /* All the inserters discover the task class of their first task at once */
+    parsec_barrier_wait(arg->barrier);
+    if( NULL != inserter ) {
+        for( m = 0; m < arg->nb_tasks; m++ ) {
+            parsec_dtd_insert_task(arg->dtd_tp, test_tile_task, 0, PARSEC_DEV_CPU, "Test_Tile_Task",
+                                   PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(arg->A, arg->key), PARSEC_INOUT | PARSEC_AFFINITY,
+                                   PARSEC_DTD_ARG_END);
+        }
+        parsec_dtd_inserter_free(inserter);
+    }
+    (void)parsec_atomic_fetch_inc_int32(arg->nb_done);
+    return (NULL == inserter) ? (void*)-1 : NULL;
+}
+
+static int *
+tile_value( parsec_data_collection_t *A, int key )
+{
+    parsec_data_t *data = A->data_of_key(A, key);
+    return (int *)PARSEC_DATA_COPY_GET_PTR(data->device_copies[0]);
+}
+
 int main(int argc, char ** argv)
 {
     parsec_context_t* parsec;
@@ -99,8 +182,11 @@ int main(int argc, char ** argv)
     rank = 0;
 #endif
 
-    int m, n;
+    int m, n, t, nb_inserters = 4;
     int no_of_tasks = 50000;
+    int nb_tile_tasks = 1000, tile_window_size = 8;
+    parsec_tiled_matrix_t *dcA;
+    parsec_data_collection_t *A;
     int amount_of_work[3] = {100, 1000, 10000};
     parsec_taskpool_t *dtd_tp;
 
@@ -212,6 +298,137 @@ int main(int argc, char ** argv)
     }
     /****** END ******/
 
+    /****** Several threads insert while the workers execute ******/
+    if( rank == 0 ) {
+        parsec_output( 0, "\nWe now insert %d tasks using 1 to %d threads that are not PaRSEC threads, "
+                       "each inserting its share of the tasks, while the other %d cores execute them, "
+                       "the main thread joins after all tasks are inserted\n\n",
+                       no_of_tasks, nb_inserters, cores-1 );
+    }
+
+    /* The main thread waits for the inserters without executing tasks, do not
+     * let the inserters block on a window that only it could drain. */
+    parsec_dtd_window_size    = no_of_tasks;
+    parsec_dtd_threshold_size = no_of_tasks;
+
+    for( t = 1; t <= nb_inserters; t++ ) {
+        pthread_t threads[nb_inserters];
+        inserter_arg_t args[nb_inserters];
+        void *trc;
+
+        count = 0;
+
+        TIME_START();
+
+        for( m = 0; m < t; m++ ) {
+            args[m].dtd_tp = dtd_tp;
+            args[m].index = m;
+            args[m].nb_tasks = no_of_tasks / t + (m < no_of_tasks % t);
+            args[m].amount_of_work = amount_of_work[0];
+            pthread_create(&threads[m], NULL, test_task_inserter, &args[m]);
+        }
+        for( m = 0; m < t; m++ ) {
+            pthread_join(threads[m], &trc);
+            if( NULL != trc ) {
+                parsec_fatal("Inserter %d could not be attached to the taskpool\n", m);
+            }
+        }
+
+        /* finishing all the tasks inserted, but not finishing the handle */
+        rc = parsec_taskpool_wait( dtd_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+
+        TIME_PRINT(rank, ("Tasks executed : %d : Inserter threads: %d\n", count, t));
+        if( count != no_of_tasks ) {
+            parsec_fatal("%d tasks executed instead of %d\n", count, no_of_tasks);
+        }
+    }
+
+    parsec_dtd_window_size    = tmp_window_size;
+    parsec_dtd_threshold_size = tmp_threshold_size;
+    /****** END ******/
+
+    /****** Several threads use a new task class at once, with a small window ******/
+    if( rank == 0 ) {
+        parsec_output( 0, "\nWe now insert chains of %d tasks on tiles using 2 to %d threads that are not "
+                       "PaRSEC threads, all creating the same task class at once in a new taskpool, "
+                       "with a window of %d tasks, while the main thread executes them\n\n",
+                       nb_tile_tasks, nb_inserters, tile_window_size );
+    }
+
+    dcA = create_and_distribute_data(rank, world, 1, world * nb_inserters);
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+    A = (parsec_data_collection_t *)dcA;
+    parsec_dtd_data_collection_init(A);
+
+    parsec_dtd_window_size    = tile_window_size;
+    parsec_dtd_threshold_size = tile_window_size / 2;
+
+    for( t = 2; t <= nb_inserters; t++ ) {
+        pthread_t threads[nb_inserters];
+        tile_inserter_arg_t args[nb_inserters];
+        parsec_barrier_t barrier;
+        int32_t nb_done = 0;
+        parsec_taskpool_t *tile_tp;
+        void *trc;
+
+        /* A new taskpool does not know any task class yet */
+        tile_tp = parsec_dtd_taskpool_new();
+        rc = parsec_context_add_taskpool( parsec, tile_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+        parsec_barrier_init(&barrier, NULL, t);
+        count = 0;
+
+        TIME_START();
+
+        for( m = 0; m < t; m++ ) {
+            args[m].dtd_tp = tile_tp;
+            args[m].A = A;
+            args[m].barrier = &barrier;
+            args[m].nb_done = &nb_done;
+            args[m].index = m;
+            args[m].key = A->data_key(A, m * world + rank, 0);  /* a local tile */
+            args[m].nb_tasks = nb_tile_tasks;
+            *tile_value(A, args[m].key) = 0;
+            pthread_create(&threads[m], NULL, test_tile_task_inserter, &args[m]);
+        }
+        /* The inserters wait for the tasks of their window to complete */
+        while( nb_done < t ) {
+            parsec_taskpool_test( tile_tp );
+        }
+        for( m = 0; m < t; m++ ) {
+            pthread_join(threads[m], &trc);
+            if( NULL != trc ) {
+                parsec_fatal("Inserter %d could not be attached to the taskpool\n", m);
+            }
+        }
+
+        parsec_dtd_data_flush_all( tile_tp, A );
+        rc = parsec_taskpool_wait( tile_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+
+        TIME_PRINT(rank, ("Tasks executed : %d : Inserter threads: %d\n", count, t));
+        if( count != t * nb_tile_tasks ) {
+            parsec_fatal("%d tasks executed instead of %d\n", count, t * nb_tile_tasks);
+        }
+        for( m = 0; m < t; m++ ) {
+            if( *tile_value(A, args[m].key) != nb_tile_tasks ) {
+                parsec_fatal("Tile of inserter %d was updated %d times instead of %d\n",
+                             m, *tile_value(A, args[m].key), nb_tile_tasks);
+            }
+        }
+
+        parsec_barrier_destroy(&barrier);
+        parsec_taskpool_free( tile_tp );
+    }
+
+    parsec_dtd_window_size    = tmp_window_size;
+    parsec_dtd_threshold_size = tmp_threshold_size;
+
+    parsec_dtd_data_collection_fini( A );
+    free_data(dcA);
+    /****** END ******/
+
     rc = parsec_context_wait(parsec);
     PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
 
@@ -6,4 +6,9 @@ include(${CMAKE_CURRENT_LIST_DIR}/multisize_bcast/Testings.cmake)
 parsec_addtest_cmd(dsl/ptg/startup1 ${SHM_TEST_CMD_LIST} dsl/ptg/startup -i=10 -j=10 -k=10 -v=5)
 parsec_addtest_cmd(dsl/ptg/startup2 ${SHM_TEST_CMD_LIST} dsl/ptg/startup -i=10 -j=20 -k=30 -v=5)
 parsec_addtest_cmd(dsl/ptg/startup3 ${SHM_TEST_CMD_LIST} dsl/ptg/startup -i=30 -j=30 -k=30 -v=5)
+parsec_addtest_cmd(dsl/ptg/startup_split:off ${SHM_TEST_CMD_LIST} dsl/ptg/startup_split -- --mca runtime_num_cores 4 --mca task_startup_split 1)
+parsec_addtest_cmd(dsl/ptg/startup_split:on ${SHM_TEST_CMD_LIST} dsl/ptg/startup_split -- --mca runtime_num_cores 4 --mca task_startup_split 0)
+parsec_addtest_cmd(dsl/ptg/startup_split:partial ${SHM_TEST_CMD_LIST} dsl/ptg/startup_split -- --mca runtime_num_cores 4 --mca task_startup_split 3)
+parsec_addtest_cmd(dsl/ptg/startup_split:chunked ${SHM_TEST_CMD_LIST} dsl/ptg/startup_split -- --mca runtime_num_cores 4 --mca task_startup_split 0 --mca task_startup_iter 4 --mca task_startup_chunk 16)
 parsec_addtest_cmd(dsl/ptg/strange ${SHM_TEST_CMD_LIST} dsl/ptg/strange)
+parsec_addtest_cmd(dsl/ptg/critical_path ${SHM_TEST_CMD_LIST} dsl/ptg/critical_path -n=10 -w=16)
@@ -2,3 +2,6 @@ include(ParsecCompilePTG)
 
 parsec_addtest_cmd(dsl/ptg/branching/hashtable ${SHM_TEST_CMD_LIST} dsl/ptg/branching/branching_ht)
 parsec_addtest_cmd(dsl/ptg/branching/idxarray ${SHM_TEST_CMD_LIST} dsl/ptg/branching/branching_idxarr)
+parsec_addtest_cmd(dsl/ptg/branching/openaddressing ${SHM_TEST_CMD_LIST} dsl/ptg/branching/branching_oa)
+parsec_addtest_cmd(dsl/ptg/branching/flatarray ${SHM_TEST_CMD_LIST} dsl/ptg/branching/branching_flat)
+parsec_addtest_cmd(dsl/ptg/branching/properties ${SHM_TEST_CMD_LIST} dsl/ptg/branching/branching_props)
@@ -1,4 +1,5 @@
 parsec_addtest_cmd(dsl/ptg/multisize_bcast ${SHM_TEST_CMD_LIST} dsl/ptg/multisize_bcast/check_multisize_bcast)
 if( MPI_C_FOUND )
   parsec_addtest_cmd(dsl/ptg/multisize_bcast:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/multisize_bcast/check_multisize_bcast)
+  parsec_addtest_cmd(dsl/ptg/multisize_bcast:mp:binary ${MPI_TEST_CMD_LIST} 4 dsl/ptg/multisize_bcast/check_multisize_bcast 8 -- --mca runtime_comm_coll_bcast 3 --mca runtime_comm_fragment_size 4096)
 endif( MPI_C_FOUND)
@@ -1,6 +1,12 @@
 foreach(_sched ${MCA_sched})
     parsec_addtest_cmd(runtime/scheduling:${_sched} ${MPI_TEST_CMD_LIST} 1 runtime/scheduling/schedmicro -t 10 -l 8 -n 512 -- --mca mca_sched ${_sched})
 endforeach()
+parsec_addtest_cmd(runtime/scheduling:latency ${SHM_TEST_CMD_LIST} runtime/scheduling/schedlatency -r 20 -b 4 -d 500)
+parsec_addtest_cmd(runtime/scheduling:fanout ${SHM_TEST_CMD_LIST} runtime/scheduling/schedfanout -r 3 -n 10000)
+# Tasks released by the first virtual process onto the second one, injected with each policy
+foreach(_policy RANGE 1 3)
+  parsec_addtest_cmd(runtime/scheduling:inject:${_policy} ${SHM_TEST_CMD_LIST} runtime/scheduling/schedmicro -t 10 -l 8 -n 512 -- --mca runtime_vpmap rr:2:2:1 --mca runtime_inject_policy ${_policy})
+endforeach()
 
 if( MPI_C_FOUND )
   foreach(_sched ${MCA_sched})
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "parsec/runtime.h"
+#include "parsec/utils/debug.h"
+#include "parsec/os-spec-timing.h"
+#include "fanout.h"
+#include "schedmicro_data.h"
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+/*
+ * Measures the cost of releasing the successors of a task, from 1 to MAX
+ * successors (in powers of 10). For each round, the time between the end of
+ * the producer and the start of the first successor covers the release of
+ * all the successors, as the ready tasks are only scheduled once they are all
+ * known. The same time divided by the number of successors should not grow
+ * with the number of successors.
+ */
+
+static int NR    =      5;
+static int MAX   = 100000;
+static int ORDER =     -1;
+
+int main(int argc, char *argv[])
+{
+    parsec_context_t* parsec;
+    parsec_fanout_taskpool_t *tp;
+    parsec_data_collection_t *dcA;
+    parsec_time_t *released;
+    double *start, first, sum;
+    int rank, world, rc, r, s, ns;
+    int parsec_argc = 0;
+    char **parsec_argv = NULL;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+    for(int a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "--") == 0) {
+            parsec_argc = argc - a;
+            parsec_argv = argv + a;
+            break;
+        }
+        if(strcmp(argv[a], "-r") == 0) {
+            a++;
+            NR = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-n") == 0) {
+            a++;
+            MAX = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-o") == 0) {
+            a++;
+            ORDER = atoi(argv[a]);
+            continue;
+        }
+        fprintf(stderr, "Usage: %s [-r ROUNDS] [-n MAX SUCCESSORS] [-o ORDER (-1 decreasing, 0 same, 1 increasing priorities)] [-- <parsec parameters]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    if( world != 1 ) {
+        fprintf(stderr, "This benchmark measures the release of local successors, run it on one process\n");
+        exit(EXIT_FAILURE);
+    }
+
+    parsec = parsec_init(0, &parsec_argc, &parsec_argv);
+    if( NULL == parsec ) {
+        exit(-1);
+    }
+
+    dcA = create_and_distribute_data(rank, world, 1, 1);
+    parsec_data_collection_set_key(dcA, "A");
+
+    released = (parsec_time_t*)calloc(NR, sizeof(parsec_time_t));
+    start = (double*)calloc((size_t)NR * MAX, sizeof(double));
+
+    printf("#Release of the successors of a task, average over %d rounds, with %s priorities. Times are expressed in " TIMER_UNIT "\n",
+           NR, ORDER > 0 ? "increasing" : (ORDER < 0 ? "decreasing" : "equal"));
+    printf("#Successors\tFirst start\tPer successor\n");
+    for( ns = 1; ns <= MAX; ns *= 10 ) {
+        tp = parsec_fanout_new(NR, ns, ORDER, released, start, dcA);
+        rc = parsec_context_add_taskpool(parsec, &tp->super);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+        rc = parsec_context_start(parsec);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+        rc = parsec_context_wait(parsec);
+        PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+        parsec_taskpool_free(&tp->super);
+
+        sum = 0.0;
+        for( r = 0; r < NR; r++ ) {
+            first = start[(size_t)r * ns];
+            for( s = 1; s < ns; s++ )
+                if( start[(size_t)r * ns + s] < first ) first = start[(size_t)r * ns + s];
+            sum += first;
+        }
+        printf("%d\t%g\t%g\n", ns, sum / (double)NR, sum / (double)NR / (double)ns);
+        if( ns > MAX / 10 ) break;
+    }
+
+    free(released);
+    free(start);
+    free_data(dcA);
+
+    parsec_fini(&parsec);
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
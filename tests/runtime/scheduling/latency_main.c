@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "parsec/runtime.h"
+#include "parsec/utils/debug.h"
+#include "parsec/os-spec-timing.h"
+#include "latency.h"
+#include "schedmicro_data.h"
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+/*
+ * Measures the time between the moment a burst of tasks becomes ready and
+ * the moment each of them starts, when all the other execution streams are
+ * idle. This is dominated by how fast idle execution streams notice new
+ * tasks.
+ */
+
+static int NR    =  100;
+static int NB    =    8;
+static int DELAY = 1000;
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[])
+{
+    parsec_context_t* parsec;
+    parsec_latency_taskpool_t *tp;
+    parsec_data_collection_t *dcA;
+    parsec_time_t *ready;
+    double *lat, sum = 0.0;
+    int rank, world, rc, i, n;
+    int parsec_argc = 0;
+    char **parsec_argv = NULL;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+    for(int a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "--") == 0) {
+            parsec_argc = argc - a;
+            parsec_argv = argv + a;
+            break;
+        }
+        if(strcmp(argv[a], "-r") == 0) {
+            a++;
+            NR = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-b") == 0) {
+            a++;
+            NB = atoi(argv[a]);
+            continue;
+        }
+        if(strcmp(argv[a], "-d") == 0) {
+            a++;
+            DELAY = atoi(argv[a]);
+            continue;
+        }
+        fprintf(stderr, "Usage: %s [-r ROUNDS] [-b BURST] [-d DELAY (us)] [-- <parsec parameters]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    if( world != 1 ) {
+        fprintf(stderr, "This benchmark measures the latency within a single process, run it on one process\n");
+        exit(EXIT_FAILURE);
+    }
+
+    parsec = parsec_init(0, &parsec_argc, &parsec_argv);
+    if( NULL == parsec ) {
+        exit(-1);
+    }
+
+    dcA = create_and_distribute_data(rank, world, 1, 1);
+    parsec_data_collection_set_key(dcA, "A");
+
+    n = NR * NB;
+    ready = (parsec_time_t*)calloc(NR, sizeof(parsec_time_t));
+    lat = (double*)calloc(n, sizeof(double));
+
+    tp = parsec_latency_new(NR, NB, DELAY, ready, lat, dcA);
+    rc = parsec_context_add_taskpool(parsec, &tp->super);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+    parsec_taskpool_free(&tp->super);
+
+    qsort(lat, n, sizeof(double), cmp_double);
+    for( i = 0; i < n; i++ ) sum += lat[i];
+    printf("#Ready to start latency of %d bursts of %d tasks, every %d us. Times are expressed in " TIMER_UNIT "\n",
+           NR, NB, DELAY);
+    printf("#Avg\tMin\tMedian\t90th\tMax\n");
+    printf("%g\t%g\t%g\t%g\t%g\n", sum / (double)n, lat[0], lat[n / 2], lat[(9 * n) / 10], lat[n - 1]);
+
+    free(ready);
+    free(lat);
+    free_data(dcA);
+
+    parsec_fini(&parsec);
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/*
+ * Convert a set of PaRSEC Binary Profile files into a columnar trace, without
+ * holding the events in memory. The matched events are streamed in row groups
+ * of a fixed number of rows, each column of a row group being stored
+ * contiguously, so that a reader can load only the columns and the row groups
+ * (time ranges, nodes) it needs. The event keys are dictionary encoded: the
+ * type column holds the index of the event in the dictionary of the trace.
+ *
+ * Layout of the file, all integers in the byte order of the host:
+ *   header:     magick[24], uint64 byte order, uint32 number of columns,
+ *               uint32 rows per row group
+ *   row groups: for each column, the values of the rows of the group
+ *   footer:     columns (name, numpy type), dictionary (name, attributes,
+ *               convertor), nodes (rank, identifier, file name, infos),
+ *               streams (node, stream, identifier, begin, end, number of
+ *               events), row groups (number of rows, minimal begin, maximal
+ *               end, minimal and maximal node, offset of each column)
+ *   trailer:    uint64 footer offset, magick[24]
+ * Strings are stored as an uint32 length followed by the characters.
+ */
+
+#include "parsec/parsec_config.h"
+#undef PARSEC_HAVE_MPI
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <errno.h>
+
+#include "parsec/profiling.h"
+#include "parsec/parsec_binary_profile.h"
+#include "dbpreader.h"
+
+#define DBP2COL_MAGICK "#PARSEC COLUMNAR TRACE 1"  /* 24 characters */
+
+enum {
+    COL_NODE_ID,
+    COL_STREAM_ID,
+    COL_TYPE,
+    COL_TASKPOOL_ID,
+    COL_ID,
+    COL_BEGIN,
+    COL_END,
+    COL_FLAGS,
+    NB_COLUMNS
+};
+
+static const struct {
+    const char *name;
+    const char *dtype;  /**< numpy type of the column, in the byte order of the header */
+    size_t      size;
+} columns[NB_COLUMNS] = {
+    [COL_NODE_ID]     = { "node_id",     "i4", sizeof(int32_t)  },
+    [COL_STREAM_ID]   = { "stream_id",   "i4", sizeof(int32_t)  },
+    [COL_TYPE]        = { "type",        "i4", sizeof(int32_t)  },
+    [COL_TASKPOOL_ID] = { "taskpool_id", "u4", sizeof(uint32_t) },
+    [COL_ID]          = { "id",          "u8", sizeof(uint64_t) },
+    [COL_BEGIN]       = { "begin",       "u8", sizeof(uint64_t) },
+    [COL_END]         = { "end",         "u8", sizeof(uint64_t) },
+    [COL_FLAGS]       = { "flags",       "u2", sizeof(uint16_t) },
+};
+
+typedef struct {
+    int64_t  nb_rows;
+    uint64_t min_begin;
+    uint64_t max_end;
+    int32_t  min_node;
+    int32_t  max_node;
+    int64_t  offsets[NB_COLUMNS];
+} row_group_t;
+
+typedef struct {
+    int32_t  node_id;
+    int32_t  stream_id;
+    char    *hr_id;
+    uint64_t begin;
+    uint64_t end;
+    int64_t  nb_events;
+} stream_desc_t;
+
+typedef struct {
+    FILE          *out;
+    uint32_t       rows_per_group;
+    /* the row group being filled */
+    char          *values[NB_COLUMNS];
+    row_group_t    current;
+    /* the row groups and streams already written, described in the footer */
+    row_group_t   *groups;
+    int64_t        nb_groups;
+    int64_t        groups_size;
+    stream_desc_t *streams;
+    int64_t        nb_streams;
+    /* statistics */
+    int64_t        nb_events;
+    int64_t        nb_unmatched;
+    int64_t        nb_invalid;
+} col_writer_t;
+
+static int write_bytes(col_writer_t *w, const void *p, size_t len)
+{
+    return (fwrite(p, 1, len, w->out) == len) ? 0 : -1;
+}
+
+static int write_u32(col_writer_t *w, uint32_t v) { return write_bytes(w, &v, sizeof(v)); }
+static int write_i32(col_writer_t *w, int32_t v)  { return write_bytes(w, &v, sizeof(v)); }
+static int write_u64(col_writer_t *w, uint64_t v) { return write_bytes(w, &v, sizeof(v)); }
+static int write_i64(col_writer_t *w, int64_t v)  { return write_bytes(w, &v, sizeof(v)); }
+
+static int write_string(col_writer_t *w, const char *s)
+{
+    uint32_t len = (NULL == s) ? 0 : (uint32_t)strlen(s);
+    if( 0 != write_u32(w, len) )
+        return -1;
+    return write_bytes(w, s, len);
+}
+
+static void row_group_reset(col_writer_t *w)
+{
+    memset(&w->current, 0, sizeof(row_group_t));
+    w->current.min_begin = UINT64_MAX;
+    w->current.min_node  = INT32_MAX;
+    w->current.max_node  = INT32_MIN;
+}
+
+static int row_group_flush(col_writer_t *w)
+{
+    int c;
+
+    if( 0 == w->current.nb_rows )
+        return 0;
+    for( c = 0; c < NB_COLUMNS; c++ ) {
+        w->current.offsets[c] = (int64_t)ftello(w->out);
+        if( 0 != write_bytes(w, w->values[c], w->current.nb_rows * columns[c].size) )
+            return -1;
+    }
+    if( w->nb_groups == w->groups_size ) {
+        w->groups_size = w->groups_size ? 2 * w->groups_size : 64;
+        w->groups = (row_group_t*)realloc(w->groups, w->groups_size * sizeof(row_group_t));
+    }
+    w->groups[w->nb_groups++] = w->current;
+    row_group_reset(w);
+    return 0;
+}
+
+#define COLUMN(w, c, type) ((type*)(w)->values[c])
+
+static int add_row(col_writer_t *w, int32_t node_id, int32_t stream_id, int32_t type,
+                   const dbp_event_t *s, const dbp_event_t *e)
+{
+    int64_t r = w->current.nb_rows++;
+    uint64_t begin = dbp_event_get_timestamp(s);
+    uint64_t end = dbp_event_get_timestamp(e);
+
+    COLUMN(w, COL_NODE_ID,     int32_t)[r]  = node_id;
+    COLUMN(w, COL_STREAM_ID,   int32_t)[r]  = stream_id;
+    COLUMN(w, COL_TYPE,        int32_t)[r]  = type;
+    COLUMN(w, COL_TASKPOOL_ID, uint32_t)[r] = dbp_event_get_taskpool_id(s);
+    COLUMN(w, COL_ID,          uint64_t)[r] = dbp_event_get_event_id(s);
+    COLUMN(w, COL_BEGIN,       uint64_t)[r] = begin;
+    COLUMN(w, COL_END,         uint64_t)[r] = end;
+    COLUMN(w, COL_FLAGS,       uint16_t)[r] = (uint16_t)dbp_event_get_flags(s);
+
+    if( begin < w->current.min_begin ) w->current.min_begin = begin;
+    if( end > w->current.max_end )     w->current.max_end = end;
+    if( node_id < w->current.min_node ) w->current.min_node = node_id;
+    if( node_id > w->current.max_node ) w->current.max_node = node_id;
+    w->nb_events++;
+
+    if( w->current.nb_rows == w->rows_per_group )
+        return row_group_flush(w);
+    return 0;
+}
+
+static int convert_stream(col_writer_t *w, const dbp_file_t *file, int32_t node_id, int tid)
+{
+    const dbp_thread_t *th = dbp_file_get_thread(file, tid);
+    dbp_event_iterator_t *it, *m;
+    const dbp_event_t *e, *g;
+    stream_desc_t *sd;
+    int rc = 0;
+
+    w->streams = (stream_desc_t*)realloc(w->streams, (w->nb_streams + 1) * sizeof(stream_desc_t));
+    sd = &w->streams[w->nb_streams++];
+    sd->node_id   = node_id;
+    sd->stream_id = tid;
+    sd->hr_id     = dbp_thread_get_hr_id(th);
+    sd->begin     = UINT64_MAX;
+    sd->end       = 0;
+    sd->nb_events = 0;
+
+    it = dbp_iterator_new_from_thread( th );
+    for( e = dbp_iterator_current(it); (NULL != e) && (0 == rc); e = dbp_iterator_next(it) ) {
+        if( !KEY_IS_START(dbp_event_get_key(e)) )
+            continue;
+        m = dbp_iterator_find_matching_event_all_threads(it);
+        if( NULL == m ) {
+            w->nb_unmatched++;
+            continue;
+        }
+        g = dbp_iterator_current(m);
+        if( dbp_event_get_timestamp(g) < dbp_event_get_timestamp(e) ) {
+            w->nb_invalid++;
+        } else {
+            rc = add_row(w, node_id, tid,
+                         dbp_file_translate_local_dico_to_global(file, BASE_KEY(dbp_event_get_key(e))),
+                         e, g);
+            if( dbp_event_get_timestamp(e) < sd->begin ) sd->begin = dbp_event_get_timestamp(e);
+            if( dbp_event_get_timestamp(g) > sd->end )   sd->end = dbp_event_get_timestamp(g);
+            sd->nb_events++;
+        }
+        dbp_iterator_delete(m);
+    }
+    dbp_iterator_delete(it);
+    if( UINT64_MAX == sd->begin )
+        sd->begin = 0;
+    return rc;
+}
+
+static int write_footer(col_writer_t *w, const dbp_multifile_reader_t *dbp)
+{
+    int64_t footer, g;
+    dbp_dictionary_t *dico;
+    const dbp_file_t *file;
+    const dbp_info_t *info;
+    int c, i, ifd, rc = 0;
+
+    footer = (int64_t)ftello(w->out);
+
+    rc |= write_u32(w, NB_COLUMNS);
+    for( c = 0; c < NB_COLUMNS; c++ ) {
+        rc |= write_string(w, columns[c].name);
+        rc |= write_string(w, columns[c].dtype);
+    }
+
+    rc |= write_u32(w, dbp_reader_nb_dictionary_entries(dbp));
+    for( i = 0; i < dbp_reader_nb_dictionary_entries(dbp); i++ ) {
+        dico = dbp_reader_get_dictionary(dbp, i);
+        rc |= write_string(w, dbp_dictionary_name(dico));
+        rc |= write_string(w, dbp_dictionary_attributes(dico));
+        rc |= write_string(w, dbp_dictionary_convertor(dico));
+    }
+
+    rc |= write_u32(w, dbp_reader_nb_files(dbp));
+    for( ifd = 0; ifd < dbp_reader_nb_files(dbp); ifd++ ) {
+        file = dbp_reader_get_file(dbp, ifd);
+        rc |= write_i32(w, dbp_file_get_rank(file));
+        rc |= write_string(w, dbp_file_hr_id(file));
+        rc |= write_string(w, dbp_file_get_name(file));
+        rc |= write_u32(w, dbp_file_nb_infos(file));
+        for( i = 0; i < dbp_file_nb_infos(file); i++ ) {
+            info = dbp_file_get_info(file, i);
+            rc |= write_string(w, dbp_info_get_key(info));
+            rc |= write_string(w, dbp_info_get_value(info));
+        }
+    }
+
+    rc |= write_u64(w, w->nb_streams);
+    for( g = 0; g < w->nb_streams; g++ ) {
+        rc |= write_i32(w, w->streams[g].node_id);
+        rc |= write_i32(w, w->streams[g].stream_id);
+        rc |= write_string(w, w->streams[g].hr_id);
+        rc |= write_u64(w, w->streams[g].begin);
+        rc |= write_u64(w, w->streams[g].end);
+        rc |= write_i64(w, w->streams[g].nb_events);
+    }
+
+    rc |= write_u64(w, w->nb_groups);
+    for( g = 0; g < w->nb_groups; g++ ) {
+        rc |= write_i64(w, w->groups[g].nb_rows);
+        rc |= write_u64(w, w->groups[g].min_begin);
+        rc |= write_u64(w, w->groups[g].max_end);
+        rc |= write_i32(w, w->groups[g].min_node);
+        rc |= write_i32(w, w->groups[g].max_node);
+        for( c = 0; c < NB_COLUMNS; c++ )
+            rc |= write_i64(w, w->groups[g].offsets[c]);
+    }
+
+    rc |= write_i64(w, footer);
+    rc |= write_bytes(w, DBP2COL_MAGICK, 24);
+    return rc;
+}
+
+static int convert(const char *filename, const dbp_multifile_reader_t *dbp, uint32_t rows_per_group)
+{
+    col_writer_t w;
+    char magick[24];
+    int c, ifd, t, rc = 0;
+
+    memset(&w, 0, sizeof(w));
+    w.out = fopen(filename, "w");
+    if( NULL == w.out ) {
+        fprintf(stderr, "Unable to open %s in write mode: %s\n", filename, strerror(errno));
+        return -1;
+    }
+    w.rows_per_group = rows_per_group;
+    for( c = 0; c < NB_COLUMNS; c++ )
+        w.values[c] = (char*)malloc(rows_per_group * columns[c].size);
+    row_group_reset(&w);
+
+    memcpy(magick, DBP2COL_MAGICK, sizeof(magick));  /* without the terminating nul */
+    rc |= write_bytes(&w, magick, sizeof(magick));
+    rc |= write_u64(&w, 0x0123456789ABCDEFULL);
+    rc |= write_u32(&w, NB_COLUMNS);
+    rc |= write_u32(&w, rows_per_group);
+
+    for( ifd = 0; (ifd < dbp_reader_nb_files(dbp)) && (0 == rc); ifd++ ) {
+        const dbp_file_t *file = dbp_reader_get_file(dbp, ifd);
+        if( 0 != dbp_file_error(file) )
+            continue;
+        for( t = 0; (t < dbp_file_nb_threads(file)) && (0 == rc); t++ )
+            rc = convert_stream(&w, file, dbp_file_get_rank(file), t);
+    }
+    if( 0 == rc )
+        rc = row_group_flush(&w);
+    if( 0 == rc )
+        rc = write_footer(&w, dbp);
+    if( 0 != fclose(w.out) )
+        rc = -1;
+    if( 0 != rc )
+        fprintf(stderr, "Unable to write %s: %s\n", filename, strerror(errno));
+    else
+        printf("%"PRId64" events in %"PRId64" row groups written to %s (%"PRId64" without end, %"PRId64" ending before their start)\n",
+               w.nb_events, w.nb_groups, filename, w.nb_unmatched, w.nb_invalid);
+
+    for( c = 0; c < NB_COLUMNS; c++ )
+        free(w.values[c]);
+    free(w.groups);
+    free(w.streams);
+    return rc;
+}
+
+int main(int argc, char *argv[])
+{
+    dbp_multifile_reader_t *dbp;
+    const char *filename = "out.pcol";
+    long rows_per_group = 65536, nb_threads;
+    int ch;
+    char *m;
+
+    while( (ch = getopt(argc, argv, "o:r:h?")) != -1 ) {
+        switch(ch) {
+        case 'o':
+            filename = optarg;
+            break;
+        case 'r':
+            rows_per_group = strtol(optarg, &m, 0);
+            if( (rows_per_group <= 0) || (rows_per_group > INT32_MAX) || (m[0] != '\0') ) {
+                fprintf(stderr, "invalid -r value\n");
+                exit(1);
+            }
+            break;
+        default:
+            fprintf(stderr,
+                    "Usage: %s [-o output] [-r rows] file1 file2 ...\n"
+                    "  -o output: name of the columnar trace (default out.pcol)\n"
+                    "  -r rows:   number of rows of the row groups (default 65536)\n",
+                    argv[0]);
+            exit(1);
+        }
+    }
+    if( optind >= argc ) {
+        fprintf(stderr, "Usage: %s [-o output] [-r rows] file1 file2 ...\n", argv[0]);
+        exit(1);
+    }
+
+    dbp = dbp_reader_open_files(argc - optind, argv + optind);
+    if( (NULL == dbp) || (0 == dbp_reader_nb_files(dbp)) ) {
+        fprintf(stderr, "None of the files can be read\n");
+        return 1;
+    }
+    nb_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    dbp_reader_index(dbp, nb_threads > 0 ? (int)nb_threads : 1);
+
+    if( 0 != convert(filename, dbp, (uint32_t)rows_per_group) )
+        return 1;
+
+    dbp_reader_close_files(dbp);
+    dbp_reader_destruct(dbp);
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include <sys/mman.h>
 #endif
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <pthread.h>
 #include <fcntl.h>
 #include <stdarg.h>
@@ -81,6 +82,10 @@ struct dbp_file {
     int   *dico_map;
     struct dbp_info  **infos;
     struct dbp_thread *threads;
+    char  *map;                 /**< the whole trace mapped in memory, or NULL */
+    size_t map_size;
+    struct dbp_index *index;    /**< the index of the unmatched end events, built on demand */
+    pthread_mutex_t   index_mtx;
 };
 
 struct dbp_event {
@@ -216,37 +221,72 @@ int dbp_file_translate_local_dico_to_global(const dbp_file_t *file, int lid)
    (EVENT_HAS_INFO((dbp_event)->native) ?                   \
     (dbp_object)->parent->dico_keys[(dbp_object)->dico_map[BASE_KEY((dbp_event)->native->event.key)]].keylen : 0))
 
+/* An end event that does not immediately follow its start event in its
+ * stream. The offset combines the position of the events buffer in the file,
+ * a multiple of event_buffer_size, and the position of the event in this
+ * buffer, below event_avail_space, so both can be recovered. */
 typedef struct {
+    uint64_t event_id;
     uint64_t timestamp;
-    off_t    offset;
+    int64_t  offset;
     int64_t  event_idx;
-} event_cache_item_t;
-
-typedef struct {
-    event_cache_item_t *items;
-    size_t              len;
-    size_t              size;
-} event_cache_key_t;
-
-typedef struct {
-    pthread_mutex_t    mtx;
-    event_cache_key_t *keys;
-    int                done;
-} event_cache_t;
+    uint32_t taskpool_id;
+    int32_t  key;           /**< base key, in the dictionary of the file */
+    int32_t  tid;
+    int32_t  unused;
+} dbp_index_entry_t;
+
+/* The unmatched end events of all the streams of a file, sorted by key,
+ * taskpool, event id, timestamp and stream. The start events are joined with
+ * their end event through an open addressing hash table that maps each
+ * (key, taskpool, event id) to its first entry. */
+typedef struct dbp_index {
+    dbp_index_entry_t *entries;
+    int64_t            nb_entries;
+    int64_t           *buckets;
+    uint64_t           mask;
+} dbp_index_t;
 
 struct dbp_thread {
     const parsec_profiling_stream_t *profile;
     dbp_file_t                      *file;
     dbp_info_t                      *infos;
-    event_cache_t                    cache;
     int                              nb_infos;
 };
 
 #if defined(PARSEC_PROFILING_USE_MMAP)
-static void release_events_buffer(parsec_profiling_buffer_t *buffer)
+/* Map the whole trace, so that the events buffers are referred in place. The
+ * mapping survives the closing of the file descriptor. */
+static void map_file(dbp_file_t *file)
+{
+    struct stat st;
+    void *map;
+
+    if( (0 != fstat(file->fd, &st)) || (0 == st.st_size) )
+        return;
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, file->fd, 0);
+    if( MAP_FAILED == map )
+        return;  /* the events buffers are mapped one at a time */
+    file->map = (char*)map;
+    file->map_size = st.st_size;
+}
+
+static void unmap_file(dbp_file_t *file)
+{
+    if( NULL != file->map ) {
+        munmap(file->map, file->map_size);
+        file->map = NULL;
+        file->map_size = 0;
+    }
+}
+
+static void release_events_buffer(const dbp_file_t *file, parsec_profiling_buffer_t *buffer)
 {
     if( NULL == buffer )
         return;
+    if( (NULL != file->map) && ((char*)buffer >= file->map) &&
+        ((char*)buffer < file->map + file->map_size) )
+        return;
     if( munmap(buffer, event_buffer_size) == -1 ) {
         WARNING("Warning profiling system: unmap of the events backend file at %p failed: %s\n",
                  buffer, strerror(errno));
@@ -256,14 +296,21 @@ static void release_events_buffer(parsec_profiling_buffer_t *buffer)
 static parsec_profiling_buffer_t *refer_events_buffer( const dbp_file_t *file, int64_t offset )
 {
     parsec_profiling_buffer_t *res;
+    if( (NULL != file->map) && (offset >= 0) &&
+        ((size_t)offset + event_buffer_size <= file->map_size) )
+        return (parsec_profiling_buffer_t*)(file->map + offset);
     res = mmap(NULL, event_buffer_size, PROT_READ, MAP_SHARED, file->fd, offset);
     if( MAP_FAILED == res )
         return NULL;
     return res;
 }
 #else
-static void release_events_buffer(parsec_profiling_buffer_t *buffer)
+#define map_file(file)   do {} while(0)
+#define unmap_file(file) do {} while(0)
+
+static void release_events_buffer(const dbp_file_t *file, parsec_profiling_buffer_t *buffer)
 {
+    (void)file;
     if( NULL == buffer )
         return;
     free(buffer);
@@ -357,7 +404,7 @@ static inline const dbp_event_t *
 dbp_iterator_set_offset(dbp_event_iterator_t *it, off_t offset)
 {
     if( it->current_events_buffer != NULL ) {
-        release_events_buffer( it->current_events_buffer );
+        release_events_buffer( it->thread->file, it->current_events_buffer );
         it->current_events_buffer = NULL;
         it->current_event.native = NULL;
     }
@@ -431,7 +478,7 @@ const dbp_thread_t *dbp_iterator_thread(const dbp_event_iterator_t *it)
 void dbp_iterator_delete(dbp_event_iterator_t *it)
 {
     if( NULL != it->current_events_buffer )
-        release_events_buffer(it->current_events_buffer);
+        release_events_buffer(it->thread->file, it->current_events_buffer);
     free(it);
 }
 
@@ -446,183 +493,348 @@ static inline int dbp_events_match(const dbp_event_t *s, const dbp_event_t *e)
              (dbp_event_get_timestamp(  s) <= dbp_event_get_timestamp(  e)) );
 }
 
-/* minimum allocation count for cache */
-#define EVENT_CACHE_MIN_ALLOC 64
-static void add_cache_entry(dbp_thread_t *thr, int key, dbp_event_iterator_t *it, const dbp_event_t *ev)
-{
-    event_cache_key_t  *cache_key;
-    event_cache_item_t *cache_item;
-    size_t              cache_index;
-    off_t               offset;
+/* The entries collected from one stream during the construction of an index */
+typedef struct {
+    dbp_index_entry_t *entries;
+    int64_t            nb_entries;
+    int64_t            size;
+} dbp_index_list_t;
 
-    cache_key = &thr->cache.keys[BASE_KEY(key)];
+/* minimum allocation count for the entries of a stream */
+#define DBP_INDEX_MIN_ALLOC 64
 
-    cache_index = cache_key->len++;
-    /* if index == size, we need to grow the array */
-    if( cache_index == cache_key->size ) {
-        /* if size == 0, this is the first mismatched event with this key */
-        cache_key->size = cache_key->size ? cache_key->size * 2 :
-                                            EVENT_CACHE_MIN_ALLOC;
-        cache_key->items = realloc(cache_key->items, sizeof(event_cache_item_t[cache_key->size]));
-    }
-
-    /* cache timestamp and buffer offset for this event
-     * note that we don't store the exact index of the event,
-     * so a consumer should make sure to search through the buffer */
-    cache_item = &cache_key->items[cache_index];
+static void index_list_push(dbp_index_list_t *list, int tid,
+                            const dbp_event_iterator_t *it, const dbp_event_t *e)
+{
+    dbp_index_entry_t *entry;
 
-    /* event pos it always less than event_avail_space
-     * and buffer offset is always a multiple of event_buffer_size
-     * so these can be combined together and recovered */
+    if( list->nb_entries == list->size ) {
+        list->size = list->size ? list->size * 2 : DBP_INDEX_MIN_ALLOC;
+        list->entries = realloc(list->entries, list->size * sizeof(dbp_index_entry_t));
+    }
     assert( it->current_event_position >= 0 );
     assert( it->current_event_position < event_avail_space );
     assert( (it->current_buffer_position % event_buffer_size) == 0 );
 
-    offset = it->current_buffer_position + it->current_event_position;
-    cache_item->timestamp = dbp_event_get_timestamp(ev);
-    cache_item->offset    = offset;
-    cache_item->event_idx = it->current_event_index;
-
-    assert( (offset % event_buffer_size) == it->current_event_position);
+    entry = &list->entries[list->nb_entries++];
+    entry->event_id    = dbp_event_get_event_id(e);
+    entry->timestamp   = dbp_event_get_timestamp(e);
+    entry->offset      = it->current_buffer_position + it->current_event_position;
+    entry->event_idx   = it->current_event_index;
+    entry->taskpool_id = dbp_event_get_taskpool_id(e);
+    entry->key         = BASE_KEY(dbp_event_get_key(e));
+    entry->tid         = tid;
+    entry->unused      = 0;
 }
 
-/* build a "cache" of events where the end event
- * does not immediately follow the start event */
-static void build_unmatched_events_in_thread(dbp_thread_t *thr)
+/* Collect the end events of a stream that do not immediately follow their
+ * start event. These are the only ones that need to be searched for. */
+static void index_thread(const dbp_thread_t *thr, int tid, dbp_index_list_t *list)
 {
-    const dbp_event_t      *e1,  *e2;
-    dbp_event_iterator_t   *i1,  *i2;
-    int                     key1, key2;
+    parsec_profiling_output_t prev_native;
+    dbp_event_t prev = { .native = &prev_native };
+    dbp_event_iterator_t *it;
+    const dbp_event_t *e;
+    int has_prev = 0;
 
-    /* lock cache; we're modifying volatile state! */
-    pthread_mutex_lock(&thr->cache.mtx);
-    if( thr->cache.done ) {
-        /* cache already built, we don't need to do anything */
-        goto build_events_done;
+    it = dbp_iterator_new_from_thread( thr );
+    for( e = dbp_iterator_current(it); NULL != e; e = dbp_iterator_next(it) ) {
+        if( KEY_IS_END(dbp_event_get_key(e)) &&
+            !(has_prev && dbp_events_match(&prev, e)) ) {
+            index_list_push(list, tid, it, e);
+        }
+        /* the buffer of the previous event can be released by next */
+        prev_native.event = e->native->event;
+        has_prev = 1;
     }
+    dbp_iterator_delete(it);
+}
 
-    /* iterator 1 points to current event */
-    i1 = dbp_iterator_new_from_thread( thr );
-    e1 = dbp_iterator_current( i1 );
+static int index_entry_compare(const void *a, const void *b)
+{
+    const dbp_index_entry_t *ea = (const dbp_index_entry_t*)a;
+    const dbp_index_entry_t *eb = (const dbp_index_entry_t*)b;
+    if( ea->key != eb->key ) return ea->key < eb->key ? -1 : 1;
+    if( ea->taskpool_id != eb->taskpool_id ) return ea->taskpool_id < eb->taskpool_id ? -1 : 1;
+    if( ea->event_id != eb->event_id ) return ea->event_id < eb->event_id ? -1 : 1;
+    if( ea->timestamp != eb->timestamp ) return ea->timestamp < eb->timestamp ? -1 : 1;
+    if( ea->tid != eb->tid ) return ea->tid < eb->tid ? -1 : 1;
+    return 0;
+}
+
+static inline int index_entry_same_run(const dbp_index_entry_t *e, int32_t key,
+                                       uint32_t taskpool_id, uint64_t event_id)
+{
+    return (e->key == key) && (e->taskpool_id == taskpool_id) && (e->event_id == event_id);
+}
+
+static inline uint64_t index_hash(int32_t key, uint32_t taskpool_id, uint64_t event_id)
+{
+    uint64_t h = event_id * 0x9E3779B97F4A7C15ULL;
+    h ^= ((uint64_t)taskpool_id << 32) | (uint32_t)key;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 31);
+}
+
+/* Build the hash table of the runs of a sorted index */
+static void index_build_buckets(dbp_index_t *index)
+{
+    const dbp_index_entry_t *e;
+    uint64_t size = 16, h;
+    int64_t i;
 
-    /* if e1 is already an end, it doesn't match the non-preceding event */
-    key1 = dbp_event_get_key(e1);
-    if(KEY_IS_END(key1)) {
-            add_cache_entry(thr, key1, i1, e1);
+    while( size < 2 * (uint64_t)index->nb_entries )
+        size <<= 1;
+    index->mask = size - 1;
+    index->buckets = (int64_t*)malloc(size * sizeof(int64_t));
+    memset(index->buckets, -1, size * sizeof(int64_t));
+    for( i = 0; i < index->nb_entries; i++ ) {
+        e = &index->entries[i];
+        if( (i > 0) && index_entry_same_run(&index->entries[i-1], e->key, e->taskpool_id, e->event_id) )
+            continue;
+        for( h = index_hash(e->key, e->taskpool_id, e->event_id) & index->mask;
+             -1 != index->buckets[h];
+             h = (h + 1) & index->mask ) ;
+        index->buckets[h] = i;
     }
+}
 
-    /* iterator 2 points to next event */
-    i2 = dbp_iterator_new_from_thread( thr );
-    e2 = dbp_iterator_next( i2 );
+static void index_free(dbp_index_t *index)
+{
+    if( NULL == index )
+        return;
+    free(index->entries);
+    free(index->buckets);
+    free(index);
+}
+
+/* Gather the entries of all the streams of a file in a sorted, hashed index */
+static dbp_index_t *index_merge(dbp_index_list_t *lists, int nb_lists)
+{
+    dbp_index_t *index = (dbp_index_t*)calloc(1, sizeof(dbp_index_t));
+    int64_t pos = 0;
+    int t;
+
+    for( t = 0; t < nb_lists; t++ )
+        index->nb_entries += lists[t].nb_entries;
+    index->entries = (dbp_index_entry_t*)malloc((index->nb_entries + 1) * sizeof(dbp_index_entry_t));
+    for( t = 0; t < nb_lists; t++ ) {
+        if( lists[t].nb_entries > 0 )
+            memcpy(&index->entries[pos], lists[t].entries, lists[t].nb_entries * sizeof(dbp_index_entry_t));
+        pos += lists[t].nb_entries;
+        free(lists[t].entries);
+        lists[t].entries = NULL;
+    }
+    qsort(index->entries, index->nb_entries, sizeof(dbp_index_entry_t), index_entry_compare);
+    index_build_buckets(index);
+    return index;
+}
 
-    while( NULL != e2 ) {
-        key2 = dbp_event_get_key(e2);
+/* The index of a trace is saved next to it, in the hidden file .<trace>.idx
+ * (out of the reach of the *.prof-* patterns), and reused as long as the trace
+ * is not modified. The cache is best effort: any failure to read or to write
+ * it only means that the index is built again. */
+#define DBP_INDEX_MAGICK "#PARSEC DBP INDEX 1"
 
-        /* if e2 is end event, but e1 doesn't match, e2 not in expected order
-         * store e2 position in cache to lookup later for potential match */
-        if( KEY_IS_END(key2) && !dbp_events_match(e1, e2) ) {
-            add_cache_entry(thr, key2, i2, e2);
-        }
+typedef struct {
+    char     magick[24];
+    int64_t  trace_size;
+    int64_t  trace_mtime;
+    int64_t  buffer_size;
+    int64_t  nb_entries;
+} dbp_index_header_t;
+
+static char *index_filename(const dbp_file_t *file)
+{
+    const char *base = strrchr(file->filename, '/');
+    size_t len = strlen(file->filename) + strlen("..idx") + 1;
+    char *name = (char*)malloc(len);
+    int dirlen;
+
+    base = (NULL == base) ? file->filename : base + 1;
+    dirlen = (int)(base - file->filename);
+    snprintf(name, len, "%.*s.%s.idx", dirlen, file->filename, base);
+    return name;
+}
+
+static void index_header_init(dbp_index_header_t *head, const struct stat *st, int64_t nb_entries)
+{
+    memset(head, 0, sizeof(dbp_index_header_t));
+    strncpy(head->magick, DBP_INDEX_MAGICK, sizeof(head->magick));
+    head->trace_size  = st->st_size;
+    head->trace_mtime = st->st_mtime;
+    head->buffer_size = event_buffer_size;
+    head->nb_entries  = nb_entries;
+}
+
+static dbp_index_t *index_load(const dbp_file_t *file)
+{
+    dbp_index_header_t head, expected;
+    dbp_index_t *index = NULL;
+    struct stat st;
+    char *name;
+    size_t len;
+    int64_t i;
+    int fd;
 
-        /* advance both iterators */
-        e1 = dbp_iterator_next( i1 );
-        e2 = dbp_iterator_next( i2 );
+    if( 0 != stat(file->filename, &st) )
+        return NULL;
+    name = index_filename(file);
+    fd = open(name, O_RDONLY);
+    free(name);
+    if( -1 == fd )
+        return NULL;
+    if( read(fd, &head, sizeof(head)) != sizeof(head) )
+        goto close_and_return;
+    index_header_init(&expected, &st, head.nb_entries);
+    if( (0 != memcmp(&head, &expected, sizeof(head))) || (head.nb_entries < 0) )
+        goto close_and_return;
+
+    index = (dbp_index_t*)calloc(1, sizeof(dbp_index_t));
+    index->nb_entries = head.nb_entries;
+    len = head.nb_entries * sizeof(dbp_index_entry_t);
+    index->entries = (dbp_index_entry_t*)malloc(len + sizeof(dbp_index_entry_t));
+    if( (size_t)read(fd, index->entries, len) != len )
+        goto free_and_return;
+    for( i = 0; i < index->nb_entries; i++ ) {
+        if( (index->entries[i].tid < 0) || (index->entries[i].tid >= file->nb_threads) ||
+            (index->entries[i].key < 0) || (index->entries[i].key >= file->nb_dico_map) ||
+            (index->entries[i].offset < 0) || (index->entries[i].offset >= head.trace_size) ||
+            ((i > 0) && (index_entry_compare(&index->entries[i-1], &index->entries[i]) > 0)) )
+            goto free_and_return;
     }
+    index_build_buckets(index);
+    close(fd);
+    return index;
 
-    dbp_iterator_delete( i1 );
-    dbp_iterator_delete( i2 );
+  free_and_return:
+    index_free(index);
+    index = NULL;
+  close_and_return:
+    close(fd);
+    return index;
+}
 
-    /* set cache to done - it doesn't need to be rebuilt */
-    thr->cache.done = 1;
+static void index_save(const dbp_file_t *file, const dbp_index_t *index)
+{
+    dbp_index_header_t head;
+    struct stat st;
+    char *name, *tmp;
+    size_t len;
+    int fd, rc = -1;
 
-build_events_done:
-    pthread_mutex_unlock(&thr->cache.mtx);
+    if( 0 != stat(file->filename, &st) )
+        return;
+    index_header_init(&head, &st, index->nb_entries);
+    name = index_filename(file);
+    /* write a private copy first, concurrent readers only see complete indexes */
+    len = strlen(name) + 32;
+    tmp = (char*)malloc(len);
+    snprintf(tmp, len, "%s.%d", name, (int)getpid());
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if( -1 != fd ) {
+        len = index->nb_entries * sizeof(dbp_index_entry_t);
+        if( (write(fd, &head, sizeof(head)) == sizeof(head)) &&
+            ((size_t)write(fd, index->entries, len) == len) )
+            rc = 0;
+        close(fd);
+        if( (0 != rc) || (0 != rename(tmp, name)) )
+            unlink(tmp);
+    }
+    free(tmp);
+    free(name);
 }
 
-typedef struct {
-    const dbp_event_t        *ref;
-    const event_cache_item_t *last;
-} bsearch_key_t;
+static dbp_index_t *index_build(const dbp_file_t *file)
+{
+    dbp_index_list_t *lists;
+    dbp_index_t *index;
+    int t;
 
-static int bsearch_compare(const void *key, const void *el)
+    lists = (dbp_index_list_t*)calloc(file->nb_threads + 1, sizeof(dbp_index_list_t));
+    for( t = 0; t < file->nb_threads; t++ )
+        index_thread(&file->threads[t], t, &lists[t]);
+    index = index_merge(lists, file->nb_threads);
+    free(lists);
+    return index;
+}
+
+/* Return the index of a file, loading or building it if necessary */
+static const dbp_index_t *dbp_file_get_index(dbp_file_t *file)
 {
-    /* technically does Bad Thing (shouldn't modify key), but probably works */
-    bsearch_key_t      *bsearch_key = (bsearch_key_t *)key;
-    const event_cache_item_t *cache_item  = (const event_cache_item_t *)el;
-    bsearch_key->last = cache_item;
-    if( dbp_event_get_timestamp(bsearch_key->ref) < cache_item->timestamp )
-        return -1;
-    if( dbp_event_get_timestamp(bsearch_key->ref) > cache_item->timestamp )
-        return 1;
-    return 0;
+    pthread_mutex_lock(&file->index_mtx);
+    if( NULL == file->index ) {
+        file->index = index_load(file);
+        if( NULL == file->index ) {
+            file->index = index_build(file);
+            index_save(file, file->index);
+        }
+    }
+    pthread_mutex_unlock(&file->index_mtx);
+    return file->index;
 }
 
-static const event_cache_item_t*
-dbp_event_find_in_cache(const dbp_thread_t *thr,
-                        const dbp_event_t *ref)
+/* Find the end event matching ref: the first one, in time, in the stream tid
+ * or, if other_threads is set and there is none, the first one of the stream
+ * with the lowest identifier. */
+static const dbp_index_entry_t *
+index_lookup(const dbp_index_t *index, const dbp_event_t *ref, int tid, int other_threads)
 {
-    event_cache_key_t *cache_key;
-    bsearch_key_t      bsearch_key = { ref, NULL };
+    const dbp_index_entry_t *e, *best = NULL;
+    int32_t  key = BASE_KEY(dbp_event_get_key(ref));
+    uint32_t taskpool_id = dbp_event_get_taskpool_id(ref);
+    uint64_t event_id = dbp_event_get_event_id(ref);
+    uint64_t timestamp = dbp_event_get_timestamp(ref);
+    uint64_t h;
 
-    /* ensure we have an unmatched event cache
-     * casts away const because build_unmatched_events_in_thread modifies thr
-     * thr should be memory we allocated anyway though, so this should be safe
-     * ... right? */
-    build_unmatched_events_in_thread((dbp_thread_t*)thr);
+    if( !KEY_IS_START(dbp_event_get_key(ref)) || (0 == index->nb_entries) )
+        return NULL;
+    for( h = index_hash(key, taskpool_id, event_id) & index->mask;
+         -1 != index->buckets[h];
+         h = (h + 1) & index->mask ) {
+        e = &index->entries[index->buckets[h]];
+        if( !index_entry_same_run(e, key, taskpool_id, event_id) )
+            continue;
+        /* the run is sorted by timestamp */
+        for( ; (e < &index->entries[index->nb_entries]) &&
+                 index_entry_same_run(e, key, taskpool_id, event_id); e++ ) {
+            if( e->timestamp < timestamp )
+                continue;
+            if( e->tid == tid )
+                return e;
+            if( other_threads && ((NULL == best) || (e->tid < best->tid)) )
+                best = e;
+        }
+        return best;
+    }
+    return NULL;
+}
 
-    /* do binary search in cache of key for events at ref timestamp
-     * we throw away the results of the search, because it's very unlikely to
-     * find this EXACT timestamp; however, we use a side-effect of the search
-     * in the comparison function (bsearch_compare) to store the last item in
-     * the cache array that was considered; this is the "insertion point" for
-     * ref's timestamp and is the timestamp closest to ref's we could find, so
-     * we return it as the starting point for the subsequent search */
-    cache_key = &thr->cache.keys[BASE_KEY(dbp_event_get_key(ref))];
-    bsearch(&bsearch_key, cache_key->items, cache_key->len,
-            sizeof(event_cache_item_t), bsearch_compare);
+/* move iterator to the event of an index entry */
+static const dbp_event_t *
+dbp_iterator_move_to_entry(dbp_event_iterator_t *it, const dbp_index_entry_t *entry)
+{
+    int64_t event_pos = entry->offset % event_buffer_size;
+    off_t   offset = entry->offset - event_pos;
 
-    return bsearch_key.last;
+    if( (NULL == it->current_events_buffer) || (it->current_buffer_position != offset) )
+        dbp_iterator_set_offset(it, offset);
+    return dbp_iterator_move_to_event(it, event_pos, entry->event_idx);
 }
 
 int dbp_iterator_move_to_matching_event(dbp_event_iterator_t *pos,
                                         const dbp_event_t *ref)
 {
-    const event_cache_item_t *cache_item;
-    const event_cache_key_t  *cache_key;
-    const dbp_event_t        *e;
-    const dbp_thread_t       *thr = pos->thread;
-    off_t                     offset;
-    int64_t                   event_pos;
-
-    cache_item = dbp_event_find_in_cache( thr, ref );
-    cache_key  = &thr->cache.keys[BASE_KEY(dbp_event_get_key(ref))];
-
-    /* dbp_event_find_in_cache can return NULL
-     * if the thread doesn't have a matching event */
-    if( NULL == cache_item ) {
-        /* set iterator to past-the-end */
-        dbp_iterator_set_offset(pos, (off_t)-1);
-        return 0;
-    }
+    const dbp_thread_t      *thr = pos->thread;
+    const dbp_index_entry_t *entry;
+    const dbp_event_t       *e;
 
-    assert(&cache_key->items[0]              <= cache_item);
-    assert(&cache_key->items[cache_key->len] >  cache_item);
-
-    /* iterate over all cached events containing possible matches */
-    while( cache_item < &cache_key->items[cache_key->len] ) {
-        /* we computed cache_item->offset as buffer_position + event_position,
-         * so we must recover these values */
-        event_pos = cache_item->offset % event_buffer_size;
-        offset = cache_item->offset - event_pos;
-        /* change buffer if necessary */
-        if( pos->current_buffer_position != offset )
-            dbp_iterator_set_offset(pos, offset);
-        /* set iterator to current cached event */
-        e = dbp_iterator_move_to_event(pos, event_pos, cache_item->event_idx);
-        /* check if event matches */
+    entry = index_lookup(dbp_file_get_index(thr->file), ref,
+                         (int)(thr - thr->file->threads), 0);
+    if( NULL != entry ) {
+        e = dbp_iterator_move_to_entry(pos, entry);
         if( (NULL != e) && dbp_events_match(ref, e) )
             return 1;
-        cache_item++;
     }
 
     /* set iterator to past-the-end */
@@ -632,12 +844,11 @@ int dbp_iterator_move_to_matching_event(dbp_event_iterator_t *pos,
 
 dbp_event_iterator_t *dbp_iterator_find_matching_event_all_threads(const dbp_event_iterator_t *pos)
 {
+    const dbp_index_entry_t *entry;
     dbp_event_iterator_t *it;
-    dbp_thread_t *thr;
     const dbp_event_t *ref;
     const dbp_event_t *e;
     dbp_file_t *dbp_file;
-    int tid;
 
     dbp_file = pos->thread->file;
     ref = dbp_iterator_current((dbp_event_iterator_t *)pos);
@@ -650,25 +861,16 @@ dbp_event_iterator_t *dbp_iterator_find_matching_event_all_threads(const dbp_eve
         return it;
     dbp_iterator_delete(it);
 
-    /* search through possibly matching events in this thread */
-    it = dbp_iterator_new_from_thread( pos->thread );
-    if( dbp_iterator_move_to_matching_event(it, ref) )
+    /* the other ones are in the index, preferably in the same thread */
+    entry = index_lookup(dbp_file_get_index(dbp_file), ref,
+                         (int)(pos->thread - dbp_file->threads), 1);
+    if( NULL == entry )
+        return NULL;
+    it = dbp_iterator_new_from_thread( &dbp_file->threads[entry->tid] );
+    e = dbp_iterator_move_to_entry(it, entry);
+    if( (NULL != e) && dbp_events_match(ref, e) )
         return it;
     dbp_iterator_delete(it);
-
-    /* try other threads */
-    for( tid = 0; tid < dbp_file_nb_threads(dbp_file); tid++) {
-        thr = dbp_file_get_thread(dbp_file, tid);
-        /* skip same thread */
-        if( pos->thread == thr )
-            continue;
-        /* same logic as above */
-        it = dbp_iterator_new_from_thread( thr );
-        if( dbp_iterator_move_to_matching_event(it, ref) )
-            return it;
-        dbp_iterator_delete(it);
-    }
-
     return NULL;
 }
 
@@ -854,13 +1056,13 @@ static void read_infos(dbp_file_t *dbp, parsec_profiling_binary_file_header_t *h
                 if( NULL == next ) {
                     fprintf(stderr, "Info entry %d is broken. Only %d entries read from '%s'\n",
                             dbp->nb_infos - nb, nb, dbp->filename);
-                    release_events_buffer( info );
+                    release_events_buffer( dbp, info );
                     dbp->nb_infos = nb;
                     free(id);
                     return;
                 }
                 assert( PROFILING_BUFFER_TYPE_GLOBAL_INFO == next->buffer_type );
-                release_events_buffer( info );
+                release_events_buffer( dbp, info );
                 info = next;
 
                 pos = 0;
@@ -878,19 +1080,19 @@ static void read_infos(dbp_file_t *dbp, parsec_profiling_binary_file_header_t *h
             if( NULL == next ) {
                 fprintf(stderr, "Info entry %d is broken. Only %d entries read from '%s'\n",
                         dbp->nb_infos - nb, nb, dbp->filename);
-                release_events_buffer( info );
+                release_events_buffer( dbp, info );
                 dbp->nb_infos = nb;
                 return;
             }
             assert( PROFILING_BUFFER_TYPE_GLOBAL_INFO == next->buffer_type );
-            release_events_buffer( info );
+            release_events_buffer( dbp, info );
             info = next;
 
             pos = 0;
             nbthis = 0;
         }
     }
-    release_events_buffer( info );
+    release_events_buffer( dbp, info );
 }
 
 static int read_dictionary(dbp_file_t *file, const parsec_profiling_binary_file_header_t *head)
@@ -952,18 +1154,18 @@ static int read_dictionary(dbp_file_t *file, const parsec_profiling_binary_file_
             next = refer_events_buffer( file, dico->next_buffer_file_offset );
             if( NULL == next ) {
                 fprintf(stderr, "Dictionary entry %d is broken. Dictionary broken.\n", nb);
-                release_events_buffer( dico );
+                release_events_buffer( file, dico );
                 return -1;
             }
             assert( PROFILING_BUFFER_TYPE_DICTIONARY == dico->buffer_type );
-            release_events_buffer( dico );
+            release_events_buffer( file, dico );
             dico = next;
             nbthis = dico->this_buffer.nb_dictionary_entries;
 
             pos = 0;
         }
     }
-    release_events_buffer( dico );
+    release_events_buffer( file, dico );
     return 0;
 }
 
@@ -1025,10 +1227,6 @@ static int read_threads(dbp_file_t *dbp, const parsec_profiling_binary_file_head
         thr = &dbp->threads[head->nb_threads - nb];
         thr->file        = dbp;
         thr->profile     = res;
-        pthread_mutex_init(&thr->cache.mtx, NULL);
-        thr->cache.keys = (event_cache_key_t*)calloc(
-               dbp_file_nb_dictionary_entries(dbp), sizeof(event_cache_key_t));
-        thr->cache.done  = 0;
 
         pos += sizeof(parsec_profiling_stream_buffer_t) - sizeof(parsec_profiling_info_buffer_t);
         pos += read_thread_infos( res, thr, br->nb_infos, (char*)br->infos );
@@ -1043,11 +1241,11 @@ static int read_threads(dbp_file_t *dbp, const parsec_profiling_binary_file_head
             if( NULL == next ) {
                 fprintf(stderr, "Unable to read thread entry %d/%d at offset %lx: Profile file broken\n",
                         head->nb_threads-nb, head->nb_threads, (unsigned long)b->next_buffer_file_offset);
-                release_events_buffer( b );
+                release_events_buffer( dbp, b );
                 return -1;
             }
             assert( PROFILING_BUFFER_TYPE_THREAD == next->buffer_type );
-            release_events_buffer( b );
+            release_events_buffer( dbp, b );
             b = next;
 
             nbthis = b->this_buffer.nb_threads;
@@ -1056,7 +1254,7 @@ static int read_threads(dbp_file_t *dbp, const parsec_profiling_binary_file_head
         }
     }
 
-    release_events_buffer( b );
+    release_events_buffer( dbp, b );
     return 0;
 }
 
@@ -1091,6 +1289,12 @@ static dbp_multifile_reader_t *open_files(int nbfiles, char **filenames)
         dbp->files[n].parent = dbp;
         dbp->files[n].fd = fd;
         dbp->files[n].nb_infos = 0;
+        dbp->files[n].nb_threads = 0;
+        dbp->files[n].threads = NULL;
+        dbp->files[n].map = NULL;
+        dbp->files[n].map_size = 0;
+        dbp->files[n].index = NULL;
+        pthread_mutex_init(&dbp->files[n].index_mtx, NULL);
 
         if( (p = read( fd, &head, sizeof(parsec_profiling_binary_file_header_t) )) != sizeof(parsec_profiling_binary_file_header_t) ) {
             fprintf(stderr, "read %d bytes\n", p);
@@ -1139,6 +1343,8 @@ static dbp_multifile_reader_t *open_files(int nbfiles, char **filenames)
         dbp->files[n].hr_id = strdup(head.hr_id);
         dbp->files[n].rank = head.rank;
 
+        map_file(&dbp->files[n]);
+
         read_infos(&dbp->files[n], &head /*dbp->header*/);
 
         if( read_dictionary(&dbp->files[n], &head) != 0 ) {
@@ -1183,8 +1389,111 @@ dbp_multifile_reader_t *dbp_reader_open_files(int nbfiles, char *files[])
     return dbp;
 }
 
+typedef struct {
+    dbp_multifile_reader_t *dbp;
+    int              *files;        /**< the files to index */
+    int              *first_unit;   /**< the first stream of each file, in the units */
+    dbp_index_list_t *lists;        /**< the entries of each stream */
+    int               nb_files;
+    int               nb_units;
+    int               next_unit;
+    int               merge;        /**< the units are the files rather than the streams */
+    pthread_mutex_t   mtx;
+} dbp_index_work_t;
+
+static void *index_worker(void *arg)
+{
+    dbp_index_work_t *w = (dbp_index_work_t*)arg;
+    dbp_file_t *file;
+    int u, f;
+
+    for(;;) {
+        pthread_mutex_lock(&w->mtx);
+        u = w->next_unit++;
+        pthread_mutex_unlock(&w->mtx);
+        if( u >= w->nb_units )
+            break;
+        if( w->merge ) {
+            file = &w->dbp->files[w->files[u]];
+            file->index = index_merge(&w->lists[w->first_unit[u]], file->nb_threads);
+            index_save(file, file->index);
+            continue;
+        }
+        for( f = 0; w->first_unit[f+1] <= u; f++ ) ;
+        file = &w->dbp->files[w->files[f]];
+        index_thread(&file->threads[u - w->first_unit[f]], u - w->first_unit[f], &w->lists[u]);
+    }
+    return NULL;
+}
+
+static void index_run(dbp_index_work_t *w, int nb_units, int nb_workers)
+{
+    pthread_t *workers;
+    int i;
+
+    w->nb_units = nb_units;
+    w->next_unit = 0;
+    if( nb_workers > nb_units )
+        nb_workers = nb_units;
+    if( nb_workers <= 1 ) {
+        index_worker(w);
+        return;
+    }
+    workers = (pthread_t*)malloc(nb_workers * sizeof(pthread_t));
+    for( i = 1; i < nb_workers; i++ )
+        pthread_create(&workers[i], NULL, index_worker, w);
+    index_worker(w);
+    for( i = 1; i < nb_workers; i++ )
+        pthread_join(workers[i], NULL);
+    free(workers);
+}
+
+int dbp_reader_index(dbp_multifile_reader_t *dbp, int nb_threads)
+{
+    dbp_index_work_t w;
+    dbp_file_t *file;
+    int i;
+
+    memset(&w, 0, sizeof(w));
+    w.dbp = dbp;
+    w.files = (int*)malloc((dbp->nb_files + 1) * sizeof(int));
+    w.first_unit = (int*)malloc((dbp->nb_files + 1) * sizeof(int));
+    pthread_mutex_init(&w.mtx, NULL);
+
+    /* the cached indexes are loaded, the others built from the streams */
+    w.first_unit[0] = 0;
+    for( i = 0; i < dbp->nb_files; i++ ) {
+        file = &dbp->files[i];
+        if( (SUCCESS != file->error) || (NULL != file->index) )
+            continue;
+        file->index = index_load(file);
+        if( NULL != file->index )
+            continue;
+        w.files[w.nb_files] = i;
+        w.first_unit[w.nb_files + 1] = w.first_unit[w.nb_files] + file->nb_threads;
+        w.nb_files++;
+    }
+    if( w.nb_files > 0 ) {
+        w.lists = (dbp_index_list_t*)calloc(w.first_unit[w.nb_files] + 1, sizeof(dbp_index_list_t));
+        index_run(&w, w.first_unit[w.nb_files], nb_threads);
+        w.merge = 1;
+        index_run(&w, w.nb_files, nb_threads);
+        free(w.lists);
+    }
+
+    pthread_mutex_destroy(&w.mtx);
+    free(w.first_unit);
+    free(w.files);
+    return w.nb_files;
+}
+
 void dbp_reader_destruct(dbp_multifile_reader_t *dbp)
 {
+    for( int i = 0; i < dbp->nb_files; i++ ) {
+        unmap_file(&dbp->files[i]);
+        index_free(dbp->files[i].index);
+        dbp->files[i].index = NULL;
+    }
     free( dbp->files );
     free( dbp );
 }
@@ -25,6 +25,12 @@ int dbp_reader_nb_dictionary_entries(const dbp_multifile_reader_t *dbp);
 int dbp_reader_last_error(const dbp_multifile_reader_t *dbp);
 void dbp_reader_close_files(dbp_multifile_reader_t *dbp);
 void dbp_reader_destruct(dbp_multifile_reader_t *dbp);
+/* Build, with up to nb_threads threads, the indexes used to find the end events
+ * that do not immediately follow their start event, for the files that have
+ * no valid cached index (.<trace>.idx). Otherwise each index is built on the
+ * first search in its file. Must not be called concurrently with searches.
+ * Returns the number of indexes built. */
+int dbp_reader_index(dbp_multifile_reader_t *dbp, int nb_threads);
 
 /* Dictionary interface */
 
@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+""" Benchmark the conversion of binary traces to a columnar trace (see parsec-dbp2col).
+
+The binary traces are either given on the command line, or generated by the
+synthetic benchmark of the profiling system (tests/profiling-standalone/sp-perf),
+each of its threads tracing N start/end pairs. The script reports:
+  - the size of the binary traces, and the number of events they hold
+    according to parsec-dbp2xml (when given);
+  - the wall time and the peak RSS of parsec-dbp2col, and the size of the
+    columnar trace it produces;
+  - the time to load the footer of the columnar trace, and the time to read
+    the begin and end columns of all its row groups.
+
+Example, on the trace used to evaluate parsec-dbp2col:
+  columnar_benchmark.py --sp-perf build/tests/profiling-standalone/sp-perf -n 4 -N 250000 \\
+                        --dbp2col build/tools/profiling/parsec-dbp2col \\
+                        --dbp2xml build/tools/profiling/parsec-dbp2xml
+"""
+
+import argparse
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+import time
+import parsec_columnar as pc
+
+def run(cmd, cwd=None):
+    """ Run cmd, and return its wall time (s) and its peak RSS (kB) """
+    start = time.time()
+    proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, cwd=cwd)
+    _, status, rusage = os.wait4(proc.pid, 0)
+    duration = time.time() - start
+    proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+    if 0 != proc.returncode:
+        sys.exit('{} failed'.format(' '.join(cmd)))
+    return duration, rusage.ru_maxrss
+
+def count_xml_events(dbp2xml, traces, workdir):
+    """ parsec-dbp2xml always writes the matched events in out.xml """
+    xml = os.path.join(workdir, 'out.xml')
+    run([os.path.abspath(dbp2xml)] + [os.path.abspath(t) for t in traces], cwd=workdir)
+    with open(xml) as f:
+        count = sum(1 for line in f if line.strip() == '<EVENT>')
+    os.remove(xml)
+    return count
+
+def mb(size):
+    return size / (1024.0 * 1024.0)
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Benchmark parsec-dbp2col and the columnar trace reader")
+    parser.add_argument('--dbp2col', type=str, required=True, help='Path to parsec-dbp2col')
+    parser.add_argument('--dbp2xml', type=str, default=None, help='Path to parsec-dbp2xml, to check the number of events')
+    parser.add_argument('--sp-perf', type=str, default=None, help='Path to sp-perf, to generate the binary traces')
+    parser.add_argument('-n', type=int, default=4, help='Number of sp-perf threads (default 4)')
+    parser.add_argument('-N', type=int, default=250000, help='Number of events per sp-perf thread (default 250000)')
+    parser.add_argument('-r', type=int, default=None, help='Number of rows of the row groups (parsec-dbp2col -r)')
+    parser.add_argument('--workdir', type=str, default=None, help='Where to store the traces (default: a temporary directory)')
+    parser.add_argument('traces', metavar='TRACE', type=str, nargs='*', help='Binary traces to convert')
+    args = parser.parse_args()
+
+    if (args.sp_perf is None) == (0 == len(args.traces)):
+        parser.error('give either --sp-perf or the binary traces')
+    workdir = args.workdir if args.workdir is not None else tempfile.mkdtemp(prefix='columnar-')
+
+    traces = args.traces
+    if args.sp_perf is not None:
+        prefix = os.path.join(workdir, 'sp-perf')
+        duration, _ = run([args.sp_perf, '-f', prefix, '-n', str(args.n), '-N', str(args.N)])
+        traces = sorted(glob.glob(prefix + '-*.prof'))
+        print('sp-perf -n {} -N {} traced in {:.2f} s'.format(args.n, args.N, duration))
+    print('{} binary traces, {:.1f} MB'.format(len(traces), mb(sum(os.path.getsize(t) for t in traces))))
+    if args.dbp2xml is not None:
+        print('{} events according to parsec-dbp2xml'.format(count_xml_events(args.dbp2xml, traces, workdir)))
+
+    output = os.path.join(workdir, 'trace.pcol')
+    cmd = [args.dbp2col, '-o', output]
+    if args.r is not None:
+        cmd += ['-r', str(args.r)]
+    duration, rss = run(cmd + traces)
+    print('parsec-dbp2col: {:.2f} s, {:.1f} MB peak RSS, {:.1f} MB columnar trace'.format(
+        duration, rss / 1024.0, mb(os.path.getsize(output))))
+
+    start = time.time()
+    trace = pc.ColumnarTrace(output)
+    footer = time.time() - start
+    start = time.time()
+    nb_events = 0
+    for rows in trace.iter_row_groups(['begin', 'end']):
+        nb_events += len(rows['begin'])
+    columns = time.time() - start
+    print('{} events in {} row groups: footer loaded in {:.1f} ms, begin and end columns read in {:.1f} ms'.format(
+        nb_events, len(trace.row_groups), footer * 1000.0, columns * 1000.0))
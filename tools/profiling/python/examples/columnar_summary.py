@@ -0,0 +1,36 @@
+#!/usr/bin/env python
+""" Summarize the events of a columnar trace (see parsec-dbp2col) per event type.
+
+Only the type, begin and end columns of the row groups overlapping the
+requested time range are read, one row group at a time, so the memory used
+does not depend on the size of the trace.
+"""
+
+import argparse
+import time
+import parsec_columnar as pc
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Per event type summary of a PaRSEC columnar trace")
+    parser.add_argument('--begin', type=int, default=None, help='Ignore the events that end before this date')
+    parser.add_argument('--end', type=int, default=None, help='Ignore the events that start after this date')
+    parser.add_argument('--node', type=int, action='append', default=None, help='Only consider this node (repeatable)')
+    parser.add_argument('input', metavar='INPUT', type=str, help='Columnar trace produced by parsec-dbp2col')
+    args = parser.parse_args()
+
+    start = time.time()
+    trace = pc.ColumnarTrace(args.input)
+    groups = trace.select_row_groups(args.begin, args.end, args.node)
+    count = dict()
+    duration = dict()
+    for rows in trace.iter_row_groups(['type', 'begin', 'end'], args.begin, args.end, args.node):
+        for t, b, e in zip(rows['type'], rows['begin'], rows['end']):
+            count[t] = count.get(t, 0) + 1
+            duration[t] = duration.get(t, 0) + int(e) - int(b)
+
+    print('{} events, {} of {} row groups read in {:.3f} s'.format(
+        sum(count.values()), len(groups), len(trace.row_groups), time.time() - start))
+    print('{:<32} {:>12} {:>16} {:>14}'.format('event', 'count', 'total duration', 'mean duration'))
+    for t in sorted(count.keys()):
+        print('{:<32} {:>12} {:>16} {:>14.1f}'.format(trace.event_names.get(t, str(t)), count[t],
+                                                      duration[t], duration[t] / float(count[t])))
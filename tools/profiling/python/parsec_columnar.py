@@ -0,0 +1,214 @@
+#!/usr/bin/env python
+""" Reader of the columnar traces produced by parsec-dbp2col.
+
+A columnar trace holds the matched events of a set of PaRSEC Binary Profile
+files, stored in row groups of a fixed number of rows, each column of a row
+group being contiguous. The footer describes every row group with the time
+range and the nodes of its events, so that only the row groups and the
+columns needed by an analysis are read from the disk:
+
+    trace = ColumnarTrace('out.pcol')
+    for rows in trace.iter_row_groups(columns=['type', 'begin', 'end'],
+                                      begin=t0, end=t1):
+        ...  # rows['begin'] is a numpy array of the row group
+
+Each row group fits in memory even when the whole trace does not. read()
+concatenates the selected row groups in a pandas DataFrame similar to the
+events table of a PaRSEC Trace Table.
+
+numpy is used when available, otherwise the columns are array.array objects.
+"""
+
+import array
+import struct
+import sys
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+MAGICK = b'#PARSEC COLUMNAR TRACE 1'
+BYTE_ORDER = 0x0123456789ABCDEF
+_array_typecodes = {'i2': 'h', 'u2': 'H', 'i4': 'i', 'u4': 'I', 'i8': 'q', 'u8': 'Q'}
+
+
+class _Cursor(object):
+    def __init__(self, data, endian):
+        self.data = data
+        self.pos = 0
+        self.endian = endian
+
+    def unpack(self, fmt):
+        fmt = self.endian + fmt
+        values = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += struct.calcsize(fmt)
+        return values if len(values) > 1 else values[0]
+
+    def string(self):
+        length = self.unpack('I')
+        value = self.data[self.pos:self.pos + length].decode('utf-8', 'replace')
+        self.pos += length
+        return value
+
+
+class ColumnarTrace(object):
+    """ A columnar trace, of which only the header and the footer are loaded """
+
+    def __init__(self, filename):
+        self.filename = filename
+        with open(filename, 'rb') as f:
+            header = f.read(40)
+            if len(header) != 40 or header[:24] != MAGICK:
+                raise ValueError('{} is not a PaRSEC columnar trace'.format(filename))
+            for endian in '<>':
+                if struct.unpack_from(endian + 'Q', header, 24)[0] == BYTE_ORDER:
+                    break
+            else:
+                raise ValueError('{} has an unknown byte order'.format(filename))
+            self.endian = endian
+            self.rows_per_group = struct.unpack_from(endian + 'I', header, 36)[0]
+            f.seek(-32, 2)
+            trailer = f.read(32)
+            if trailer[8:] != MAGICK:
+                raise ValueError('{} is truncated'.format(filename))
+            footer_offset = struct.unpack_from(endian + 'q', trailer, 0)[0]
+            f.seek(footer_offset)
+            cursor = _Cursor(f.read(), endian)
+
+        self.columns = []
+        self.dtypes = dict()
+        for i in range(cursor.unpack('I')):
+            name = cursor.string()
+            self.columns.append(name)
+            self.dtypes[name] = cursor.string()
+
+        self.dictionary = []
+        for i in range(cursor.unpack('I')):
+            self.dictionary.append({'name': cursor.string(), 'attributes': cursor.string(),
+                                    'convertor': cursor.string()})
+        self.event_types = dict((d['name'], i) for i, d in enumerate(self.dictionary))
+        self.event_names = dict((i, d['name']) for i, d in enumerate(self.dictionary))
+
+        self.nodes = []
+        for i in range(cursor.unpack('I')):
+            node = {'id': cursor.unpack('i'), 'exe': cursor.string(), 'filename': cursor.string()}
+            for j in range(cursor.unpack('I')):
+                key = cursor.string()
+                node[key] = cursor.string()
+            self.nodes.append(node)
+
+        self.streams = []
+        for i in range(cursor.unpack('Q')):
+            node_id, stream_id = cursor.unpack('ii')
+            description = cursor.string()
+            begin, end, nb_events = cursor.unpack('QQq')
+            self.streams.append({'node_id': node_id, 'stream_id': stream_id,
+                                 'description': description, 'begin': begin, 'end': end,
+                                 'nb_events': nb_events})
+
+        self.row_groups = []
+        for i in range(cursor.unpack('Q')):
+            nb_rows, min_begin, max_end, min_node, max_node = cursor.unpack('qQQii')
+            offsets = cursor.unpack('{}q'.format(len(self.columns)))
+            if len(self.columns) == 1:
+                offsets = (offsets,)
+            self.row_groups.append({'nb_rows': nb_rows, 'min_begin': min_begin, 'max_end': max_end,
+                                    'min_node': min_node, 'max_node': max_node,
+                                    'offsets': dict(zip(self.columns, offsets))})
+
+    def nb_events(self):
+        return sum(g['nb_rows'] for g in self.row_groups)
+
+    def select_row_groups(self, begin=None, end=None, nodes=None):
+        """ Returns the row groups that may hold events overlapping [begin, end]
+        on one of the nodes """
+        selected = []
+        for g in self.row_groups:
+            if begin is not None and g['max_end'] < begin:
+                continue
+            if end is not None and g['min_begin'] > end:
+                continue
+            if nodes is not None and not any(g['min_node'] <= n <= g['max_node'] for n in nodes):
+                continue
+            selected.append(g)
+        return selected
+
+    def _read_column(self, f, group, name):
+        dtype = self.dtypes[name]
+        f.seek(group['offsets'][name])
+        if numpy is not None:
+            return numpy.fromfile(f, dtype=numpy.dtype(self.endian + dtype), count=group['nb_rows'])
+        values = array.array(_array_typecodes[dtype])
+        values.fromfile(f, group['nb_rows'])
+        if (self.endian == '<') != (sys.byteorder == 'little'):
+            values.byteswap()
+        return values
+
+    def iter_row_groups(self, columns=None, begin=None, end=None, nodes=None, types=None):
+        """ Yields a dict of the requested columns for each row group holding
+        events overlapping [begin, end], on one of the nodes, of one of the
+        types (names or identifiers). Only the events that match are kept. """
+        if columns is None:
+            columns = self.columns
+        for name in columns:
+            if name not in self.dtypes:
+                raise KeyError('{} is not a column of {}'.format(name, self.filename))
+        if types is not None:
+            types = set(self.event_types[t] if t in self.event_types else t for t in types)
+        filters = []
+        if begin is not None:
+            filters.append(('end', 'ge', begin))
+        if end is not None:
+            filters.append(('begin', 'le', end))
+        if nodes is not None:
+            filters.append(('node_id', 'in', set(nodes)))
+        if types is not None:
+            filters.append(('type', 'in', types))
+        needed = list(columns) + [f[0] for f in filters if f[0] not in columns]
+
+        with open(self.filename, 'rb') as f:
+            for group in self.select_row_groups(begin, end, nodes):
+                rows = dict((name, self._read_column(f, group, name)) for name in needed)
+                if filters:
+                    rows = self._filter(rows, filters, group['nb_rows'])
+                yield dict((name, rows[name]) for name in columns)
+
+    @staticmethod
+    def _keep(value, op, arg):
+        if op == 'ge':
+            return value >= arg
+        if op == 'le':
+            return value <= arg
+        return value in arg
+
+    def _filter(self, rows, filters, nb_rows):
+        if numpy is not None:
+            mask = numpy.ones(nb_rows, dtype=bool)
+            for name, op, arg in filters:
+                if op == 'in':
+                    mask &= numpy.isin(rows[name], list(arg))
+                else:
+                    mask &= self._keep(rows[name], op, arg)
+            return dict((name, values[mask]) for name, values in rows.items())
+        keep = [i for i in range(nb_rows)
+                if all(self._keep(rows[name][i], op, arg) for name, op, arg in filters)]
+        return dict((name, array.array(values.typecode, (values[i] for i in keep)))
+                    for name, values in rows.items())
+
+    def read(self, columns=None, begin=None, end=None, nodes=None, types=None):
+        """ Returns a pandas DataFrame of the requested columns of the events
+        overlapping [begin, end], on one of the nodes, of one of the types """
+        import pandas as pd
+        if columns is None:
+            columns = self.columns
+        parts = [pd.DataFrame(rows, columns=columns)
+                 for rows in self.iter_row_groups(columns, begin, end, nodes, types)]
+        if not parts:
+            return pd.DataFrame(columns=columns)
+        return pd.concat(parts, ignore_index=True)
+
+
+def read(filename, columns=None, begin=None, end=None, nodes=None, types=None):
+    """ Returns a pandas DataFrame of the requested columns and events of a columnar trace """
+    return ColumnarTrace(filename).read(columns, begin, end, nodes, types)
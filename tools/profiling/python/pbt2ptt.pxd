@@ -44,6 +44,7 @@ cdef extern from "dbpreader.h":
    int dbp_reader_last_error(const dbp_multifile_reader_t *dbp)
    void dbp_reader_close_files(dbp_multifile_reader_t * dbp)
    void dbp_reader_destruct(dbp_multifile_reader_t * dbp)
+   int dbp_reader_index(dbp_multifile_reader_t * dbp, int nb_threads)
 
    dbp_dictionary_t * dbp_file_get_dictionary(dbp_file_t * file, int did)
    dbp_dictionary_t * dbp_reader_get_dictionary(dbp_multifile_reader_t * dbp, int did)
@@ -110,6 +110,11 @@ cpdef read(filenames, report_progress=False, skeleton_only=False, multiprocess=F
     if skeleton_only:
         multiprocess = 1
 
+    # index the out-of-order end events of all the files with all the cores, so
+    # that the processes reading the streams load the cached indexes
+    if not skeleton_only:
+        dbp_reader_index(dbp, multiprocessing.cpu_count())
+
     nb_dict_entries = dbp_reader_nb_dictionary_entries(dbp)
     nb_files = dbp_reader_nb_files(dbp)
     worldsize = nb_files